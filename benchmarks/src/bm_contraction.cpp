@@ -0,0 +1,237 @@
+// This file is part of Holor, a C++ header-only template library for multi-dimensional containers
+
+// Copyright 2020-2022 Carlo Masone
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to 
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is 
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER 
+// DEALINGS IN THE SOFTWARE.
+#include <benchmark/benchmark.h>
+#include <holor/holor_full.h>
+#include <numeric>
+
+
+
+using namespace holor;
+
+// The products report the throughput in floating point operations per second (2*m*n*k per product): the counter GFLOPS is printed in units of G/s.
+// The naive versions use a triple loop on the raw data in the i-k-j order, which is the fastest order for a loop nest without blocking.
+
+template<typename T, size_t N>
+static Holor<T, N> make_holor(const std::array<size_t, N>& lengths){
+    Holor<T, N> h(lengths);
+    T value = T(0);
+    for (auto& x : h){
+        x = value;
+        value = (value > T(10)) ? T(0) : value + T(0.5);
+    }
+    return h;
+}
+
+static void set_flops(benchmark::State& state, double flops){
+    state.counters["GFLOPS"] = benchmark::Counter(flops*state.iterations(), benchmark::Counter::kIsRate, benchmark::Counter::kIs1000);
+}
+
+/*=============================================================================
+ ====================         MATRIX PRODUCT          =======================
+ ============================================================================*/
+template<typename T>
+static void BM_MatrixProductNaive(benchmark::State& state) {
+    const size_t n = state.range(0);
+    auto a = make_holor<T, 2>({n, n});
+    auto b = make_holor<T, 2>({n, n});
+    Holor<T, 2> c(std::vector<size_t>{n, n});
+    for (auto _ : state){
+        const T* pa = a.data();
+        const T* pb = b.data();
+        T* pc = c.data();
+        std::fill(pc, pc + n*n, T(0));
+        for (size_t i = 0; i < n; i++){
+            for (size_t k = 0; k < n; k++){
+                const T aik = pa[i*n + k];
+                for (size_t j = 0; j < n; j++){
+                    pc[i*n + j] += aik*pb[k*n + j];
+                }
+            }
+        }
+        benchmark::DoNotOptimize(c.data());
+    }
+    set_flops(state, 2.0*n*n*n);
+}
+BENCHMARK_TEMPLATE(BM_MatrixProductNaive, float)->Arg(64)->Arg(256)->Arg(1024)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_MatrixProductNaive, double)->Arg(64)->Arg(256)->Arg(1024)->Unit(benchmark::kMillisecond);
+
+template<typename T>
+static void BM_MatrixProductContract(benchmark::State& state) {
+    const size_t n = state.range(0);
+    auto a = make_holor<T, 2>({n, n});
+    auto b = make_holor<T, 2>({n, n});
+    for (auto _ : state){
+        auto c = contract<1>(a, b, {1}, {0});
+        benchmark::DoNotOptimize(c.data());
+    }
+    set_flops(state, 2.0*n*n*n);
+}
+BENCHMARK_TEMPLATE(BM_MatrixProductContract, float)->Arg(64)->Arg(256)->Arg(1024)->Arg(2048)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_MatrixProductContract, double)->Arg(64)->Arg(256)->Arg(1024)->Arg(2048)->Unit(benchmark::kMillisecond);
+
+static void BM_MatrixProductContractParallel(benchmark::State& state) {
+    const size_t n = 2048;
+    auto a = make_holor<float, 2>({n, n});
+    auto b = make_holor<float, 2>({n, n});
+    const auto policy = execution::par.with_threads(state.range(0));
+    for (auto _ : state){
+        auto c = contract<1>(policy, a, b, {1}, {0});
+        benchmark::DoNotOptimize(c.data());
+    }
+    set_flops(state, 2.0*n*n*n);
+}
+BENCHMARK(BM_MatrixProductContractParallel)->DenseRange(1, std::max<size_t>(1, executor::global().concurrency()), 1)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+
+
+/*=============================================================================
+ ====================             MATMUL              =======================
+ ============================================================================*/
+// a batch of 256 inputs with 1024 features multiplied by the transpose of a 1024x1024 weight matrix, which is read in place through a transposed view
+template<typename T>
+static void BM_MatmulManualLoop(benchmark::State& state) {
+    const size_t batch = 256, n = state.range(0);
+    auto x = make_holor<T, 2>({batch, n});
+    auto w = make_holor<T, 2>({n, n});
+    Holor<T, 2> y(std::vector<size_t>{batch, n});
+    for (auto _ : state){
+        for (size_t i = 0; i < batch; i++){
+            for (size_t j = 0; j < n; j++){
+                T sum = T(0);
+                for (size_t k = 0; k < n; k++){
+                    sum += x(i, k)*w(j, k);
+                }
+                y(i, j) = sum;
+            }
+        }
+        benchmark::DoNotOptimize(y.data());
+    }
+    set_flops(state, 2.0*batch*n*n);
+}
+BENCHMARK_TEMPLATE(BM_MatmulManualLoop, float)->Arg(256)->Arg(1024)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_MatmulManualLoop, double)->Arg(256)->Arg(1024)->Unit(benchmark::kMillisecond);
+
+template<typename T>
+static void BM_MatmulTransposedView(benchmark::State& state) {
+    const size_t batch = 256, n = state.range(0);
+    auto x = make_holor<T, 2>({batch, n});
+    auto w = make_holor<T, 2>({n, n});
+    auto wt = transpose_view(w, std::array<size_t, 2>{1, 0});
+    Holor<T, 2> y(std::vector<size_t>{batch, n});
+    for (auto _ : state){
+        matmul(x, wt, y);
+        benchmark::DoNotOptimize(y.data());
+    }
+    set_flops(state, 2.0*batch*n*n);
+}
+BENCHMARK_TEMPLATE(BM_MatmulTransposedView, float)->Arg(256)->Arg(1024)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_MatmulTransposedView, double)->Arg(256)->Arg(1024)->Unit(benchmark::kMillisecond);
+
+// product with a small depth, where the update of the tiles of C is a large part of the work
+static void BM_MatmulSmallDepth(benchmark::State& state) {
+    const size_t n = 2048, k = state.range(0);
+    auto a = make_holor<float, 2>({n, k});
+    auto b = make_holor<float, 2>({k, n});
+    Holor<float, 2> c(std::vector<size_t>{n, n});
+    for (auto _ : state){
+        matmul(a, b, c, 1.0f, 1.0f);
+        benchmark::DoNotOptimize(c.data());
+    }
+    set_flops(state, 2.0*n*n*k);
+}
+BENCHMARK(BM_MatmulSmallDepth)->Arg(16)->Arg(64)->Unit(benchmark::kMillisecond);
+
+static void BM_MatmulParallel(benchmark::State& state) {
+    const size_t n = 2048;
+    auto a = make_holor<float, 2>({n, n});
+    auto b = make_holor<float, 2>({n, n});
+    Holor<float, 2> c(std::vector<size_t>{n, n});
+    const auto policy = execution::par.with_threads(state.range(0));
+    for (auto _ : state){
+        matmul(policy, a, b, c);
+        benchmark::DoNotOptimize(c.data());
+    }
+    set_flops(state, 2.0*n*n*n);
+}
+BENCHMARK(BM_MatmulParallel)->DenseRange(1, std::max<size_t>(1, executor::global().concurrency()), 1)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+
+
+/*=============================================================================
+ ====================          CONTRACTIONS          ========================
+ ============================================================================*/
+// contraction of two 4D containers over two pairs of dimensions that are not adjacent in the first operand, so the operand is permuted before the product
+static void BM_ContractPermuted(benchmark::State& state) {
+    const size_t n = state.range(0);
+    auto a = make_holor<float, 4>({n, n, n, n});
+    auto b = make_holor<float, 4>({n, n, n, n});
+    for (auto _ : state){
+        auto c = contract<2>(a, b, {0, 2}, {1, 0});
+        benchmark::DoNotOptimize(c.data());
+    }
+    set_flops(state, 2.0*n*n*n*n*n*n);
+}
+BENCHMARK(BM_ContractPermuted)->Arg(16)->Arg(32)->Unit(benchmark::kMillisecond);
+
+static void BM_ContractPermutedNaive(benchmark::State& state) {
+    const size_t n = state.range(0);
+    auto a = make_holor<float, 4>({n, n, n, n});
+    auto b = make_holor<float, 4>({n, n, n, n});
+    Holor<float, 4> c(std::vector<size_t>{n, n, n, n});
+    for (auto _ : state){
+        for (size_t i = 0; i < n; i++){
+            for (size_t j = 0; j < n; j++){
+                for (size_t k = 0; k < n; k++){
+                    for (size_t l = 0; l < n; l++){
+                        float sum = 0;
+                        for (size_t p = 0; p < n; p++){
+                            for (size_t q = 0; q < n; q++){
+                                sum += a(p, i, q, j)*b(q, p, k, l);
+                            }
+                        }
+                        c(i, j, k, l) = sum;
+                    }
+                }
+            }
+        }
+        benchmark::DoNotOptimize(c.data());
+    }
+    set_flops(state, 2.0*n*n*n*n*n*n);
+}
+BENCHMARK(BM_ContractPermutedNaive)->Arg(16)->Arg(32)->Unit(benchmark::kMillisecond);
+
+// batch of small matrix products
+static void BM_EinsumBatch(benchmark::State& state) {
+    const size_t batch = 1024, n = state.range(0);
+    auto a = make_holor<float, 3>({batch, n, n});
+    auto b = make_holor<float, 3>({batch, n, n});
+    for (auto _ : state){
+        auto c = einsum<3>("bij,bjk->bik", a, b);
+        benchmark::DoNotOptimize(c.data());
+    }
+    set_flops(state, 2.0*batch*n*n*n);
+}
+BENCHMARK(BM_EinsumBatch)->Arg(8)->Arg(32)->Unit(benchmark::kMillisecond);
+
+
+
+BENCHMARK_MAIN();
@@ -24,6 +24,7 @@
 
 #include <benchmark/benchmark.h>
 #include <holor/holor_full.h>
+#include <algorithm>
 
 
 
@@ -238,4 +239,254 @@ static void BM_DimSlicing(benchmark::State& state) {
 }
 BENCHMARK(BM_DimSlicing);
 
+/*=============================================================================
+ ====================      STATIC AND DYNAMIC LENGTHS     =====================
+ ============================================================================*/
+// Small fixed-size matrices: a 4x4 matrix product that creates its result at every iteration, with dynamic and static lengths
+static void BM_MatrixProduct4x4Dynamic(benchmark::State& state) {
+    Holor<float, 2> a{{1,2,3,4},{5,6,7,8},{9,10,11,12},{13,14,15,16}};
+    Holor<float, 2> b{{1,0,0,1},{0,1,1,0},{1,1,0,0},{0,0,1,1}};
+    for (auto _ : state){
+        benchmark::DoNotOptimize(a.data());
+        Holor<float, 2> c(std::vector<size_t>{4,4});
+        for (size_t i = 0; i < 4; i++){
+            for (size_t j = 0; j < 4; j++){
+                float sum = 0;
+                for (size_t k = 0; k < 4; k++){
+                    sum += a(i,k)*b(k,j);
+                }
+                c(i,j) = sum;
+            }
+        }
+        benchmark::DoNotOptimize(c.data());
+    }
+}
+BENCHMARK(BM_MatrixProduct4x4Dynamic);
+
+
+static void BM_MatrixProduct4x4Static(benchmark::State& state) {
+    StaticHolor<float, 4, 4> a{{1,2,3,4},{5,6,7,8},{9,10,11,12},{13,14,15,16}};
+    StaticHolor<float, 4, 4> b{{1,0,0,1},{0,1,1,0},{1,1,0,0},{0,0,1,1}};
+    for (auto _ : state){
+        benchmark::DoNotOptimize(a.data());
+        StaticHolor<float, 4, 4> c;
+        for (size_t i = 0; i < 4; i++){
+            for (size_t j = 0; j < 4; j++){
+                float sum = 0;
+                for (size_t k = 0; k < 4; k++){
+                    sum += a(i,k)*b(k,j);
+                }
+                c(i,j) = sum;
+            }
+        }
+        benchmark::DoNotOptimize(c.data());
+    }
+}
+BENCHMARK(BM_MatrixProduct4x4Static);
+
+
+static void BM_HolorIndexing3x3Dynamic(benchmark::State& state) {
+    Holor<float, 2> h{{1,2,3},{4,5,6},{7,8,9}};
+    for (auto _ : state){
+        benchmark::DoNotOptimize(h(2,1));
+    }
+}
+BENCHMARK(BM_HolorIndexing3x3Dynamic);
+
+
+static void BM_HolorIndexing3x3Static(benchmark::State& state) {
+    StaticHolor<float, 3, 3> h{{1,2,3},{4,5,6},{7,8,9}};
+    for (auto _ : state){
+        benchmark::DoNotOptimize(h(2,1));
+    }
+}
+BENCHMARK(BM_HolorIndexing3x3Static);
+
+
+/*=============================================================================
+ ========================          ALLOCATORS          =========================
+ ============================================================================*/
+// Allocation and a full streaming pass over a large buffer, with the default allocator, a cache-line aligned allocator and transparent huge pages
+template<class Allocator>
+static void BM_HolorAllocateAndFill(benchmark::State& state) {
+    const size_t n = state.range(0);
+    for (auto _ : state){
+        Holor<float, 2, Allocator> h(std::vector<size_t>{n, n});
+        std::fill(h.begin(), h.end(), 1.0f);
+        benchmark::DoNotOptimize(h.data());
+    }
+    state.SetBytesProcessed(state.iterations()*n*n*sizeof(float));
+}
+BENCHMARK_TEMPLATE(BM_HolorAllocateAndFill, std::allocator<float>)->Arg(64)->Arg(2048);
+BENCHMARK_TEMPLATE(BM_HolorAllocateAndFill, AlignedAllocator<float>)->Arg(64)->Arg(2048);
+BENCHMARK_TEMPLATE(BM_HolorAllocateAndFill, HugePageAllocator<float>)->Arg(64)->Arg(2048);
+
+
+/*=============================================================================
+ ====================      UNINITIALIZED CONSTRUCTION     ======================
+ ============================================================================*/
+// Creation of a container that is immediately overwritten: the value-initialized construction writes the buffer twice, the uninitialized one only once
+static void BM_HolorConstructValueInit(benchmark::State& state) {
+    const size_t n = state.range(0);
+    for (auto _ : state){
+        Holor<float, 2> h(std::vector<size_t>{n, n});
+        std::fill(h.begin(), h.end(), 1.0f);
+        benchmark::DoNotOptimize(h.data());
+    }
+    state.SetBytesProcessed(state.iterations()*n*n*sizeof(float));
+}
+BENCHMARK(BM_HolorConstructValueInit)->Arg(64)->Arg(2048);
+
+static void BM_HolorConstructUninitialized(benchmark::State& state) {
+    const size_t n = state.range(0);
+    for (auto _ : state){
+        Holor<float, 2> h(holor::uninitialized, std::vector<size_t>{n, n});
+        std::fill(h.begin(), h.end(), 1.0f);
+        benchmark::DoNotOptimize(h.data());
+    }
+    state.SetBytesProcessed(state.iterations()*n*n*sizeof(float));
+}
+BENCHMARK(BM_HolorConstructUninitialized)->Arg(64)->Arg(2048);
+
+// Operations that create their result without initializing it
+static void BM_HolorTransposeLarge(benchmark::State& state) {
+    const size_t n = state.range(0);
+    Holor<float, 2> h(std::vector<size_t>{n, n});
+    for (auto _ : state){
+        auto t = transpose(h);
+        benchmark::DoNotOptimize(t.data());
+    }
+    state.SetBytesProcessed(state.iterations()*n*n*sizeof(float));
+}
+BENCHMARK(BM_HolorTransposeLarge)->Arg(64)->Arg(2048);
+
+static void BM_HolorConcatenateLarge(benchmark::State& state) {
+    const size_t n = state.range(0);
+    Holor<float, 2> h(std::vector<size_t>{n, n});
+    for (auto _ : state){
+        auto c = concatenate<0>(h, h);
+        benchmark::DoNotOptimize(c.data());
+    }
+    state.SetBytesProcessed(state.iterations()*2*n*n*sizeof(float));
+}
+BENCHMARK(BM_HolorConcatenateLarge)->Arg(64)->Arg(2048);
+
+
+/*=============================================================================
+ ========================          EXPRESSIONS          ========================
+ ============================================================================*/
+// r = 2*x + y - z/4 computed with a hand-written loop, with a chain of operations that creates temporaries, and with a lazy expression
+static void BM_ElementwiseLoop(benchmark::State& state) {
+    const size_t n = state.range(0);
+    Holor<float, 2> x(std::vector<size_t>{n, n}), y(std::vector<size_t>{n, n}), z(std::vector<size_t>{n, n});
+    Holor<float, 2> r(std::vector<size_t>{n, n});
+    for (auto _ : state){
+        auto xp = x.data(); auto yp = y.data(); auto zp = z.data(); auto rp = r.data();
+        for (size_t i = 0; i < n*n; i++){
+            rp[i] = 2.0f*xp[i] + yp[i] - zp[i]/4.0f;
+        }
+        benchmark::DoNotOptimize(r.data());
+    }
+    state.SetBytesProcessed(state.iterations()*4*n*n*sizeof(float));
+}
+BENCHMARK(BM_ElementwiseLoop)->Arg(64)->Arg(2048);
+
+static void BM_ElementwiseTemporaries(benchmark::State& state) {
+    const size_t n = state.range(0);
+    Holor<float, 2> x(std::vector<size_t>{n, n}), y(std::vector<size_t>{n, n}), z(std::vector<size_t>{n, n});
+    for (auto _ : state){
+        Holor<float, 2> r = x;
+        apply(r, [](float v){ return 2.0f*v; });
+        Holor<float, 2> t = z;
+        apply(t, [](float v){ return v/4.0f; });
+        std::transform(r.begin(), r.end(), y.begin(), r.begin(), std::plus<>{});
+        std::transform(r.begin(), r.end(), t.begin(), r.begin(), std::minus<>{});
+        benchmark::DoNotOptimize(r.data());
+    }
+    state.SetBytesProcessed(state.iterations()*4*n*n*sizeof(float));
+}
+BENCHMARK(BM_ElementwiseTemporaries)->Arg(64)->Arg(2048);
+
+static void BM_ElementwiseExpression(benchmark::State& state) {
+    const size_t n = state.range(0);
+    Holor<float, 2> x(std::vector<size_t>{n, n}), y(std::vector<size_t>{n, n}), z(std::vector<size_t>{n, n});
+    Holor<float, 2> r(std::vector<size_t>{n, n});
+    for (auto _ : state){
+        r = 2.0f*x + y - z/4.0f;
+        benchmark::DoNotOptimize(r.data());
+    }
+    state.SetBytesProcessed(state.iterations()*4*n*n*sizeof(float));
+}
+BENCHMARK(BM_ElementwiseExpression)->Arg(64)->Arg(2048);
+
+// r = x + bias, where the bias is a row broadcast to all the rows of x, by materializing the expanded bias and by broadcasting it in the expression with a zero stride
+static void BM_BiasAddMaterialized(benchmark::State& state) {
+    const size_t n = state.range(0);
+    Holor<float, 2> x(std::vector<size_t>{n, n});
+    Holor<float, 1> bias(std::vector<size_t>{n});
+    Holor<float, 2> r(std::vector<size_t>{n, n});
+    for (auto _ : state){
+        Holor<float, 2> expanded(std::vector<size_t>{n, n});
+        for (size_t i = 0; i < n; i++){
+            expanded.row(i).substitute(bias);
+        }
+        r = x + expanded;
+        benchmark::DoNotOptimize(r.data());
+    }
+    state.SetBytesProcessed(state.iterations()*2*n*n*sizeof(float));
+}
+BENCHMARK(BM_BiasAddMaterialized)->Arg(64)->Arg(2048);
+
+static void BM_BiasAddBroadcast(benchmark::State& state) {
+    const size_t n = state.range(0);
+    Holor<float, 2> x(std::vector<size_t>{n, n});
+    Holor<float, 1> bias(std::vector<size_t>{n});
+    Holor<float, 2> r(std::vector<size_t>{n, n});
+    for (auto _ : state){
+        r = x + bias;
+        benchmark::DoNotOptimize(r.data());
+    }
+    state.SetBytesProcessed(state.iterations()*2*n*n*sizeof(float));
+}
+BENCHMARK(BM_BiasAddBroadcast)->Arg(64)->Arg(2048);
+
+
+/*=============================================================================
+ ====================             APPEND                =======================
+ ============================================================================*/
+// rows of 64 elements are appended one at a time, by changing the first length or with append
+static void BM_AppendSetLength(benchmark::State& state) {
+    const size_t n = state.range(0);
+    Holor<float, 1> sample(std::vector<size_t>{64});
+    for (auto _ : state){
+        Holor<float, 2> h;
+        for (size_t i = 0; i < n; i++){
+            if (i == 0){
+                h.set_lengths(1, 64);
+            } else{
+                h.set_length(0, i+1);
+            }
+            h.row(i).substitute(sample);
+        }
+        benchmark::DoNotOptimize(h.data());
+    }
+    state.SetItemsProcessed(state.iterations()*n);
+}
+BENCHMARK(BM_AppendSetLength)->Arg(1000)->Arg(100000);
+
+static void BM_Append(benchmark::State& state) {
+    const size_t n = state.range(0);
+    Holor<float, 1> sample(std::vector<size_t>{64});
+    for (auto _ : state){
+        Holor<float, 2> h;
+        for (size_t i = 0; i < n; i++){
+            h.append(sample);
+        }
+        benchmark::DoNotOptimize(h.data());
+    }
+    state.SetItemsProcessed(state.iterations()*n);
+}
+BENCHMARK(BM_Append)->Arg(1000)->Arg(100000);
+
+
 BENCHMARK_MAIN();
\ No newline at end of file
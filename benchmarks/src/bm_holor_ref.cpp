@@ -25,6 +25,7 @@
 #include <holor/holor_full.h>
 
 #include <string>
+#include <numeric>
 
 using namespace holor;
 
@@ -282,4 +283,186 @@ BENCHMARK(BM_DimSlicing);
 
 
 
+/*=============================================================================
+ ====================           SUBSTITUTE              =======================
+ ============================================================================*/
+// The rows of a Holor are contiguous and they are copied as flat sequences, while the columns require a strided traversal.
+static void BM_SubstituteContiguous(benchmark::State& state) {
+    const size_t n = state.range(0);
+    Holor<float, 2> source(std::vector<size_t>{n, n});
+    Holor<float, 2> dest(std::vector<size_t>{n, n});
+    auto source_rows = source.slice<0>(range{0, n/2-1});
+    auto dest_rows = dest.slice<0>(range{n/2, n-1});
+    for (auto _ : state){
+        dest_rows.substitute(source_rows);
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations()*source_rows.size()*sizeof(float));
+}
+BENCHMARK(BM_SubstituteContiguous)->Arg(64)->Arg(1024);
+
+
+static void BM_SubstituteStrided(benchmark::State& state) {
+    const size_t n = state.range(0);
+    Holor<float, 2> source(std::vector<size_t>{n, n});
+    Holor<float, 2> dest(std::vector<size_t>{n, n});
+    auto source_cols = source.slice<1>(range{0, n/2-1});
+    auto dest_cols = dest.slice<1>(range{n/2, n-1});
+    for (auto _ : state){
+        dest_cols.substitute(source_cols);
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations()*source_cols.size()*sizeof(float));
+}
+BENCHMARK(BM_SubstituteStrided)->Arg(64)->Arg(1024);
+
+
+/*=============================================================================
+ ====================      STRIDED AND REVERSED VIEWS    =======================
+ ============================================================================*/
+// Decimation and flips are obtained as views with a range step, and compared with copying the selected elements into a new container before reading them.
+static void BM_DecimateView(benchmark::State& state) {
+    const size_t n = state.range(0);
+    const int step = 4;
+    Holor<float, 1> signal(std::vector<size_t>{n});
+    std::iota(signal.begin(), signal.end(), 0.0f);
+    for (auto _ : state){
+        auto decimated = signal(range{0, n-1, step});
+        benchmark::DoNotOptimize(std::accumulate(decimated.begin(), decimated.end(), 0.0f));
+    }
+}
+BENCHMARK(BM_DecimateView)->Arg(1<<12)->Arg(1<<20);
+
+
+static void BM_DecimateCopy(benchmark::State& state) {
+    const size_t n = state.range(0);
+    const int step = 4;
+    Holor<float, 1> signal(std::vector<size_t>{n});
+    std::iota(signal.begin(), signal.end(), 0.0f);
+    for (auto _ : state){
+        Holor<float, 1> decimated(std::vector<size_t>{(n-1)/step + 1});
+        for (size_t i = 0; i < decimated.length(0); i++){
+            decimated(i) = signal(i*step);
+        }
+        benchmark::DoNotOptimize(std::accumulate(decimated.begin(), decimated.end(), 0.0f));
+    }
+}
+BENCHMARK(BM_DecimateCopy)->Arg(1<<12)->Arg(1<<20);
+
+
+static void BM_FlipView(benchmark::State& state) {
+    const size_t n = state.range(0);
+    Holor<float, 2> h(std::vector<size_t>{n, n});
+    std::iota(h.begin(), h.end(), 0.0f);
+    for (auto _ : state){
+        auto flipped = h(range{n-1, 0, -1}, range{0, n-1});
+        benchmark::DoNotOptimize(std::accumulate(flipped.begin(), flipped.end(), 0.0f));
+    }
+}
+BENCHMARK(BM_FlipView)->Arg(64)->Arg(1024);
+
+
+static void BM_FlipCopy(benchmark::State& state) {
+    const size_t n = state.range(0);
+    Holor<float, 2> h(std::vector<size_t>{n, n});
+    std::iota(h.begin(), h.end(), 0.0f);
+    for (auto _ : state){
+        Holor<float, 2> flipped(std::vector<size_t>{n, n});
+        for (size_t i = 0; i < n; i++){
+            auto row = flipped.row(i);
+            row.substitute(h.row(n-1-i));
+        }
+        benchmark::DoNotOptimize(std::accumulate(flipped.begin(), flipped.end(), 0.0f));
+    }
+}
+BENCHMARK(BM_FlipCopy)->Arg(64)->Arg(1024);
+
+
+/*=============================================================================
+ ====================           ITERATORS               =======================
+ ============================================================================*/
+static void BM_IteratorAdvance(benchmark::State& state) {
+    const size_t n = state.range(0);
+    Holor<int, 2> h(std::vector<size_t>{n, n});
+    auto column = h.col(n/2);
+    for (auto _ : state){
+        auto it = column.begin();
+        std::advance(it, n-1);
+        benchmark::DoNotOptimize(*it);
+    }
+}
+BENCHMARK(BM_IteratorAdvance)->Arg(16)->Arg(256)->Arg(4096);
+
+
+static void BM_IteratorSortColumn(benchmark::State& state) {
+    const size_t n = state.range(0);
+    Holor<int, 2> h(std::vector<size_t>{n, n});
+    for (auto _ : state){
+        state.PauseTiming();
+        for (size_t i = 0; i < n; i++){
+            h(i, n/2) = static_cast<int>((i*7919)%n);
+        }
+        auto column = h.col(n/2);
+        state.ResumeTiming();
+        std::sort(column.begin(), column.end());
+        benchmark::ClobberMemory();
+    }
+}
+BENCHMARK(BM_IteratorSortColumn)->Arg(256)->Arg(4096);
+
+
+// The traversal benchmarks iterate over all the elements of a strided slice of a Holor<int,N> with 8 elements per dimension. 
+// BM_IteratorTraversal uses the HolorRef iterators, whereas BM_ReindexingTraversal reproduces the computation of the memory 
+// location of each element from its coordinates through the Layout, which is how the iterators advanced before stepping incrementally. 
+template<size_t N>
+static void BM_IteratorTraversal(benchmark::State& state) {
+    std::vector<size_t> lengths(N, 8);
+    Holor<int, N> h(lengths);
+    auto slice = h.template slice<N-1>(range{1,6});
+    for (auto _ : state){
+        int sum = 0;
+        for (auto& e : slice){
+            sum += e;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations()*slice.size());
+}
+BENCHMARK_TEMPLATE(BM_IteratorTraversal,2);
+BENCHMARK_TEMPLATE(BM_IteratorTraversal,3);
+BENCHMARK_TEMPLATE(BM_IteratorTraversal,4);
+BENCHMARK_TEMPLATE(BM_IteratorTraversal,5);
+BENCHMARK_TEMPLATE(BM_IteratorTraversal,6);
+
+
+template<size_t N>
+static void BM_ReindexingTraversal(benchmark::State& state) {
+    std::vector<size_t> lengths(N, 8);
+    Holor<int, N> h(lengths);
+    auto slice = h.template slice<N-1>(range{1,6});
+    auto layout = slice.layout();
+    for (auto _ : state){
+        int sum = 0;
+        std::array<size_t, N> coordinates;
+        coordinates.fill(0);
+        for (size_t cnt = 0; cnt < slice.size(); cnt++){
+            sum += *(slice.data() + layout(coordinates));
+            for (int dim = N-1; dim >= 0; dim--){
+                if (++coordinates[dim] < layout.length(dim)){
+                    break;
+                }
+                coordinates[dim] = 0;
+            }
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations()*slice.size());
+}
+BENCHMARK_TEMPLATE(BM_ReindexingTraversal,2);
+BENCHMARK_TEMPLATE(BM_ReindexingTraversal,3);
+BENCHMARK_TEMPLATE(BM_ReindexingTraversal,4);
+BENCHMARK_TEMPLATE(BM_ReindexingTraversal,5);
+BENCHMARK_TEMPLATE(BM_ReindexingTraversal,6);
+
+
 BENCHMARK_MAIN();
\ No newline at end of file
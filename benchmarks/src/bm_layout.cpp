@@ -148,6 +148,89 @@ static void BM_LayoutIndexing5D(benchmark::State& state) {
 BENCHMARK(BM_LayoutIndexing5D)->Args({0,0,0,0,0})->Args({7,7,7,7,7});
 
 
+/*=============================================================================
+ ====================   CHECKED VS UNCHECKED INDEXING   ======================
+ ============================================================================*/
+// The checked benchmarks index the Layout with the dynamic assertions of the level chosen at configure time (release by default), 
+// whereas the unchecked ones compute the same memory indices directly from the offset and strides, without any check. 
+static void BM_LayoutCheckedIndexing2D(benchmark::State& state) {
+    const size_t n = state.range(0);
+    Layout<2> h(n, n);
+    for (auto _ : state){
+        size_t sum = 0;
+        for (size_t i = 0; i < n; i++){
+            for (size_t j = 0; j < n; j++){
+                sum += h(i, j);
+            }
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations()*h.size());
+}
+BENCHMARK(BM_LayoutCheckedIndexing2D)->Arg(8)->Arg(64);
+
+static void BM_LayoutUncheckedIndexing2D(benchmark::State& state) {
+    const size_t n = state.range(0);
+    Layout<2> h(n, n);
+    auto offset = h.offset();
+    auto strides = h.strides();
+    for (auto _ : state){
+        size_t sum = 0;
+        for (size_t i = 0; i < n; i++){
+            for (size_t j = 0; j < n; j++){
+                sum += offset + i*strides[0] + j*strides[1];
+            }
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations()*h.size());
+}
+BENCHMARK(BM_LayoutUncheckedIndexing2D)->Arg(8)->Arg(64);
+
+
+static void BM_LayoutCheckedIndexing4D(benchmark::State& state) {
+    const size_t n = state.range(0);
+    Layout<4> h(n, n, n, n);
+    for (auto _ : state){
+        size_t sum = 0;
+        for (size_t i = 0; i < n; i++){
+            for (size_t j = 0; j < n; j++){
+                for (size_t k = 0; k < n; k++){
+                    for (size_t w = 0; w < n; w++){
+                        sum += h(i, j, k, w);
+                    }
+                }
+            }
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations()*h.size());
+}
+BENCHMARK(BM_LayoutCheckedIndexing4D)->Arg(8)->Arg(16);
+
+static void BM_LayoutUncheckedIndexing4D(benchmark::State& state) {
+    const size_t n = state.range(0);
+    Layout<4> h(n, n, n, n);
+    auto offset = h.offset();
+    auto strides = h.strides();
+    for (auto _ : state){
+        size_t sum = 0;
+        for (size_t i = 0; i < n; i++){
+            for (size_t j = 0; j < n; j++){
+                for (size_t k = 0; k < n; k++){
+                    for (size_t w = 0; w < n; w++){
+                        sum += offset + i*strides[0] + j*strides[1] + k*strides[2] + w*strides[3];
+                    }
+                }
+            }
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations()*h.size());
+}
+BENCHMARK(BM_LayoutUncheckedIndexing4D)->Arg(8)->Arg(16);
+
+
 /*=============================================================================
  ====================           SLICING                =======================
  ============================================================================*/
@@ -229,6 +312,54 @@ static void BM_LayoutSlicingUnreduced4D_3(benchmark::State& state) {
 BENCHMARK(BM_LayoutSlicingUnreduced4D_3);
 
 
+// slicing of a N-dimensional layout, with ranges on even dimensions and single indices on odd dimensions
+template<size_t N, size_t... Dims>
+auto layout_mixed_slice(const Layout<N>& h, std::index_sequence<Dims...>){
+    return h( [](){ if constexpr(Dims%2 == 0){ return range(1,5); } else{ return size_t{3}; } }()... );
+}
+
+template<size_t N>
+static void BM_LayoutSlicingMixed(benchmark::State& state) {
+    std::array<size_t, N> lengths;
+    lengths.fill(8);
+    Layout<N> h(lengths);
+    for (auto _ : state){
+        benchmark::DoNotOptimize(layout_mixed_slice(h, std::make_index_sequence<N>{}));
+    }
+}
+BENCHMARK_TEMPLATE(BM_LayoutSlicingMixed,2);
+BENCHMARK_TEMPLATE(BM_LayoutSlicingMixed,3);
+BENCHMARK_TEMPLATE(BM_LayoutSlicingMixed,4);
+BENCHMARK_TEMPLATE(BM_LayoutSlicingMixed,5);
+BENCHMARK_TEMPLATE(BM_LayoutSlicingMixed,6);
+BENCHMARK_TEMPLATE(BM_LayoutSlicingMixed,7);
+BENCHMARK_TEMPLATE(BM_LayoutSlicingMixed,8);
+
+
+// slicing of a N-dimensional layout with a range on every dimension
+template<size_t N, size_t... Dims>
+auto layout_range_slice(const Layout<N>& h, std::index_sequence<Dims...>){
+    return h( range(1, 2+Dims%5)... );
+}
+
+template<size_t N>
+static void BM_LayoutSlicingRanges(benchmark::State& state) {
+    std::array<size_t, N> lengths;
+    lengths.fill(8);
+    Layout<N> h(lengths);
+    for (auto _ : state){
+        benchmark::DoNotOptimize(layout_range_slice(h, std::make_index_sequence<N>{}));
+    }
+}
+BENCHMARK_TEMPLATE(BM_LayoutSlicingRanges,2);
+BENCHMARK_TEMPLATE(BM_LayoutSlicingRanges,3);
+BENCHMARK_TEMPLATE(BM_LayoutSlicingRanges,4);
+BENCHMARK_TEMPLATE(BM_LayoutSlicingRanges,5);
+BENCHMARK_TEMPLATE(BM_LayoutSlicingRanges,6);
+BENCHMARK_TEMPLATE(BM_LayoutSlicingRanges,7);
+BENCHMARK_TEMPLATE(BM_LayoutSlicingRanges,8);
+
+
 static void BM_DimIndexSlicing(benchmark::State& state) {
     Layout<3> h(std::vector<size_t>{8,8,8});
     for (auto _ : state){
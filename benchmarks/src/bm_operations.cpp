@@ -0,0 +1,489 @@
+// This file is part of Holor, a C++ header-only template library for multi-dimensional containers
+
+// Copyright 2020-2022 Carlo Masone
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to 
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is 
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER 
+// DEALINGS IN THE SOFTWARE.
+
+#include <benchmark/benchmark.h>
+#include <holor/holor_full.h>
+#include <algorithm>
+#include <numeric>
+#include <functional>
+#include <cmath>
+
+
+
+using namespace holor;
+
+// Each benchmark is run on a container that fits in the L1/L2 caches (64x64) and on one that does not (2048x2048), and it reports the bandwidth in bytes/s.
+// The scalar versions apply the same operation through a generic callable, which is not vectorized by the kernels in holor_simd.h.
+
+template<typename T>
+static Holor<T, 2> make_holor(size_t n){
+    Holor<T, 2> h(std::vector<size_t>{n, n});
+    std::iota(h.begin(), h.end(), T(1));
+    return h;
+}
+
+/*=============================================================================
+ ====================          BROADCAST ALL           =======================
+ ============================================================================*/
+template<typename T>
+static void BM_BroadcastAllScalar(benchmark::State& state) {
+    const size_t n = state.range(0);
+    auto h = make_holor<T>(n);
+    for (auto _ : state){
+        broadcast_all(h, T(1), [](T x, T y){ return x + y; });
+        benchmark::DoNotOptimize(h.data());
+    }
+    state.SetBytesProcessed(state.iterations()*2*n*n*sizeof(T));
+}
+BENCHMARK_TEMPLATE(BM_BroadcastAllScalar, float)->Arg(64)->Arg(2048);
+BENCHMARK_TEMPLATE(BM_BroadcastAllScalar, double)->Arg(64)->Arg(2048);
+BENCHMARK_TEMPLATE(BM_BroadcastAllScalar, int)->Arg(64)->Arg(2048);
+
+template<typename T>
+static void BM_BroadcastAllSimd(benchmark::State& state) {
+    const size_t n = state.range(0);
+    auto h = make_holor<T>(n);
+    for (auto _ : state){
+        broadcast_all(h, T(1), std::plus<T>());
+        benchmark::DoNotOptimize(h.data());
+    }
+    state.SetBytesProcessed(state.iterations()*2*n*n*sizeof(T));
+}
+BENCHMARK_TEMPLATE(BM_BroadcastAllSimd, float)->Arg(64)->Arg(2048);
+BENCHMARK_TEMPLATE(BM_BroadcastAllSimd, double)->Arg(64)->Arg(2048);
+BENCHMARK_TEMPLATE(BM_BroadcastAllSimd, int)->Arg(64)->Arg(2048);
+
+
+/*=============================================================================
+ ====================            REDUCE ALL            =======================
+ ============================================================================*/
+template<typename T>
+static void BM_ReduceSumScalar(benchmark::State& state) {
+    const size_t n = state.range(0);
+    auto h = make_holor<T>(n);
+    for (auto _ : state){
+        auto sum = reduce_all(h, T(0), [](T x, T y){ return x + y; });
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetBytesProcessed(state.iterations()*n*n*sizeof(T));
+}
+BENCHMARK_TEMPLATE(BM_ReduceSumScalar, float)->Arg(64)->Arg(2048);
+BENCHMARK_TEMPLATE(BM_ReduceSumScalar, double)->Arg(64)->Arg(2048);
+BENCHMARK_TEMPLATE(BM_ReduceSumScalar, int)->Arg(64)->Arg(2048);
+
+template<typename T>
+static void BM_ReduceSumSimd(benchmark::State& state) {
+    const size_t n = state.range(0);
+    auto h = make_holor<T>(n);
+    for (auto _ : state){
+        auto sum = reduce_all(h, T(0), std::plus<T>());
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetBytesProcessed(state.iterations()*n*n*sizeof(T));
+}
+BENCHMARK_TEMPLATE(BM_ReduceSumSimd, float)->Arg(64)->Arg(2048);
+BENCHMARK_TEMPLATE(BM_ReduceSumSimd, double)->Arg(64)->Arg(2048);
+BENCHMARK_TEMPLATE(BM_ReduceSumSimd, int)->Arg(64)->Arg(2048);
+
+template<typename T>
+static void BM_ReduceMaxScalar(benchmark::State& state) {
+    const size_t n = state.range(0);
+    auto h = make_holor<T>(n);
+    for (auto _ : state){
+        auto max = reduce_all(h, T(0), [](T x, T y){ return std::max(x, y); });
+        benchmark::DoNotOptimize(max);
+    }
+    state.SetBytesProcessed(state.iterations()*n*n*sizeof(T));
+}
+BENCHMARK_TEMPLATE(BM_ReduceMaxScalar, float)->Arg(64)->Arg(2048);
+
+template<typename T>
+static void BM_ReduceMaxSimd(benchmark::State& state) {
+    const size_t n = state.range(0);
+    auto h = make_holor<T>(n);
+    for (auto _ : state){
+        auto max = reduce_all(h, T(0), simd::Max{});
+        benchmark::DoNotOptimize(max);
+    }
+    state.SetBytesProcessed(state.iterations()*n*n*sizeof(T));
+}
+BENCHMARK_TEMPLATE(BM_ReduceMaxSimd, float)->Arg(64)->Arg(2048);
+
+
+/*=============================================================================
+ ====================         AXIS REDUCTIONS          =======================
+ ============================================================================*/
+// The generic reduce<D> is compared with sum along the outer dimension (accumulation of the rows) and along the inner dimension (reduction of contiguous runs).
+template<typename T, size_t D>
+static void BM_ReduceAxisGeneric(benchmark::State& state) {
+    const size_t n = state.range(0);
+    auto h = make_holor<T>(n);
+    Holor<T, 1> init(std::vector<size_t>{n});
+    std::ranges::fill(init, T(0));
+    for (auto _ : state){
+        auto result = reduce<D>(h, init, std::plus<T>());
+        benchmark::DoNotOptimize(result.data());
+    }
+    state.SetBytesProcessed(state.iterations()*n*n*sizeof(T));
+}
+BENCHMARK_TEMPLATE(BM_ReduceAxisGeneric, float, 0)->Arg(64)->Arg(2048);
+BENCHMARK_TEMPLATE(BM_ReduceAxisGeneric, float, 1)->Arg(64)->Arg(2048);
+BENCHMARK_TEMPLATE(BM_ReduceAxisGeneric, double, 0)->Arg(64)->Arg(2048);
+BENCHMARK_TEMPLATE(BM_ReduceAxisGeneric, double, 1)->Arg(64)->Arg(2048);
+
+template<typename T, size_t D>
+static void BM_SumAxis(benchmark::State& state) {
+    const size_t n = state.range(0);
+    auto h = make_holor<T>(n);
+    for (auto _ : state){
+        auto result = sum<1>(h, {D});
+        benchmark::DoNotOptimize(result.data());
+    }
+    state.SetBytesProcessed(state.iterations()*n*n*sizeof(T));
+}
+BENCHMARK_TEMPLATE(BM_SumAxis, float, 0)->Arg(64)->Arg(2048);
+BENCHMARK_TEMPLATE(BM_SumAxis, float, 1)->Arg(64)->Arg(2048);
+BENCHMARK_TEMPLATE(BM_SumAxis, double, 0)->Arg(64)->Arg(2048);
+BENCHMARK_TEMPLATE(BM_SumAxis, double, 1)->Arg(64)->Arg(2048);
+
+template<typename T>
+static void BM_SumAll(benchmark::State& state) {
+    const size_t n = state.range(0);
+    auto h = make_holor<T>(n);
+    for (auto _ : state){
+        auto result = sum(h);
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetBytesProcessed(state.iterations()*n*n*sizeof(T));
+}
+BENCHMARK_TEMPLATE(BM_SumAll, float)->Arg(64)->Arg(2048);
+BENCHMARK_TEMPLATE(BM_SumAll, double)->Arg(64)->Arg(2048);
+
+template<typename T, size_t D>
+static void BM_VarAxis(benchmark::State& state) {
+    const size_t n = state.range(0);
+    auto h = make_holor<T>(n);
+    for (auto _ : state){
+        auto result = var<1>(h, {D});
+        benchmark::DoNotOptimize(result.data());
+    }
+    state.SetBytesProcessed(state.iterations()*2*n*n*sizeof(T));
+}
+BENCHMARK_TEMPLATE(BM_VarAxis, float, 0)->Arg(2048);
+BENCHMARK_TEMPLATE(BM_VarAxis, float, 1)->Arg(2048);
+
+
+/*=============================================================================
+ ====================               AXPY               =======================
+ ============================================================================*/
+template<typename T>
+static void BM_AxpyScalar(benchmark::State& state) {
+    const size_t n = state.range(0);
+    auto x = make_holor<T>(n);
+    auto y = make_holor<T>(n);
+    for (auto _ : state){
+        std::transform(x.cbegin(), x.cend(), y.cbegin(), y.begin(), [](T a, T b){ return T(2)*a + b; });
+        benchmark::DoNotOptimize(y.data());
+    }
+    state.SetBytesProcessed(state.iterations()*3*n*n*sizeof(T));
+}
+BENCHMARK_TEMPLATE(BM_AxpyScalar, float)->Arg(64)->Arg(2048);
+BENCHMARK_TEMPLATE(BM_AxpyScalar, double)->Arg(64)->Arg(2048);
+
+template<typename T>
+static void BM_AxpySimd(benchmark::State& state) {
+    const size_t n = state.range(0);
+    auto x = make_holor<T>(n);
+    auto y = make_holor<T>(n);
+    for (auto _ : state){
+        axpy(T(2), x, y);
+        benchmark::DoNotOptimize(y.data());
+    }
+    state.SetBytesProcessed(state.iterations()*3*n*n*sizeof(T));
+}
+BENCHMARK_TEMPLATE(BM_AxpySimd, float)->Arg(64)->Arg(2048);
+BENCHMARK_TEMPLATE(BM_AxpySimd, double)->Arg(64)->Arg(2048);
+
+
+/*=============================================================================
+ ====================             EQUALITY             =======================
+ ============================================================================*/
+template<typename T>
+static void BM_EqualityScalar(benchmark::State& state) {
+    const size_t n = state.range(0);
+    auto h1 = make_holor<T>(n);
+    auto h2 = make_holor<T>(n);
+    for (auto _ : state){
+        bool equal = std::equal(h1.cbegin(), h1.cend(), h2.cbegin(), h2.cend(), [](T a, T b){ return a == b; });
+        benchmark::DoNotOptimize(equal);
+    }
+    state.SetBytesProcessed(state.iterations()*2*n*n*sizeof(T));
+}
+BENCHMARK_TEMPLATE(BM_EqualityScalar, float)->Arg(64)->Arg(2048);
+
+template<typename T>
+static void BM_EqualitySimd(benchmark::State& state) {
+    const size_t n = state.range(0);
+    auto h1 = make_holor<T>(n);
+    auto h2 = make_holor<T>(n);
+    for (auto _ : state){
+        bool equal = (h1 == h2);
+        benchmark::DoNotOptimize(equal);
+    }
+    state.SetBytesProcessed(state.iterations()*2*n*n*sizeof(T));
+}
+BENCHMARK_TEMPLATE(BM_EqualitySimd, float)->Arg(64)->Arg(2048);
+
+
+/*=============================================================================
+ ====================            TRANSPOSE             =======================
+ ============================================================================*/
+// The blocked transpose is compared with the copy of a transposed view in row-major order, which reads the source with large strides.
+// The largest sizes exceed the last level cache of most machines (256 MiB of float elements per container).
+template<size_t N>
+static auto make_cube(size_t n){
+    std::array<size_t, N> lengths;
+    lengths.fill(n);
+    Holor<float, N> h(lengths);
+    std::iota(h.begin(), h.end(), 1.0f);
+    return h;
+}
+
+template<size_t N>
+static void BM_TransposeNaive(benchmark::State& state) {
+    const size_t n = state.range(0);
+    auto h = make_cube<N>(n);
+    auto view = transpose_view(h);
+    Holor<float, N> result(holor::uninitialized, view.lengths());
+    for (auto _ : state){
+        std::copy(view.cbegin(), view.cend(), result.data());
+        benchmark::DoNotOptimize(result.data());
+    }
+    state.SetBytesProcessed(state.iterations()*2*h.size()*sizeof(float));
+}
+BENCHMARK_TEMPLATE(BM_TransposeNaive, 2)->Arg(1024)->Arg(8192)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_TransposeNaive, 3)->Arg(128)->Arg(406)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_TransposeNaive, 4)->Arg(32)->Arg(90)->Unit(benchmark::kMillisecond);
+
+template<size_t N>
+static void BM_TransposeBlocked(benchmark::State& state) {
+    const size_t n = state.range(0);
+    auto h = make_cube<N>(n);
+    for (auto _ : state){
+        auto result = transpose(h);
+        benchmark::DoNotOptimize(result.data());
+    }
+    state.SetBytesProcessed(state.iterations()*2*h.size()*sizeof(float));
+}
+BENCHMARK_TEMPLATE(BM_TransposeBlocked, 2)->Arg(1024)->Arg(8192)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_TransposeBlocked, 3)->Arg(128)->Arg(406)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_TransposeBlocked, 4)->Arg(32)->Arg(90)->Unit(benchmark::kMillisecond);
+
+// permutation of a 4D container that keeps the innermost dimension, so the elements are copied by contiguous runs
+static void BM_TransposeKeepInner(benchmark::State& state) {
+    const size_t n = state.range(0);
+    auto h = make_cube<4>(n);
+    for (auto _ : state){
+        auto result = transpose(h, std::array<size_t, 4>{2, 0, 1, 3});
+        benchmark::DoNotOptimize(result.data());
+    }
+    state.SetBytesProcessed(state.iterations()*2*h.size()*sizeof(float));
+}
+BENCHMARK(BM_TransposeKeepInner)->Arg(32)->Arg(90)->Unit(benchmark::kMillisecond);
+
+
+
+// In-place transposition of square matrices (blocked swaps) and rectangular matrices (cycle following), compared with the out-of-place transpose.
+static void BM_TransposeInplaceSquare(benchmark::State& state) {
+    const size_t n = state.range(0);
+    auto h = make_cube<2>(n);
+    for (auto _ : state){
+        transpose_inplace(h);
+        benchmark::DoNotOptimize(h.data());
+    }
+    state.SetBytesProcessed(state.iterations()*2*h.size()*sizeof(float));
+}
+BENCHMARK(BM_TransposeInplaceSquare)->Arg(1024)->Arg(8192)->Unit(benchmark::kMillisecond);
+
+static void BM_TransposeInplaceRectangular(benchmark::State& state) {
+    const size_t n = state.range(0);
+    Holor<float, 2> h(std::vector<size_t>{n, 2*n});
+    std::iota(h.begin(), h.end(), 1.0f);
+    for (auto _ : state){
+        transpose_inplace(h);
+        benchmark::DoNotOptimize(h.data());
+    }
+    state.SetBytesProcessed(state.iterations()*2*h.size()*sizeof(float));
+}
+BENCHMARK(BM_TransposeInplaceRectangular)->Arg(512)->Arg(4096)->Unit(benchmark::kMillisecond);
+
+static void BM_TransposeOutOfPlaceRectangular(benchmark::State& state) {
+    const size_t n = state.range(0);
+    Holor<float, 2> h(std::vector<size_t>{n, 2*n});
+    std::iota(h.begin(), h.end(), 1.0f);
+    for (auto _ : state){
+        auto result = transpose(h);
+        benchmark::DoNotOptimize(result.data());
+    }
+    state.SetBytesProcessed(state.iterations()*2*h.size()*sizeof(float));
+}
+BENCHMARK(BM_TransposeOutOfPlaceRectangular)->Arg(512)->Arg(4096)->Unit(benchmark::kMillisecond);
+
+
+
+/*=============================================================================
+ ====================         THREAD SCALING           =======================
+ ============================================================================*/
+// The parallel overloads are run on a 2048x2048 container with 1, 2, 4, ... threads, up to the number of hardware threads.
+// The argument of each benchmark is the number of threads, and the speedup is the ratio of the time with 1 thread to the time with N threads.
+static void ThreadCounts(benchmark::internal::Benchmark* b){
+    const size_t threads = executor::global().concurrency();
+    for (size_t t = 1; t < threads; t *= 2){
+        b->Arg(t);
+    }
+    b->Arg(threads);
+    b->UseRealTime();
+}
+
+static void BM_ParallelApply(benchmark::State& state) {
+    const size_t n = 2048;
+    auto h = make_holor<float>(n);
+    const auto policy = execution::par.with_threads(state.range(0));
+    for (auto _ : state){
+        apply(policy, h, [](float x){ return std::sqrt(x)*0.5f + 1.0f; });
+        benchmark::DoNotOptimize(h.data());
+    }
+    state.SetBytesProcessed(state.iterations()*2*n*n*sizeof(float));
+}
+BENCHMARK(BM_ParallelApply)->Apply(ThreadCounts);
+
+static void BM_ParallelReduceAll(benchmark::State& state) {
+    const size_t n = 2048;
+    auto h = make_holor<float>(n);
+    const auto policy = execution::par_unseq.with_threads(state.range(0));
+    for (auto _ : state){
+        auto sum = reduce_all(policy, h, 0.0f, std::plus<float>());
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetBytesProcessed(state.iterations()*n*n*sizeof(float));
+}
+BENCHMARK(BM_ParallelReduceAll)->Apply(ThreadCounts);
+
+static void BM_ParallelReduceRows(benchmark::State& state) {
+    const size_t n = 2048;
+    auto h = make_holor<float>(n);
+    Holor<float, 1> init(std::vector<size_t>{n});
+    std::ranges::fill(init, 0.0f);
+    const auto policy = execution::par.with_threads(state.range(0));
+    for (auto _ : state){
+        auto result = reduce<1>(policy, h, init, std::plus<float>());
+        benchmark::DoNotOptimize(result.data());
+    }
+    state.SetBytesProcessed(state.iterations()*n*n*sizeof(float));
+}
+BENCHMARK(BM_ParallelReduceRows)->Apply(ThreadCounts);
+
+static void BM_ParallelSumAxis(benchmark::State& state) {
+    const size_t n = 2048;
+    auto h = make_holor<float>(n);
+    const auto policy = execution::par.with_threads(state.range(0));
+    for (auto _ : state){
+        auto result = sum<1>(policy, h, {0});
+        benchmark::DoNotOptimize(result.data());
+    }
+    state.SetBytesProcessed(state.iterations()*n*n*sizeof(float));
+}
+BENCHMARK(BM_ParallelSumAxis)->Apply(ThreadCounts);
+
+static void BM_ParallelBroadcast(benchmark::State& state) {
+    const size_t n = 2048;
+    auto h = make_holor<float>(n);
+    Holor<float, 1> row(std::vector<size_t>{n});
+    std::ranges::fill(row, 1.0f);
+    const auto policy = execution::par.with_threads(state.range(0));
+    for (auto _ : state){
+        broadcast<0>(policy, h, row, std::plus<float>());
+        benchmark::DoNotOptimize(h.data());
+    }
+    state.SetBytesProcessed(state.iterations()*2*n*n*sizeof(float));
+}
+BENCHMARK(BM_ParallelBroadcast)->Apply(ThreadCounts);
+
+static void BM_ParallelTranspose(benchmark::State& state) {
+    const size_t n = 2048;
+    auto h = make_holor<float>(n);
+    const auto policy = execution::par.with_threads(state.range(0));
+    for (auto _ : state){
+        auto result = transpose(policy, h);
+        benchmark::DoNotOptimize(result.data());
+    }
+    state.SetBytesProcessed(state.iterations()*2*n*n*sizeof(float));
+}
+BENCHMARK(BM_ParallelTranspose)->Apply(ThreadCounts);
+
+static void BM_ParallelShift(benchmark::State& state) {
+    const size_t n = 2048;
+    auto h = make_holor<float>(n);
+    const auto policy = execution::par.with_threads(state.range(0));
+    for (auto _ : state){
+        auto result = shift<1>(policy, h, 5);
+        benchmark::DoNotOptimize(result.data());
+    }
+    state.SetBytesProcessed(state.iterations()*2*n*n*sizeof(float));
+}
+BENCHMARK(BM_ParallelShift)->Apply(ThreadCounts);
+
+static void BM_ParallelConcatenate(benchmark::State& state) {
+    const size_t n = 2048;
+    auto h = make_holor<float>(n);
+    const auto policy = execution::par.with_threads(state.range(0));
+    for (auto _ : state){
+        auto result = concatenate<1>(policy, h, h);
+        benchmark::DoNotOptimize(result.data());
+    }
+    state.SetBytesProcessed(state.iterations()*4*n*n*sizeof(float));
+}
+BENCHMARK(BM_ParallelConcatenate)->Apply(ThreadCounts);
+
+// Unbalanced workload: the cost of processing a row grows with its index. The rows are processed with parallel_for_slices on an executor with N threads,
+// which balances the work by stealing.
+static void BM_ParallelForSlicesUnbalanced(benchmark::State& state) {
+    const size_t n = 1024;
+    auto h = make_holor<float>(n);
+    executor exec(state.range(0));
+    for (auto _ : state){
+        parallel_for_slices<0>(exec, h, [](HolorRef<float, 2> rows, size_t first){
+            for (size_t i = 0; i < rows.length(0); i++){
+                auto row = rows.row(i);
+                for (size_t repetition = 0; repetition < (first + i)/64 + 1; repetition++){
+                    apply(row, [](float x){ return std::sqrt(x + 1.0f); });
+                }
+            }
+        });
+        benchmark::DoNotOptimize(h.data());
+    }
+}
+BENCHMARK(BM_ParallelForSlicesUnbalanced)->Apply(ThreadCounts);
+
+
+
+BENCHMARK_MAIN();
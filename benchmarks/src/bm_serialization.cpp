@@ -0,0 +1,332 @@
+// This file is part of Holor, a C++ header-only template library for multi-dimensional containers
+
+// Copyright 2020-2022 Carlo Masone
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to 
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is 
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER 
+// DEALINGS IN THE SOFTWARE.
+#include <benchmark/benchmark.h>
+#include <holor/holor_full.h>
+#include <io/holor_serialization.h>
+#include <io/holor_npy.h>
+#include <io/mapped_holor.h>
+#include <io/chunked_holor.h>
+#include <io/holor_stream.h>
+#include <filesystem>
+#include <fstream>
+
+
+
+using namespace holor;
+
+// The binary save and load are compared with the text output of operator<<, and the load of a file is compared with its memory mapping, and the partial reads of a chunked file are compared with the load of the whole file. The files are written in the temporary directory, so the results depend on the file system (often a page cache in memory).
+
+static std::filesystem::path bm_path(){
+    return std::filesystem::temp_directory_path() / "holor_bm_serialization";
+}
+
+static Holor<float, 2> make_holor(size_t n){
+    Holor<float, 2> h(std::vector<size_t>{n, n});
+    float value = 0;
+    for (auto& x : h){
+        x = value;
+        value = (value > 10.0f) ? 0.0f : value + 0.25f;
+    }
+    return h;
+}
+
+/*=============================================================================
+ ====================              SAVE               =======================
+ ============================================================================*/
+static void BM_SaveText(benchmark::State& state) {
+    const size_t n = state.range(0);
+    auto h = make_holor(n);
+    for (auto _ : state){
+        std::ofstream os(bm_path());
+        os << h;
+    }
+    state.SetBytesProcessed(state.iterations()*n*n*sizeof(float));
+    std::filesystem::remove(bm_path());
+}
+BENCHMARK(BM_SaveText)->Arg(64)->Arg(1024)->Unit(benchmark::kMillisecond);
+
+static void BM_SaveBinary(benchmark::State& state) {
+    const size_t n = state.range(0);
+    auto h = make_holor(n);
+    for (auto _ : state){
+        save(bm_path(), h);
+    }
+    state.SetBytesProcessed(state.iterations()*n*n*sizeof(float));
+    std::filesystem::remove(bm_path());
+}
+BENCHMARK(BM_SaveBinary)->Arg(64)->Arg(1024)->Arg(4096)->Unit(benchmark::kMillisecond);
+
+static void BM_SaveBinarySlice(benchmark::State& state) {
+    const size_t n = state.range(0);
+    auto h = make_holor(n);
+    auto slice = h(range{0, n-1, 2}, range{0, n-2});
+    for (auto _ : state){
+        save(bm_path(), slice);
+    }
+    state.SetBytesProcessed(state.iterations()*slice.size()*sizeof(float));
+    std::filesystem::remove(bm_path());
+}
+BENCHMARK(BM_SaveBinarySlice)->Arg(1024)->Arg(4096)->Unit(benchmark::kMillisecond);
+
+static void BM_SaveBinaryTransposed(benchmark::State& state) {
+    const size_t n = state.range(0);
+    auto h = make_holor(n);
+    auto transposed = transpose_view(h);
+    for (auto _ : state){
+        save(bm_path(), transposed);
+    }
+    state.SetBytesProcessed(state.iterations()*n*n*sizeof(float));
+    std::filesystem::remove(bm_path());
+}
+BENCHMARK(BM_SaveBinaryTransposed)->Arg(1024)->Arg(4096)->Unit(benchmark::kMillisecond);
+
+
+/*=============================================================================
+ ====================              LOAD               =======================
+ ============================================================================*/
+static void BM_LoadBinary(benchmark::State& state) {
+    const size_t n = state.range(0);
+    save(bm_path(), make_holor(n));
+    for (auto _ : state){
+        auto h = load<float, 2>(bm_path());
+        benchmark::DoNotOptimize(h.data());
+    }
+    state.SetBytesProcessed(state.iterations()*n*n*sizeof(float));
+    std::filesystem::remove(bm_path());
+}
+BENCHMARK(BM_LoadBinary)->Arg(64)->Arg(1024)->Arg(4096)->Unit(benchmark::kMillisecond);
+
+
+/*=============================================================================
+ ====================              NPY                =======================
+ ============================================================================*/
+static void BM_LoadNpy(benchmark::State& state) {
+    const size_t n = state.range(0);
+    save_npy(bm_path(), make_holor(n));
+    for (auto _ : state){
+        auto h = load_npy<float, 2>(bm_path());
+        benchmark::DoNotOptimize(h.data());
+    }
+    state.SetBytesProcessed(state.iterations()*n*n*sizeof(float));
+    std::filesystem::remove(bm_path());
+}
+BENCHMARK(BM_LoadNpy)->Arg(1024)->Arg(4096)->Unit(benchmark::kMillisecond);
+
+static void BM_LoadNpyFortran(benchmark::State& state) {
+    const size_t n = state.range(0);
+    auto h = make_holor(n);
+    save_npy(bm_path(), transpose_view(h));
+    for (auto _ : state){
+        auto loaded = load_npy<float, 2>(bm_path());
+        benchmark::DoNotOptimize(loaded.data());
+    }
+    state.SetBytesProcessed(state.iterations()*n*n*sizeof(float));
+    std::filesystem::remove(bm_path());
+}
+BENCHMARK(BM_LoadNpyFortran)->Arg(1024)->Arg(4096)->Unit(benchmark::kMillisecond);
+
+// mapping the file takes constant time, because the pages are read only when they are accessed
+static void BM_MapNpy(benchmark::State& state) {
+    const size_t n = state.range(0);
+    save_npy(bm_path(), make_holor(n));
+    for (auto _ : state){
+        auto mapped = map_npy<float, 2>(bm_path());
+        benchmark::DoNotOptimize(mapped.view().data());
+    }
+    std::filesystem::remove(bm_path());
+}
+BENCHMARK(BM_MapNpy)->Arg(1024)->Arg(4096)->Unit(benchmark::kMicrosecond);
+
+static void BM_MapNpyRow(benchmark::State& state) {
+    const size_t n = state.range(0);
+    save_npy(bm_path(), make_holor(n));
+    for (auto _ : state){
+        auto mapped = map_npy<float, 2>(bm_path());
+        benchmark::DoNotOptimize(sum(mapped.view().row(n/2)));
+    }
+    std::filesystem::remove(bm_path());
+}
+BENCHMARK(BM_MapNpyRow)->Arg(1024)->Arg(4096)->Unit(benchmark::kMicrosecond);
+
+static void BM_MapNpySum(benchmark::State& state) {
+    const size_t n = state.range(0);
+    save_npy(bm_path(), make_holor(n));
+    for (auto _ : state){
+        auto mapped = map_npy<float, 2>(bm_path());
+        benchmark::DoNotOptimize(sum(mapped.view()));
+    }
+    state.SetBytesProcessed(state.iterations()*n*n*sizeof(float));
+    std::filesystem::remove(bm_path());
+}
+BENCHMARK(BM_MapNpySum)->Arg(1024)->Arg(4096)->Unit(benchmark::kMillisecond);
+
+
+/*=============================================================================
+ ====================          MAPPED HOLOR           =======================
+ ============================================================================*/
+static void BM_MappedOpen(benchmark::State& state) {
+    const size_t n = state.range(0);
+    save(bm_path(), make_holor(n));
+    for (auto _ : state){
+        MappedHolor<const float, 2> mapped(bm_path());
+        benchmark::DoNotOptimize(mapped.data());
+    }
+    std::filesystem::remove(bm_path());
+}
+BENCHMARK(BM_MappedOpen)->Arg(1024)->Arg(4096)->Unit(benchmark::kMicrosecond);
+
+// 64 rows in a pseudo-random order, with the advice to not read ahead
+static void BM_MappedRandomRows(benchmark::State& state) {
+    const size_t n = state.range(0);
+    save(bm_path(), make_holor(n));
+    for (auto _ : state){
+        MappedHolor<const float, 2> mapped(bm_path(), MapMode::read_only, MapAdvice::random);
+        float total = 0;
+        for (size_t i = 0; i < 64; i++){
+            total += sum(mapped.view().row((i*7919) % n));
+        }
+        benchmark::DoNotOptimize(total);
+    }
+    std::filesystem::remove(bm_path());
+}
+BENCHMARK(BM_MappedRandomRows)->Arg(1024)->Arg(4096)->Unit(benchmark::kMicrosecond);
+
+static void BM_MappedSum(benchmark::State& state) {
+    const size_t n = state.range(0);
+    save(bm_path(), make_holor(n));
+    for (auto _ : state){
+        MappedHolor<const float, 2> mapped(bm_path(), MapMode::read_only, MapAdvice::sequential);
+        benchmark::DoNotOptimize(sum(mapped));
+    }
+    state.SetBytesProcessed(state.iterations()*n*n*sizeof(float));
+    std::filesystem::remove(bm_path());
+}
+BENCHMARK(BM_MappedSum)->Arg(1024)->Arg(4096)->Unit(benchmark::kMillisecond);
+
+static void BM_LoadSum(benchmark::State& state) {
+    const size_t n = state.range(0);
+    save(bm_path(), make_holor(n));
+    for (auto _ : state){
+        auto h = load<float, 2>(bm_path());
+        benchmark::DoNotOptimize(sum(h));
+    }
+    state.SetBytesProcessed(state.iterations()*n*n*sizeof(float));
+    std::filesystem::remove(bm_path());
+}
+BENCHMARK(BM_LoadSum)->Arg(1024)->Arg(4096)->Unit(benchmark::kMillisecond);
+
+
+/*=============================================================================
+ ====================            CHUNKED              =======================
+ ============================================================================*/
+static void BM_SaveChunked(benchmark::State& state) {
+    const size_t n = state.range(0);
+    auto h = make_holor(n);
+    for (auto _ : state){
+        save_chunked(bm_path(), h, {64, 64});
+    }
+    state.SetBytesProcessed(state.iterations()*n*n*sizeof(float));
+    std::filesystem::remove(bm_path());
+}
+BENCHMARK(BM_SaveChunked)->Arg(1024)->Arg(4096)->Unit(benchmark::kMillisecond);
+
+static void BM_LoadChunked(benchmark::State& state) {
+    const size_t n = state.range(0);
+    save_chunked(bm_path(), make_holor(n), {64, 64});
+    for (auto _ : state){
+        ChunkedHolorFile<float, 2> chunked(bm_path());
+        benchmark::DoNotOptimize(chunked.read().data());
+    }
+    state.SetBytesProcessed(state.iterations()*n*n*sizeof(float));
+    std::filesystem::remove(bm_path());
+}
+BENCHMARK(BM_LoadChunked)->Arg(1024)->Arg(4096)->Unit(benchmark::kMillisecond);
+
+// 64 slices of 100x100 elements at pseudo-random positions, each overlapping with 4 to 9 chunks. The second argument is the capacity of the cache in MiB:
+// without a cache every slice decompresses its chunks, while a cache of 64 MiB keeps all the chunks after the first iteration
+static void BM_ChunkedRandomSlices(benchmark::State& state) {
+    const size_t n = state.range(0);
+    save_chunked(bm_path(), make_holor(n), {64, 64});
+    ChunkedHolorFile<float, 2> chunked(bm_path(), static_cast<size_t>(state.range(1)) << 20);
+    for (auto _ : state){
+        float total = 0;
+        for (size_t i = 0; i < 64; i++){
+            const size_t row = (i*7919) % (n - 100);
+            const size_t col = (i*104729) % (n - 100);
+            total += sum(chunked.read(range{row, row + 99}, range{col, col + 99}));
+        }
+        benchmark::DoNotOptimize(total);
+    }
+    std::filesystem::remove(bm_path());
+}
+BENCHMARK(BM_ChunkedRandomSlices)->Args({1024, 0})->Args({1024, 64})->Args({4096, 0})->Args({4096, 64})->Unit(benchmark::kMicrosecond);
+
+static void BM_LoadRandomSlices(benchmark::State& state) {
+    const size_t n = state.range(0);
+    save(bm_path(), make_holor(n));
+    for (auto _ : state){
+        auto h = load<float, 2>(bm_path());
+        float total = 0;
+        for (size_t i = 0; i < 64; i++){
+            const size_t row = (i*7919) % (n - 100);
+            const size_t col = (i*104729) % (n - 100);
+            total += sum(h(range{row, row + 99}, range{col, col + 99}));
+        }
+        benchmark::DoNotOptimize(total);
+    }
+    std::filesystem::remove(bm_path());
+}
+BENCHMARK(BM_LoadRandomSlices)->Arg(1024)->Arg(4096)->Unit(benchmark::kMicrosecond);
+
+
+/*=============================================================================
+ ====================            STREAM               =======================
+ ============================================================================*/
+// rows of 256 elements are appended one at a time to a growing file, and compared with saving the whole container at once
+static void BM_StreamAppend(benchmark::State& state) {
+    const size_t n = state.range(0);
+    auto h = make_holor(256);
+    for (auto _ : state){
+        HolorStreamWriter<float, 2> writer(bm_path(), {256});
+        for (size_t i = 0; i < n; i++){
+            writer.append(h.row(i % 256));
+        }
+        writer.close();
+    }
+    state.SetBytesProcessed(state.iterations()*n*256*sizeof(float));
+    std::filesystem::remove(bm_path());
+}
+BENCHMARK(BM_StreamAppend)->Arg(4096)->Arg(65536)->Unit(benchmark::kMillisecond);
+
+static void BM_StreamSave(benchmark::State& state) {
+    const size_t n = state.range(0);
+    Holor<float, 2> h(std::vector<size_t>{n, 256});
+    for (auto _ : state){
+        save(bm_path(), h);
+    }
+    state.SetBytesProcessed(state.iterations()*n*256*sizeof(float));
+    std::filesystem::remove(bm_path());
+}
+BENCHMARK(BM_StreamSave)->Arg(4096)->Arg(65536)->Unit(benchmark::kMillisecond);
+
+
+BENCHMARK_MAIN();
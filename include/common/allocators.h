@@ -0,0 +1,196 @@
+// This file is part of Holor, a C++ header-only template library for multi-dimensional containers
+
+// Copyright 2020-2022 Carlo Masone
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to 
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is 
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER 
+// DEALINGS IN THE SOFTWARE.
+
+
+
+#ifndef HOLOR_ALLOCATORS_H
+#define HOLOR_ALLOCATORS_H
+
+/** \file allocators.h
+ * \brief This header contains the allocators that can be used to customize the storage of a Holor container.
+ */
+
+#include <cstddef>
+#include <new>
+#include <limits>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+
+namespace holor{
+
+/*================================================================================================
+                                    ALIGNED ALLOCATOR
+================================================================================================*/
+/*!
+ * \brief Allocator that returns memory aligned to a given boundary (by default a cache line), which can be used as the `Allocator` of a Holor to get buffers suitable for aligned SIMD loads.
+ *
+ * Optionally, the allocator can request transparent huge pages for large buffers: when `HugePages` is true and a buffer is at least `huge_page_size` bytes,
+ * the buffer is aligned to the huge page size and the kernel is advised with `madvise(MADV_HUGEPAGE)` to back it with huge pages. The advice is only a hint
+ * and it is ignored on systems that do not support it.
+ *
+ * \tparam T type of the allocated elements
+ * \tparam Alignment alignment in bytes of the allocated buffers. It must be a power of two and at least `alignof(T)`.
+ * \tparam HugePages if true, buffers of at least `huge_page_size` bytes are aligned to the huge page size and advised to use transparent huge pages
+ */
+template<typename T, size_t Alignment = 64, bool HugePages = false> requires ( (Alignment >= alignof(T)) && ((Alignment & (Alignment-1)) == 0) )
+struct AlignedAllocator{
+    using value_type = T;                                   ///< \brief type of the allocated elements
+    static constexpr size_t alignment = Alignment;          ///< \brief alignment of the allocated buffers
+    static constexpr size_t huge_page_size = 2*1024*1024;   ///< \brief size of the huge pages, and minimum size of the buffers that request them
+
+    /*!
+     * \brief rebinds the allocator to another type of elements, with the same alignment and huge pages option
+     */
+    template<typename U>
+    struct rebind{
+        using other = AlignedAllocator<U, Alignment, HugePages>;
+    };
+
+    AlignedAllocator() noexcept = default;
+
+    template<typename U>
+    AlignedAllocator(const AlignedAllocator<U, Alignment, HugePages>&) noexcept {}
+
+    /*!
+     * \brief allocates an aligned buffer
+     * \param n number of elements in the buffer
+     * \exception std::bad_array_new_length if the size of the buffer overflows, or std::bad_alloc if the allocation fails
+     * \return a pointer to the buffer
+     */
+    [[nodiscard]] T* allocate(size_t n){
+        if (n > std::numeric_limits<size_t>::max()/sizeof(T)){
+            throw std::bad_array_new_length();
+        }
+        const size_t bytes = n*sizeof(T);
+        void* ptr = ::operator new(bytes, std::align_val_t{buffer_alignment(bytes)});
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+        if constexpr(HugePages){
+            if (bytes >= huge_page_size){
+                madvise(ptr, bytes, MADV_HUGEPAGE);
+            }
+        }
+#endif
+        return static_cast<T*>(ptr);
+    }
+
+    /*!
+     * \brief releases a buffer obtained with `allocate`
+     * \param ptr pointer to the buffer
+     * \param n number of elements in the buffer
+     */
+    void deallocate(T* ptr, size_t n) noexcept{
+        ::operator delete(ptr, n*sizeof(T), std::align_val_t{buffer_alignment(n*sizeof(T))});
+    }
+
+    /*!
+     * \brief computes the alignment of a buffer, which depends on its size only when the huge pages option is enabled
+     * \param bytes size of the buffer
+     * \return the alignment of the buffer
+     */
+    static constexpr size_t buffer_alignment(size_t bytes){
+        if constexpr(HugePages){
+            if (bytes >= huge_page_size){
+                return huge_page_size;
+            }
+        }
+        return Alignment;
+    }
+};
+
+/*!
+ * \brief All the AlignedAllocators with the same parameters are interchangeable
+ */
+template<typename T, typename U, size_t Alignment, bool HugePages>
+bool operator==(const AlignedAllocator<T, Alignment, HugePages>&, const AlignedAllocator<U, Alignment, HugePages>&){
+    return true;
+}
+
+
+/*!
+ * \brief Alias of an allocator that aligns its buffers to a cache line and requests transparent huge pages for large buffers
+ */
+template<typename T>
+using HugePageAllocator = AlignedAllocator<T, 64, true>;
+
+
+/*================================================================================================
+                                    DEFAULT-INIT ADAPTOR
+================================================================================================*/
+namespace impl{
+
+/*!
+ * \brief Allocator adaptor that default-initializes, instead of value-initializing, the elements of trivial types that are constructed without arguments.
+ * It is used for the storage of a Holor, so that a container can be created without writing its elements when they are going to be overwritten.
+ * The elements of non-trivial types are always value-initialized, and all the other constructions are forwarded to the adapted allocator.
+ * \tparam Allocator the adapted allocator
+ */
+template<class Allocator>
+struct DefaultInitAllocator: public Allocator{
+    using traits = std::allocator_traits<Allocator>;
+
+    template<typename U>
+    struct rebind{
+        using other = DefaultInitAllocator<typename traits::template rebind_alloc<U>>;
+    };
+
+    using Allocator::Allocator;
+
+    DefaultInitAllocator() noexcept(std::is_nothrow_default_constructible_v<Allocator>) = default;
+
+    DefaultInitAllocator(const Allocator& allocator) noexcept: Allocator(allocator) {}
+
+    template<class Other>
+    DefaultInitAllocator(const DefaultInitAllocator<Other>& allocator) noexcept: Allocator(static_cast<const Other&>(allocator)) {}
+
+    template<typename U>
+    void construct(U* ptr) noexcept(std::is_nothrow_default_constructible_v<U>){
+        if constexpr(std::is_trivially_default_constructible_v<U>){
+            ::new(static_cast<void*>(ptr)) U;
+        } else{
+            traits::construct(static_cast<Allocator&>(*this), ptr);
+        }
+    }
+
+    template<typename U, typename... Args>
+    void construct(U* ptr, Args&&... args){
+        traits::construct(static_cast<Allocator&>(*this), ptr, std::forward<Args>(args)...);
+    }
+};
+
+template<class A1, class A2>
+bool operator==(const DefaultInitAllocator<A1>& a1, const DefaultInitAllocator<A2>& a2){
+    return static_cast<const A1&>(a1) == static_cast<const A2&>(a2);
+}
+
+} //namespace impl
+
+
+
+} //namespace holor
+
+#endif // HOLOR_ALLOCATORS_H
@@ -65,22 +65,41 @@ struct HolorRuntimeError : public std::runtime_error {
  * 
  * \return the message as a \p std::string
  */
-std::string compose_message(const char* file, int line, const std::string& info){
-   std::ostringstream os("(");
-   os << file << ", " << line << "): " << info;
+inline std::string compose_message(const char* file, int line, const std::string& info){
+   std::ostringstream os;
+   os << "(" << file << ", " << line << "): " << info;
    return os.str();
 }
 
 
+/*!
+ * \brief Structure that stores the information needed to compose the message of an exception. 
+ * Its purpose is to defer the composition of the message (and thus the creation of a \p std::string) until the exception is actually thrown, so that a successful check does not pay for it.
+ */
+struct ExceptionInfo{
+    const char* file_;  /*! name of the file where the exception originated */
+    int line_;          /*! line number of the file where the exception originated */
+    const char* info_;  /*! additional information to be inserted in the message */
+
+    /*!
+     * \brief Function that composes the message of the exception
+     * \return the message as a \p std::string
+     */
+    std::string message() const{
+        return compose_message(file_, line_, info_);
+    }
+};
+
+
 } //namespace exception
 
 } //namespace holor
 
 
 /*!
- * \brief macro that is used to compose an exception message that specifies the file and line number which originated the exception
+ * \brief macro that is used to collect the information for an exception message that specifies the file and line number which originated the exception. The message is composed only when the exception is thrown.
  */
-#define EXCEPTION_MESSAGE(msg) holor::exception::compose_message(__FILE__, __LINE__, msg)
+#define EXCEPTION_MESSAGE(msg) holor::exception::ExceptionInfo{__FILE__, __LINE__, msg}
 
 
 #endif // HOLOR_EXCEPTIONS_H
\ No newline at end of file
@@ -0,0 +1,507 @@
+// This file is part of Holor, a C++ header-only template library for multi-dimensional containers
+
+// Copyright 2020-2022 Carlo Masone
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to 
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is 
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER 
+// DEALINGS IN THE SOFTWARE.
+
+
+
+#ifndef HOLOR_EXECUTOR_H
+#define HOLOR_EXECUTOR_H
+
+/** \file executor.h
+ * \brief This header contains the work-stealing scheduler that runs the parallel operations and the helpers to partition a container into slices processed in parallel.
+ *
+ * Each worker thread owns a deque of tasks: it pushes and pops its own tasks at the bottom of the deque, while the idle workers steal tasks from the top of the deques of the other workers without locks.
+ * The tasks submitted by threads that are not workers are put in a shared queue. A thread that waits for a group of tasks executes pending tasks in the meantime,
+ * so nested parallel loops do not block threads and do not create new ones.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <algorithm>
+#include <concepts>
+#include <type_traits>
+#include <utility>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+
+/*!
+ * \brief Number of threads of the global executor, including the thread that waits for the tasks. If it is zero, the number of hardware threads is used
+ */
+#ifndef HOLOR_EXECUTOR_THREADS
+#define HOLOR_EXECUTOR_THREADS 0
+#endif
+
+/*!
+ * \brief If it is non-zero, the worker threads of the global executor are pinned to distinct cores
+ */
+#ifndef HOLOR_EXECUTOR_PIN_THREADS
+#define HOLOR_EXECUTOR_PIN_THREADS 0
+#endif
+
+
+namespace holor{
+
+class task_group;
+
+namespace impl{
+
+/*================================================================================================
+                                    TASKS
+================================================================================================*/
+/*!
+ * \brief Base of the tasks executed by the executor. A task is allocated when it is submitted and it deletes itself after its execution
+ */
+struct Task{
+    void (*execute_)(Task*); ///< \brief function that executes the task and deletes it
+};
+
+
+/*!
+ * \brief Bounded work-stealing deque of tasks (Chase-Lev). The owner thread pushes and pops tasks at the bottom, while the other threads steal them from the top.
+ * All the operations are lock-free, and the only synchronization between the owner and the thieves is a compare-and-swap on the top index when they compete for the last task.
+ */
+class WorkStealingDeque{
+    public:
+        static constexpr int64_t capacity = 1 << 12; ///< \brief maximum number of tasks in the deque
+
+        WorkStealingDeque(): buffer_{std::make_unique<std::atomic<Task*>[]>(capacity)}{}
+
+        /*!
+         * \brief Function that pushes a task at the bottom of the deque. It must be called only by the owner thread
+         * \param task the task
+         * \return false if the deque is full
+         */
+        bool push(Task* task){
+            const int64_t bottom = bottom_.load(std::memory_order_relaxed);
+            const int64_t top = top_.load(std::memory_order_acquire);
+            if (bottom - top >= capacity){
+                return false;
+            }
+            buffer_[bottom & (capacity-1)].store(task, std::memory_order_relaxed);
+            bottom_.store(bottom+1, std::memory_order_seq_cst);
+            return true;
+        }
+
+        /*!
+         * \brief Function that pops the last pushed task from the bottom of the deque. It must be called only by the owner thread
+         * \return the task, or nullptr if the deque is empty
+         */
+        Task* pop(){
+            const int64_t bottom = bottom_.load(std::memory_order_relaxed) - 1;
+            bottom_.store(bottom, std::memory_order_seq_cst);
+            int64_t top = top_.load(std::memory_order_seq_cst);
+            if (top > bottom){
+                bottom_.store(bottom+1, std::memory_order_relaxed);
+                return nullptr;
+            }
+            Task* task = buffer_[bottom & (capacity-1)].load(std::memory_order_relaxed);
+            if (top == bottom){
+                // last task: compete with the thieves
+                if (!top_.compare_exchange_strong(top, top+1, std::memory_order_seq_cst, std::memory_order_relaxed)){
+                    task = nullptr;
+                }
+                bottom_.store(bottom+1, std::memory_order_relaxed);
+            }
+            return task;
+        }
+
+        /*!
+         * \brief Function that steals the oldest task from the top of the deque. It can be called by any thread
+         * \return the task, or nullptr if the deque is empty or another thread took the task first
+         */
+        Task* steal(){
+            int64_t top = top_.load(std::memory_order_seq_cst);
+            const int64_t bottom = bottom_.load(std::memory_order_seq_cst);
+            if (top >= bottom){
+                return nullptr;
+            }
+            Task* task = buffer_[top & (capacity-1)].load(std::memory_order_relaxed);
+            if (!top_.compare_exchange_strong(top, top+1, std::memory_order_seq_cst, std::memory_order_relaxed)){
+                return nullptr;
+            }
+            return task;
+        }
+
+        /*!
+         * \brief Function that checks if the deque may contain tasks. The result is only a hint when other threads operate on the deque
+         */
+        bool empty() const{
+            return top_.load(std::memory_order_relaxed) >= bottom_.load(std::memory_order_relaxed);
+        }
+
+    private:
+        alignas(64) std::atomic<int64_t> top_{0};       ///< \brief index of the oldest task
+        alignas(64) std::atomic<int64_t> bottom_{0};    ///< \brief index past the newest task
+        std::unique_ptr<std::atomic<Task*>[]> buffer_;  ///< \brief circular buffer of tasks
+};
+
+} //namespace impl
+
+
+
+/*================================================================================================
+                                    EXECUTOR
+================================================================================================*/
+/*!
+ * \brief Work-stealing scheduler with a fixed number of threads, which runs the tasks of `task_group`s and the parallel loops of the library.
+ *
+ * The thread that waits for a group of tasks takes part in their execution, so an executor with `threads` threads starts `threads-1` worker threads.
+ * Since waiting threads execute pending tasks instead of blocking, parallel loops can be nested and unbalanced workloads are redistributed by stealing, without creating more threads than the executor has.
+ */
+class executor{
+    public:
+        /*!
+         * \brief Constructor
+         * \param threads number of threads that execute the tasks, including the thread that waits for them. If it is zero, it is set to the number of hardware threads
+         * \param pin_threads if true, each worker thread is pinned to a distinct core (only on Linux), so that the operating system does not migrate it and its caches stay warm
+         */
+        explicit executor(size_t threads = 0, bool pin_threads = false){
+            const size_t hardware_threads = std::max<size_t>(1, std::thread::hardware_concurrency());
+            if (threads == 0){
+                threads = hardware_threads;
+            }
+            deques_.reserve(threads-1);
+            for (size_t i = 0; i + 1 < threads; i++){
+                deques_.push_back(std::make_unique<impl::WorkStealingDeque>());
+            }
+            workers_.reserve(threads-1);
+            for (size_t i = 0; i + 1 < threads; i++){
+                workers_.emplace_back([this, i]{ worker_loop(i); });
+                if (pin_threads){
+                    pin_thread(workers_.back(), (i+1) % hardware_threads);
+                }
+            }
+        }
+
+        executor(const executor&) = delete;
+        executor& operator=(const executor&) = delete;
+
+        ~executor(){
+            {
+                std::lock_guard<std::mutex> lock(sleep_mutex_);
+                stop_.store(true);
+            }
+            wake_.notify_all();
+            for (auto& worker : workers_){
+                worker.join();
+            }
+        }
+
+        /*!
+         * \brief Function that returns the executor used by the parallel operations of the library. Its number of threads is given by the macro `HOLOR_EXECUTOR_THREADS`,
+         * and its worker threads are pinned to distinct cores if the macro `HOLOR_EXECUTOR_PIN_THREADS` is non-zero
+         * \return a reference to the executor
+         */
+        static executor& global(){
+            static executor instance(HOLOR_EXECUTOR_THREADS, HOLOR_EXECUTOR_PIN_THREADS != 0);
+            return instance;
+        }
+
+        /*!
+         * \brief Function that returns the number of threads that execute the tasks, including the thread that waits for them
+         * \return the number of threads
+         */
+        size_t concurrency() const{
+            return workers_.size() + 1;
+        }
+
+        /*!
+         * \brief Function that runs a loop over the range `[begin, end)` in parallel and waits for its completion. The range is split recursively in halves that are submitted as tasks,
+         * until they have at most `grain` indices, so idle threads steal the largest halves left.
+         * \param begin first index of the range
+         * \param end index past the last one of the range
+         * \param grain maximum number of indices processed by a single call of the function
+         * \param func function called as `func(first, last)` on disjoint sub-ranges `[first, last)` that cover the range
+         */
+        template<class Func> requires std::invocable<Func&, size_t, size_t>
+        void parallel_for(size_t begin, size_t end, size_t grain, Func&& func);
+
+    private:
+        friend class task_group;
+
+        /*!
+         * \brief identifies the executor and the deque of the current thread, if it is a worker thread
+         */
+        struct WorkerIdentity{
+            executor* owner_ = nullptr;
+            size_t index_ = 0;
+        };
+
+        std::vector<std::unique_ptr<impl::WorkStealingDeque>> deques_;  ///< \brief deques of the worker threads
+        std::vector<std::thread> workers_;                              ///< \brief worker threads
+        std::mutex injection_mutex_;                                    ///< \brief protects the queue of the tasks submitted by external threads
+        std::deque<impl::Task*> injection_queue_;                       ///< \brief tasks submitted by external threads
+        std::atomic<size_t> injected_{0};                               ///< \brief number of tasks in the injection queue
+        std::mutex sleep_mutex_;                                        ///< \brief protects the sleep of idle workers
+        std::condition_variable wake_;                                  ///< \brief wakes the idle workers
+        std::atomic<uint64_t> epoch_{0};                                ///< \brief incremented every time a task is submitted
+        std::atomic<size_t> sleeping_{0};                               ///< \brief number of sleeping workers
+        std::atomic<bool> stop_{false};                                 ///< \brief tells the workers to terminate
+
+        static constexpr size_t spins_before_sleep = 64;
+
+        static WorkerIdentity& current_worker(){
+            static thread_local WorkerIdentity identity;
+            return identity;
+        }
+
+        static void pin_thread([[maybe_unused]] std::thread& thread, [[maybe_unused]] size_t cpu){
+#if defined(__linux__)
+            cpu_set_t cpus;
+            CPU_ZERO(&cpus);
+            CPU_SET(cpu, &cpus);
+            pthread_setaffinity_np(thread.native_handle(), sizeof(cpu_set_t), &cpus);
+#endif
+        }
+
+        /*!
+         * \brief Function that submits a task: a worker pushes it on its own deque, other threads on the shared injection queue
+         */
+        void submit(impl::Task* task){
+            const auto& identity = current_worker();
+            if (!(identity.owner_ == this && deques_[identity.index_]->push(task))){
+                std::lock_guard<std::mutex> lock(injection_mutex_);
+                injection_queue_.push_back(task);
+                injected_.fetch_add(1, std::memory_order_seq_cst);
+            }
+            epoch_.fetch_add(1, std::memory_order_seq_cst);
+            if (sleeping_.load(std::memory_order_seq_cst) > 0){
+                std::lock_guard<std::mutex> lock(sleep_mutex_);
+                wake_.notify_one();
+            }
+        }
+
+        /*!
+         * \brief Function that looks for a pending task: first in the deque of the current thread, then in the injection queue, finally in the deques of the other workers
+         * \return the task, or nullptr if no task has been found
+         */
+        impl::Task* find_task(){
+            const auto& identity = current_worker();
+            const bool is_worker = (identity.owner_ == this);
+            if (is_worker){
+                if (auto task = deques_[identity.index_]->pop()){
+                    return task;
+                }
+            }
+            if (injected_.load(std::memory_order_seq_cst) > 0){
+                std::lock_guard<std::mutex> lock(injection_mutex_);
+                if (!injection_queue_.empty()){
+                    auto task = injection_queue_.front();
+                    injection_queue_.pop_front();
+                    injected_.fetch_sub(1, std::memory_order_seq_cst);
+                    return task;
+                }
+            }
+            const size_t n = deques_.size();
+            const size_t first = is_worker ? identity.index_ + 1 : 0;
+            for (size_t k = 0; k < n; k++){
+                const size_t victim = (first + k) % n;
+                if (is_worker && victim == identity.index_){
+                    continue;
+                }
+                if (auto task = deques_[victim]->steal()){
+                    return task;
+                }
+            }
+            return nullptr;
+        }
+
+        /*!
+         * \brief Function that executes a pending task, if there is one
+         * \return true if a task has been executed
+         */
+        bool execute_one(){
+            if (auto task = find_task()){
+                task->execute_(task);
+                return true;
+            }
+            return false;
+        }
+
+        bool has_pending_tasks() const{
+            if (injected_.load(std::memory_order_seq_cst) > 0){
+                return true;
+            }
+            return std::ranges::any_of(deques_, [](const auto& deque){ return !deque->empty(); });
+        }
+
+        void worker_loop(size_t index){
+            current_worker() = WorkerIdentity{this, index};
+            size_t idle = 0;
+            while (!stop_.load(std::memory_order_relaxed)){
+                if (execute_one()){
+                    idle = 0;
+                    continue;
+                }
+                if (++idle < spins_before_sleep){
+                    std::this_thread::yield();
+                    continue;
+                }
+                idle = 0;
+                const uint64_t epoch = epoch_.load(std::memory_order_seq_cst);
+                sleeping_.fetch_add(1, std::memory_order_seq_cst);
+                if (!has_pending_tasks()){
+                    std::unique_lock<std::mutex> lock(sleep_mutex_);
+                    wake_.wait(lock, [&]{ return stop_.load() || epoch_.load(std::memory_order_seq_cst) != epoch; });
+                }
+                sleeping_.fetch_sub(1, std::memory_order_seq_cst);
+            }
+        }
+};
+
+
+
+/*================================================================================================
+                                    TASK GROUP
+================================================================================================*/
+/*!
+ * \brief Group of tasks submitted to an executor, whose completion can be awaited. The thread that waits executes pending tasks until all the tasks of the group have been completed.
+ * If a task throws an exception, the other tasks are still executed and the first exception is rethrown by `wait()`.
+ */
+class task_group{
+    public:
+        /*!
+         * \brief Constructor
+         * \param exec the executor that runs the tasks
+         */
+        explicit task_group(executor& exec = executor::global()): executor_{exec}{}
+
+        task_group(const task_group&) = delete;
+        task_group& operator=(const task_group&) = delete;
+
+        /*!
+         * \brief The destructor waits for the completion of the tasks, ignoring their exceptions
+         */
+        ~task_group(){
+            wait_tasks();
+        }
+
+        /*!
+         * \brief Function that submits a task
+         * \param func the function executed by the task. It is copied or moved in the task
+         */
+        template<class Func> requires std::invocable<std::decay_t<Func>&>
+        void run(Func&& func){
+            struct GroupTask : impl::Task{
+                task_group* group_;
+                std::decay_t<Func> func_;
+            };
+            auto task = new GroupTask{{&execute<GroupTask>}, this, std::forward<Func>(func)};
+            pending_.fetch_add(1, std::memory_order_relaxed);
+            executor_.submit(task);
+        }
+
+        /*!
+         * \brief Function that waits for the completion of all the submitted tasks, executing pending tasks in the meantime
+         * \exception the first exception thrown by a task, if any
+         */
+        void wait(){
+            wait_tasks();
+            if (exception_){
+                auto exception = std::exchange(exception_, nullptr);
+                std::rethrow_exception(exception);
+            }
+        }
+
+    private:
+        executor& executor_;                ///< \brief executor that runs the tasks
+        std::atomic<size_t> pending_{0};    ///< \brief number of tasks not yet completed
+        std::mutex exception_mutex_;        ///< \brief protects exception_
+        std::exception_ptr exception_;      ///< \brief first exception thrown by a task
+
+        template<class GroupTask>
+        static void execute(impl::Task* base){
+            auto task = static_cast<GroupTask*>(base);
+            auto group = task->group_;
+            try{
+                task->func_();
+            } catch(...){
+                std::lock_guard<std::mutex> lock(group->exception_mutex_);
+                if (!group->exception_){
+                    group->exception_ = std::current_exception();
+                }
+            }
+            delete task;
+            group->pending_.fetch_sub(1, std::memory_order_acq_rel);
+        }
+
+        void wait_tasks(){
+            while (pending_.load(std::memory_order_acquire) > 0){
+                if (!executor_.execute_one()){
+                    std::this_thread::yield();
+                }
+            }
+        }
+};
+
+
+template<class Func> requires std::invocable<Func&, size_t, size_t>
+void executor::parallel_for(size_t begin, size_t end, size_t grain, Func&& func){
+    if (end <= begin){
+        return;
+    }
+    grain = std::max<size_t>(grain, 1);
+    if (workers_.empty()){
+        for (size_t first = begin; first < end; first += std::min(grain, end - first)){
+            func(first, first + std::min(grain, end - first));
+        }
+        return;
+    }
+    if (end - begin <= grain){
+        func(begin, end);
+        return;
+    }
+    task_group group(*this);
+    auto split = [&group, &func, grain](auto& self, size_t first, size_t last) -> void{
+        while (last - first > grain){
+            const size_t middle = first + (last - first)/2;
+            group.run([&self, middle, last]{ self(self, middle, last); });
+            last = middle;
+        }
+        func(first, last);
+    };
+    try{
+        split(split, begin, end);
+    } catch(...){
+        // the submitted tasks refer to split, so they must complete before it is destroyed
+        try{
+            group.wait();
+        } catch(...){}
+        throw;
+    }
+    group.wait();
+}
+
+} //namespace holor
+
+#endif // HOLOR_EXECUTOR_H
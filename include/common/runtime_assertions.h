@@ -64,6 +64,24 @@ constexpr bool assertion_level(int n){
 }
 
 
+namespace impl{
+    /*!
+     * \brief function that throws the exception of a failed assertion. It is kept out of line and marked as cold, so that the code of the checks stays small and the composition of the message is moved away from the hot path.
+     * \tparam Exception is the type of exception to be thrown
+     * \param info contains the information used to compose the message of the exception
+     */
+    template<typename Exception>
+    [[noreturn, gnu::cold, gnu::noinline]] void assertion_failure(const holor::exception::ExceptionInfo& info){
+        throw Exception(info.message());
+    }
+
+    template<typename Exception>
+    [[noreturn, gnu::cold, gnu::noinline]] void assertion_failure(const std::string& message){
+        throw Exception(message);
+    }
+} //namespace impl
+
+
 /*!
  * \brief function that checks an assertion and throws an exception if it is not verified.
  * \b Example:
@@ -73,28 +91,36 @@ constexpr bool assertion_level(int n){
  *      int a = 5; int b = 7;
  *      assert::dynamic_assert( a < b, EXCEPTION_MESSAGE("Invalid assertion, a is not smaller than b.") );
  * \endverbatim
+ * \b Note: the message of the exception is composed only if the assertion fails, therefore a successful check costs only a comparison and a branch.
  * \tparam cond is a parameter that is used to conditionally exclude the check. Namely, if the assertion level of the assertion to be verified is less or equal to the current level, the check is performed
  * \tparam Exception is the type of exception that the check would throw.
  * \param assertion is the assertion to be verified
- * \param message is a optional message that will be written when the exception is thrown
+ * \param info is a optional information (usually created with the macro `EXCEPTION_MESSAGE`) used to compose the message that will be written when the exception is thrown
  */
 template<bool cond = assertion_level(default_level), typename Exception = holor::exception::HolorRuntimeError>
-void dynamic_assert(bool assertion, const std::string& message = "Dynamic assertion failed."){
-    if (assertion){
-        return;
-    } else {
-        throw Exception(message);
+constexpr void dynamic_assert(bool assertion, const holor::exception::ExceptionInfo& info = {"", 0, "Dynamic assertion failed."}){
+    if constexpr(cond){
+        if (!assertion) [[unlikely]]{
+            impl::assertion_failure<Exception>(info);
+        }
     }
 }
 
-// If condition is false (the assertion level is higher than the current level chosen) do nothing
-template<>
-void dynamic_assert<false, holor::exception::HolorRuntimeError>(bool, const std::string&){}
-
-
-// If condition is false (the assertion level is higher than the current level chosen) do nothing
-template<>
-void dynamic_assert<false, holor::exception::HolorInvalidArgument>(bool, const std::string&){}
+/*!
+ * \brief overload of the function `dynamic_assert` that takes an already composed message.
+ * \tparam cond is a parameter that is used to conditionally exclude the check. Namely, if the assertion level of the assertion to be verified is less or equal to the current level, the check is performed
+ * \tparam Exception is the type of exception that the check would throw.
+ * \param assertion is the assertion to be verified
+ * \param message is the message that will be written when the exception is thrown
+ */
+template<bool cond = assertion_level(default_level), typename Exception = holor::exception::HolorRuntimeError>
+inline void dynamic_assert(bool assertion, const std::string& message){
+    if constexpr(cond){
+        if (!assertion) [[unlikely]]{
+            impl::assertion_failure<Exception>(message);
+        }
+    }
+}
 
 
 
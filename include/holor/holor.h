@@ -27,17 +27,46 @@
 
 #include <cstddef>
 #include <vector>
+#include <memory>
+#include <span>
+#include <type_traits>
+#include <algorithm>
+#include <iterator>
 
 #include "holor_ref.h"
 #include "holor_concepts.h"
 #include "../layout/layout.h"
+#include "../layout/layout_traversal.h"
 #include "initializer.h"
+#include "../common/allocators.h"
 
 
 
 namespace holor{
 
 
+/*!
+ * \brief Tag type used to create a Holor without initializing its elements, when they are going to be overwritten. The elements of trivial types are left with unspecified values, while the elements of other types are value-initialized.
+ */
+struct uninitialized_t{
+    explicit uninitialized_t() = default;
+};
+
+/*!
+ * \brief Tag used to create a Holor without initializing its elements, e.g., `Holor<float, 2> h(holor::uninitialized, lengths)`
+ */
+inline constexpr uninitialized_t uninitialized{};
+
+
+namespace impl{
+    /*!
+     * \brief type of the storage of a Holor, whose allocator default-initializes the elements of trivial types unless they are explicitly value-initialized
+     */
+    template<typename T, class Allocator>
+    using holor_storage = std::vector<T, DefaultInitAllocator<Allocator>>;
+}
+
+
 /*================================================================================================
                                     Holor Class
 ================================================================================================*/
@@ -49,8 +78,9 @@ namespace holor{
  * 
  * \tparam N the number of dimensions of the container. For example, for a matrix-like container it is `N-2`.
  * \tparam T the type of the elements stored in the container.
+ * \tparam Allocator the allocator used to acquire the storage of the elements. For example, `holor::AlignedAllocator` (see allocators.h) provides buffers aligned to a cache line and can request transparent huge pages for large buffers.
  */
-template<typename T, size_t N> requires (N>0)
+template<typename T, size_t N, class Allocator = std::allocator<T>> requires (N>0)
 class Holor{   
 
     public:
@@ -59,10 +89,11 @@ class Holor{
         ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
         static constexpr size_t dimensions = N;                                         ///< \brief number of dimensions in the container 
         using value_type = T;                                                           ///< \brief type of the values in the container
-        using iterator = typename std::vector<T>::iterator;                             ///< \brief type of the iterator for the container
-        using const_iterator = typename std::vector<T>::const_iterator;                 ///< \brief type of the const_iterator for the container
-        using reverse_iterator = typename std::vector<T>::reverse_iterator;             ///< \brief type of the reverse_iterator for the container
-        using const_reverse_iterator = typename std::vector<T>::const_reverse_iterator; ///< \brief type of the const_reverse_iterator for the container
+        using allocator_type = Allocator;                                               ///< \brief type of the allocator used for the storage of the elements
+        using iterator = typename impl::holor_storage<T, Allocator>::iterator;                             ///< \brief type of the iterator for the container
+        using const_iterator = typename impl::holor_storage<T, Allocator>::const_iterator;                 ///< \brief type of the const_iterator for the container
+        using reverse_iterator = typename impl::holor_storage<T, Allocator>::reverse_iterator;             ///< \brief type of the reverse_iterator for the container
+        using const_reverse_iterator = typename impl::holor_storage<T, Allocator>::const_reverse_iterator; ///< \brief type of the const_reverse_iterator for the container
         using holor_type = holor::impl::HolorOwningTypeTag;                             ///< \brief tags a Holor type with ownership over its data
 
 
@@ -70,30 +101,68 @@ class Holor{
                 CONSTRUCTORS, ASSIGNMENTS AND DESTRUCTOR
         ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
         Holor() = default;                                      ///< \brief default constructor with zero elements in every dimension
-        Holor(Holor<T, N>&& holor) = default;                   ///< \brief default move constructor
-        Holor(const Holor<T, N>& holor) = default;              ///< \brief default copy constructor
-        Holor& operator=(Holor<T, N>&& holor) = default;        ///< \brief default move assignment
-        Holor& operator=(const Holor<T, N>& holor) = default;   ///< \brief default copy assignment
+        Holor(Holor&& holor) = default;                         ///< \brief default move constructor
+        Holor& operator=(Holor&& holor) = default;              ///< \brief default move assignment
         ~Holor() = default;                                     ///< \brief default destructor
+
+        /*!
+         * \brief Copy constructor
+         * \param holor the Holor to be copied
+         */
+        Holor(const Holor& holor): layout_{holor.layout_}, data_(std::allocator_traits<typename impl::holor_storage<T, Allocator>::allocator_type>::select_on_container_copy_construction(holor.data_.get_allocator())){
+            assign_elements(holor.data_.cbegin(), holor.data_.cend());
+        }
+
+        /*!
+         * \brief Copy assignment
+         * \param holor the Holor to be copied
+         * \return a reference to this Holor
+         */
+        Holor& operator=(const Holor& holor){
+            if (this != &holor){
+                layout_ = holor.layout_;
+                assign_elements(holor.data_.cbegin(), holor.data_.cend());
+            }
+            return *this;
+        }
     
         
         //TODO: cleanup and add to docs
         /*!
          * \brief Constructor that creates a Holor by specifying its layout
          * \param layout the memory layout
-         * \return a Holor with specified layout but without initializing its elements
+         * \return a Holor with specified layout and value-initialized elements
          */
         explicit Holor(Layout<N> layout): layout_{layout}{
+            resize_value_initialized(layout_.size());
+        }
+
+        /*!
+         * \brief Constructor that creates a Holor by specifying its layout, without initializing its elements
+         * \param layout the memory layout
+         * \return a Holor with specified layout, whose elements have unspecified values if `T` is a trivial type
+         */
+        Holor(uninitialized_t, Layout<N> layout): layout_{layout}{
             data_.resize(layout_.size());
         }
         
         /*!
          * \brief Constructor that creates a Holor by specifying the length of each dimension
          * \param lengths container with `N` lengths
-         * \return a Holor with specified lenghts but without initialization of its elements
+         * \return a Holor with specified lenghts and value-initialized elements
          */
         template <class Container> requires assert::RSTypedContainer<Container, size_t, N>
         explicit Holor(const Container& lengths): layout_{lengths}{
+            resize_value_initialized(layout_.size());
+        }
+
+        /*!
+         * \brief Constructor that creates a Holor by specifying the length of each dimension, without initializing its elements
+         * \param lengths container with `N` lengths
+         * \return a Holor with specified lenghts, whose elements have unspecified values if `T` is a trivial type
+         */
+        template <class Container> requires assert::RSTypedContainer<Container, size_t, N>
+        Holor(uninitialized_t, const Container& lengths): layout_{lengths}{
             data_.resize(layout_.size());
         }
 
@@ -105,8 +174,48 @@ class Holor{
         template<typename U> requires (std::convertible_to<U, T>)
         Holor(const HolorRef<U,N>& ref) {
             layout_ = Layout<N>(ref.layout().lengths());
+            if (ref.is_contiguous()){
+                auto flat = ref.span();
+                assign_elements(flat.begin(), flat.end());
+            } else{
+                assign_elements(ref.cbegin(), ref.cend());
+            }
+        }
+
+        /*!
+         * \brief Constructor from a Holor that uses a different allocator. The elements are copied into storage acquired with `Allocator`.
+         * \param holor a Holor object
+         * \return a Holor
+         */
+        template<class OtherAllocator> requires (!std::same_as<OtherAllocator, Allocator>)
+        explicit Holor(const Holor<T, N, OtherAllocator>& holor): layout_{holor.lengths()}{
+            assign_elements(holor.cbegin(), holor.cend());
+        }
+
+        /*!
+         * \brief Constructor from a lazy expression of element-wise operations (see holor_expressions.h), that is evaluated with a single traversal of its operands
+         * \param expression the expression
+         * \return a Holor with the lengths of the expression, whose elements are the values of the expression
+         */
+        template<HolorExpression E> requires ((E::dimensions == N) && std::convertible_to<typename E::value_type, T>)
+        Holor(const E& expression): layout_{expression.lengths()}{
             data_.resize(layout_.size());
-            std::copy(ref.cbegin(), ref.cend(), data_.begin());
+            expression.evaluate_into(data_.data(), layout_);
+        }
+
+        /*!
+         * \brief Assignment from a lazy expression of element-wise operations (see holor_expressions.h). If the lengths of the Holor are different from those of the expression, the Holor is resized
+         * \param expression the expression. The Holor can appear in the expression only in positions that access the element being written
+         * \return a reference to this Holor
+         */
+        template<HolorExpression E> requires ((E::dimensions == N) && std::convertible_to<typename E::value_type, T>)
+        Holor& operator=(const E& expression){
+            if (layout_.lengths() == expression.lengths()){
+                expression.evaluate_into(data_.data(), layout_);
+            } else{
+                *this = Holor(expression);
+            }
+            return *this;
         }
 
 
@@ -244,7 +353,129 @@ class Holor{
          * \return the data as a vector
          */
         auto data_vector() const{
-            return data_;
+            return std::vector<T, Allocator>(data_.cbegin(), data_.cend());
+        }
+
+        /*!
+         * \brief Function that verifies if the elements of the container are stored contiguously in memory. A Holor is always contiguous, and this function is provided for consistency with HolorRef
+         * \return true
+         */
+        constexpr bool is_contiguous() const{
+            return true;
+        }
+
+        /*!
+         * \brief Function that provides a flat view of the elements of the container
+         * \return a `std::span` over the elements of the container
+         */
+        std::span<T> span(){
+            return std::span<T>(data_);
+        }
+
+        std::span<const T> span() const{
+            return std::span<const T>(data_);
+        }
+
+
+        /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+                            APPEND FUNCTIONS
+        ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+        /*!
+         * \brief Function that returns the number of slices along the first dimension (rows) that the container can hold without reallocating its storage
+         * \return the capacity in rows
+         */
+        size_t capacity() const{
+            const size_t row_size = slice_size();
+            return (row_size == 0) ? 0 : data_.capacity()/row_size;
+        }
+
+        /*!
+         * \brief Function that reserves the storage for at least `rows` slices along the first dimension, so that the container can grow up to `rows` rows without reallocating. It does nothing if the capacity is already enough
+         * \param rows the number of rows
+         */
+        void reserve(size_t rows){
+            data_.reserve(rows*slice_size());
+        }
+
+        /*!
+         * \brief Function that releases the storage that exceeds the size of the container
+         */
+        void shrink_to_fit(){
+            data_.shrink_to_fit();
+        }
+
+        /*!
+         * \brief Function that appends a slab of rows along the first dimension. The storage grows geometrically, so that appending one row at a time takes amortized constant time,
+         * and the strides of the container do not change. The references to the elements and the HolorRefs to the container are invalidated if the storage is reallocated.
+         * \b Example: appending a `Holor<float, 2>` with lengths [10, 3] or a `Holor<float, 1>` with length 3 to a `Holor<float, 2>` with lengths [5, 3] gives lengths [15, 3] or [6, 3].
+         * \tparam H the type of the slab
+         * \param slab a container with `N` dimensions, whose lengths must be equal to the lengths of this container except for the first, or a container with `N-1` dimensions, that is appended as a single row.
+         * If this container has no rows, its other lengths are taken from the slab. The slab can be a view of this container
+         * \exception holor::exception::HolorRuntimeError if the lengths of the slab are not compatible with the container. The compiler flag DDEFINE_ASSERT_LEVEL in the CMakeLists can be set to AssertionLevel::no_checks to exclude this check.
+         */
+        template<HolorType H> requires ((H::dimensions == N || H::dimensions + 1 == N) && std::convertible_to<typename H::value_type, T>)
+        void append(const H& slab){
+            // the slab is described by a layout with N dimensions, whose first dimension has length 1 for a single row
+            std::array<size_t, N> lengths;
+            std::array<std::ptrdiff_t, N> strides;
+            if constexpr(H::dimensions == N){
+                lengths = slab.lengths();
+                strides = slab.layout().strides();
+            } else{
+                lengths[0] = 1;
+                strides[0] = 0;
+                const auto slab_lengths = slab.lengths();
+                std::copy(slab_lengths.begin(), slab_lengths.end(), lengths.begin() + 1);
+                const auto slab_strides = slab.layout().strides();
+                std::copy(slab_strides.begin(), slab_strides.end(), strides.begin() + 1);
+            }
+            if (layout_.length(0) == 0){
+                auto new_lengths = lengths;
+                new_lengths[0] = 0;
+                layout_.set_lengths(new_lengths);
+            }
+            assert::dynamic_assert(std::equal(lengths.begin() + 1, lengths.end(), layout_.lengths().begin() + 1), EXCEPTION_MESSAGE("holor::Holor::append - The lengths of the slab do not match the container."));
+            if (lengths[0] == 0){
+                return;
+            }
+            const Layout<N> source_layout(lengths, strides, slab.layout().offset());
+
+            // a slab that is a view of this container is copied before the storage is reallocated
+            const auto* source = slab.data();
+            if (std::greater_equal<const void*>()(source, data_.data()) && std::less<const void*>()(source, data_.data() + data_.size())){
+                append(Holor<T, N>(HolorRef<const typename H::value_type, N>(slab.data(), source_layout)));
+                return;
+            }
+            auto rows = append_rows(lengths[0]);
+            impl::for_each_index(impl::normalize_layouts(rows.layout(), source_layout), [dest = rows.data(), source](size_t i, size_t j){
+                dest[i] = static_cast<T>(source[j]);
+            });
+        }
+
+        /*!
+         * \brief Function that appends a single element to a container with a single dimension
+         * \param value the element
+         */
+        template<typename U> requires ((N == 1) && std::convertible_to<U, T> && !HolorType<U>)
+        void append(const U& value){
+            grow(1);
+            data_.back() = static_cast<T>(value);
+        }
+
+        /*!
+         * \brief Function that appends `rows` rows along the first dimension, whose elements have unspecified values if `T` is a trivial type, so that they can be written in place without copying them from another container.
+         * The storage grows geometrically, as in `append`
+         * \param rows the number of rows to be appended
+         * \exception holor::exception::HolorRuntimeError if `rows` is zero. The compiler flag DDEFINE_ASSERT_LEVEL in the CMakeLists can be set to AssertionLevel::no_checks to exclude this check.
+         * \return a HolorRef to the new rows, that is valid until the storage is reallocated
+         */
+        HolorRef<T, N> append_rows(size_t rows){
+            assert::dynamic_assert(rows > 0, EXCEPTION_MESSAGE("holor::Holor::append_rows - The number of rows must be positive."));
+            const size_t first = layout_.length(0);
+            grow(rows);
+            auto lengths = layout_.lengths();
+            lengths[0] = rows;
+            return HolorRef<T, N>(data_.data(), Layout<N>(lengths, layout_.strides(), first*slice_size()));
         }
 
 
@@ -304,8 +535,8 @@ class Holor{
             return HolorRef<T, N-1>(data_.data(), layout_.template slice_dimension<0>(i));
         }
 
-        const auto row(size_t i) const{
-            return HolorRef<T, N-1>(data_.data(), layout_.template slice_dimension<0>(i));
+        auto row(size_t i) const{
+            return HolorRef<const T, N-1>(data_.data(), layout_.template slice_dimension<0>(i));
         }
 
         
@@ -318,8 +549,8 @@ class Holor{
             return HolorRef<T, N-1>(data_.data(), layout_.template slice_dimension<1>(i));
         }
 
-        const auto col(size_t i) const{
-            return HolorRef<T, N-1>(data_.data(), layout_.template slice_dimension<1>(i));
+        auto col(size_t i) const{
+            return HolorRef<const T, N-1>(data_.data(), layout_.template slice_dimension<1>(i));
         }
 
 
@@ -335,8 +566,8 @@ class Holor{
         }
 
         template<size_t M> requires (M<N)
-        const auto slice(size_t i) const{
-            return HolorRef<T, N-1>(data_.data(), layout_.template slice_dimension<M>(i));
+        auto slice(size_t i) const{
+            return HolorRef<const T, N-1>(data_.data(), layout_.template slice_dimension<M>(i));
         }
 
 
@@ -352,8 +583,8 @@ class Holor{
         }
 
         template<size_t M> requires (M<N)
-        const auto slice(range range_slice) const{
-            return HolorRef<T, N>(data_.data(), layout_.template slice_dimension<M>(range_slice));
+        auto slice(range range_slice) const{
+            return HolorRef<const T, N>(data_.data(), layout_.template slice_dimension<M>(range_slice));
         }
 
 
@@ -362,7 +593,61 @@ class Holor{
     ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
     private:
         Layout<N> layout_;      ///< \brief The Layout of how the elements of the container are stored in memory
-        std::vector<T> data_;   ///< \brief Vector storing the actual data
+        impl::holor_storage<T, Allocator> data_;   ///< \brief Vector storing the actual data
+
+        /*!
+         * \brief Function that resizes the storage, value-initializing the new elements also when `T` is a trivial type
+         * \param size the new number of elements
+         */
+        void resize_value_initialized(size_t size){
+            if constexpr(std::is_trivially_default_constructible_v<T>){
+                data_.resize(size, T{});
+            } else{
+                data_.resize(size);
+            }
+        }
+
+        /*!
+         * \brief Function that returns the number of elements of a slice along the first dimension
+         */
+        size_t slice_size() const{
+            size_t result = 1;
+            for (size_t i = 1; i < N; i++){
+                result *= layout_.length(i);
+            }
+            return result;
+        }
+
+        /*!
+         * \brief Function that adds `rows` rows to the container, whose elements are default-initialized. The capacity is at least doubled when the storage is reallocated, so that the cost of the reallocations is amortized over the appended rows
+         * \param rows the number of rows
+         */
+        void grow(size_t rows){
+            const size_t size = (layout_.length(0) + rows)*slice_size();
+            if (size > data_.capacity()){
+                data_.reserve(std::max(size, 2*data_.capacity()));
+            }
+            data_.resize(size);
+            auto lengths = layout_.lengths();
+            lengths[0] += rows;
+            layout_.set_lengths(lengths);
+        }
+
+        /*!
+         * \brief Function that replaces the elements of the storage with the elements in a range. The elements of trivially copyable types are copied into default-initialized storage, so that the copy of contiguous ranges is done in bulk
+         * \param first iterator to the first element of the range
+         * \param last iterator past the last element of the range
+         */
+        template<std::forward_iterator It>
+        void assign_elements(It first, It last){
+            if constexpr(std::is_trivially_copyable_v<T>){
+                data_.clear();
+                data_.resize(std::distance(first, last));
+                std::copy(first, last, data_.begin());
+            } else{
+                data_.assign(first, last);
+            }
+        }
 };
 
 
@@ -27,6 +27,8 @@
 
 #include "holor.h"
 #include "holor_ref.h"
+#include "static_holor.h"
+#include "../operations/holor_simd.h"
 #include <concepts>
 #include <algorithm>
 #include <iostream>
@@ -34,17 +36,42 @@
 
 using namespace holor; 
 
+
+namespace holor{
+namespace impl{
+    /*!
+     * \brief Helper function that compares the elements of two containers with the same lengths. If both containers are contiguous, their elements are compared as flat sequences, otherwise they are compared with the iterators.
+     * \param h1 is the lhs in the comparison
+     * \param h2 is the rhs in the comparison
+     * \return true if the elements of the two containers are equal, false otherwise
+     */
+    template<FlatAccessibleHolor H1, FlatAccessibleHolor H2>
+    bool equal_elements(const H1& h1, const H2& h2){
+        if (h1.is_contiguous() && h2.is_contiguous()){
+            if constexpr(std::is_same_v<typename H1::value_type, typename H2::value_type> && simd::Vectorizable<typename H1::value_type>){
+                return simd::equal(h1.span().data(), h2.span().data(), h1.size());
+            } else{
+                return std::ranges::equal(h1.span(), h2.span());
+            }
+        }
+        return std::ranges::equal(h1.cbegin(), h1.cend(), h2.cbegin(), h2.cend());
+    }
+} //namespace impl
+} //namespace holor
+
+
 /*!
  * \brief Equality comparison between two Holor containers. Two Holor containers of the same dimension and type of elements are considered to be the same if they have the same layout and their elements have the same values.
  * \tparam `T` is the type of the elements in the containers. `T` must be a type that supports an equality comparison
  * \tparam `N` is the dimensionality of the Holor containers.
+ * \tparam `A1`, `A2` are the allocators of the Holor containers, that do not affect the comparison.
  * \param h1 is the lhs in the comparison
  * \param h2 is the rhs in the comparison
  * \return true if the two Holors are equal, false otherwise
  */
-template<typename T, size_t N> requires std::equality_comparable<T>
-bool operator==(const Holor<T,N>& h1, const Holor<T,N>& h2){
-    return ( (h1.layout()==h2.layout()) && std::ranges::equal(h1.cbegin(), h1.cend(), h2.cbegin(), h2.cend()) );
+template<typename T, size_t N, class A1, class A2> requires std::equality_comparable<T>
+bool operator==(const Holor<T,N,A1>& h1, const Holor<T,N,A2>& h2){
+    return ( (h1.layout()==h2.layout()) && holor::impl::equal_elements(h1, h2) );
 }
 
 
@@ -52,12 +79,13 @@ bool operator==(const Holor<T,N>& h1, const Holor<T,N>& h2){
  * \brief Inequality comparison between two Holor containers. Two Holor containers of the same dimension and type of elements are considered to be the same if they have the same layout and their elements have the same values.
  * \tparam `T` is the type of the elements in the containers. `T` must be a type that supports an equality comparison
  * \tparam `N` is the dimensionality of the Holor containers.
+ * \tparam `A1`, `A2` are the allocators of the Holor containers, that do not affect the comparison.
  * \param h1 is the lhs in the comparison
  * \param h2 is the rhs in the comparison
  * \return true if the two Holors are not equal, false otherwise
  */
-template<typename T, size_t N> requires std::equality_comparable<T>
-bool operator!=(const Holor<T,N>& h1, const Holor<T,N>& h2){
+template<typename T, size_t N, class A1, class A2> requires std::equality_comparable<T>
+bool operator!=(const Holor<T,N,A1>& h1, const Holor<T,N,A2>& h2){
     return !( h1==h2 );
 }
 
@@ -72,7 +100,7 @@ bool operator!=(const Holor<T,N>& h1, const Holor<T,N>& h2){
  */
 template<typename T, size_t N> requires std::equality_comparable<T>
 bool operator==(const HolorRef<T,N>& h1, const HolorRef<T,N>& h2){
-    return ( (h1.lengths()==h2.lengths()) && std::ranges::equal(h1.cbegin(), h1.cend(), h2.cbegin(), h2.cend()) );
+    return ( (h1.lengths()==h2.lengths()) && holor::impl::equal_elements(h1, h2) );
 }
 
 
@@ -98,9 +126,9 @@ bool operator!=(const HolorRef<T,N>& h1, const HolorRef<T,N>& h2){
  * \param h2 is the rhs in the comparison
  * \return true if the two containers are equal, false otherwise
  */
-template<typename T, size_t N> requires std::equality_comparable<T>
-bool operator==(const Holor<T,N>& h1, const HolorRef<T,N>& h2){
-    return ( (h1.lengths()==h2.lengths()) && std::ranges::equal(h1.cbegin(), h1.cend(), h2.cbegin(), h2.cend()) );
+template<typename T, size_t N, class A> requires std::equality_comparable<T>
+bool operator==(const Holor<T,N,A>& h1, const HolorRef<T,N>& h2){
+    return ( (h1.lengths()==h2.lengths()) && holor::impl::equal_elements(h1, h2) );
 }
 
 
@@ -113,8 +141,8 @@ bool operator==(const Holor<T,N>& h1, const HolorRef<T,N>& h2){
  * \param h2 is the rhs in the comparison
  * \return true if the two containes are not equal, false otherwise
  */
-template<typename T, size_t N> requires std::equality_comparable<T>
-bool operator!=(const Holor<T,N>& h1, const HolorRef<T,N>& h2){
+template<typename T, size_t N, class A> requires std::equality_comparable<T>
+bool operator!=(const Holor<T,N,A>& h1, const HolorRef<T,N>& h2){
     return !( h1==h2 );
 }
 
@@ -127,9 +155,9 @@ bool operator!=(const Holor<T,N>& h1, const HolorRef<T,N>& h2){
  * \param h2 is the rhs in the comparison
  * \return true if the two HolorsRefs are equal, false otherwise
  */
-template<typename T, size_t N> requires std::equality_comparable<T>
-bool operator==(const HolorRef<T,N>& h1, const Holor<T,N>& h2){
-    return ( (h1.lengths()==h2.lengths()) && std::ranges::equal(h1.cbegin(), h1.cend(), h2.cbegin(), h2.cend()) );
+template<typename T, size_t N, class A> requires std::equality_comparable<T>
+bool operator==(const HolorRef<T,N>& h1, const Holor<T,N,A>& h2){
+    return ( (h1.lengths()==h2.lengths()) && holor::impl::equal_elements(h1, h2) );
 }
 
 
@@ -141,8 +169,36 @@ bool operator==(const HolorRef<T,N>& h1, const Holor<T,N>& h2){
  * \param h2 is the rhs in the comparison
  * \return true if the two containers are not equal, false otherwise
  */
-template<typename T, size_t N> requires std::equality_comparable<T>
-bool operator!=(const HolorRef<T,N>& h1, const Holor<T,N>& h2){
+template<typename T, size_t N, class A> requires std::equality_comparable<T>
+bool operator!=(const HolorRef<T,N>& h1, const Holor<T,N,A>& h2){
+    return !( h1==h2 );
+}
+
+
+/*!
+ * \brief Equality comparison between two StaticHolor containers with the same type of elements and lengths. The containers are considered equal if their elements have the same values.
+ * \tparam `T` is the type of the elements in the containers. `T` must be a type that supports an equality comparison
+ * \tparam `Lengths` are the lengths of the containers.
+ * \param h1 is the lhs in the comparison
+ * \param h2 is the rhs in the comparison
+ * \return true if the two containers are equal, false otherwise
+ */
+template<typename T, size_t... Lengths> requires std::equality_comparable<T>
+constexpr bool operator==(const StaticHolor<T,Lengths...>& h1, const StaticHolor<T,Lengths...>& h2){
+    return std::ranges::equal(h1.span(), h2.span());
+}
+
+
+/*!
+ * \brief Inequality comparison between two StaticHolor containers with the same type of elements and lengths. The containers are considered equal if their elements have the same values.
+ * \tparam `T` is the type of the elements in the containers. `T` must be a type that supports an equality comparison
+ * \tparam `Lengths` are the lengths of the containers.
+ * \param h1 is the lhs in the comparison
+ * \param h2 is the rhs in the comparison
+ * \return true if the two containers are not equal, false otherwise
+ */
+template<typename T, size_t... Lengths> requires std::equality_comparable<T>
+constexpr bool operator!=(const StaticHolor<T,Lengths...>& h1, const StaticHolor<T,Lengths...>& h2){
     return !( h1==h2 );
 }
 
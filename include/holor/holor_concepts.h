@@ -43,6 +43,9 @@ namespace impl{
 
     struct HolorOwningTypeTag{};  ///<! \brief type that is used to tag a holor container that has ownership over its data (Holor)
     struct HolorNonOwningTypeTag{};  ///<! \brief type that is used to tag a holor container that does not have ownership over its data (HolorRef)
+    struct HolorStaticTypeTag{};  ///<! \brief type that is used to tag a holor container that has ownership over its data and whose lengths are fixed at compile time (StaticHolor)
+    struct HolorMappedTypeTag{};  ///<! \brief type that is used to tag a holor container whose elements are stored in a memory mapped file, and whose lengths are fixed by the file (MappedHolor)
+    struct HolorExpressionTag{};  ///<! \brief type that is used to tag a lazy expression of element-wise operations on holor containers
 
 
     /*!
@@ -50,7 +53,7 @@ namespace impl{
      */
     template<typename T>
     concept HolorWithDimensions = (T::dimensions > 0) && requires (T holor){
-        std::is_same<typename T::holor_type, impl::HolorOwningTypeTag>() || std::is_same<typename T::holor_type, impl::HolorNonOwningTypeTag>();
+        std::is_same<typename T::holor_type, impl::HolorOwningTypeTag>() || std::is_same<typename T::holor_type, impl::HolorNonOwningTypeTag>() || std::is_same<typename T::holor_type, impl::HolorStaticTypeTag>() || std::is_same<typename T::holor_type, impl::HolorMappedTypeTag>();
     };
 
     /*!
@@ -134,12 +137,22 @@ namespace impl{
      * \brief Constraints Layouts to have a resizeable lengths
      */
     template<typename T>
-    concept ResizeableHolor = std::is_same_v<typename T::holor_type, impl::HolorNonOwningTypeTag> || requires (T holor){
+    concept ResizeableHolor = std::is_same_v<typename T::holor_type, impl::HolorNonOwningTypeTag> || std::is_same_v<typename T::holor_type, impl::HolorStaticTypeTag> || std::is_same_v<typename T::holor_type, impl::HolorMappedTypeTag> || requires (T holor){
         impl::holor_variadic_set_lengths(holor, std::make_index_sequence<T::dimensions>{});
         holor.set_lengths(std::array<size_t, T::dimensions>());
         holor.set_lengths(std::vector<size_t>());
     };
 
+
+    /*!
+     * \brief Constraints Holor Containers to provide a flat access to their elements when these are stored contiguously in memory
+     */
+    template<typename T>
+    concept FlatAccessibleHolor = requires (T holor){
+        {holor.is_contiguous()}->std::same_as<bool>;
+        holor.span();
+    };
+
 }
 
 
@@ -155,6 +168,16 @@ concept HolorType = impl::HolorWithDimensions<T> && impl::IterableHolor<T> && im
 template<typename T>
 concept DecaysToHolorType = HolorType<std::decay_t<T>>;
 
+
+/*!
+ * \brief Constraints a type to be a lazy expression of element-wise operations on holor containers, that can be evaluated into a Holor or a HolorRef (see holor_expressions.h)
+ */
+template<typename T>
+concept HolorExpression = std::is_same_v<typename T::expression_type, impl::HolorExpressionTag> && (T::dimensions > 0) && requires (T expression){
+    typename T::value_type;
+    {expression.lengths()}->std::same_as<std::array<size_t,T::dimensions>>;
+};
+
 } //namespace holor
 
 #endif // HOLOR_TYPES_H
\ No newline at end of file
@@ -25,8 +25,12 @@
 #define HOLOR_FULL_H
 
 #include "holor.h"
+#include "static_holor.h"
 #include "holor_comparisons.h"
 #include "holor_printer.h"
 #include "../operations/holor_operations.h"
+#include "../operations/holor_expressions.h"
+#include "../operations/holor_contraction.h"
+#include "../operations/holor_reductions.h"
 
 #endif // HOLOR_FULL_H
\ No newline at end of file
@@ -27,6 +27,7 @@
 
 #include "holor.h"
 #include "holor_ref.h"
+#include "static_holor.h"
 #include "../common/static_assertions.h"
 
 #include <iostream>
@@ -76,8 +77,8 @@ namespace impl{
  * \param h is the container to be printed
  * \return a reference to the ostream
  */
-template<typename T, size_t N> requires (assert::Printable<T>)
-std::ostream& operator<<(std::ostream& os, const Holor<T,N>& h){
+template<typename T, size_t N, class A> requires (assert::Printable<T>)
+std::ostream& operator<<(std::ostream& os, const Holor<T,N,A>& h){
     return impl::holor_printer<std::remove_cvref_t<decltype(h)>>()(os, h);
 }
 
@@ -96,6 +97,21 @@ std::ostream& operator<<(std::ostream& os, const HolorRef<T,N>& h){
     return impl::holor_printer<std::remove_cvref_t<decltype(h)>>()(os, h);
 }
 
+
+/*!
+ * \brief operator to print the content of a StaticHolor on a ostream
+ * \tparam `T` is the type of the data contained in the StaticHolor.
+ * \b Note: `T` is required to be a printable data type
+ * \tparam `Lengths` are the lengths of the container
+ * \param os is the reference to the ostream
+ * \param h is container to be printed
+ * \return a reference to the ostream
+ */
+template<typename T, size_t... Lengths> requires (assert::Printable<T>)
+std::ostream& operator<<(std::ostream& os, const StaticHolor<T,Lengths...>& h){
+    return impl::holor_printer<std::remove_cvref_t<decltype(h)>>()(os, h);
+}
+
 } //namespace holor
 
 #endif // HOLOR_PRINTER_H
\ No newline at end of file
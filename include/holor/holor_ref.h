@@ -27,8 +27,11 @@
 
 #include <cstddef>
 #include <vector>
+#include <span>
+#include <algorithm>
 
 #include "../layout/layout.h"
+#include "../layout/layout_traversal.h"
 #include "holor_concepts.h"
 #include "../common/static_assertions.h"
 
@@ -73,7 +76,7 @@ class HolorRef{
             public:
                 using iterator_category = std::random_access_iterator_tag;
                 using difference_type = std::ptrdiff_t;
-                using value_type = T;
+                using value_type = std::remove_cv_t<T>;
                 using pointer = typename assert::choose<IsConst, const T*, T*>::type;
                 using reference = typename assert::choose<IsConst, const T&, T&>::type;
                 using holor_pointer = typename assert::choose<IsConst, const HolorRef<T,N>*, HolorRef<T,N>*>::type;
@@ -96,11 +99,7 @@ class HolorRef{
                 explicit Iterator(holor_pointer holor, end_iterator_tag){
                     start_ptr_ = holor->dataptr_;
                     layout_ptr_ = &(holor->layout_);
-                    for (auto cnt = 0; cnt < (N-1) ; cnt++){
-                        coordinates_[cnt] = layout_ptr_->length(cnt) - 1;
-                    }
-                    coordinates_[N-1] = layout_ptr_->length(N-1); //one element past the last in the container
-                    iter_ptr_ = start_ptr_ + layout_ptr_->operator()(coordinates_); 
+                    set_end();
                     compute_iterator_strides();
                 }
 
@@ -131,7 +130,7 @@ class HolorRef{
 
                 //! \brief offset dereference operator
                 reference operator[](difference_type n) const {
-                    return *((this + n)->iter_ptr_);
+                    return *(*this + n);
                 } 
 
                 /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
@@ -140,7 +139,6 @@ class HolorRef{
                 //! \brief prefix ++
                 Iterator& operator++(){
                     step_forward<N-1>();
-                    iter_ptr_ = start_ptr_ + layout_ptr_->operator()(coordinates_);
                     return *this;
                 }
 
@@ -153,8 +151,11 @@ class HolorRef{
 
                 //! \brief prefix --
                 Iterator& operator--(){
-                    step_back<N-1>();
-                    iter_ptr_ = start_ptr_ + layout_ptr_->operator()(coordinates_);
+                    if (is_end()){
+                        move_to(static_cast<difference_type>(layout_ptr_->size()) - 1);
+                    } else{
+                        step_back<N-1>();
+                    }
                     return *this;
                 }
 
@@ -165,21 +166,15 @@ class HolorRef{
                     return retval;
                 }
 
-                //! \brief advances the iterator by n positions
+                //! \brief advances the iterator by n positions in constant time
                 Iterator& operator+=(difference_type n){
-                    for (auto cnt = 0; cnt < n; cnt++){
-                        step_forward<N-1>();
-                    }
-                    iter_ptr_ = start_ptr_ + layout_ptr_->operator()(coordinates_);
+                    move_to(position() + n);
                     return *this;
                 }
                 
-                //! \brief decreases the iterator by n positions
+                //! \brief decreases the iterator by n positions in constant time
                 Iterator& operator-=(difference_type n){
-                    for (auto cnt = 0; cnt < n; cnt++){
-                        step_back<N-1>();
-                    }
-                    iter_ptr_ = start_ptr_ + layout_ptr_->operator()(coordinates_);
+                    move_to(position() - n);
                     return *this;
                 }
 
@@ -206,28 +201,26 @@ class HolorRef{
 
                 //! \brief given two iterators a and b, it implements the difference a - b
                 friend difference_type operator-(const Iterator& a, const Iterator&b) {
-                    difference_type result = 0;
-                    for (auto cnt = 0; cnt<N; cnt++){
-                        result += a.coordinates_[cnt]*a.iterator_strides_[cnt] - b.coordinates_[cnt]*b.iterator_strides_[cnt];
-                    }
-                    return result;
+                    return a.position() - b.position();
                 }
 
                 /*~~~~~~~~~~~~~~~~~~~~~~~~
                 equality operators
                 ~~~~~~~~~~~~~~~~~~~~~~~*/
-                //! \brief equality operations to compare two iterators. For example, needed to test iter == end()
+                //! \brief equality operations to compare two iterators. For example, needed to test iter == end(). The iterators are compared by their position, because different positions can address the same element (e.g., along a dimension with zero stride)
                 bool operator==(const Iterator& rhs) const{
-                    return iter_ptr_ == rhs.iter_ptr_;
+                    return position() == rhs.position();
                 }  
 
                 //! \brief equality operations to compare two iterators. For example, needed to test iter != end()
                 bool operator!=(const Iterator& rhs) const{
-                    return iter_ptr_ != rhs.iter_ptr_;
+                    return position() != rhs.position();
                 }
 
-                //! \brief defualt three-way comparison operator
-                friend auto operator<=>(Iterator, Iterator) = default;
+                //! \brief three-way comparison operator, which orders the iterators by their position in the container
+                friend auto operator<=>(const Iterator& a, const Iterator& b){
+                    return a.position() <=> b.position();
+                }
 
 
             private:
@@ -250,48 +243,87 @@ class HolorRef{
                 }
 
 
-                //! \brief helper function to implement the ++ operator
+                /*!
+                * \brief Sets the coordinates to one past the last element of the container, which is the position of the end iterator.
+                * The end iterator is not dereferenceable, so its pointer is set to the first element of the view rather than computed from the coordinates, which are out of range and could give a pointer outside the buffer (e.g., before its beginning if the innermost dimension is reversed)
+                */
+                void set_end(){
+                    for (auto cnt = 0; cnt < (N-1) ; cnt++){
+                        coordinates_[cnt] = layout_ptr_->length(cnt) - 1;
+                    }
+                    coordinates_[N-1] = layout_ptr_->length(N-1);
+                    iter_ptr_ = start_ptr_ + layout_ptr_->offset();
+                }
+
+                /*!
+                * \brief Verifies if the iterator is at the end of the container
+                */
+                bool is_end() const{
+                    return coordinates_[N-1] == static_cast<difference_type>(layout_ptr_->length(N-1));
+                }
+
+                /*!
+                * \brief Computes the position of the iterator, i.e., the number of increments needed to reach it from the beginning of the container
+                */
+                difference_type position() const{
+                    difference_type result = 0;
+                    for (auto cnt = 0; cnt<N; cnt++){
+                        result += coordinates_[cnt]*iterator_strides_[cnt];
+                    }
+                    return result;
+                }
+
+                /*!
+                * \brief Moves the iterator to a position in the container, decomposing it into coordinates with the iterator strides. Positions before the beginning or after the end of the container are saturated, consistently with the ++ and -- operators.
+                * \param pos the position, i.e., the number of increments from the beginning of the container
+                */
+                void move_to(difference_type pos){
+                    if (pos <= 0){
+                        coordinates_.fill(0);
+                    } else if (pos >= static_cast<difference_type>(layout_ptr_->size())){
+                        set_end();
+                        return;
+                    } else{
+                        for (auto cnt = 0; cnt<N; cnt++){
+                            coordinates_[cnt] = pos / static_cast<difference_type>(iterator_strides_[cnt]);
+                            pos %= static_cast<difference_type>(iterator_strides_[cnt]);
+                        }
+                    }
+                    iter_ptr_ = start_ptr_ + layout_ptr_->operator()(coordinates_);
+                }
+
+                /*!
+                * \brief helper function to implement the ++ operator. It works like an odometer: the pointer is moved by the stride of the dimension `Coord`, and only when this dimension rolls over the pointer is moved back to its first element and the carry is propagated to the previous dimension.
+                */
                 template<size_t Coord>
                 void step_forward(){
                     if ( coordinates_[Coord] < (layout_ptr_->length(Coord) -1) ){
                         coordinates_[Coord] += 1;
-                    } else{
+                        iter_ptr_ += layout_ptr_->stride(Coord);
+                    } else if constexpr (Coord > 0){
+                        iter_ptr_ -= static_cast<std::ptrdiff_t>(coordinates_[Coord])*layout_ptr_->stride(Coord);
                         coordinates_[Coord] = 0;
                         step_forward<Coord-1>();
-                    }
-                }
-
-                template<>
-                void step_forward<0>(){
-                    if ( coordinates_[0] < (layout_ptr_->length(0) -1) ){
-                        coordinates_[0] += 1;
                     } else{ //end of the container
-                        for (auto cnt = 0; cnt < (N-1) ; cnt++){
-                            coordinates_[cnt] = layout_ptr_->length(cnt) -1;
-                        }
-                        coordinates_[N-1] = layout_ptr_->length(N-1); //coordinates to one past the last element of the container
+                        set_end();
                     }
                 }
 
-                //! \brief helper function to implement the -- operator
+                /*!
+                * \brief helper function to implement the -- operator. It works like the `step_forward` function, but backwards.
+                */
                 template<size_t Coord>
                 void step_back(){
                     if ( coordinates_[Coord] > 0 ){
                         coordinates_[Coord] -= 1;
-                    } else{
+                        iter_ptr_ -= layout_ptr_->stride(Coord);
+                    } else if constexpr (Coord > 0){
                         coordinates_[Coord] = layout_ptr_->length(Coord) -1;
+                        iter_ptr_ += static_cast<std::ptrdiff_t>(coordinates_[Coord])*layout_ptr_->stride(Coord);
                         step_back<Coord-1>();
-                    }
-                }
-
-                template<>
-                void step_back<0>(){
-                    if ( coordinates_[0] > 0 ){
-                        coordinates_[0] -= 1;
                     } else{ //beginning of the container
-                        for (auto& coord : coordinates_){
-                            coord = 0;
-                        }
+                        coordinates_.fill(0);
+                        iter_ptr_ = start_ptr_ + layout_ptr_->offset();
                     }
                 }
         };
@@ -306,7 +338,7 @@ class HolorRef{
                                     ALIASES
         ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
         static constexpr size_t dimensions = N;                                 ///< \brief number of dimensions in the container 
-        using value_type = T;                                                   ///< \brief type of the values in the container
+        using value_type = std::remove_cv_t<T>;                                  ///< \brief type of the values in the container. A HolorRef<const T, N> is a read-only view of elements of type `T`
         using iterator = typename HolorRef<T,N>::Iterator<false>;               ///< \brief type of the iterator for the container
         using const_iterator = typename HolorRef<T,N>::Iterator<true>;          ///< \brief type of the const_iterator for the container
         using reverse_iterator = std::reverse_iterator<iterator>;               ///< \brief type of the reverse_iterator for the container
@@ -344,6 +376,18 @@ class HolorRef{
         template <class Container> requires assert::RSTypedContainer<Container, size_t, N>
         explicit HolorRef(T* dataptr, const Container& lengths): layout_{lengths}, dataptr_{dataptr}{}       
 
+        /*!
+         * \brief Assignment from a lazy expression of element-wise operations (see holor_expressions.h), that writes the values of the expression into the referenced elements
+         * \param expression the expression. The referenced elements can appear in the expression only in positions that access the element being written
+         * \exception holor::exception::HolorRuntimeError if the lengths of the expression are different from those of the HolorRef. The compiler flag DDEFINE_ASSERT_LEVEL in the CMakeLists can be set to AssertionLevel::no_checks to exclude this check.
+         * \return a reference to this HolorRef
+         */
+        template<HolorExpression E> requires ((E::dimensions == N) && std::convertible_to<typename E::value_type, T>)
+        HolorRef& operator=(const E& expression){
+            expression.evaluate_into(dataptr_, layout_);
+            return *this;
+        }
+
         /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
                             GET/SET FUNCTIONS
         ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
@@ -392,6 +436,29 @@ class HolorRef{
             return dataptr_;
         }
 
+        /*!
+         * \brief Verify if the elements of the container are stored contiguously in memory, so that they can be accessed as a flat sequence
+         * \return true if the container is contiguous, false otherwise
+         */
+        bool is_contiguous() const{
+            return layout_.is_contiguous();
+        }
+
+        /*!
+         * \brief Get a flat view of the elements of the container, in the same order in which they are iterated. This function requires the container to be contiguous.
+         * \exception holor::exception::HolorRuntimeError if the container is not contiguous. The compiler flag DDEFINE_ASSERT_LEVEL in the CMakeLists can be set to AssertionLevel::no_checks to exclude this check.
+         * \return a `std::span` over the elements of the container
+         */
+        std::span<T> span(){
+            assert::dynamic_assert(is_contiguous(), EXCEPTION_MESSAGE("holor::HolorRef - The container is not contiguous."));
+            return std::span<T>(dataptr_ + layout_.offset(), layout_.size());
+        }
+
+        std::span<const T> span() const{
+            assert::dynamic_assert(is_contiguous(), EXCEPTION_MESSAGE("holor::HolorRef - The container is not contiguous."));
+            return std::span<const T>(dataptr_ + layout_.offset(), layout_.size());
+        }
+
 
         /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
                             ITERATORS
@@ -528,7 +595,7 @@ class HolorRef{
      */
     void substitute(const HolorRef<T,N>& rhs){
         assert::dynamic_assert(this->layout_.lengths() == rhs.lengths(), EXCEPTION_MESSAGE("Incompatible dimensions."));
-        std::copy(rhs.cbegin(), rhs.cend(), this->begin());
+        copy_from(rhs);
     }
 
     /*!
@@ -539,13 +606,23 @@ class HolorRef{
     template<HolorType HolorContainer> requires ( (HolorContainer::dimensions == N) && (std::is_same_v<typename HolorContainer::value_type, T>) )
     void substitute(const HolorContainer& rhs){
         assert::dynamic_assert(this->layout_.lengths() == rhs.lengths(), EXCEPTION_MESSAGE("Incompatible dimensions."));
-        std::copy(rhs.cbegin(), rhs.cend(), this->begin());
+        copy_from(rhs);
     }
 
     template<HolorType HolorContainer> requires ( (HolorContainer::dimensions == N) && (std::is_same_v<typename HolorContainer::value_type, T>) )
     void substitute(HolorContainer&& rhs){
         assert::dynamic_assert(this->layout_.lengths() == rhs.lengths(), EXCEPTION_MESSAGE("Incompatible dimensions."));
-        std::move(rhs.begin(), rhs.end(), this->begin());
+        if constexpr(impl::FlatAccessibleHolor<HolorContainer>){
+            if (is_contiguous() && rhs.is_contiguous()){
+                std::ranges::move(rhs.span(), span().begin());
+                return;
+            }
+        }
+        auto dest = dataptr_;
+        auto source = rhs.data();
+        impl::for_each_index(impl::normalize_layouts(layout_, rhs.layout()), [dest, source](size_t i, size_t j){
+            dest[i] = std::move(source[j]);
+        });
     }
 
 
@@ -556,6 +633,26 @@ private:
         Layout<N> layout_;  ///< \brief The Layout of how the elements of the container are stored in memory
         T* dataptr_;        ///< \brief Pointer to the memory location where the data is stored
 
+
+        /*!
+         * \brief Copies the elements of another container with the same lengths. If both containers are contiguous, the elements are copied as flat sequences, otherwise the layouts of the two containers are normalized and traversed jointly.
+         * \param rhs container from where the values are copied
+         */
+        template<class HolorContainer>
+        void copy_from(const HolorContainer& rhs){
+            if constexpr(impl::FlatAccessibleHolor<HolorContainer>){
+                if (is_contiguous() && rhs.is_contiguous()){
+                    std::ranges::copy(rhs.span(), span().begin());
+                    return;
+                }
+            }
+            auto dest = dataptr_;
+            auto source = rhs.data();
+            impl::for_each_index(impl::normalize_layouts(layout_, rhs.layout()), [dest, source](size_t i, size_t j){
+                dest[i] = source[j];
+            });
+        }
+
 };
 
 
@@ -0,0 +1,354 @@
+// This file is part of Holor, a C++ header-only template library for multi-dimensional containers
+
+// Copyright 2020-2022 Carlo Masone
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to 
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is 
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER 
+// DEALINGS IN THE SOFTWARE.
+
+
+
+#ifndef HOLOR_STATIC_HOLOR_H
+#define HOLOR_STATIC_HOLOR_H
+
+#include <cstddef>
+#include <array>
+#include <span>
+#include <algorithm>
+
+#include "holor_ref.h"
+#include "holor_concepts.h"
+#include "../layout/static_layout.h"
+#include "../layout/layout_traversal.h"
+#include "initializer.h"
+
+
+namespace holor{
+
+namespace impl{
+    /*!
+     * \brief Helper that is used to write the elements of a nested list into the fixed-size storage of a StaticHolor. It exposes the subset of the interface of a `std::vector` that is used by `impl::insert_flat`.
+     */
+    template<typename T>
+    struct FlatArrayWriter{
+        T* cursor_; ///< \brief position where the next element is written
+
+        T* end(){
+            return cursor_;
+        }
+
+        template<typename Iter>
+        void insert(T*, Iter first, Iter last){
+            cursor_ = std::copy(first, last, cursor_);
+        }
+    };
+}
+
+
+/*================================================================================================
+                                    STATIC HOLOR CLASS
+================================================================================================*/
+/*!
+ * \brief Class that represents a multi-dimensional container whose lengths are known at compile time.
+ *
+ * A StaticHolor owns its elements like a Holor, but it stores them in a `std::array` and it uses a StaticLayout, so that it does not allocate memory and
+ * the computation of the position of an element from its indices can be folded by the compiler. It is meant for small tensors with fixed shapes (e.g., 3x3 or 4x4 matrices).
+ * The lengths of a StaticHolor cannot be changed. Its slices are HolorRef objects with dynamic layouts.
+ *
+ * \tparam T type of the elements stored in the container
+ * \tparam Lengths number of elements along each dimension of the container
+ */
+template<typename T, size_t... Lengths> requires ( (sizeof...(Lengths) > 0) && ((Lengths > 0) && ...) )
+class StaticHolor{
+    static constexpr size_t N = sizeof...(Lengths);
+    using static_layout = StaticLayout<Lengths...>;
+
+    public:
+        /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+                                    ALIASES
+        ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+        static constexpr size_t dimensions = N;                                                                 ///< \brief number of dimensions in the container 
+        using value_type = T;                                                                                   ///< \brief type of the values in the container
+        using iterator = typename std::array<T, static_layout::size()>::iterator;                               ///< \brief type of the iterator for the container
+        using const_iterator = typename std::array<T, static_layout::size()>::const_iterator;                   ///< \brief type of the const_iterator for the container
+        using reverse_iterator = typename std::array<T, static_layout::size()>::reverse_iterator;               ///< \brief type of the reverse_iterator for the container
+        using const_reverse_iterator = typename std::array<T, static_layout::size()>::const_reverse_iterator;   ///< \brief type of the const_reverse_iterator for the container
+        using holor_type = holor::impl::HolorStaticTypeTag;                                                     ///< \brief tags a Holor type with ownership over its data and lengths fixed at compile time
+
+
+        /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+                CONSTRUCTORS, ASSIGNMENTS AND DESTRUCTOR
+        ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+        constexpr StaticHolor() = default;                                          ///< \brief default constructor. The elements are value initialized, i.e. arithmetic types are set to zero
+        constexpr StaticHolor(StaticHolor&& holor) = default;                       ///< \brief default move constructor
+        constexpr StaticHolor(const StaticHolor& holor) = default;                  ///< \brief default copy constructor
+        constexpr StaticHolor& operator=(StaticHolor&& holor) = default;            ///< \brief default move assignment
+        constexpr StaticHolor& operator=(const StaticHolor& holor) = default;       ///< \brief default copy assignment
+        ~StaticHolor() = default;                                                   ///< \brief default destructor
+
+        /*!
+         * \brief Constructor from a nested list of elements
+         * \param init nested list of the elements to be inserted in the container
+         * \exception holor::exception::HolorRuntimeError if the lengths of the nested list do not match the lengths of the container. The compiler flag DDEFINE_ASSERT_LEVEL in the CMakeLists can be set to AssertionLevel::no_checks to exclude this check.
+         * \return a StaticHolor containing the elements in the list
+         */
+        StaticHolor(holor::nested_list<T,N> init){
+            *this = init;
+        }
+
+        /*!
+         * \brief Assignment from a nested list of elements
+         * \param init nested list of the elements to be inserted in the container
+         * \exception holor::exception::HolorRuntimeError if the lengths of the nested list do not match the lengths of the container. The compiler flag DDEFINE_ASSERT_LEVEL in the CMakeLists can be set to AssertionLevel::no_checks to exclude this check.
+         * \return a StaticHolor containing the elements in the list
+         */
+        StaticHolor& operator=(holor::nested_list<T,N> init){
+            assert::dynamic_assert(impl::derive_lengths<N>(init) == static_layout::lengths(), EXCEPTION_MESSAGE("The lengths of the list do not match the lengths of the StaticHolor."));
+            impl::FlatArrayWriter<T> writer{data_.data()};
+            impl::insert_flat(init, writer);
+            return *this;
+        }
+
+        /*!
+         * \brief Constructor from another Holor container (e.g., a Holor or a HolorRef) with the same lengths
+         * \param other the container from where the elements are copied
+         * \exception holor::exception::HolorRuntimeError if the lengths of the containers do not match. The compiler flag DDEFINE_ASSERT_LEVEL in the CMakeLists can be set to AssertionLevel::no_checks to exclude this check.
+         * \return a StaticHolor with a copy of the elements of `other`
+         */
+        template<typename Other> requires ( !std::same_as<Other, StaticHolor> && HolorType<Other> && (Other::dimensions == N) && std::convertible_to<typename Other::value_type, T> )
+        explicit StaticHolor(const Other& other){
+            assert::dynamic_assert(other.lengths() == static_layout::lengths(), EXCEPTION_MESSAGE("Incompatible dimensions."));
+            auto dest = data_.data();
+            auto source = other.data();
+            impl::for_each_index(impl::normalize_layouts(layout(), other.layout()), [dest, source](size_t i, size_t j){
+                dest[i] = static_cast<T>(source[j]);
+            });
+        }
+
+
+        /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+                                ITERATORS
+        ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+        constexpr auto begin(){ return data_.begin(); } ///< \brief returns an iterator to the beginning
+        constexpr auto end(){ return data_.end(); } ///< \brief returns an iterator to the end
+        constexpr auto begin() const{ return data_.begin(); } ///< \brief returns a constant iterator to the beginning
+        constexpr auto end() const{ return data_.end(); } ///< \brief returns a constant iterator to the end
+        constexpr auto cbegin() const{ return data_.cbegin(); } ///< \brief returns a constant iterator to the beginning
+        constexpr auto cend() const{ return data_.cend(); } ///< \brief returns a constant iterator to the end
+        constexpr auto rbegin(){ return data_.rbegin(); } ///< \brief returns a reverse iterator to the beginning
+        constexpr auto rend(){ return data_.rend(); } ///< \brief returns a reverse iterator to the end
+        constexpr auto crbegin() const{ return data_.crbegin(); } ///< \brief returns a constant reverse iterator to the beginning
+        constexpr auto crend() const{ return data_.crend(); } ///< \brief returns a constant reverse iterator to the end
+
+
+        /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+                                GET/SET FUNCTIONS
+        ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+        /*!
+         * \brief Get the dynamic Layout equivalent to the static layout of the container
+         * \return the layout of the container
+         */
+        Layout<N> layout() const{
+            return static_layout::layout();
+        }
+
+        /*!
+         * \brief Get the lengths of the container
+         * \return the number of elements along each dimension
+         */
+        static constexpr std::array<size_t,N> lengths(){
+            return static_layout::lengths();
+        }
+
+        /*!
+         * \brief Get the strides of the container
+         * \return the strides of the container
+         */
+        static constexpr std::array<std::ptrdiff_t,N> strides(){
+            return static_layout::strides();
+        }
+
+        /*!
+         * \brief Get the length of a dimension of the container
+         * \param dim the dimension
+         * \return the number of elements along the dimension
+         */
+        static constexpr size_t length(size_t dim){
+            return static_layout::length(dim);
+        }
+
+        /*!
+         * \brief Get the total number of elements in the container
+         * \return the size of the container
+         */
+        static constexpr size_t size(){
+            return static_layout::size();
+        }
+
+        /*!
+         * \brief Get the pointer to the data of the container
+         * \return the pointer to the data
+         */
+        constexpr T* data(){
+            return data_.data();
+        }
+
+        constexpr const T* data() const{
+            return data_.data();
+        }
+
+        /*!
+         * \brief The elements of a StaticHolor are always stored contiguously in memory
+         * \return true
+         */
+        static constexpr bool is_contiguous(){
+            return true;
+        }
+
+        /*!
+         * \brief Get a span with static extent over the elements of the container
+         * \return the span over the elements of the container
+         */
+        constexpr std::span<T, static_layout::size()> span(){
+            return std::span<T, static_layout::size()>(data_);
+        }
+
+        constexpr std::span<const T, static_layout::size()> span() const{
+            return std::span<const T, static_layout::size()>(data_);
+        }
+
+
+        /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+                            INDEXING AND SLICING
+        ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+        /*!
+         * \brief Access a single element in the container
+         * \param dims pack of indices, one per dimension of the container
+         * \return the element stored at the position indexed by the indices
+         */
+        template<SingleIndex... Dims> requires ((sizeof...(Dims)==N) )
+        constexpr T& operator()(Dims&&... dims){
+            return data_[static_layout{}(std::forward<Dims>(dims)...)];
+        }
+
+        template<SingleIndex... Dims> requires ((sizeof...(Dims)==N) )
+        constexpr const T& operator()(Dims&&... dims) const{
+            return data_[static_layout{}(std::forward<Dims>(dims)...)];
+        }
+
+        /*!
+         * \brief Access a single element in the container
+         * \param indices Container of indices, one per dimension of the container
+         * \return the element stored at the position indexed by the indices
+         */
+        template <class Container> requires (assert::RSContainer<Container, N> && SingleIndex<typename Container::value_type>)
+        constexpr T& operator()(const Container& indices){
+            return data_[static_layout{}(indices)];
+        }
+
+        template <class Container> requires (assert::RSContainer<Container, N> && SingleIndex<typename Container::value_type>)
+        constexpr const T& operator()(const Container& indices) const{
+            return data_[static_layout{}(indices)];
+        }
+
+        /*!
+         * \brief Access a slice of the container by providing a single index or a range of indices for each dimension
+         * \param args pack of indices, one per dimension of the container
+         * \return a HolorRef to the slice
+         */
+        template<typename... Args> requires (impl::ranged_index_pack<Args...>() && (sizeof...(Args)==N) )
+        auto operator()(Args&&... args){
+            auto sliced_layout = static_layout{}(std::forward<Args>(args)...);
+            return HolorRef<T, decltype(sliced_layout)::order>(data_.data(), sliced_layout);
+        }
+
+        template<typename... Args> requires (impl::ranged_index_pack<Args...>() && (sizeof...(Args)==N) )
+        auto operator()(Args&&... args) const{
+            auto sliced_layout = static_layout{}(std::forward<Args>(args)...);
+            return HolorRef<const T, decltype(sliced_layout)::order>(data_.data(), sliced_layout);
+        }
+
+        /*!
+         * \brief Access the `i-th` row of the container
+         * \param i index of the row
+         * \return a HolorRef to the row
+         */
+        auto row(size_t i){
+            return HolorRef<T, N-1>(data_.data(), static_layout{}.template slice_dimension<0>(i));
+        }
+
+        auto row(size_t i) const{
+            return HolorRef<const T, N-1>(data_.data(), static_layout{}.template slice_dimension<0>(i));
+        }
+
+        /*!
+         * \brief Access the `i-th` column of the container
+         * \param i index of the column
+         * \return a HolorRef to the column
+         */
+        auto col(size_t i){
+            return HolorRef<T, N-1>(data_.data(), static_layout{}.template slice_dimension<1>(i));
+        }
+
+        auto col(size_t i) const{
+            return HolorRef<const T, N-1>(data_.data(), static_layout{}.template slice_dimension<1>(i));
+        }
+
+        /*!
+         * \brief Access the `i-th` slice of a single dimension (e.g., the fifth row or the second column)
+         * \tparam M is the dimension to be sliced. 0 is a row, 1 is a column, ...
+         * \param i index of the slice along the `M-th` dimension
+         * \return a HolorRef to the slice
+         */
+        template<size_t M> requires (M<N)
+        auto slice(size_t i){
+            return HolorRef<T, N-1>(data_.data(), static_layout{}.template slice_dimension<M>(i));
+        }
+
+        template<size_t M> requires (M<N)
+        auto slice(size_t i) const{
+            return HolorRef<const T, N-1>(data_.data(), static_layout{}.template slice_dimension<M>(i));
+        }
+
+        /*!
+         * \brief Slice the container along a dimension selecting a range of components from said dimension
+         * \tparam M is the dimension to be sliced. 0 is a row, 1 is a column, ...
+         * \param range_slice is the range of indices to be taken along the `M-th` dimension
+         * \return a HolorRef to the slice
+         */
+        template<size_t M> requires (M<N)
+        auto slice(range range_slice){
+            return HolorRef<T, N>(data_.data(), static_layout{}.template slice_dimension<M>(range_slice));
+        }
+
+        template<size_t M> requires (M<N)
+        auto slice(range range_slice) const{
+            return HolorRef<const T, N>(data_.data(), static_layout{}.template slice_dimension<M>(range_slice));
+        }
+
+
+    /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+                        PRIVATE MEMBERS AND FUNCTIONS
+    ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+    private:
+        std::array<T, static_layout::size()> data_{};   ///< \brief Array storing the actual data
+};
+
+
+} //namespace holor
+
+#endif // HOLOR_STATIC_HOLOR_H
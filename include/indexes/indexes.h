@@ -39,11 +39,11 @@ namespace holor{
  * \brief Structure that represents a range of indexes to slice a Holor container. 
  * \b Example: Assume to have a 1D Holor container of size 7. To select the slice that takes the elements from the second to the fourth, we 
  * can index the holor using `range{1, 3}` to create the slice.
- * \b Note: `range{1, 5, 1}` is equivalent to `1:5` in Matlab. `range{1, 5, 2}` yields the indexes `1, 3, 5`.
+ * \b Note: `range{1, 5, 1}` is equivalent to `1:5` in Matlab. `range{1, 5, 2}` yields the indexes `1, 3, 5`, while `range{5, 0, -2}` yields the indexes `5, 3, 1`.
  */
 struct range{
     size_t start_;  /*! beginning of the range */
-    size_t end_;    /*! end of the range (this element is included in the range) */
+    size_t end_;    /*! end of the range (this element is included in the range if it is reached with the given step) */
     int step_;      /*! number of steps between elements. \b Example: step = +1, the elements in the range are contiguous and iterated in a positive direction; step = -2, the range skips every other element, moving in a negative direction. */
 
     /*!
@@ -51,13 +51,27 @@ struct range{
      * \param start beginning of the range
      * \param end end (last element) of the range
      * \param step step between two elements in the range. Defaults to 1.
-     * \exception holor::exception::HolorRuntimeError if the arguments for the constructor do not implement a meaningful range of indices, i.e., if they do not satisfy `(start>=0) && (end>start) && (step>0)`. The compiler flag DDEFINE_ASSERT_LEVEL in the CMakeLists can be set to AssertionLevel::no_checks to exclude this check.
+     * \exception holor::exception::HolorRuntimeError if the arguments for the constructor do not implement a meaningful range of indices, i.e., if they do not satisfy `(step>0) && (end>start)` or `(step<0) && (end<start)`. The compiler flag DDEFINE_ASSERT_LEVEL in the CMakeLists can be set to AssertionLevel::no_checks to exclude this check.
      */
     range(size_t start, size_t end, int step=1): start_{start}, end_{end}, step_{step}{
-        assert::dynamic_assert( (start>=0) && (end>=0) && (start!=end), EXCEPTION_MESSAGE("Invalid range!"));
-        assert::dynamic_assert( (end>start), EXCEPTION_MESSAGE("Invalid range!")); //TODO: right now let's only allow ranges in increasing order. This has to be removd to allow ranges in reverse order
-        assert::dynamic_assert( (start>=0) && (end>=0) && (start!=end), EXCEPTION_MESSAGE("Invalid range!")); //TODO: right now let's only allow +1 as step. This has to be removed to allow other steps
-    }        
+        assert::dynamic_assert( ((step>0) && (end>start)) || ((step<0) && (end<start)), EXCEPTION_MESSAGE("Invalid range!"));
+    }
+
+    /*!
+     * \brief Get the number of indices in the range
+     * \return the number of indices in the range
+     */
+    size_t length() const{
+        return (step_ > 0) ? (end_-start_)/static_cast<size_t>(step_) + 1 : (start_-end_)/static_cast<size_t>(-step_) + 1;
+    }
+
+    /*!
+     * \brief Get the last index of the range, i.e., the last index that is reached from `start_` with steps of `step_` without going past `end_`
+     * \return the last index of the range
+     */
+    size_t last() const{
+        return (step_ > 0) ? start_ + (length()-1)*static_cast<size_t>(step_) : start_ - (length()-1)*static_cast<size_t>(-step_);
+    }
 };
 
 
@@ -0,0 +1,789 @@
+// This file is part of Holor, a C++ header-only template library for multi-dimensional containers
+
+// Copyright 2020-2022 Carlo Masone
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to 
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is 
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER 
+// DEALINGS IN THE SOFTWARE.
+
+
+
+
+#ifndef HOLOR_CHUNKED_HOLOR_H
+#define HOLOR_CHUNKED_HOLOR_H
+
+/** \file chunked_holor.h
+ * \brief This header contains the classes that write and read chunked files, which store a holor container split in `N`-dimensional tiles (chunks) that are compressed independently, so that a slice can be read by decompressing only the chunks that overlap with it.
+ *
+ * A chunked file contains a header of `32 + 16*N` bytes, followed by the compressed chunks and by an index:
+ *  - bytes 0-7: the magic string `HOLORCHK`;
+ *  - byte 8: the version of the format, currently 1;
+ *  - byte 9: the byte order of the numbers in the file, `<` for little-endian and `>` for big-endian;
+ *  - byte 10: the kind of the elements, `b` for `bool`, `i` for signed integers, `u` for unsigned integers and `f` for floating point numbers;
+ *  - byte 11: the size of the elements in bytes;
+ *  - byte 12: the codec of the chunks (see ChunkCodec);
+ *  - bytes 13-15: reserved, set to zero;
+ *  - bytes 16-19: the number of dimensions `N`, as an unsigned integer of 32 bits;
+ *  - bytes 20-23: reserved, set to zero;
+ *  - bytes 24-31: the position of the index, as an unsigned integer of 64 bits. It is zero while the file is being written;
+ *  - bytes 32-(32+8N): the lengths of the dimensions, as unsigned integers of 64 bits;
+ *  - bytes (32+8N)-(32+16N): the lengths of the chunks, as unsigned integers of 64 bits.
+ *
+ * The chunks form a grid, whose cells are numbered in row-major order. The chunks on the upper border of a dimension are smaller if the length of the dimension is not a multiple of the length of the chunks.
+ * The elements of a chunk are stored in row-major order and compressed. The index contains, for each chunk, its position and its compressed size as unsigned integers of 64 bits. A chunk that is not compressed has the size of its elements,
+ * and a chunk that has not been written has position zero, and its elements are zeros.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <filesystem>
+#include <list>
+#include <memory>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include "../holor/holor.h"
+#include "../holor/holor_concepts.h"
+#include "../indexes/indexes.h"
+#include "../layout/layout.h"
+#include "../layout/layout_traversal.h"
+#include "../common/runtime_assertions.h"
+#include "file.h"
+#include "compression.h"
+#include "holor_serialization.h"
+
+
+namespace holor{
+
+/*!
+ * \brief Enumeration of the codecs used to compress the chunks of a chunked file
+ */
+enum class ChunkCodec : uint8_t{
+    none = 0,           ///< \brief the chunks are not compressed
+    lz = 1,             ///< \brief the chunks are compressed with the LZ compressor (see compression.h)
+    shuffle_lz = 2      ///< \brief the bytes of the elements are shuffled before they are compressed with the LZ compressor. It is usually the best choice for numerical data
+};
+
+namespace impl{
+
+/*================================================================================================
+                                    CHUNKED FORMAT
+================================================================================================*/
+inline constexpr char chunked_magic[8] = {'H', 'O', 'L', 'O', 'R', 'C', 'H', 'K'};   ///< \brief magic string at the beginning of a chunked file
+inline constexpr uint8_t chunked_version = 1;                                       ///< \brief version of the format of the chunked files
+inline constexpr size_t chunked_fixed_header = 32;                                  ///< \brief size of the part of the header that does not depend on the number of dimensions
+inline constexpr size_t chunked_index_position = 24;                                ///< \brief position of the field of the header with the position of the index
+
+/*!
+ * \brief Structure that contains the information in the header of a chunked file, and the grid of its chunks
+ * \tparam N the number of dimensions
+ */
+template<size_t N>
+struct ChunkedHeader{
+    ElementType type_;                          /*! type of the elements */
+    std::endian order_;                         /*! byte order of the numbers in the file */
+    ChunkCodec codec_;                          /*! codec of the chunks */
+    std::array<size_t, N> lengths_;             /*! lengths of the dimensions */
+    std::array<size_t, N> chunk_lengths_;       /*! lengths of the chunks */
+    size_t index_position_;                     /*! position of the index in the file */
+
+    /*!
+     * \brief Function that returns the size of the header in bytes
+     */
+    static constexpr size_t size(){
+        return chunked_fixed_header + 16*N;
+    }
+
+    /*!
+     * \brief Function that returns the number of chunks along each dimension
+     */
+    std::array<size_t, N> grid() const{
+        std::array<size_t, N> result;
+        for (size_t i = 0; i < N; i++){
+            result[i] = (lengths_[i] + chunk_lengths_[i] - 1)/chunk_lengths_[i];
+        }
+        return result;
+    }
+
+    /*!
+     * \brief Function that returns the total number of chunks
+     */
+    size_t chunks() const{
+        const auto cells = grid();
+        size_t result = 1;
+        for (auto cell : cells){
+            result *= cell;
+        }
+        return result;
+    }
+
+    /*!
+     * \brief Function that returns the lengths of a chunk, which are smaller than the lengths of the chunks on the upper border of a dimension
+     * \param chunk the coordinates of the chunk in the grid
+     */
+    std::array<size_t, N> chunk_extent(const std::array<size_t, N>& chunk) const{
+        std::array<size_t, N> result;
+        for (size_t i = 0; i < N; i++){
+            result[i] = std::min(chunk_lengths_[i], lengths_[i] - chunk[i]*chunk_lengths_[i]);
+        }
+        return result;
+    }
+
+    /*!
+     * \brief Function that returns the index of a chunk in the row-major order of the grid
+     * \param chunk the coordinates of the chunk in the grid
+     */
+    size_t chunk_index(const std::array<size_t, N>& chunk) const{
+        const auto cells = grid();
+        size_t result = 0;
+        for (size_t i = 0; i < N; i++){
+            result = result*cells[i] + chunk[i];
+        }
+        return result;
+    }
+
+    /*!
+     * \brief Function that encodes the header in a sequence of bytes
+     */
+    std::vector<unsigned char> encode() const{
+        std::vector<unsigned char> bytes(size(), 0);
+        std::copy(std::begin(chunked_magic), std::end(chunked_magic), bytes.begin());
+        bytes[8] = chunked_version;
+        bytes[9] = (order_ == std::endian::little) ? '<' : '>';
+        bytes[10] = static_cast<unsigned char>(type_.kind_);
+        bytes[11] = static_cast<unsigned char>(type_.size_);
+        bytes[12] = static_cast<unsigned char>(codec_);
+        encode_unsigned(bytes.data() + 16, static_cast<uint32_t>(N), order_);
+        encode_unsigned(bytes.data() + chunked_index_position, static_cast<uint64_t>(index_position_), order_);
+        for (size_t i = 0; i < N; i++){
+            encode_unsigned(bytes.data() + chunked_fixed_header + 8*i, static_cast<uint64_t>(lengths_[i]), order_);
+            encode_unsigned(bytes.data() + chunked_fixed_header + 8*(N + i), static_cast<uint64_t>(chunk_lengths_[i]), order_);
+        }
+        return bytes;
+    }
+};
+
+/*!
+ * \brief Function that reads and validates the header of a chunked file
+ * \tparam N the number of dimensions, which must match the number of dimensions in the file
+ * \param file the file
+ * \exception holor::exception::HolorRuntimeError if the file is not a valid chunked file, if its number of dimensions is not `N`, or if it has not been closed after it was written
+ * \return the header
+ */
+template<size_t N>
+ChunkedHeader<N> read_chunked_header(const File& file){
+    std::array<unsigned char, ChunkedHeader<N>::size()> bytes;
+    file.pread_all(bytes.data(), chunked_fixed_header, 0);
+    file.check_content(std::equal(std::begin(chunked_magic), std::end(chunked_magic), bytes.begin()), "not a holor chunked file");
+    file.check_content(bytes[8] == chunked_version, "unsupported version of the holor chunked format");
+    file.check_content(bytes[9] == '<' || bytes[9] == '>', "invalid byte order in the header of");
+    ChunkedHeader<N> header;
+    header.order_ = (bytes[9] == '<') ? std::endian::little : std::endian::big;
+    header.type_ = {static_cast<char>(bytes[10]), bytes[11]};
+    file.check_content(bytes[12] <= static_cast<uint8_t>(ChunkCodec::shuffle_lz), "unsupported codec in the chunked file");
+    header.codec_ = static_cast<ChunkCodec>(bytes[12]);
+    file.check_content(decode_unsigned<uint32_t>(bytes.data() + 16, header.order_) == N, "the number of dimensions does not match the chunked file");
+    header.index_position_ = static_cast<size_t>(decode_unsigned<uint64_t>(bytes.data() + chunked_index_position, header.order_));
+    file.check_content(header.index_position_ != 0, "the chunked file has not been completed");
+    file.pread_all(bytes.data() + chunked_fixed_header, 16*N, chunked_fixed_header);
+    for (size_t i = 0; i < N; i++){
+        header.lengths_[i] = static_cast<size_t>(decode_unsigned<uint64_t>(bytes.data() + chunked_fixed_header + 8*i, header.order_));
+        header.chunk_lengths_[i] = static_cast<size_t>(decode_unsigned<uint64_t>(bytes.data() + chunked_fixed_header + 8*(N + i), header.order_));
+        file.check_content(header.lengths_[i] > 0 && header.chunk_lengths_[i] > 0, "invalid length in the header of");
+    }
+    file.check_content(file.size() >= header.index_position_ + 16*header.chunks(), "the size of the index does not match the header of");
+    return header;
+}
+
+/*!
+ * \brief Structure that describes the elements selected along a dimension by a read: `count_` elements, the first of which has index `start_`, and the following ones at a distance of `step_`
+ */
+struct ChunkSelection{
+    size_t start_ = 0;          /*! index of the first selected element */
+    size_t count_ = 0;          /*! number of selected elements */
+    std::ptrdiff_t step_ = 1;   /*! distance between two selected elements, which can be negative */
+    bool reduced_ = false;      /*! true if the dimension is selected by a single index, and it is removed from the result */
+
+    ChunkSelection() = default;
+
+    /*!
+     * \brief Constructor that selects `count` elements starting from `start` with the given step
+     */
+    ChunkSelection(size_t start, size_t count, std::ptrdiff_t step, bool reduced): start_{start}, count_{count}, step_{step}, reduced_{reduced}{}
+
+    /*!
+     * \brief Constructor that selects a single element, and removes the dimension from the result
+     */
+    template<SingleIndex I>
+    ChunkSelection(I index): start_{static_cast<size_t>(index)}, count_{1}, step_{1}, reduced_{true}{}
+
+    /*!
+     * \brief Constructor that selects the elements of a range
+     */
+    ChunkSelection(const range& selected): start_{selected.start_}, count_{selected.length()}, step_{selected.step_}, reduced_{false}{}
+
+    /*!
+     * \brief Function that returns the smallest and the largest selected index
+     */
+    std::pair<size_t, size_t> bounds() const{
+        const size_t last = static_cast<size_t>(static_cast<std::ptrdiff_t>(start_) + static_cast<std::ptrdiff_t>(count_ - 1)*step_);
+        return {std::min(start_, last), std::max(start_, last)};
+    }
+
+    /*!
+     * \brief Function that returns the positions (in the selection) of the first and past the last selected elements whose indices are in `[low, high]`
+     */
+    std::pair<size_t, size_t> positions_in(size_t low, size_t high) const{
+        const std::ptrdiff_t start = static_cast<std::ptrdiff_t>(start_);
+        const std::ptrdiff_t step = std::abs(step_);
+        // distances of the bounds of the interval from the first index, in the direction of the selection
+        std::ptrdiff_t near = (step_ > 0) ? static_cast<std::ptrdiff_t>(low) - start : start - static_cast<std::ptrdiff_t>(high);
+        std::ptrdiff_t far = (step_ > 0) ? static_cast<std::ptrdiff_t>(high) - start : start - static_cast<std::ptrdiff_t>(low);
+        if (far < 0){
+            return {0, 0};
+        }
+        const size_t first = (near <= 0) ? 0 : static_cast<size_t>((near + step - 1)/step);
+        const size_t last = std::min(count_, static_cast<size_t>(far/step) + 1);
+        return {first, std::max(first, last)};
+    }
+};
+
+} //namespace impl
+
+
+
+/*================================================================================================
+                                    CHUNKED WRITER
+================================================================================================*/
+/*!
+ * \brief Class that writes a chunked file, by compressing and appending one chunk at a time. The chunks can be written in any order, so that a container larger than the memory can be written by parts.
+ * The file is completed by writing the index of the chunks when the writer is closed or destroyed; until then, it cannot be read.
+ * \tparam T the type of the elements, which must be an arithmetic type other than `bool`
+ * \tparam N the number of dimensions
+ */
+template<typename T, size_t N> requires (std::is_arithmetic_v<T> && !std::is_same_v<T, bool> && (N > 0))
+class ChunkedHolorWriter{
+    public:
+        /*!
+         * \brief Constructor that creates a chunked file
+         * \param path the path of the file, which is created or overwritten
+         * \param lengths the lengths of the container
+         * \param chunk_lengths the lengths of the chunks
+         * \param codec the codec of the chunks
+         * \exception holor::exception::HolorRuntimeError if a length or a length of the chunks is zero. The compiler flag DDEFINE_ASSERT_LEVEL in the CMakeLists can be set to AssertionLevel::no_checks to exclude this check.
+         * \exception holor::exception::HolorRuntimeError if the file cannot be written. This check does not depend on the compiler flag DDEFINE_ASSERT_LEVEL.
+         */
+        ChunkedHolorWriter(const std::filesystem::path& path, const std::array<size_t, N>& lengths, const std::array<size_t, N>& chunk_lengths, ChunkCodec codec = ChunkCodec::shuffle_lz): file_{path, impl::File::write}{
+            assert::dynamic_assert(std::ranges::all_of(lengths, [](size_t l){ return l > 0; }) && std::ranges::all_of(chunk_lengths, [](size_t l){ return l > 0; }), EXCEPTION_MESSAGE("holor::ChunkedHolorWriter - The lengths and the lengths of the chunks must be positive."));
+            header_ = {impl::element_type<T>(), std::endian::native, codec, lengths, chunk_lengths, 0};
+            index_.assign(2*header_.chunks(), 0);
+            const auto bytes = header_.encode();
+            file_.pwrite_all(bytes.data(), bytes.size(), 0);
+            end_ = bytes.size();
+        }
+
+        ChunkedHolorWriter(const ChunkedHolorWriter&) = delete;
+        ChunkedHolorWriter& operator=(const ChunkedHolorWriter&) = delete;
+        ChunkedHolorWriter(ChunkedHolorWriter&&) = default;
+        ChunkedHolorWriter& operator=(ChunkedHolorWriter&&) = default;
+
+        /*!
+         * \brief Destructor that completes the file, if it has not been closed. The errors are ignored: `close` must be called to detect them
+         */
+        ~ChunkedHolorWriter(){
+            try{
+                close();
+            } catch(...){}
+        }
+
+        /*!
+         * \brief Get the number of chunks along each dimension
+         */
+        std::array<size_t, N> grid() const{
+            return header_.grid();
+        }
+
+        /*!
+         * \brief Get the lengths of a chunk, which are smaller than the lengths of the chunks on the upper border of a dimension
+         * \param chunk the coordinates of the chunk in the grid
+         */
+        std::array<size_t, N> chunk_extent(const std::array<size_t, N>& chunk) const{
+            return header_.chunk_extent(chunk);
+        }
+
+        /*!
+         * \brief Function that compresses and writes a chunk. If the chunk has already been written, it is replaced
+         * \param chunk the coordinates of the chunk in the grid
+         * \param tile the elements of the chunk, whose lengths must be `chunk_extent(chunk)`
+         * \exception holor::exception::HolorRuntimeError if the coordinates are outside the grid, or if the lengths of the tile do not match the chunk. The compiler flag DDEFINE_ASSERT_LEVEL in the CMakeLists can be set to AssertionLevel::no_checks to exclude this check.
+         * \exception holor::exception::HolorRuntimeError if the writer has been closed or the file cannot be written. This check does not depend on the compiler flag DDEFINE_ASSERT_LEVEL.
+         */
+        template<HolorType H> requires ((H::dimensions == N) && std::is_same_v<typename H::value_type, T>)
+        void write_chunk(const std::array<size_t, N>& chunk, const H& tile){
+            const auto cells = header_.grid();
+            assert::dynamic_assert(std::ranges::equal(chunk, cells, std::less<size_t>()), EXCEPTION_MESSAGE("holor::ChunkedHolorWriter - The chunk is outside the grid."));
+            assert::dynamic_assert(tile.lengths() == header_.chunk_extent(chunk), EXCEPTION_MESSAGE("holor::ChunkedHolorWriter - The lengths of the tile do not match the chunk."));
+            file_.check_content(file_.descriptor() >= 0, "the chunked writer has been closed");
+
+            // the elements are packed in row-major order, and then compressed
+            const size_t count = tile.size();
+            const size_t bytes = count*sizeof(T);
+            elements_.resize(count);
+            const T* data = tile.data();
+            if (tile.layout().is_contiguous()){
+                std::copy(data + tile.layout().offset(), data + tile.layout().offset() + count, elements_.data());
+            } else{
+                T* dest = elements_.data();
+                impl::for_each_index(impl::normalize_layouts(Layout<N>(tile.lengths()), tile.layout()), [dest, data](size_t i, size_t j){
+                    dest[i] = data[j];
+                });
+            }
+            const unsigned char* payload = reinterpret_cast<const unsigned char*>(elements_.data());
+            size_t stored = bytes;
+            if (header_.codec_ != ChunkCodec::none){
+                const unsigned char* source = payload;
+                if (header_.codec_ == ChunkCodec::shuffle_lz && sizeof(T) > 1){
+                    shuffled_.resize(bytes);
+                    impl::shuffle_bytes(payload, shuffled_.data(), count, sizeof(T));
+                    source = shuffled_.data();
+                }
+                compressed_.resize(impl::lz_compress_bound(bytes));
+                const size_t size = impl::lz_compress(source, bytes, compressed_.data());
+                // the chunks that do not compress are stored as they are
+                if (size < bytes){
+                    payload = compressed_.data();
+                    stored = size;
+                }
+            }
+            file_.pwrite_all(payload, stored, end_);
+            const size_t index = header_.chunk_index(chunk);
+            index_[2*index] = end_;
+            index_[2*index + 1] = stored;
+            end_ += stored;
+        }
+
+        /*!
+         * \brief Function that writes a whole container, chunk by chunk
+         * \param holor the container, whose lengths must be the lengths of the file
+         * \exception holor::exception::HolorRuntimeError if the lengths of the container do not match the file. The compiler flag DDEFINE_ASSERT_LEVEL in the CMakeLists can be set to AssertionLevel::no_checks to exclude this check.
+         * \exception holor::exception::HolorRuntimeError if the file cannot be written. This check does not depend on the compiler flag DDEFINE_ASSERT_LEVEL.
+         */
+        template<HolorType H> requires ((H::dimensions == N) && std::is_same_v<typename H::value_type, T>)
+        void write(const H& holor){
+            assert::dynamic_assert(holor.lengths() == header_.lengths_, EXCEPTION_MESSAGE("holor::ChunkedHolorWriter - The lengths of the container do not match the file."));
+            const auto cells = header_.grid();
+            std::array<size_t, N> chunk{};
+            for (size_t c = 0; c < header_.chunks(); c++){
+                size_t offset = holor.layout().offset();
+                for (size_t d = 0; d < N; d++){
+                    offset += chunk[d]*header_.chunk_lengths_[d]*static_cast<size_t>(holor.layout().stride(d));
+                }
+                const Layout<N> tile_layout(header_.chunk_extent(chunk), holor.layout().strides(), offset);
+                write_chunk(chunk, HolorRef<const T, N>(holor.data(), tile_layout));
+                // advance the coordinates of the chunk in row-major order
+                for (size_t d = N; d-- > 0;){
+                    if (++chunk[d] < cells[d]){
+                        break;
+                    }
+                    chunk[d] = 0;
+                }
+            }
+        }
+
+        /*!
+         * \brief Function that completes the file, by writing the index of the chunks and updating the header. Closing a writer that is already closed has no effect
+         * \exception holor::exception::HolorRuntimeError if the file cannot be written. This check does not depend on the compiler flag DDEFINE_ASSERT_LEVEL.
+         */
+        void close(){
+            if (file_.descriptor() < 0){
+                return;
+            }
+            std::vector<unsigned char> bytes(8*index_.size());
+            for (size_t i = 0; i < index_.size(); i++){
+                impl::encode_unsigned(bytes.data() + 8*i, static_cast<uint64_t>(index_[i]), header_.order_);
+            }
+            file_.pwrite_all(bytes.data(), bytes.size(), end_);
+            header_.index_position_ = end_;
+            const auto header = header_.encode();
+            file_.pwrite_all(header.data(), header.size(), 0);
+            file_.close();
+        }
+
+    private:
+        impl::File file_;                           ///< \brief the file
+        impl::ChunkedHeader<N> header_;             ///< \brief the header of the file
+        std::vector<size_t> index_;                 ///< \brief position and compressed size of each chunk
+        size_t end_ = 0;                            ///< \brief position where the next chunk is written
+        std::vector<T> elements_;                   ///< \brief buffer with the packed elements of a chunk
+        std::vector<unsigned char> shuffled_;       ///< \brief buffer with the shuffled bytes of a chunk
+        std::vector<unsigned char> compressed_;     ///< \brief buffer with the compressed bytes of a chunk
+};
+
+
+
+/*!
+ * \brief Function that writes a container to a chunked file
+ * \tparam H the type of the container
+ * \param path the path of the file, which is created or overwritten
+ * \param holor the container
+ * \param chunk_lengths the lengths of the chunks
+ * \param codec the codec of the chunks
+ * \exception holor::exception::HolorRuntimeError if the container is empty or a length of the chunks is zero. The compiler flag DDEFINE_ASSERT_LEVEL in the CMakeLists can be set to AssertionLevel::no_checks to exclude this check.
+ * \exception holor::exception::HolorRuntimeError if the file cannot be written. This check does not depend on the compiler flag DDEFINE_ASSERT_LEVEL.
+ */
+template<HolorType H>
+void save_chunked(const std::filesystem::path& path, const H& holor, const std::array<size_t, H::dimensions>& chunk_lengths, ChunkCodec codec = ChunkCodec::shuffle_lz){
+    ChunkedHolorWriter<typename H::value_type, H::dimensions> writer(path, holor.lengths(), chunk_lengths, codec);
+    writer.write(holor);
+    writer.close();
+}
+
+
+
+/*================================================================================================
+                                    CHUNKED READER
+================================================================================================*/
+inline constexpr size_t default_chunk_cache_bytes = size_t{64} << 20;    ///< \brief default capacity of the cache of the decompressed chunks of a ChunkedHolorFile
+
+/*!
+ * \brief Structure with the statistics of the cache of the decompressed chunks of a ChunkedHolorFile
+ */
+struct ChunkCacheStatistics{
+    size_t hits_ = 0;           /*! number of chunks that have been found in the cache */
+    size_t misses_ = 0;         /*! number of chunks that have been read from the file and decompressed */
+    size_t bytes_ = 0;          /*! size of the chunks currently in the cache */
+};
+
+
+/*!
+ * \brief Class that reads a chunked file. A slice is read by decompressing only the chunks that overlap with it, and the decompressed chunks are kept in a cache with a least-recently-used policy,
+ * so that reading slices that are close to each other does not decompress the same chunks again.
+ * The functions that read the file modify the cache, so an object of this class must not be used by more threads at the same time.
+ * \tparam T the type of the elements, which must match the type of the elements in the file
+ * \tparam N the number of dimensions, which must match the number of dimensions in the file
+ */
+template<typename T, size_t N> requires (std::is_arithmetic_v<T> && !std::is_same_v<T, bool> && (N > 0))
+class ChunkedHolorFile{
+    public:
+        /*!
+         * \brief Constructor that opens a chunked file and reads the index of its chunks
+         * \param path the path of the file
+         * \param cache_bytes the capacity of the cache of the decompressed chunks in bytes. The last chunk that has been read is kept in the cache even if it is larger than the capacity
+         * \exception holor::exception::HolorRuntimeError if the file cannot be read, if it is not a valid chunked file, or if its type or number of dimensions do not match `T` and `N`. This check does not depend on the compiler flag DDEFINE_ASSERT_LEVEL.
+         */
+        explicit ChunkedHolorFile(const std::filesystem::path& path, size_t cache_bytes = default_chunk_cache_bytes): file_{path, impl::File::read}, capacity_{cache_bytes}{
+            header_ = impl::read_chunked_header<N>(file_);
+            file_.check_content(header_.type_ == impl::element_type<T>(), "the type of the elements does not match the file");
+            const size_t chunks = header_.chunks();
+            std::vector<unsigned char> bytes(16*chunks);
+            file_.pread_all(bytes.data(), bytes.size(), header_.index_position_);
+            index_.resize(2*chunks);
+            for (size_t c = 0; c < chunks; c++){
+                index_[2*c] = static_cast<size_t>(impl::decode_unsigned<uint64_t>(bytes.data() + 16*c, header_.order_));
+                index_[2*c + 1] = static_cast<size_t>(impl::decode_unsigned<uint64_t>(bytes.data() + 16*c + 8, header_.order_));
+                const bool missing = (index_[2*c] == 0);
+                file_.check_content(missing || (index_[2*c] >= header_.size() && index_[2*c + 1] <= header_.index_position_ - index_[2*c]), "invalid index of the chunks in");
+            }
+        }
+
+        ChunkedHolorFile(const ChunkedHolorFile&) = delete;
+        ChunkedHolorFile& operator=(const ChunkedHolorFile&) = delete;
+        ChunkedHolorFile(ChunkedHolorFile&&) = default;
+        ChunkedHolorFile& operator=(ChunkedHolorFile&&) = default;
+
+
+        /*====================================================================================
+                                    Get/Set Functions
+        ====================================================================================*/
+        /*!
+         * \brief Get the lengths of the container stored in the file
+         */
+        std::array<size_t, N> lengths() const{
+            return header_.lengths_;
+        }
+
+        /*!
+         * \brief Get the lengths of the chunks
+         */
+        std::array<size_t, N> chunk_lengths() const{
+            return header_.chunk_lengths_;
+        }
+
+        /*!
+         * \brief Get the number of chunks along each dimension
+         */
+        std::array<size_t, N> grid() const{
+            return header_.grid();
+        }
+
+        /*!
+         * \brief Get the codec of the chunks
+         */
+        ChunkCodec codec() const{
+            return header_.codec_;
+        }
+
+        /*!
+         * \brief Get the statistics of the cache
+         */
+        ChunkCacheStatistics statistics() const{
+            return statistics_;
+        }
+
+        /*!
+         * \brief Get the capacity of the cache in bytes
+         */
+        size_t cache_capacity() const{
+            return capacity_;
+        }
+
+        /*!
+         * \brief Set the capacity of the cache in bytes, evicting the least recently used chunks that do not fit in the new capacity
+         */
+        void set_cache_capacity(size_t bytes){
+            capacity_ = bytes;
+            evict(0);
+        }
+
+        /*!
+         * \brief Function that removes all the chunks from the cache. The statistics of the hits and of the misses are not modified
+         */
+        void clear_cache(){
+            lru_.clear();
+            entries_.clear();
+            statistics_.bytes_ = 0;
+        }
+
+
+        /*====================================================================================
+                                    Read Functions
+        ====================================================================================*/
+        /*!
+         * \brief Function that reads all the elements of the file
+         * \exception holor::exception::HolorRuntimeError if a chunk cannot be read or is corrupted. This check does not depend on the compiler flag DDEFINE_ASSERT_LEVEL.
+         * \return a Holor with the elements of the file
+         */
+        Holor<T, N> read(){
+            std::array<impl::ChunkSelection, N> selections;
+            for (size_t i = 0; i < N; i++){
+                selections[i] = impl::ChunkSelection(0, header_.lengths_[i], 1, false);
+            }
+            return read_selection<N>(selections);
+        }
+
+        /*!
+         * \brief Function that reads a slice of the file, decompressing only the chunks that overlap with it.
+         * The indices have the same meaning as in the slicing of a Holor: a dimension indexed by a single index is removed from the result, and a dimension indexed by a range is kept.
+         * \b Example: `file.read(range{0, 9}, 4)` reads the fifth column of the first ten rows of a file with two dimensions, and returns a `Holor<T, 1>`.
+         * \param args the indices, one for each dimension
+         * \exception holor::exception::HolorRuntimeError if an index is outside the lengths of the file. The compiler flag DDEFINE_ASSERT_LEVEL in the CMakeLists can be set to AssertionLevel::no_checks to exclude this check.
+         * \exception holor::exception::HolorRuntimeError if a chunk cannot be read or is corrupted. This check does not depend on the compiler flag DDEFINE_ASSERT_LEVEL.
+         * \return a Holor with the elements of the slice, with one dimension for each range
+         */
+        template <typename... Args> requires ((sizeof...(Args) == N) && impl::ranged_index_pack<Args...>())
+        auto read(Args&&... args){
+            constexpr size_t M = (static_cast<size_t>(RangeIndex<Args>) + ...);
+            const std::array<impl::ChunkSelection, N> selections{impl::ChunkSelection(args)...};
+            for (size_t i = 0; i < N; i++){
+                const auto [low, high] = selections[i].bounds();
+                assert::dynamic_assert(high < header_.lengths_[i], EXCEPTION_MESSAGE("holor::ChunkedHolorFile - Index out of bounds."));
+            }
+            return read_selection<M>(selections);
+        }
+
+    private:
+        /*!
+         * \brief Structure with a decompressed chunk in the cache
+         */
+        struct CacheEntry{
+            size_t index_;              ///< \brief index of the chunk
+            std::vector<T> elements_;   ///< \brief elements of the chunk in row-major order
+        };
+
+        impl::File file_;                                                               ///< \brief the file
+        impl::ChunkedHeader<N> header_;                                                 ///< \brief the header of the file
+        std::vector<size_t> index_;                                                     ///< \brief position and compressed size of each chunk
+        size_t capacity_;                                                               ///< \brief capacity of the cache in bytes
+        std::list<CacheEntry> lru_;                                                     ///< \brief chunks in the cache, from the most to the least recently used
+        std::unordered_map<size_t, typename std::list<CacheEntry>::iterator> entries_;  ///< \brief position of the chunks in the cache
+        ChunkCacheStatistics statistics_;                                               ///< \brief statistics of the cache
+        std::vector<unsigned char> compressed_;                                         ///< \brief buffer with the compressed bytes of a chunk
+        std::vector<unsigned char> shuffled_;                                           ///< \brief buffer with the shuffled bytes of a chunk
+
+        /*!
+         * \brief Function that reads the elements selected along each dimension in a new Holor with `M` dimensions, one for each selection with more than one element or created from a range
+         */
+        template<size_t M>
+        Holor<T, M> read_selection(const std::array<impl::ChunkSelection, N>& selections){
+            // the strides of the result along the dimensions of the file, zero for the dimensions that are removed
+            std::array<size_t, M> lengths;
+            std::array<std::ptrdiff_t, N> dest_strides{};
+            {
+                size_t m = M;
+                std::ptrdiff_t stride = 1;
+                for (size_t i = N; i-- > 0;){
+                    if (selections[i].reduced_){
+                        continue;
+                    }
+                    lengths[--m] = selections[i].count_;
+                    dest_strides[i] = stride;
+                    stride *= static_cast<std::ptrdiff_t>(selections[i].count_);
+                }
+            }
+            Holor<T, M> result(holor::uninitialized, Layout<M>(lengths));
+            T* dest = result.data();
+
+            // range of the chunks that overlap with the selection along each dimension
+            std::array<size_t, N> first_chunk;
+            std::array<size_t, N> last_chunk;
+            for (size_t i = 0; i < N; i++){
+                const auto [low, high] = selections[i].bounds();
+                first_chunk[i] = low/header_.chunk_lengths_[i];
+                last_chunk[i] = high/header_.chunk_lengths_[i];
+            }
+            std::array<size_t, N> chunk = first_chunk;
+            while (true){
+                copy_chunk(chunk, selections, dest, dest_strides);
+                size_t d = N;
+                while (d > 0){
+                    --d;
+                    if (++chunk[d] <= last_chunk[d]){
+                        break;
+                    }
+                    chunk[d] = first_chunk[d];
+                    if (d == 0){
+                        return result;
+                    }
+                }
+            }
+        }
+
+        /*!
+         * \brief Function that copies the elements of a chunk that belong to the selection to their position in the result
+         */
+        void copy_chunk(const std::array<size_t, N>& chunk, const std::array<impl::ChunkSelection, N>& selections, T* dest, const std::array<std::ptrdiff_t, N>& dest_strides){
+            const auto extent = header_.chunk_extent(chunk);
+            std::array<size_t, N> counts;
+            std::array<std::ptrdiff_t, N> tile_strides;
+            std::array<std::ptrdiff_t, N> strides;
+            size_t tile_offset = 0;
+            size_t dest_offset = 0;
+            std::ptrdiff_t tile_stride = 1;
+            for (size_t i = N; i-- > 0;){
+                const size_t low = chunk[i]*header_.chunk_lengths_[i];
+                const auto [first, last] = selections[i].positions_in(low, low + extent[i] - 1);
+                if (first == last){
+                    // a selection with a step larger than the chunks can skip a chunk
+                    return;
+                }
+                counts[i] = last - first;
+                const size_t start = static_cast<size_t>(static_cast<std::ptrdiff_t>(selections[i].start_) + static_cast<std::ptrdiff_t>(first)*selections[i].step_);
+                tile_offset += (start - low)*static_cast<size_t>(tile_stride);
+                tile_strides[i] = selections[i].step_*tile_stride;
+                dest_offset += first*static_cast<size_t>(dest_strides[i]);
+                strides[i] = dest_strides[i];
+                tile_stride *= static_cast<std::ptrdiff_t>(extent[i]);
+            }
+            const T* tile = load_chunk(header_.chunk_index(chunk));
+            if (tile == nullptr){
+                impl::for_each_index(impl::normalize_layouts<N, 1>(counts, {strides}, {dest_offset}), [dest](size_t i){
+                    dest[i] = T{};
+                });
+            } else{
+                impl::for_each_index(impl::normalize_layouts<N, 2>(counts, {strides, tile_strides}, {dest_offset, tile_offset}), [dest, tile](size_t i, size_t j){
+                    dest[i] = tile[j];
+                });
+            }
+        }
+
+        /*!
+         * \brief Function that returns the elements of a chunk, reading and decompressing it if it is not in the cache
+         * \return a pointer to the elements of the chunk, that is valid until the next chunk is loaded, or `nullptr` if the chunk has not been written
+         */
+        const T* load_chunk(size_t index){
+            if (index_[2*index] == 0){
+                return nullptr;
+            }
+            if (auto found = entries_.find(index); found != entries_.end()){
+                statistics_.hits_++;
+                lru_.splice(lru_.begin(), lru_, found->second);
+                return found->second->elements_.data();
+            }
+
+            std::array<size_t, N> chunk;
+            {
+                const auto cells = header_.grid();
+                size_t rest = index;
+                for (size_t i = N; i-- > 0;){
+                    chunk[i] = rest % cells[i];
+                    rest /= cells[i];
+                }
+            }
+            const auto extent = header_.chunk_extent(chunk);
+            size_t count = 1;
+            for (auto length : extent){
+                count *= length;
+            }
+            const size_t bytes = count*sizeof(T);
+            const size_t stored = index_[2*index + 1];
+            evict(bytes);
+            std::vector<T> elements(count);
+            unsigned char* raw = reinterpret_cast<unsigned char*>(elements.data());
+            if (stored == bytes){
+                file_.pread_all(raw, bytes, index_[2*index]);
+            } else{
+                file_.check_content(header_.codec_ != ChunkCodec::none, "invalid size of a chunk in");
+                compressed_.resize(stored);
+                file_.pread_all(compressed_.data(), stored, index_[2*index]);
+                if (header_.codec_ == ChunkCodec::shuffle_lz && sizeof(T) > 1){
+                    shuffled_.resize(bytes);
+                    file_.check_content(impl::lz_decompress(compressed_.data(), stored, shuffled_.data(), bytes), "corrupted chunk in");
+                    impl::unshuffle_bytes(shuffled_.data(), raw, count, sizeof(T));
+                } else{
+                    file_.check_content(impl::lz_decompress(compressed_.data(), stored, raw, bytes), "corrupted chunk in");
+                }
+            }
+            if (header_.order_ != std::endian::native){
+                impl::byteswap(raw, count, sizeof(T));
+            }
+            statistics_.misses_++;
+            statistics_.bytes_ += bytes;
+            lru_.push_front(CacheEntry{index, std::move(elements)});
+            entries_[index] = lru_.begin();
+            return lru_.front().elements_.data();
+        }
+
+        /*!
+         * \brief Function that evicts the least recently used chunks from the cache, until there is room for a chunk of the given size
+         */
+        void evict(size_t bytes){
+            while (!lru_.empty() && statistics_.bytes_ + bytes > capacity_){
+                statistics_.bytes_ -= lru_.back().elements_.size()*sizeof(T);
+                entries_.erase(lru_.back().index_);
+                lru_.pop_back();
+            }
+        }
+};
+
+} //namespace holor
+
+#endif // HOLOR_CHUNKED_HOLOR_H
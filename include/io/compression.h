@@ -0,0 +1,262 @@
+// This file is part of Holor, a C++ header-only template library for multi-dimensional containers
+
+// Copyright 2020-2022 Carlo Masone
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to 
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is 
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER 
+// DEALINGS IN THE SOFTWARE.
+
+
+
+
+#ifndef HOLOR_COMPRESSION_H
+#define HOLOR_COMPRESSION_H
+
+/** \file compression.h
+ * \brief This header contains the byte shuffle and the lossless compressor used by the chunked files (see chunked_holor.h). They have no external dependencies.
+ *
+ * The compressor is a LZ77 compressor in the style of LZ4: the compressed data is a sequence of literals (bytes copied as they are) and matches (copies of `length >= 4` bytes that appear at a distance of at most 65535 bytes before),
+ * found with a hash table of the sequences of 4 bytes. It is fast rather than strong, so that decompressing a chunk is cheaper than reading it uncompressed from the device.
+ * The byte shuffle groups the bytes with the same significance of a sequence of numbers (e.g., the exponents of floating point numbers, or the most significant bytes of small integers), which usually makes them much more compressible.
+ *
+ * Each sequence of the compressed data begins with a token byte, whose high nibble is the number of literals and whose low nibble is the length of the match minus 4. A nibble equal to 15 is followed by bytes that are added to it,
+ * until a byte different from 255. The literals follow the token and its extra bytes, then the distance of the match as a little-endian integer of 2 bytes, and then the extra bytes of the length of the match.
+ * The last sequence has only literals, and it ends the compressed data.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <vector>
+
+
+namespace holor{
+
+namespace impl{
+
+/*================================================================================================
+                                    BYTE SHUFFLE
+================================================================================================*/
+/*!
+ * \brief Function that shuffles the bytes of a sequence of numbers, storing all the first bytes of the numbers, then all the second bytes, and so on
+ * \param source the bytes of the numbers
+ * \param dest the shuffled bytes. It must not overlap with `source`
+ * \param n the number of numbers
+ * \param size the size of each number in bytes
+ */
+inline void shuffle_bytes(const unsigned char* source, unsigned char* dest, size_t n, size_t size){
+    for (size_t b = 0; b < size; b++){
+        unsigned char* plane = dest + b*n;
+        for (size_t i = 0; i < n; i++){
+            plane[i] = source[i*size + b];
+        }
+    }
+}
+
+/*!
+ * \brief Function that restores the bytes of a sequence of numbers shuffled by `shuffle_bytes`
+ * \param source the shuffled bytes
+ * \param dest the bytes of the numbers. It must not overlap with `source`
+ * \param n the number of numbers
+ * \param size the size of each number in bytes
+ */
+inline void unshuffle_bytes(const unsigned char* source, unsigned char* dest, size_t n, size_t size){
+    for (size_t b = 0; b < size; b++){
+        const unsigned char* plane = source + b*n;
+        for (size_t i = 0; i < n; i++){
+            dest[i*size + b] = plane[i];
+        }
+    }
+}
+
+
+
+/*================================================================================================
+                                    LZ COMPRESSION
+================================================================================================*/
+inline constexpr size_t lz_min_match = 4;           ///< \brief minimum length of a match
+inline constexpr size_t lz_max_distance = 65535;    ///< \brief maximum distance of a match
+inline constexpr unsigned lz_hash_bits = 14;        ///< \brief number of bits of the hash of the sequences of 4 bytes, i.e., logarithm of the number of entries of the hash table
+
+/*!
+ * \brief Function that returns the maximum size of the compression of `n` bytes, i.e., the size of the buffer that must be passed to `lz_compress`
+ */
+constexpr size_t lz_compress_bound(size_t n){
+    return n + n/255 + 16;
+}
+
+namespace lz{
+    /*!
+     * \brief Function that loads 4 bytes that may not be aligned
+     */
+    inline uint32_t load32(const unsigned char* p){
+        uint32_t value;
+        std::memcpy(&value, p, sizeof(value));
+        return value;
+    }
+
+    /*!
+     * \brief Function that writes the extra bytes of a length whose nibble in the token is 15, and returns the position after them
+     */
+    inline unsigned char* write_length(unsigned char* op, size_t length){
+        while (length >= 255){
+            *op++ = 255;
+            length -= 255;
+        }
+        *op++ = static_cast<unsigned char>(length);
+        return op;
+    }
+
+    /*!
+     * \brief Function that adds the extra bytes of a length to `length`, and returns false if the input ends before them
+     */
+    inline bool read_length(const unsigned char* source, size_t n, size_t& ip, size_t& length){
+        unsigned char byte;
+        do{
+            if (ip >= n){
+                return false;
+            }
+            byte = source[ip++];
+            length += byte;
+        } while (byte == 255);
+        return true;
+    }
+
+    /*!
+     * \brief Function that writes the token of a sequence and its literals, and returns the position after them
+     */
+    inline unsigned char* write_literals(unsigned char* op, const unsigned char* literals, size_t count, size_t match_code){
+        *op++ = static_cast<unsigned char>((std::min<size_t>(count, 15) << 4) | std::min<size_t>(match_code, 15));
+        if (count >= 15){
+            op = write_length(op, count - 15);
+        }
+        if (count > 0){
+            std::memcpy(op, literals, count);
+        }
+        return op + count;
+    }
+}
+
+/*!
+ * \brief Function that compresses a sequence of bytes
+ * \param source the bytes to be compressed
+ * \param n the number of bytes
+ * \param dest the buffer where the compressed bytes are written, whose size must be at least `lz_compress_bound(n)`
+ * \return the size of the compressed data
+ */
+inline size_t lz_compress(const unsigned char* source, size_t n, unsigned char* dest){
+    unsigned char* op = dest;
+    size_t anchor = 0;
+    if (n > lz_min_match){
+        std::vector<uint32_t> table(size_t{1} << lz_hash_bits, 0);
+        size_t ip = 1;
+        while (ip + lz_min_match <= n){
+            const uint32_t sequence = lz::load32(source + ip);
+            const uint32_t hash = (sequence*2654435761u) >> (32 - lz_hash_bits);
+            const size_t candidate = table[hash];
+            table[hash] = static_cast<uint32_t>(ip);
+            if (ip - candidate > lz_max_distance || lz::load32(source + candidate) != sequence){
+                // skip faster through the data that does not compress
+                ip += 1 + ((ip - anchor) >> 6);
+                continue;
+            }
+            size_t length = lz_min_match;
+            while (ip + length < n && source[candidate + length] == source[ip + length]){
+                length++;
+            }
+            op = lz::write_literals(op, source + anchor, ip - anchor, length - lz_min_match);
+            *op++ = static_cast<unsigned char>((ip - candidate) & 0xFF);
+            *op++ = static_cast<unsigned char>((ip - candidate) >> 8);
+            if (length - lz_min_match >= 15){
+                op = lz::write_length(op, length - lz_min_match - 15);
+            }
+            ip += length;
+            anchor = ip;
+        }
+    }
+    op = lz::write_literals(op, source + anchor, n - anchor, 0);
+    return static_cast<size_t>(op - dest);
+}
+
+/*!
+ * \brief Function that decompresses a sequence of bytes compressed by `lz_compress`. The compressed data is validated, so that a corrupted input cannot write outside of the destination
+ * \param source the compressed bytes
+ * \param n the number of compressed bytes
+ * \param dest the buffer where the decompressed bytes are written
+ * \param size the size of the decompressed data
+ * \return true if the data has been decompressed, false if it is corrupted or if its decompressed size is not `size`
+ */
+inline bool lz_decompress(const unsigned char* source, size_t n, unsigned char* dest, size_t size){
+    size_t ip = 0;
+    size_t op = 0;
+    // the data always ends with a sequence of literals without a match, so that a truncated input is detected
+    while (true){
+        if (ip >= n){
+            return false;
+        }
+        const unsigned token = source[ip++];
+        size_t literals = token >> 4;
+        if (literals == 15 && !lz::read_length(source, n, ip, literals)){
+            return false;
+        }
+        if (literals > n - ip || literals > size - op){
+            return false;
+        }
+        if (literals > 0){
+            std::memcpy(dest + op, source + ip, literals);
+        }
+        ip += literals;
+        op += literals;
+        if (ip == n){
+            break;
+        }
+        if (n - ip < 2){
+            return false;
+        }
+        const size_t distance = source[ip] | (static_cast<size_t>(source[ip+1]) << 8);
+        ip += 2;
+        size_t length = token & 15;
+        if (length == 15 && !lz::read_length(source, n, ip, length)){
+            return false;
+        }
+        length += lz_min_match;
+        if (distance == 0 || distance > op || length > size - op){
+            return false;
+        }
+        if (distance >= length){
+            std::memcpy(dest + op, dest + op - distance, length);
+        } else{
+            // the match overlaps with the bytes being written, e.g., a run of repeated bytes. The bytes repeat with period `distance`,
+            // so they are copied in blocks that begin at the start of the match and double at each step, without overlapping
+            size_t copied = 0;
+            while (copied < length){
+                const size_t block = std::min(copied + distance, length - copied);
+                std::memcpy(dest + op + copied, dest + op - distance, block);
+                copied += block;
+            }
+        }
+        op += length;
+    }
+    return op == size;
+}
+
+} //namespace impl
+
+} //namespace holor
+
+#endif // HOLOR_COMPRESSION_H
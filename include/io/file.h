@@ -0,0 +1,363 @@
+// This file is part of Holor, a C++ header-only template library for multi-dimensional containers
+
+// Copyright 2020-2022 Carlo Masone
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to 
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is 
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER 
+// DEALINGS IN THE SOFTWARE.
+
+
+
+#ifndef HOLOR_FILE_H
+#define HOLOR_FILE_H
+
+/** \file file.h
+ * \brief This header contains thin wrappers of a POSIX file descriptor and of a memory mapping of a file, used by the functions that save and load holor containers.
+ *
+ * The wrapper closes the descriptor when it is destroyed, and its functions repeat the system calls until all the bytes are transferred (the calls can transfer fewer bytes than requested, e.g., the writes larger than 2 GiB on Linux).
+ * Every failure throws a holor::exception::HolorRuntimeError with the description of the error. These checks do not depend on the compiler flag DDEFINE_ASSERT_LEVEL, because they verify the result of the operations on the files and not the arguments passed to the functions.
+ */
+
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <algorithm>
+#include <filesystem>
+#include <string>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include "../common/runtime_assertions.h"
+
+
+namespace holor{
+
+namespace impl{
+
+/*================================================================================================
+                                    FILE
+================================================================================================*/
+/*!
+ * \brief Class that owns a POSIX file descriptor, closing it when it is destroyed
+ */
+class File{
+    public:
+        /*!
+         * \brief Enumeration of the modes used to open a file
+         */
+        enum Mode{
+            read,       ///< \brief opens an existing file for reading
+            write,      ///< \brief creates a file, or truncates an existing one, for writing
+            update      ///< \brief opens an existing file for reading and writing
+        };
+
+        File() = default;
+
+        /*!
+         * \brief Constructor that opens a file
+         * \param path the path of the file
+         * \param mode the mode used to open the file
+         * \exception holor::exception::HolorRuntimeError if the file cannot be opened
+         */
+        File(const std::filesystem::path& path, Mode mode): path_{path.string()}{
+            const int flags = (mode == read) ? O_RDONLY : ((mode == write) ? (O_WRONLY | O_CREAT | O_TRUNC) : O_RDWR);
+            fd_ = ::open(path_.c_str(), flags | O_CLOEXEC, 0644);
+            check(fd_ >= 0, "cannot open the file");
+        }
+
+        File(const File&) = delete;
+        File& operator=(const File&) = delete;
+
+        File(File&& other) noexcept: fd_{std::exchange(other.fd_, -1)}, path_{std::move(other.path_)}{}
+
+        File& operator=(File&& other) noexcept{
+            if (this != &other){
+                close();
+                fd_ = std::exchange(other.fd_, -1);
+                path_ = std::move(other.path_);
+            }
+            return *this;
+        }
+
+        ~File(){
+            close();
+        }
+
+        /*!
+         * \brief Get the file descriptor
+         */
+        int descriptor() const{
+            return fd_;
+        }
+
+        /*!
+         * \brief Get the size of the file in bytes
+         */
+        size_t size() const{
+            struct stat info;
+            check(::fstat(fd_, &info) == 0, "cannot read the size of the file");
+            return static_cast<size_t>(info.st_size);
+        }
+
+        /*!
+         * \brief Function that changes the size of the file, filling the new bytes with zeros
+         */
+        void resize(size_t size) const{
+            check(::ftruncate(fd_, static_cast<off_t>(size)) == 0, "cannot resize the file");
+        }
+
+        /*!
+         * \brief Function that writes a buffer at the current position of the file
+         */
+        void write_all(const void* buffer, size_t bytes) const{
+            const char* data = static_cast<const char*>(buffer);
+            while (bytes > 0){
+                const ssize_t written = ::write(fd_, data, bytes);
+                if (written < 0 && errno == EINTR){
+                    continue;
+                }
+                check(written > 0, "cannot write the file");
+                data += written;
+                bytes -= static_cast<size_t>(written);
+            }
+        }
+
+        /*!
+         * \brief Function that writes a buffer at a position of the file, without changing the current position
+         */
+        void pwrite_all(const void* buffer, size_t bytes, size_t offset) const{
+            const char* data = static_cast<const char*>(buffer);
+            while (bytes > 0){
+                const ssize_t written = ::pwrite(fd_, data, bytes, static_cast<off_t>(offset));
+                if (written < 0 && errno == EINTR){
+                    continue;
+                }
+                check(written > 0, "cannot write the file");
+                data += written;
+                offset += static_cast<size_t>(written);
+                bytes -= static_cast<size_t>(written);
+            }
+        }
+
+        /*!
+         * \brief Function that writes a sequence of buffers at the current position of the file with gather writes, i.e., with a single system call for up to `IOV_MAX` buffers.
+         * The buffers are modified to track the bytes that have been written.
+         * \param buffers pointer to the descriptors of the buffers
+         * \param count number of buffers
+         */
+        void writev_all(struct iovec* buffers, size_t count) const{
+            while (count > 0){
+                const int batch = static_cast<int>(std::min<size_t>(count, IOV_MAX));
+                ssize_t written = ::writev(fd_, buffers, batch);
+                if (written < 0 && errno == EINTR){
+                    continue;
+                }
+                check(written >= 0, "cannot write the file");
+                // skip the buffers that have been written completely, and advance the first one that has been written partially
+                while (count > 0 && static_cast<size_t>(written) >= buffers->iov_len){
+                    written -= static_cast<ssize_t>(buffers->iov_len);
+                    buffers++;
+                    count--;
+                }
+                if (count > 0){
+                    buffers->iov_base = static_cast<char*>(buffers->iov_base) + written;
+                    buffers->iov_len -= static_cast<size_t>(written);
+                }
+            }
+        }
+
+        /*!
+         * \brief Function that reads a buffer from a position of the file, without changing the current position
+         * \exception holor::exception::HolorRuntimeError if the file ends before all the bytes are read
+         */
+        void pread_all(void* buffer, size_t bytes, size_t offset) const{
+            char* data = static_cast<char*>(buffer);
+            while (bytes > 0){
+                const ssize_t count = ::pread(fd_, data, bytes, static_cast<off_t>(offset));
+                if (count < 0 && errno == EINTR){
+                    continue;
+                }
+                check(count >= 0, "cannot read the file");
+                check_content(count > 0, "unexpected end of the file");
+                data += count;
+                offset += static_cast<size_t>(count);
+                bytes -= static_cast<size_t>(count);
+            }
+        }
+
+        /*!
+         * \brief Function that forces the data written to the file to be stored on the device
+         */
+        void sync() const{
+            check(::fsync(fd_) == 0, "cannot synchronize the file");
+        }
+
+        /*!
+         * \brief Function that closes the file
+         */
+        void close(){
+            if (fd_ >= 0){
+                ::close(fd_);
+                fd_ = -1;
+            }
+        }
+
+        /*!
+         * \brief Function that throws an exception with the path of the file and the description of the last system error if the result of a system call is not valid
+         */
+        void check(bool condition, const char* message) const{
+            if (!condition) [[unlikely]]{
+                fail(message, true);
+            }
+        }
+
+        /*!
+         * \brief Function that throws an exception with the path of the file if its content is not valid, e.g., if it is truncated or it has a different format
+         */
+        void check_content(bool condition, const char* message) const{
+            if (!condition) [[unlikely]]{
+                fail(message, false);
+            }
+        }
+
+    private:
+        int fd_ = -1;           ///< \brief file descriptor, or -1 if no file is open
+        std::string path_;      ///< \brief path of the file, used in the messages of the exceptions
+
+        [[noreturn, gnu::cold, gnu::noinline]] void fail(const char* message, bool system_error) const{
+            std::string description = std::string("holor::File - ") + message + " '" + path_ + "'";
+            if (system_error && errno != 0){
+                description += std::string(": ") + std::strerror(errno);
+            }
+            assert::impl::assertion_failure<exception::HolorRuntimeError>(description);
+        }
+};
+
+
+
+/*================================================================================================
+                                    MEMORY MAP
+================================================================================================*/
+/*!
+ * \brief Class that owns a memory mapping of a whole file, unmapping it when it is destroyed.
+ * The pages of the file are read lazily by the kernel when they are accessed for the first time, so the mapping of a large file takes constant time. The mapping remains valid after the file is closed.
+ */
+class MemoryMap{
+    public:
+        MemoryMap() = default;
+
+        /*!
+         * \brief Constructor that maps the whole content of a file
+         * \param file the file, opened for reading, or for reading and writing if the mapping is writable and shared
+         * \param writable if true, the mapped memory can be written
+         * \param shared if true, the writes to the mapped memory are carried through to the file and are visible to the other mappings of the file; otherwise, the pages that are written are copied on write and the writes are private to the mapping
+         * \exception holor::exception::HolorRuntimeError if the file cannot be mapped
+         */
+        explicit MemoryMap(const File& file, bool writable = false, bool shared = true): size_{file.size()}{
+            if (size_ > 0){
+                void* address = ::mmap(nullptr, size_, writable ? (PROT_READ | PROT_WRITE) : PROT_READ, shared ? MAP_SHARED : MAP_PRIVATE, file.descriptor(), 0);
+                file.check(address != MAP_FAILED, "cannot map the file");
+                data_ = address;
+            }
+        }
+
+        MemoryMap(const MemoryMap&) = delete;
+        MemoryMap& operator=(const MemoryMap&) = delete;
+
+        MemoryMap(MemoryMap&& other) noexcept: data_{std::exchange(other.data_, nullptr)}, size_{std::exchange(other.size_, 0)}{}
+
+        MemoryMap& operator=(MemoryMap&& other) noexcept{
+            if (this != &other){
+                unmap();
+                data_ = std::exchange(other.data_, nullptr);
+                size_ = std::exchange(other.size_, 0);
+            }
+            return *this;
+        }
+
+        ~MemoryMap(){
+            unmap();
+        }
+
+        /*!
+         * \brief Get a pointer to the first byte of the mapping, or nullptr if the file is empty
+         */
+        unsigned char* data(){
+            return static_cast<unsigned char*>(data_);
+        }
+
+        const unsigned char* data() const{
+            return static_cast<const unsigned char*>(data_);
+        }
+
+        /*!
+         * \brief Get the size of the mapping in bytes
+         */
+        size_t size() const{
+            return size_;
+        }
+
+        /*!
+         * \brief Function that writes the modified pages of a shared mapping to the file, waiting for the writes to complete
+         * \param file the mapped file, used to report the errors
+         */
+        void sync(const File& file) const{
+            if (data_ != nullptr){
+                file.check(::msync(data_, size_, MS_SYNC) == 0, "cannot synchronize the mapping of the file");
+            }
+        }
+
+        /*!
+         * \brief Function that advises the kernel about how a range of bytes of the mapping will be accessed, e.g., with `MADV_SEQUENTIAL` to read ahead aggressively or with `MADV_WILLNEED` to start reading the pages.
+         * The range is extended to whole pages. The advice is only a hint, and it does not change the content of the mapping.
+         * \param file the mapped file, used to report the errors
+         * \param offset position of the first byte of the range in the mapping
+         * \param bytes size of the range
+         * \param advice the advice, one of the `MADV_*` constants of `madvise`
+         */
+        void advise(const File& file, size_t offset, size_t bytes, int advice) const{
+            if (data_ == nullptr || bytes == 0){
+                return;
+            }
+            const size_t page = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+            const size_t begin = offset - offset % page;
+            const size_t end = std::min(offset + bytes, size_);
+            file.check(::madvise(static_cast<char*>(data_) + begin, end - begin, advice) == 0, "cannot advise the kernel about the mapping of the file");
+        }
+
+    private:
+        void* data_ = nullptr;  ///< \brief address of the mapping, or nullptr if nothing is mapped
+        size_t size_ = 0;       ///< \brief size of the mapping in bytes
+
+        void unmap(){
+            if (data_ != nullptr){
+                ::munmap(data_, size_);
+                data_ = nullptr;
+            }
+        }
+};
+
+} //namespace impl
+
+} //namespace holor
+
+#endif // HOLOR_FILE_H
@@ -0,0 +1,405 @@
+// This file is part of Holor, a C++ header-only template library for multi-dimensional containers
+
+// Copyright 2020-2022 Carlo Masone
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to 
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is 
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER 
+// DEALINGS IN THE SOFTWARE.
+
+
+
+
+#ifndef HOLOR_NPY_H
+#define HOLOR_NPY_H
+
+/** \file holor_npy.h
+ * \brief This header contains the functions that read and write holor containers in the NumPy `.npy` format, which stores a single array with a header that describes the type of its elements, its shape and its ordering.
+ *
+ * An `.npy` file begins with the magic string `\x93NUMPY`, the major and minor versions of the format and the length of the header, which is a little-endian integer of 2 bytes (version 1.0) or 4 bytes (versions 2.0 and 3.0).
+ * The header is the text of a Python dictionary, e.g., `{'descr': '<f8', 'fortran_order': False, 'shape': (2, 3), }`, padded with spaces and terminated by a newline so that the elements begin at a multiple of 64 bytes.
+ * The elements follow the header, in row-major order (C order) or in column-major order (Fortran order). Only the arrays of booleans, integers and floating point numbers are supported.
+ *
+ * Arrays in C order are read directly into the memory of a Holor. Arrays in Fortran order have the same memory representation of the transposition of an array in C order, so they are read in chunks that are copied into a Holor
+ * with the blocked transposition, or they are described without copies by a HolorRef with a transposed layout. The function `map_npy` maps a file in memory, and returns a read-only HolorRef to its elements that can be created in constant time.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cctype>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "../holor/holor.h"
+#include "../holor/holor_ref.h"
+#include "../holor/holor_concepts.h"
+#include "../layout/layout.h"
+#include "../layout/layout_traversal.h"
+#include "../operations/holor_operations.h"
+#include "file.h"
+#include "holor_serialization.h"
+
+
+namespace holor{
+
+namespace impl{
+
+/*================================================================================================
+                                    NPY FORMAT
+================================================================================================*/
+inline constexpr unsigned char npy_magic[6] = {0x93, 'N', 'U', 'M', 'P', 'Y'};    ///< \brief magic string at the beginning of a `.npy` file
+inline constexpr size_t npy_alignment = 64;                                       ///< \brief alignment of the beginning of the elements in the files that are written
+
+/*!
+ * \brief Structure that contains the information in the header of a `.npy` file
+ */
+struct NpyHeader{
+    ElementType type_;                  /*! type of the elements */
+    std::endian order_;                 /*! byte order of the elements */
+    bool fortran_order_;                /*! true if the elements are stored in column-major order */
+    std::vector<size_t> lengths_;       /*! lengths of the dimensions (the shape of the array) */
+    size_t data_offset_;                /*! position of the first element in the file */
+
+    /*!
+     * \brief Function that returns the number of elements described by the header
+     */
+    size_t elements() const{
+        size_t result = 1;
+        for (auto length : lengths_){
+            result *= length;
+        }
+        return result;
+    }
+};
+
+
+/*!
+ * \brief Function that encodes the header of a `.npy` file, using the version 1.0 of the format if the dictionary is shorter than 64 KiB and the version 2.0 otherwise
+ * \param type the type of the elements
+ * \param lengths the lengths of the dimensions
+ * \param fortran_order true if the elements are written in column-major order
+ * \return the bytes of the header, whose size is a multiple of `npy_alignment`
+ */
+inline std::vector<unsigned char> encode_npy_header(const ElementType& type, const std::vector<size_t>& lengths, bool fortran_order){
+    std::string dictionary = "{'descr': '";
+    dictionary += (type.size_ == 1) ? '|' : ((std::endian::native == std::endian::little) ? '<' : '>');
+    dictionary += type.kind_ + std::to_string(type.size_) + "', 'fortran_order': " + (fortran_order ? "True" : "False") + ", 'shape': (";
+    for (auto length : lengths){
+        dictionary += std::to_string(length) + ", ";
+    }
+    if (lengths.size() > 1){
+        dictionary.resize(dictionary.size() - 2);
+    } else{
+        dictionary.resize(dictionary.size() - 1);
+    }
+    dictionary += "), }";
+
+    const bool small = (dictionary.size() + 1 + 10 + npy_alignment <= 65535);
+    const size_t prefix = small ? 10 : 12;
+    const size_t padding = (npy_alignment - (prefix + dictionary.size() + 1) % npy_alignment) % npy_alignment;
+    dictionary.append(padding, ' ');
+    dictionary += '\n';
+
+    std::vector<unsigned char> bytes(std::begin(npy_magic), std::end(npy_magic));
+    bytes.push_back(small ? 1 : 2);
+    bytes.push_back(0);
+    bytes.resize(prefix);
+    if (small){
+        encode_unsigned(bytes.data() + 8, static_cast<uint16_t>(dictionary.size()), std::endian::little);
+    } else{
+        encode_unsigned(bytes.data() + 8, static_cast<uint32_t>(dictionary.size()), std::endian::little);
+    }
+    bytes.insert(bytes.end(), dictionary.begin(), dictionary.end());
+    return bytes;
+}
+
+
+/*!
+ * \brief Function that finds the value of a key in the dictionary of the header of a `.npy` file
+ * \param file the file, used to report the errors
+ * \param dictionary the text of the dictionary
+ * \param key the key, without quotes
+ * \exception holor::exception::HolorRuntimeError if the key is not in the dictionary
+ * \return the position of the first character of the value
+ */
+inline size_t npy_find_value(const File& file, const std::string& dictionary, const std::string& key){
+    size_t position = dictionary.find("'" + key + "'");
+    if (position == std::string::npos){
+        position = dictionary.find("\"" + key + "\"");
+    }
+    file.check_content(position != std::string::npos, "missing key in the header of the npy file");
+    position = dictionary.find(':', position + key.size() + 2);
+    file.check_content(position != std::string::npos, "invalid header of the npy file");
+    position++;
+    while (position < dictionary.size() && std::isspace(static_cast<unsigned char>(dictionary[position]))){
+        position++;
+    }
+    return position;
+}
+
+
+/*!
+ * \brief Function that reads and validates the header of a `.npy` file
+ * \param file the file
+ * \exception holor::exception::HolorRuntimeError if the file is not a valid `.npy` file, if the type of its elements is not supported, or if it is shorter than the size described by the header
+ * \return the header
+ */
+inline NpyHeader read_npy_header(const File& file){
+    std::array<unsigned char, 12> prefix;
+    file.pread_all(prefix.data(), 10, 0);
+    file.check_content(std::equal(std::begin(npy_magic), std::end(npy_magic), prefix.begin()), "not a npy file");
+    const unsigned major = prefix[6];
+    file.check_content(major >= 1 && major <= 3, "unsupported version of the npy format");
+    size_t length;
+    NpyHeader header;
+    if (major == 1){
+        length = decode_unsigned<uint16_t>(prefix.data() + 8, std::endian::little);
+        header.data_offset_ = 10 + length;
+    } else{
+        file.pread_all(prefix.data() + 10, 2, 10);
+        length = decode_unsigned<uint32_t>(prefix.data() + 8, std::endian::little);
+        header.data_offset_ = 12 + length;
+    }
+    std::string dictionary(length, '\0');
+    file.pread_all(dictionary.data(), length, header.data_offset_ - length);
+
+    // 'descr': a string with the byte order, the kind and the size of the elements, e.g. '<f8'
+    size_t position = npy_find_value(file, dictionary, "descr");
+    file.check_content(position < dictionary.size() && (dictionary[position] == '\'' || dictionary[position] == '"'), "unsupported type of the elements in the npy file");
+    const size_t end = dictionary.find(dictionary[position], position + 1);
+    file.check_content(end != std::string::npos && end >= position + 4, "invalid type of the elements in the npy file");
+    const std::string descr = dictionary.substr(position + 1, end - position - 1);
+    const char order = descr[0];
+    file.check_content(order == '<' || order == '>' || order == '|' || order == '=', "invalid byte order in the npy file");
+    header.order_ = (order == '<') ? std::endian::little : ((order == '>') ? std::endian::big : std::endian::native);
+    header.type_.kind_ = descr[1];
+    file.check_content(std::all_of(descr.begin() + 2, descr.end(), [](char c){ return std::isdigit(static_cast<unsigned char>(c)); }), "unsupported type of the elements in the npy file");
+    header.type_.size_ = std::stoul(descr.substr(2));
+
+    // 'fortran_order': True or False
+    position = npy_find_value(file, dictionary, "fortran_order");
+    header.fortran_order_ = (dictionary.compare(position, 4, "True") == 0);
+    file.check_content(header.fortran_order_ || dictionary.compare(position, 5, "False") == 0, "invalid ordering in the npy file");
+
+    // 'shape': a tuple of integers, e.g. (2, 3) or (5,)
+    position = npy_find_value(file, dictionary, "shape");
+    file.check_content(position < dictionary.size() && dictionary[position] == '(', "invalid shape in the npy file");
+    position++;
+    while (true){
+        while (position < dictionary.size() && (std::isspace(static_cast<unsigned char>(dictionary[position])) || dictionary[position] == ',')){
+            position++;
+        }
+        file.check_content(position < dictionary.size(), "invalid shape in the npy file");
+        if (dictionary[position] == ')'){
+            break;
+        }
+        file.check_content(std::isdigit(static_cast<unsigned char>(dictionary[position])), "invalid shape in the npy file");
+        size_t value = 0;
+        while (position < dictionary.size() && std::isdigit(static_cast<unsigned char>(dictionary[position]))){
+            value = 10*value + static_cast<size_t>(dictionary[position] - '0');
+            position++;
+        }
+        header.lengths_.push_back(value);
+    }
+    file.check_content(file.size() >= header.data_offset_ + header.elements()*header.type_.size_, "the size of the data does not match the header of the npy file");
+    return header;
+}
+
+
+/*!
+ * \brief Function that reads the header of a `.npy` file and verifies that it describes an array with elements of type `T` and `N` dimensions
+ * \return the header
+ */
+template<typename T, size_t N>
+NpyHeader read_npy_header(const File& file){
+    const auto header = read_npy_header(file);
+    file.check_content(header.type_ == element_type<T>(), "the type of the elements does not match the npy file");
+    file.check_content(header.lengths_.size() == N, "the number of dimensions does not match the npy file");
+    return header;
+}
+
+
+/*!
+ * \brief Function that returns the layout of the elements stored in a `.npy` file: a row-major layout for the C order, and the transposition of a row-major layout with the lengths reversed for the Fortran order
+ */
+template<size_t N>
+Layout<N> npy_layout(const NpyHeader& header){
+    std::array<size_t, N> lengths{};
+    if (header.fortran_order_){
+        std::reverse_copy(header.lengths_.begin(), header.lengths_.end(), lengths.begin());
+        Layout<N> layout(lengths);
+        layout.transpose();
+        return layout;
+    }
+    std::copy(header.lengths_.begin(), header.lengths_.end(), lengths.begin());
+    return Layout<N>(lengths);
+}
+
+} //namespace impl
+
+
+
+/*================================================================================================
+                                    SAVE AND LOAD
+================================================================================================*/
+/*!
+ * \brief Function that saves a holor container in a `.npy` file, which can be read with `numpy.load`.
+ * The elements are written in C order; if the container is the transposition of a contiguous container (e.g., the result of `transpose_view`), they are written in Fortran order directly from its memory.
+ * \tparam H is the type of the container, whose elements must be of an arithmetic type
+ * \param path the path of the file, which is created or overwritten
+ * \param holor the container
+ * \exception holor::exception::HolorRuntimeError if the file cannot be written. This check does not depend on the compiler flag DDEFINE_ASSERT_LEVEL.
+ */
+template<HolorType H> requires std::is_arithmetic_v<typename H::value_type>
+void save_npy(const std::filesystem::path& path, const H& holor){
+    using T = typename H::value_type;
+    const auto lengths = holor.lengths();
+    const std::vector<size_t> shape(lengths.begin(), lengths.end());
+    auto memory = holor.layout();
+    memory.transpose();
+    impl::File file(path, impl::File::write);
+    if (!holor.layout().is_contiguous() && memory.is_contiguous()){
+        HolorRef<const T, H::dimensions> columns(holor.data(), memory);
+        impl::write_elements(file, columns, impl::encode_npy_header(impl::element_type<T>(), shape, true));
+    } else{
+        impl::write_elements(file, holor, impl::encode_npy_header(impl::element_type<T>(), shape, false));
+    }
+}
+
+
+/*!
+ * \brief Function that loads a holor container from a `.npy` file. The elements in C order are read with a single system call directly into the memory of the new container,
+ * while the elements in Fortran order are read in chunks of about 1 MiB, that are copied into the new container with the blocked transposition. The elements are converted if the file has a different byte order.
+ * \tparam T is the type of the elements, which must match the type of the elements in the file
+ * \tparam N is the number of dimensions, which must match the number of dimensions in the file
+ * \tparam Allocator is the allocator of the new container
+ * \param path the path of the file
+ * \exception holor::exception::HolorRuntimeError if the file cannot be read, if it is not a valid `.npy` file, or if the type of its elements or its number of dimensions do not match `T` and `N`. This check does not depend on the compiler flag DDEFINE_ASSERT_LEVEL.
+ * \return a new Holor with the shape and the elements stored in the file
+ */
+template<typename T, size_t N, class Allocator = std::allocator<T>> requires (std::is_arithmetic_v<T> && (N > 0))
+Holor<T, N, Allocator> load_npy(const std::filesystem::path& path){
+    impl::File file(path, impl::File::read);
+    const auto header = impl::read_npy_header<T, N>(file);
+    const auto layout = impl::npy_layout<N>(header);
+    Holor<T, N, Allocator> result(holor::uninitialized, layout.lengths());
+    if (result.size() == 0){
+        return result;
+    }
+    if (header.fortran_order_){
+        // the file stores the transposition of the container: slabs of its outermost dimension, i.e. of the innermost dimension of the container, are read in chunks and copied with the blocked transposition
+        const size_t slab_elements = result.size()/layout.length(N-1);
+        const size_t slabs = std::max<size_t>(1, impl::io_chunk_bytes/(slab_elements*sizeof(T)));
+        std::unique_ptr<T[]> buffer(new T[std::min(slabs, layout.length(N-1))*slab_elements]);
+        for (size_t begin = 0; begin < layout.length(N-1); begin += slabs){
+            const size_t end = std::min(begin + slabs, layout.length(N-1));
+            file.pread_all(buffer.get(), (end - begin)*slab_elements*sizeof(T), header.data_offset_ + begin*slab_elements*sizeof(T));
+            // the chunk is described by its lengths and offsets rather than by ranges, which cannot select a single slab
+            auto chunk_lengths = layout.lengths();
+            chunk_lengths[N-1] = end - begin;
+            impl::copy_transposed(result.data(), buffer.get(), impl::normalize_layouts<N, 2>(chunk_lengths, {result.layout().strides(), layout.strides()}, {begin*result.layout().stride(N-1), layout.offset()}));
+        }
+    } else{
+        file.pread_all(result.data(), result.size()*sizeof(T), header.data_offset_);
+    }
+    if (header.order_ != std::endian::native && sizeof(T) > 1){
+        impl::byteswap(result.data(), result.size(), sizeof(T));
+    }
+    return result;
+}
+
+
+
+/*================================================================================================
+                                    MEMORY MAPPED NPY
+================================================================================================*/
+/*!
+ * \brief Class that maps a `.npy` file in memory and provides a read-only view of its elements, without copying them. The view of an array in Fortran order is a HolorRef with a transposed layout.
+ * Creating the mapping takes constant time, regardless of the size of the file: the pages of the file are read by the kernel only when they are accessed.
+ * The view is valid as long as the object that owns the mapping exists; moving the object does not invalidate the view.
+ * \tparam T the type of the elements, which must match the type of the elements in the file
+ * \tparam N the number of dimensions, which must match the number of dimensions in the file
+ */
+template<typename T, size_t N> requires (std::is_arithmetic_v<T> && (N > 0))
+class MappedNpy{
+    public:
+        /*!
+         * \brief Constructor that maps a `.npy` file in memory
+         * \param path the path of the file
+         * \exception holor::exception::HolorRuntimeError if the file cannot be mapped, if it is not a valid `.npy` file, if the type of its elements or its number of dimensions do not match `T` and `N`,
+         * or if its elements have a byte order different from the one of the machine, because they cannot be converted without copying them. This check does not depend on the compiler flag DDEFINE_ASSERT_LEVEL.
+         */
+        explicit MappedNpy(const std::filesystem::path& path){
+            impl::File file(path, impl::File::read);
+            const auto header = impl::read_npy_header<T, N>(file);
+            file.check_content(header.order_ == std::endian::native || sizeof(T) == 1, "the byte order of the elements does not match the machine, and the npy file cannot be mapped");
+            file.check_content(header.data_offset_ % alignof(T) == 0, "the elements are not aligned, and the npy file cannot be mapped");
+            fortran_order_ = header.fortran_order_;
+            map_ = impl::MemoryMap(file);
+            const T* data = (header.elements() > 0) ? reinterpret_cast<const T*>(map_.data() + header.data_offset_) : nullptr;
+            view_ = HolorRef<const T, N>(data, impl::npy_layout<N>(header));
+        }
+
+        /*!
+         * \brief Get a read-only view of the elements of the file
+         */
+        HolorRef<const T, N> view() const{
+            return view_;
+        }
+
+        /*!
+         * \brief Get the lengths of the array stored in the file
+         */
+        std::array<size_t, N> lengths() const{
+            return view_.lengths();
+        }
+
+        /*!
+         * \brief Verify if the elements are stored in column-major order, i.e., if the view has a transposed layout
+         */
+        bool fortran_order() const{
+            return fortran_order_;
+        }
+
+    private:
+        impl::MemoryMap map_;               ///< \brief mapping of the file
+        HolorRef<const T, N> view_;         ///< \brief view of the elements in the mapping
+        bool fortran_order_ = false;        ///< \brief true if the elements are stored in column-major order
+};
+
+
+/*!
+ * \brief Function that maps a `.npy` file in memory, so that its elements can be accessed with a read-only HolorRef without loading them. See MappedNpy.
+ * \tparam T the type of the elements, which must match the type of the elements in the file
+ * \tparam N the number of dimensions, which must match the number of dimensions in the file
+ * \param path the path of the file
+ * \exception holor::exception::HolorRuntimeError if the file cannot be mapped. This check does not depend on the compiler flag DDEFINE_ASSERT_LEVEL.
+ * \return the object that owns the mapping, whose function `view()` returns a HolorRef<const T, N> to the elements
+ */
+template<typename T, size_t N> requires (std::is_arithmetic_v<T> && (N > 0))
+MappedNpy<T, N> map_npy(const std::filesystem::path& path){
+    return MappedNpy<T, N>(path);
+}
+
+} //namespace holor
+
+#endif // HOLOR_NPY_H
@@ -0,0 +1,336 @@
+// This file is part of Holor, a C++ header-only template library for multi-dimensional containers
+
+// Copyright 2020-2022 Carlo Masone
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to 
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is 
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER 
+// DEALINGS IN THE SOFTWARE.
+
+
+
+#ifndef HOLOR_SERIALIZATION_H
+#define HOLOR_SERIALIZATION_H
+
+/** \file holor_serialization.h
+ * \brief This header contains the functions `save` and `load`, that store a holor container in a binary file and read it back.
+ *
+ * A binary file contains a header that describes the container, followed by its elements in row-major order, as they are stored in memory. The header has a size of `16 + 8*N` bytes, so that the elements are aligned to 8 bytes:
+ *  - bytes 0-4: the magic string `HOLOR`;
+ *  - byte 5: the version of the format, currently 1;
+ *  - byte 6: the byte order of the numbers in the file, `<` for little-endian and `>` for big-endian;
+ *  - byte 7: the kind of the elements, `b` for `bool`, `i` for signed integers, `u` for unsigned integers and `f` for floating point numbers;
+ *  - byte 8: the size of the elements in bytes;
+ *  - bytes 9-11: reserved, set to zero;
+ *  - bytes 12-15: the number of dimensions `N`, as an unsigned integer of 32 bits;
+ *  - bytes 16-(16+8N): the lengths of the dimensions, as unsigned integers of 64 bits.
+ *
+ * The elements of a contiguous container are written together with the header with a single gather write, while the elements of a strided container (e.g., a slice or a transposed view) are written
+ * by runs (gathering the contiguous runs of elements in the same system call) or copied in chunks to a buffer with the blocked transposition. A file written on a machine with a different byte order is converted when it is loaded.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <filesystem>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+#include <sys/uio.h>
+
+#include "../holor/holor.h"
+#include "../holor/holor_concepts.h"
+#include "../common/runtime_assertions.h"
+#include "../layout/layout_traversal.h"
+#include "../operations/holor_operations.h"
+#include "file.h"
+
+
+namespace holor{
+
+namespace impl{
+
+/*================================================================================================
+                                    FORMAT
+================================================================================================*/
+inline constexpr char binary_magic[5] = {'H', 'O', 'L', 'O', 'R'};    ///< \brief magic string at the beginning of a binary file
+inline constexpr uint8_t binary_version = 1;                          ///< \brief version of the format of the binary files
+inline constexpr size_t binary_fixed_header = 16;                     ///< \brief size of the part of the header that does not depend on the number of dimensions
+inline constexpr size_t io_chunk_bytes = size_t{1} << 20;            ///< \brief size of the buffer used to write the elements of a container that are not contiguous
+inline constexpr size_t io_gather_run_bytes = 512;                    ///< \brief minimum size of a run of contiguous elements that is written directly from the container, without copying it to a buffer
+
+/*!
+ * \brief Structure that describes the type of the elements stored in a file, with a character that denotes its kind and its size in bytes
+ */
+struct ElementType{
+    char kind_;     /*! `b` for bool, `i` for signed integers, `u` for unsigned integers, `f` for floating point numbers */
+    size_t size_;   /*! size of an element in bytes */
+
+    friend bool operator==(const ElementType&, const ElementType&) = default;
+};
+
+/*!
+ * \brief Function that returns the description of an arithmetic type in a file
+ */
+template<typename T> requires std::is_arithmetic_v<T>
+constexpr ElementType element_type(){
+    if constexpr(std::is_same_v<T, bool>){
+        return {'b', sizeof(T)};
+    } else if constexpr(std::is_floating_point_v<T>){
+        return {'f', sizeof(T)};
+    } else if constexpr(std::is_signed_v<T>){
+        return {'i', sizeof(T)};
+    } else{
+        return {'u', sizeof(T)};
+    }
+}
+
+/*!
+ * \brief Function that reverses the order of the bytes of `n` consecutive values of `size` bytes each, converting them between little-endian and big-endian
+ */
+inline void byteswap(void* data, size_t n, size_t size){
+    auto bytes = static_cast<unsigned char*>(data);
+    for (size_t i = 0; i < n; i++, bytes += size){
+        std::reverse(bytes, bytes + size);
+    }
+}
+
+/*!
+ * \brief Function that writes an unsigned integer in a buffer with a byte order
+ */
+template<std::unsigned_integral U>
+void encode_unsigned(unsigned char* dest, U value, std::endian order){
+    for (size_t i = 0; i < sizeof(U); i++){
+        const size_t shift = 8*((order == std::endian::little) ? i : sizeof(U) - 1 - i);
+        dest[i] = static_cast<unsigned char>(value >> shift);
+    }
+}
+
+/*!
+ * \brief Function that reads an unsigned integer from a buffer with a byte order
+ */
+template<std::unsigned_integral U>
+U decode_unsigned(const unsigned char* source, std::endian order){
+    U value = 0;
+    for (size_t i = 0; i < sizeof(U); i++){
+        const size_t shift = 8*((order == std::endian::little) ? i : sizeof(U) - 1 - i);
+        value |= static_cast<U>(source[i]) << shift;
+    }
+    return value;
+}
+
+/*!
+ * \brief Structure that contains the information in the header of a binary file
+ */
+struct BinaryHeader{
+    ElementType type_;                  /*! type of the elements */
+    std::endian order_;                 /*! byte order of the numbers in the file */
+    std::vector<size_t> lengths_;       /*! lengths of the dimensions */
+
+    /*!
+     * \brief Function that returns the size of the header in bytes
+     */
+    size_t size() const{
+        return binary_fixed_header + 8*lengths_.size();
+    }
+
+    /*!
+     * \brief Function that returns the number of elements described by the header
+     */
+    size_t elements() const{
+        size_t result = 1;
+        for (auto length : lengths_){
+            result *= length;
+        }
+        return result;
+    }
+
+    /*!
+     * \brief Function that encodes the header in a sequence of bytes
+     */
+    std::vector<unsigned char> encode() const{
+        std::vector<unsigned char> bytes(size(), 0);
+        std::copy(std::begin(binary_magic), std::end(binary_magic), bytes.begin());
+        bytes[5] = binary_version;
+        bytes[6] = (order_ == std::endian::little) ? '<' : '>';
+        bytes[7] = static_cast<unsigned char>(type_.kind_);
+        bytes[8] = static_cast<unsigned char>(type_.size_);
+        encode_unsigned(bytes.data() + 12, static_cast<uint32_t>(lengths_.size()), order_);
+        for (size_t i = 0; i < lengths_.size(); i++){
+            encode_unsigned(bytes.data() + binary_fixed_header + 8*i, static_cast<uint64_t>(lengths_[i]), order_);
+        }
+        return bytes;
+    }
+};
+
+/*!
+ * \brief Function that reads and validates the header of a binary file
+ * \param file the file
+ * \param growing true if the file is being written by a HolorStreamWriter (see holor_stream.h): the file can contain more elements than the header describes
+ * \exception holor::exception::HolorRuntimeError if the file is not a valid binary file, or if its size is different from the size described by the header
+ * \return the header
+ */
+inline BinaryHeader read_binary_header(const File& file, bool growing = false){
+    std::array<unsigned char, binary_fixed_header> fixed;
+    file.pread_all(fixed.data(), fixed.size(), 0);
+    file.check_content(std::equal(std::begin(binary_magic), std::end(binary_magic), fixed.begin()), "not a holor binary file");
+    file.check_content(fixed[5] == binary_version, "unsupported version of the holor binary format");
+    file.check_content(fixed[6] == '<' || fixed[6] == '>', "invalid byte order in the header of");
+    BinaryHeader header;
+    header.order_ = (fixed[6] == '<') ? std::endian::little : std::endian::big;
+    header.type_ = {static_cast<char>(fixed[7]), fixed[8]};
+    const auto dimensions = decode_unsigned<uint32_t>(fixed.data() + 12, header.order_);
+    file.check_content(dimensions > 0 && dimensions <= 64, "invalid number of dimensions in the header of");
+    std::vector<unsigned char> lengths(8*dimensions);
+    file.pread_all(lengths.data(), lengths.size(), binary_fixed_header);
+    for (size_t i = 0; i < dimensions; i++){
+        header.lengths_.push_back(static_cast<size_t>(decode_unsigned<uint64_t>(lengths.data() + 8*i, header.order_)));
+    }
+    const size_t expected = header.size() + header.elements()*header.type_.size_;
+    file.check_content(growing ? (file.size() >= expected) : (file.size() == expected), "the size of the data does not match the header of");
+    return header;
+}
+
+/*!
+ * \brief Function that writes the elements of a container at the current position of a file, in row-major order, together with a prefix (e.g., the header of the file)
+ * \param file the file
+ * \param holor the container
+ * \param prefix the bytes written before the elements
+ */
+template<HolorType H>
+void write_elements(const File& file, const H& holor, const std::vector<unsigned char>& prefix){
+    using T = typename H::value_type;
+    const T* data = holor.data();
+    const auto& layout = holor.layout();
+    if (holor.size() == 0){
+        file.write_all(prefix.data(), prefix.size());
+        return;
+    }
+    if (layout.is_contiguous()){
+        // a single gather write for the prefix and all the elements
+        struct iovec buffers[2] = {{const_cast<unsigned char*>(prefix.data()), prefix.size()}, {const_cast<T*>(data + layout.offset()), holor.size()*sizeof(T)}};
+        file.writev_all(buffers, 2);
+        return;
+    }
+    file.write_all(prefix.data(), prefix.size());
+    const auto normalized = impl::normalize_layouts(layout);
+    const size_t inner = normalized.dimensions_ - 1;
+    const size_t run = normalized.lengths_[inner];
+    if (normalized.strides_[0][inner] == 1 && run*sizeof(T) >= io_gather_run_bytes){
+        // the runs of contiguous elements are written directly from the container, with gather writes
+        auto outer = normalized;
+        outer.lengths_[inner] = 1;
+        outer.size_ = normalized.size_/run;
+        std::vector<struct iovec> buffers;
+        buffers.reserve(std::min<size_t>(outer.size_, IOV_MAX));
+        impl::for_each_index(outer, [&](size_t i){
+            buffers.push_back({const_cast<T*>(data + i), run*sizeof(T)});
+            if (buffers.size() == IOV_MAX){
+                file.writev_all(buffers.data(), buffers.size());
+                buffers.clear();
+            }
+        });
+        file.writev_all(buffers.data(), buffers.size());
+        return;
+    }
+    // the elements are copied in chunks to a buffer: slabs of the outermost dimension are copied with the blocked transposition, which reads the source by contiguous runs when it is transposed
+    const size_t capacity = std::max<size_t>(1, io_chunk_bytes/sizeof(T));
+    const size_t slab_elements = holor.size()/layout.length(0);
+    if constexpr(H::dimensions > 1){
+        if (slab_elements <= capacity){
+            const size_t slabs = capacity/slab_elements;
+            const auto buffer_strides = Layout<H::dimensions>(layout.lengths()).strides();
+            std::unique_ptr<T[]> buffer(new T[std::min(slabs, layout.length(0))*slab_elements]);
+            for (size_t begin = 0; begin < layout.length(0); begin += slabs){
+                // the chunk is described by its lengths and offset rather than by a range, which cannot select a single slab
+                const size_t end = std::min(begin + slabs, layout.length(0));
+                auto chunk_lengths = layout.lengths();
+                chunk_lengths[0] = end - begin;
+                impl::copy_transposed(buffer.get(), data, impl::normalize_layouts<H::dimensions, 2>(chunk_lengths, {buffer_strides, layout.strides()}, {0, layout.offset() + begin*layout.stride(0)}));
+                file.write_all(buffer.get(), (end - begin)*slab_elements*sizeof(T));
+            }
+            return;
+        }
+    }
+    std::unique_ptr<T[]> buffer(new T[std::min(capacity, holor.size())]);
+    size_t count = 0;
+    impl::for_each_index(normalized, [&](size_t i){
+        buffer[count++] = data[i];
+        if (count == capacity){
+            file.write_all(buffer.get(), count*sizeof(T));
+            count = 0;
+        }
+    });
+    file.write_all(buffer.get(), count*sizeof(T));
+}
+
+} //namespace impl
+
+
+
+/*================================================================================================
+                                    SAVE AND LOAD
+================================================================================================*/
+/*!
+ * \brief Function that saves a holor container in a binary file, with a header that describes the type of its elements, its number of dimensions, its lengths and the byte order, followed by its elements in row-major order.
+ * A contiguous container is written with a single system call; the elements of a strided container are gathered by runs or copied in chunks to a buffer.
+ * \tparam H is the type of the container, whose elements must be of an arithmetic type
+ * \param path the path of the file, which is created or overwritten
+ * \param holor the container
+ * \exception holor::exception::HolorRuntimeError if the file cannot be written. This check does not depend on the compiler flag DDEFINE_ASSERT_LEVEL.
+ */
+template<HolorType H> requires std::is_arithmetic_v<typename H::value_type>
+void save(const std::filesystem::path& path, const H& holor){
+    using T = typename H::value_type;
+    impl::BinaryHeader header{impl::element_type<T>(), std::endian::native, {}};
+    const auto lengths = holor.lengths();
+    header.lengths_.assign(lengths.begin(), lengths.end());
+    impl::File file(path, impl::File::write);
+    impl::write_elements(file, holor, header.encode());
+}
+
+
+/*!
+ * \brief Function that loads a holor container from a binary file written by `save`. The elements are read with a single system call directly into the memory of the new container, and they are converted if the file has a different byte order.
+ * \tparam T is the type of the elements, which must match the type of the elements in the file
+ * \tparam N is the number of dimensions, which must match the number of dimensions in the file
+ * \tparam Allocator is the allocator of the new container
+ * \param path the path of the file
+ * \exception holor::exception::HolorRuntimeError if the file cannot be read, if it is not a valid binary file, or if the type of its elements or its number of dimensions do not match `T` and `N`. This check does not depend on the compiler flag DDEFINE_ASSERT_LEVEL.
+ * \return a new Holor with the lengths and the elements stored in the file
+ */
+template<typename T, size_t N, class Allocator = std::allocator<T>> requires (std::is_arithmetic_v<T> && (N > 0))
+Holor<T, N, Allocator> load(const std::filesystem::path& path){
+    impl::File file(path, impl::File::read);
+    const auto header = impl::read_binary_header(file);
+    file.check_content(header.type_ == impl::element_type<T>(), "the type of the elements does not match the file");
+    file.check_content(header.lengths_.size() == N, "the number of dimensions does not match the file");
+    std::array<size_t, N> lengths{};
+    std::copy(header.lengths_.begin(), header.lengths_.end(), lengths.begin());
+    Holor<T, N, Allocator> result(holor::uninitialized, lengths);
+    file.pread_all(result.data(), result.size()*sizeof(T), header.size());
+    if (header.order_ != std::endian::native && sizeof(T) > 1){
+        impl::byteswap(result.data(), result.size(), sizeof(T));
+    }
+    return result;
+}
+
+} //namespace holor
+
+#endif // HOLOR_SERIALIZATION_H
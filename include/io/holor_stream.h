@@ -0,0 +1,296 @@
+// This file is part of Holor, a C++ header-only template library for multi-dimensional containers
+
+// Copyright 2020-2022 Carlo Masone
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to 
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is 
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER 
+// DEALINGS IN THE SOFTWARE.
+
+
+
+
+#ifndef HOLOR_STREAM_H
+#define HOLOR_STREAM_H
+
+/** \file holor_stream.h
+ * \brief This header contains the classes that write a binary file (see holor_serialization.h) by appending slabs along its first dimension, and that read it while it grows.
+ *
+ * The writer appends the elements at the end of the file and periodically updates the first length in the header, which is the number of rows that the readers can consume.
+ * The elements of the rows are always written before the header is updated, so a reader never sees a row that has not been written completely.
+ * When the writer is closed, the file is a valid binary file that can be loaded with `load` or mapped with MappedHolor.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <filesystem>
+#include <type_traits>
+#include <vector>
+
+#include "../holor/holor.h"
+#include "../holor/holor_concepts.h"
+#include "../layout/layout.h"
+#include "../layout/layout_traversal.h"
+#include "../common/runtime_assertions.h"
+#include "file.h"
+#include "holor_serialization.h"
+
+
+namespace holor{
+
+/*================================================================================================
+                                    STREAM WRITER
+================================================================================================*/
+/*!
+ * \brief Class that writes a binary file whose first dimension grows, by appending slabs of rows. The appended rows are collected in a buffer, which is written to the file when it is full or when `flush` is called;
+ * after each write the number of rows in the header is updated, so that a HolorStreamReader can read the rows while the file grows.
+ * \tparam T the type of the elements, which must be an arithmetic type
+ * \tparam N the number of dimensions of the file
+ */
+template<typename T, size_t N> requires (std::is_arithmetic_v<T> && (N > 0))
+class HolorStreamWriter{
+    public:
+        /*!
+         * \brief Constructor that creates a file with no rows
+         * \param path the path of the file, which is created or overwritten
+         * \param row_lengths the lengths of the dimensions after the first, i.e., the lengths of a row
+         * \param buffer_bytes the size of the buffer of the rows. The rows are written to the file, and become visible to the readers, when the buffer is full
+         * \param durable if true, the elements are synchronized to the device before the header is updated, so that after a crash the header does not describe rows that have not been stored
+         * \exception holor::exception::HolorRuntimeError if a length is zero. The compiler flag DDEFINE_ASSERT_LEVEL in the CMakeLists can be set to AssertionLevel::no_checks to exclude this check.
+         * \exception holor::exception::HolorRuntimeError if the file cannot be written. This check does not depend on the compiler flag DDEFINE_ASSERT_LEVEL.
+         */
+        HolorStreamWriter(const std::filesystem::path& path, const std::array<size_t, N-1>& row_lengths, size_t buffer_bytes = impl::io_chunk_bytes, bool durable = false): file_{path, impl::File::write}, durable_{durable}{
+            assert::dynamic_assert(std::ranges::all_of(row_lengths, [](size_t l){ return l > 0; }), EXCEPTION_MESSAGE("holor::HolorStreamWriter - The lengths of the rows must be positive."));
+            lengths_[0] = 0;
+            std::copy(row_lengths.begin(), row_lengths.end(), lengths_.begin() + 1);
+            row_size_ = 1;
+            for (auto length : row_lengths){
+                row_size_ *= length;
+            }
+            buffer_rows_ = std::max<size_t>(1, buffer_bytes/(row_size_*sizeof(T)));
+            header_ = {impl::element_type<T>(), std::endian::native, std::vector<size_t>(lengths_.begin(), lengths_.end())};
+            const auto bytes = header_.encode();
+            file_.pwrite_all(bytes.data(), bytes.size(), 0);
+            end_ = bytes.size();
+        }
+
+        HolorStreamWriter(const HolorStreamWriter&) = delete;
+        HolorStreamWriter& operator=(const HolorStreamWriter&) = delete;
+        HolorStreamWriter(HolorStreamWriter&&) = default;
+        HolorStreamWriter& operator=(HolorStreamWriter&&) = default;
+
+        /*!
+         * \brief Destructor that writes the rows in the buffer and closes the file, if it has not been closed. The errors are ignored: `close` must be called to detect them
+         */
+        ~HolorStreamWriter(){
+            try{
+                close();
+            } catch(...){}
+        }
+
+        /*!
+         * \brief Get the number of rows that have been appended
+         */
+        size_t rows() const{
+            return rows_;
+        }
+
+        /*!
+         * \brief Get the number of rows that have been written to the file, and that are visible to the readers
+         */
+        size_t committed_rows() const{
+            return lengths_[0];
+        }
+
+        /*!
+         * \brief Function that appends a slab of rows at the end of the file
+         * \param slab a container with `N` dimensions, whose lengths must be equal to the lengths of the file except for the first, or a container with `N-1` dimensions, that is appended as a single row
+         * \exception holor::exception::HolorRuntimeError if the lengths of the slab do not match the rows of the file. The compiler flag DDEFINE_ASSERT_LEVEL in the CMakeLists can be set to AssertionLevel::no_checks to exclude this check.
+         * \exception holor::exception::HolorRuntimeError if the writer has been closed or the file cannot be written. This check does not depend on the compiler flag DDEFINE_ASSERT_LEVEL.
+         */
+        template<HolorType H> requires ((H::dimensions == N || H::dimensions + 1 == N) && std::convertible_to<typename H::value_type, T>)
+        void append(const H& slab){
+            const auto slab_lengths = slab.lengths();
+            const auto slab_strides = slab.layout().strides();
+            constexpr size_t first = N - H::dimensions;
+            std::array<size_t, N> lengths;
+            std::array<std::ptrdiff_t, N> strides;
+            lengths[0] = 1;
+            strides[0] = 0;
+            std::copy(slab_lengths.begin(), slab_lengths.end(), lengths.begin() + first);
+            std::copy(slab_strides.begin(), slab_strides.end(), strides.begin() + first);
+            assert::dynamic_assert(std::equal(lengths.begin() + 1, lengths.end(), lengths_.begin() + 1), EXCEPTION_MESSAGE("holor::HolorStreamWriter - The lengths of the slab do not match the rows of the file."));
+            file_.check_content(file_.descriptor() >= 0, "the stream writer has been closed");
+
+            // the rows are copied to the buffer in groups that fill it
+            const auto* source = slab.data();
+            const size_t total = lengths[0];
+            for (size_t begin = 0; begin < total;){
+                lengths[0] = std::min(total - begin, buffer_rows_ - buffered_rows_);
+                const Layout<N> source_layout(lengths, strides, slab.layout().offset() + begin*static_cast<size_t>(strides[0]));
+                buffer_.resize((buffered_rows_ + lengths[0])*row_size_);
+                impl::for_each_index(impl::normalize_layouts(Layout<N>(lengths), source_layout), [dest = buffer_.data() + buffered_rows_*row_size_, source](size_t i, size_t j){
+                    dest[i] = static_cast<T>(source[j]);
+                });
+                buffered_rows_ += lengths[0];
+                rows_ += lengths[0];
+                begin += lengths[0];
+                if (buffered_rows_ == buffer_rows_){
+                    flush();
+                }
+            }
+        }
+
+        /*!
+         * \brief Function that writes the rows in the buffer to the file, and updates the number of rows in the header
+         * \exception holor::exception::HolorRuntimeError if the file cannot be written. This check does not depend on the compiler flag DDEFINE_ASSERT_LEVEL.
+         */
+        void flush(){
+            if (buffered_rows_ == 0){
+                return;
+            }
+            file_.pwrite_all(buffer_.data(), buffered_rows_*row_size_*sizeof(T), end_);
+            end_ += buffered_rows_*row_size_*sizeof(T);
+            if (durable_){
+                file_.sync();
+            }
+            lengths_[0] += buffered_rows_;
+            buffered_rows_ = 0;
+            buffer_.clear();
+            unsigned char rows[8];
+            impl::encode_unsigned(rows, static_cast<uint64_t>(lengths_[0]), header_.order_);
+            file_.pwrite_all(rows, sizeof(rows), impl::binary_fixed_header);
+            if (durable_){
+                file_.sync();
+            }
+        }
+
+        /*!
+         * \brief Function that writes the rows in the buffer and closes the file. Closing a writer that is already closed has no effect
+         * \exception holor::exception::HolorRuntimeError if the file cannot be written. This check does not depend on the compiler flag DDEFINE_ASSERT_LEVEL.
+         */
+        void close(){
+            if (file_.descriptor() < 0){
+                return;
+            }
+            flush();
+            file_.close();
+        }
+
+    private:
+        impl::File file_;                       ///< \brief the file
+        impl::BinaryHeader header_;             ///< \brief the header of the file
+        std::array<size_t, N> lengths_;         ///< \brief the lengths of the file, whose first element is the number of rows that have been written to the file
+        size_t row_size_ = 0;                   ///< \brief number of elements of a row
+        size_t rows_ = 0;                       ///< \brief number of rows that have been appended
+        size_t end_ = 0;                        ///< \brief position of the end of the rows that have been written to the file
+        impl::holor_storage<T, std::allocator<T>> buffer_;     ///< \brief buffer with the rows that have not been written to the file, whose elements are not initialized when it grows
+        size_t buffered_rows_ = 0;              ///< \brief number of rows in the buffer
+        size_t buffer_rows_ = 1;                ///< \brief capacity of the buffer in rows
+        bool durable_ = false;                  ///< \brief true if the elements are synchronized to the device before the header is updated
+};
+
+
+
+/*================================================================================================
+                                    STREAM READER
+================================================================================================*/
+/*!
+ * \brief Class that reads the rows of a binary file while it is written by a HolorStreamWriter. The number of rows is read from the header when the reader is created and when `refresh` is called.
+ * It can also read a binary file written by `save`, whose number of rows does not change.
+ * \tparam T the type of the elements, which must match the type of the elements in the file
+ * \tparam N the number of dimensions, which must match the number of dimensions in the file
+ */
+template<typename T, size_t N> requires (std::is_arithmetic_v<T> && (N > 0))
+class HolorStreamReader{
+    public:
+        /*!
+         * \brief Constructor that opens a file and reads its header
+         * \param path the path of the file
+         * \exception holor::exception::HolorRuntimeError if the file cannot be read, if it is not a valid binary file, or if the type of its elements or its number of dimensions do not match `T` and `N`. This check does not depend on the compiler flag DDEFINE_ASSERT_LEVEL.
+         */
+        explicit HolorStreamReader(const std::filesystem::path& path): file_{path, impl::File::read}{
+            header_ = impl::read_binary_header(file_, true);
+            file_.check_content(header_.type_ == impl::element_type<T>(), "the type of the elements does not match the file");
+            file_.check_content(header_.lengths_.size() == N, "the number of dimensions does not match the file");
+            std::copy(header_.lengths_.begin(), header_.lengths_.end(), lengths_.begin());
+            row_size_ = 1;
+            for (size_t i = 1; i < N; i++){
+                row_size_ *= lengths_[i];
+            }
+        }
+
+        /*!
+         * \brief Get the number of rows that can be read, as of the last call to `refresh`
+         */
+        size_t rows() const{
+            return lengths_[0];
+        }
+
+        /*!
+         * \brief Get the lengths of the file, whose first element is the number of rows that can be read
+         */
+        std::array<size_t, N> lengths() const{
+            return lengths_;
+        }
+
+        /*!
+         * \brief Function that reads again the number of rows from the header of the file
+         * \exception holor::exception::HolorRuntimeError if the file cannot be read, or if it is shorter than the header describes. This check does not depend on the compiler flag DDEFINE_ASSERT_LEVEL.
+         * \return the number of rows that can be read
+         */
+        size_t refresh(){
+            unsigned char rows[8];
+            file_.pread_all(rows, sizeof(rows), impl::binary_fixed_header);
+            const size_t count = static_cast<size_t>(impl::decode_unsigned<uint64_t>(rows, header_.order_));
+            file_.check_content(count >= lengths_[0] && file_.size() >= header_.size() + count*row_size_*sizeof(T), "the size of the data does not match the header of");
+            lengths_[0] = count;
+            return count;
+        }
+
+        /*!
+         * \brief Function that reads a range of rows
+         * \param first the index of the first row
+         * \param count the number of rows
+         * \exception holor::exception::HolorRuntimeError if `count` is zero or the rows are not in the file, as of the last call to `refresh`. The compiler flag DDEFINE_ASSERT_LEVEL in the CMakeLists can be set to AssertionLevel::no_checks to exclude this check.
+         * \exception holor::exception::HolorRuntimeError if the file cannot be read. This check does not depend on the compiler flag DDEFINE_ASSERT_LEVEL.
+         * \return a Holor with `count` rows
+         */
+        Holor<T, N> read(size_t first, size_t count){
+            assert::dynamic_assert(count > 0 && first + count <= lengths_[0], EXCEPTION_MESSAGE("holor::HolorStreamReader - The rows are not in the file."));
+            auto lengths = lengths_;
+            lengths[0] = count;
+            Holor<T, N> result(holor::uninitialized, lengths);
+            file_.pread_all(result.data(), result.size()*sizeof(T), header_.size() + first*row_size_*sizeof(T));
+            if (header_.order_ != std::endian::native && sizeof(T) > 1){
+                impl::byteswap(result.data(), result.size(), sizeof(T));
+            }
+            return result;
+        }
+
+    private:
+        impl::File file_;                       ///< \brief the file
+        impl::BinaryHeader header_;             ///< \brief the header of the file, as read when the reader was created
+        std::array<size_t, N> lengths_;         ///< \brief the lengths of the file, whose first element is the number of rows that can be read
+        size_t row_size_ = 1;                   ///< \brief number of elements of a row
+};
+
+} //namespace holor
+
+#endif // HOLOR_STREAM_H
@@ -0,0 +1,492 @@
+// This file is part of Holor, a C++ header-only template library for multi-dimensional containers
+
+// Copyright 2020-2022 Carlo Masone
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to 
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is 
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER 
+// DEALINGS IN THE SOFTWARE.
+
+
+
+
+#ifndef HOLOR_MAPPED_HOLOR_H
+#define HOLOR_MAPPED_HOLOR_H
+
+/** \file mapped_holor.h
+ * \brief This header contains the class MappedHolor, a holor container whose elements are stored in a memory mapped binary file (see holor_serialization.h), instead of a buffer allocated in memory.
+ */
+
+#include <cstddef>
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <filesystem>
+#include <iterator>
+#include <span>
+#include <type_traits>
+
+#include <sys/mman.h>
+
+#include "../holor/holor_ref.h"
+#include "../holor/holor_concepts.h"
+#include "../layout/layout.h"
+#include "../common/runtime_assertions.h"
+#include "file.h"
+#include "holor_serialization.h"
+
+
+namespace holor{
+
+/*================================================================================================
+                                    MAPPING OPTIONS
+================================================================================================*/
+/*!
+ * \brief Enumeration of the ways a file can be mapped by a MappedHolor
+ */
+enum class MapMode{
+    read_only,      ///< \brief the elements can only be read
+    copy_on_write,  ///< \brief the elements can be written, but the writes are private to the MappedHolor and are never carried through to the file
+    shared          ///< \brief the elements can be written, and the writes are carried through to the file
+};
+
+/*!
+ * \brief Enumeration of the hints about the expected access pattern to the elements of a MappedHolor, that are given to the kernel with `madvise`
+ */
+enum class MapAdvice{
+    normal,         ///< \brief no specific pattern: the kernel reads ahead a moderate number of pages
+    sequential,     ///< \brief the elements are read in order: the kernel reads ahead aggressively, and can drop the pages soon after they are read
+    random,         ///< \brief the elements are read in random order: the kernel does not read ahead, so that only the accessed pages are read
+    willneed,       ///< \brief the elements will be accessed soon: the kernel starts reading their pages in background
+    dontneed        ///< \brief the elements will not be accessed soon: the kernel can free their pages. It is ignored by copy-on-write mappings, whose written pages would be discarded together with the writes
+};
+
+namespace impl{
+    /*!
+     * \brief Function that returns the argument of `madvise` that corresponds to a MapAdvice
+     */
+    inline int madvise_flag(MapAdvice advice){
+        switch (advice){
+            case MapAdvice::sequential: return MADV_SEQUENTIAL;
+            case MapAdvice::random: return MADV_RANDOM;
+            case MapAdvice::willneed: return MADV_WILLNEED;
+            case MapAdvice::dontneed: return MADV_DONTNEED;
+            default: return MADV_NORMAL;
+        }
+    }
+}
+
+
+
+/*================================================================================================
+                                    MAPPED HOLOR CLASS
+================================================================================================*/
+/*!
+ * \brief Class that represents a multi-dimensional container whose elements are stored in a binary file written by `save` or created by `create_mapped`, which is mapped in memory.
+ *
+ * A MappedHolor has the same interface of a Holor for accessing and slicing its elements, and it can be used in all the operations, but its storage is the memory mapping of the file instead of a `std::vector`.
+ * Opening a MappedHolor takes constant time, regardless of the size of the file, because the pages of the file are read by the kernel only when they are accessed, and the pages that have not been accessed
+ * recently can be freed. Therefore, a MappedHolor can represent a dataset larger than the memory, whose slices are read on demand. The kernel can be advised about the pattern of the accesses with the function `advise`.
+ * The lengths of a MappedHolor are fixed by the file, and cannot be changed.
+ *
+ * A `MappedHolor<const T, N>` maps the file as read-only. A `MappedHolor<T, N>` maps the file as writable: if the mapping is shared, the writes are carried through to the file, either when the kernel decides to write back the pages or when `flush` is called;
+ * if the mapping is copy-on-write, the pages that are written are copied in memory and the file is never modified.
+ *
+ * \tparam T type of the elements stored in the file, which must be an arithmetic type. It is `const` for a read-only mapping.
+ * \tparam N the number of dimensions of the container
+ */
+template<typename T, size_t N> requires (std::is_arithmetic_v<std::remove_const_t<T>> && (alignof(T) <= 8) && (N>0))
+class MappedHolor{
+
+    public:
+        /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+                                    ALIASES
+        ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+        static constexpr size_t dimensions = N;                                 ///< \brief number of dimensions in the container
+        using value_type = std::remove_const_t<T>;                              ///< \brief type of the values in the container
+        using iterator = T*;                                                    ///< \brief type of the iterator for the container
+        using const_iterator = const T*;                                        ///< \brief type of the const_iterator for the container
+        using reverse_iterator = std::reverse_iterator<iterator>;               ///< \brief type of the reverse_iterator for the container
+        using const_reverse_iterator = std::reverse_iterator<const_iterator>;   ///< \brief type of the const_reverse_iterator for the container
+        using holor_type = holor::impl::HolorMappedTypeTag;                     ///< \brief tags a Holor type whose elements are stored in a memory mapped file
+
+
+        /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+                CONSTRUCTORS, ASSIGNMENTS AND DESTRUCTOR
+        ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+        MappedHolor() = default;                                        ///< \brief default constructor, that does not map any file
+        MappedHolor(MappedHolor&& holor) = default;                     ///< \brief default move constructor. The slices of the moved MappedHolor remain valid
+        MappedHolor& operator=(MappedHolor&& holor) = default;          ///< \brief default move assignment
+        MappedHolor(const MappedHolor& holor) = delete;                 ///< \brief a MappedHolor cannot be copied, because it owns the mapping
+        MappedHolor& operator=(const MappedHolor& holor) = delete;      ///< \brief a MappedHolor cannot be copied, because it owns the mapping
+        ~MappedHolor() = default;                                       ///< \brief default destructor, that unmaps the file. The writes to a shared mapping are not lost, but they are not guaranteed to be on the device until `flush` is called
+
+        /*!
+         * \brief Constructor that maps a binary file written by `save` or created by `create_mapped`
+         * \param path the path of the file
+         * \param mode the way the file is mapped. It must be `MapMode::read_only` if `T` is const, and by default it is `MapMode::shared` otherwise
+         * \param advice the hint about the expected access pattern to the elements
+         * \exception holor::exception::HolorRuntimeError if `T` is not const and `mode` is `MapMode::read_only`. The compiler flag DDEFINE_ASSERT_LEVEL in the CMakeLists can be set to AssertionLevel::no_checks to exclude this check.
+         * \exception holor::exception::HolorRuntimeError if the file cannot be mapped, if it is not a valid binary file, if the type of its elements or its number of dimensions do not match `T` and `N`, or if its elements have a byte order different from the one of the machine. This check does not depend on the compiler flag DDEFINE_ASSERT_LEVEL.
+         * \return a MappedHolor with the lengths and the elements stored in the file
+         */
+        explicit MappedHolor(const std::filesystem::path& path, MapMode mode = (std::is_const_v<T> ? MapMode::read_only : MapMode::shared), MapAdvice advice = MapAdvice::normal):
+            file_{path, (mode == MapMode::shared) ? impl::File::update : impl::File::read}, mode_{mode}{
+            assert::dynamic_assert(std::is_const_v<T> == (mode == MapMode::read_only), EXCEPTION_MESSAGE("holor::MappedHolor - A read-only mapping requires a MappedHolor<const T, N>, and a writable mapping a MappedHolor<T, N>."));
+            const auto header = impl::read_binary_header(file_);
+            file_.check_content(header.type_ == impl::element_type<value_type>(), "the type of the elements does not match the file");
+            file_.check_content(header.lengths_.size() == N, "the number of dimensions does not match the file");
+            file_.check_content(header.order_ == std::endian::native || sizeof(T) == 1, "the byte order of the elements does not match the machine, and the file cannot be mapped");
+            std::array<size_t, N> lengths{};
+            std::copy(header.lengths_.begin(), header.lengths_.end(), lengths.begin());
+            layout_ = Layout<N>(lengths);
+            map_ = impl::MemoryMap(file_, mode != MapMode::read_only, mode == MapMode::shared);
+            data_ = reinterpret_cast<T*>(map_.data() + header.size());
+            if (advice != MapAdvice::normal){
+                this->advise(advice);
+            }
+        }
+
+
+        /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+                                ITERATORS
+        ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+        iterator begin(){ return data_; } ///< \brief returns an iterator to the beginning
+        iterator end(){ return data_ + size(); } ///< \brief returns an iterator to the end
+        const_iterator begin() const{ return data_; } ///< \brief returns a constant iterator to the beginning
+        const_iterator end() const{ return data_ + size(); } ///< \brief returns a constant iterator to the end
+        const_iterator cbegin() const{ return data_; } ///< \brief returns a constant iterator to the beginning
+        const_iterator cend() const{ return data_ + size(); } ///< \brief returns a constant iterator to the end
+        reverse_iterator rbegin(){ return reverse_iterator(end()); } ///< \brief returns a reverse iterator to the beginning
+        reverse_iterator rend(){ return reverse_iterator(begin()); } ///< \brief returns a reverse iterator to the end
+        const_reverse_iterator crbegin() const{ return const_reverse_iterator(cend()); } ///< \brief returns a constant reverse iterator to the beginning
+        const_reverse_iterator crend() const{ return const_reverse_iterator(cbegin()); } ///< \brief returns a constant reverse iterator to the end
+
+
+        /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+                            GET/SET FUNCTIONS
+        ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+        /*!
+         * \brief Function that returns the Layout used to index the elements in the file
+         * \return Layout
+         */
+        const Layout<N>& layout() const{
+            return layout_;
+        }
+
+        /*!
+         * \brief Function that returns the number of elements along each of the container's dimensions
+         * \return the lengths of each dimension of the container
+         */
+        auto lengths() const{
+            return layout_.lengths();
+        }
+
+        /*!
+         * \brief Function that returns the strides of the container
+         * \return the strides of each dimension of the container
+         */
+        auto strides() const{
+            return layout_.strides();
+        }
+
+        /*!
+         * \brief Function that returns the number of elements along a specific dimension of the container
+         * \param dim the dimension to be inquired for its length
+         * \return the length of the selected dimension
+         */
+        auto length(size_t dim) const{
+            return layout_.length(dim);
+        }
+
+        /*!
+         * \brief Function that returns the total number of elements in the container
+         * \return the total number of elements in the container
+         */
+        size_t size() const{
+            return layout_.size();
+        }
+
+        /*!
+         * \brief Function that provides a flat access to the elements in the mapping
+         * \return a pointer to the first element
+         */
+        T* data(){
+            return data_;
+        }
+
+        const T* data() const{
+            return data_;
+        }
+
+        /*!
+         * \brief Function that returns the way the file is mapped
+         */
+        MapMode mode() const{
+            return mode_;
+        }
+
+        /*!
+         * \brief Function that verifies if the elements of the container are stored contiguously in memory. A MappedHolor is always contiguous
+         * \return true
+         */
+        constexpr bool is_contiguous() const{
+            return true;
+        }
+
+        /*!
+         * \brief Function that provides a flat view of the elements of the container
+         * \return a `std::span` over the elements of the container
+         */
+        std::span<T> span(){
+            return std::span<T>(data_, size());
+        }
+
+        std::span<const T> span() const{
+            return std::span<const T>(data_, size());
+        }
+
+        /*!
+         * \brief Function that returns a HolorRef to all the elements of the container, e.g., to compare them or to copy them into a Holor
+         * \return a HolorRef with the lengths of the container
+         */
+        HolorRef<T, N> view(){
+            return HolorRef<T, N>(data_, layout_);
+        }
+
+        HolorRef<const value_type, N> view() const{
+            return HolorRef<const value_type, N>(data_, layout_);
+        }
+
+
+        /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+                            MAPPING FUNCTIONS
+        ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+        /*!
+         * \brief Function that writes the modified elements of a shared mapping to the file, and waits until they are stored on the device. It has no effect on read-only and copy-on-write mappings
+         * \exception holor::exception::HolorRuntimeError if the mapping cannot be synchronized. This check does not depend on the compiler flag DDEFINE_ASSERT_LEVEL.
+         */
+        void flush() const{
+            if (mode_ == MapMode::shared){
+                map_.sync(file_);
+            }
+        }
+
+        /*!
+         * \brief Function that advises the kernel about the expected access pattern to all the elements, e.g., `MapAdvice::sequential` before a traversal of the whole container or `MapAdvice::random` before reading sparse slices
+         * \param advice the hint about the access pattern
+         * \exception holor::exception::HolorRuntimeError if the advice is rejected by the kernel. This check does not depend on the compiler flag DDEFINE_ASSERT_LEVEL.
+         */
+        void advise(MapAdvice advice) const{
+            if (ignores(advice)){
+                return;
+            }
+            map_.advise(file_, element_offset(0), size()*sizeof(T), impl::madvise_flag(advice));
+        }
+
+        /*!
+         * \brief Function that advises the kernel about the expected access pattern to the elements of a slice of the container, e.g., `MapAdvice::willneed` to start reading a slice that will be processed soon.
+         * The advice applies to all the pages between the first and the last element of the slice.
+         * \param slice a slice of this container, e.g., the result of `row`, `col`, `slice` or `operator()` with ranges
+         * \param advice the hint about the access pattern
+         * \exception holor::exception::HolorRuntimeError if the slice does not refer to the elements of this container. The compiler flag DDEFINE_ASSERT_LEVEL in the CMakeLists can be set to AssertionLevel::no_checks to exclude this check.
+         * \exception holor::exception::HolorRuntimeError if the advice is rejected by the kernel. This check does not depend on the compiler flag DDEFINE_ASSERT_LEVEL.
+         */
+        template<HolorType Slice>
+        void advise(const Slice& slice, MapAdvice advice) const{
+            if (slice.size() == 0 || ignores(advice)){
+                return;
+            }
+            const auto& layout = slice.layout();
+            std::ptrdiff_t first = layout.offset();
+            std::ptrdiff_t last = layout.offset();
+            for (size_t i = 0; i < Slice::dimensions; i++){
+                const std::ptrdiff_t extent = static_cast<std::ptrdiff_t>(layout.length(i) - 1)*layout.stride(i);
+                (extent < 0 ? first : last) += extent;
+            }
+            const std::ptrdiff_t begin = (slice.data() - data_) + first;
+            const std::ptrdiff_t end = (slice.data() - data_) + last + 1;
+            assert::dynamic_assert(begin >= 0 && end <= static_cast<std::ptrdiff_t>(size()), EXCEPTION_MESSAGE("holor::MappedHolor::advise - The slice does not refer to the elements of the container."));
+            map_.advise(file_, element_offset(begin), static_cast<size_t>(end - begin)*sizeof(T), impl::madvise_flag(advice));
+        }
+
+
+        /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+                            ACCESS FUNCTIONS
+        ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+        /*!
+         * \brief Access a single element in the container
+         * \param dims pack of indices, one per dimension of the container
+         * \return the element stored at the position indexed by the indices
+         */
+        template<SingleIndex... Dims> requires ((sizeof...(Dims)==N) )
+        T& operator()(Dims&&... dims){
+            return data_[layout_(std::forward<Dims>(dims)...)];
+        }
+
+        template<SingleIndex... Dims> requires ((sizeof...(Dims)==N) )
+        const T operator()(Dims&&... dims) const{
+            return data_[layout_(std::forward<Dims>(dims)...)];
+        }
+
+        /*!
+         * \brief Access a single element in the container
+         * \param indices Container of indices, one per dimension of the container
+         * \return the element stored at the position indexed by the indices
+         */
+        template <class Container> requires (assert::RSContainer<Container, N> && SingleIndex<typename Container::value_type>)
+        T& operator()(const Container& indices){
+            return data_[layout_(indices)];
+        }
+
+        template <class Container> requires (assert::RSContainer<Container, N> && SingleIndex<typename Container::value_type>)
+        const T operator()(const Container& indices) const{
+            return data_[layout_(indices)];
+        }
+
+        /*!
+         * \brief Access a slice of the container by providing a single index or a range of indices for each dimension
+         * \param args pack of indices, one per dimension of the container
+         * \return a HolorRef to the slice
+         */
+        template<typename... Args> requires (impl::ranged_index_pack<Args...>() && (sizeof...(Args)==N) )
+        auto operator()(Args&&... args){
+            auto sliced_layout = layout_(std::forward<Args>(args)...);
+            return HolorRef<T, decltype(sliced_layout)::order>(data_, sliced_layout);
+        }
+
+        template<typename... Args> requires (impl::ranged_index_pack<Args...>() && (sizeof...(Args)==N) )
+        auto operator()(Args&&... args) const{
+            auto sliced_layout = layout_(std::forward<Args>(args)...);
+            return HolorRef<const value_type, decltype(sliced_layout)::order>(data_, sliced_layout);
+        }
+
+        /*!
+         * \brief Access the `i-th` row of the container
+         * \param i index of the row
+         * \return a HolorRef to the row
+         */
+        auto row(size_t i){
+            return HolorRef<T, N-1>(data_, layout_.template slice_dimension<0>(i));
+        }
+
+        auto row(size_t i) const{
+            return HolorRef<const value_type, N-1>(data_, layout_.template slice_dimension<0>(i));
+        }
+
+        /*!
+         * \brief Access the `i-th` column of the container
+         * \param i index of the column
+         * \return a HolorRef to the column
+         */
+        auto col(size_t i){
+            return HolorRef<T, N-1>(data_, layout_.template slice_dimension<1>(i));
+        }
+
+        auto col(size_t i) const{
+            return HolorRef<const value_type, N-1>(data_, layout_.template slice_dimension<1>(i));
+        }
+
+        /*!
+         * \brief Access the `i-th` slice of a single dimension (e.g., the fifth row or the second column)
+         * \tparam M is the dimension to be sliced. 0 is a row, 1 is a column, ...
+         * \param i index of the slice along the `M-th` dimension
+         * \return a HolorRef to the slice
+         */
+        template<size_t M> requires (M<N)
+        auto slice(size_t i){
+            return HolorRef<T, N-1>(data_, layout_.template slice_dimension<M>(i));
+        }
+
+        template<size_t M> requires (M<N)
+        auto slice(size_t i) const{
+            return HolorRef<const value_type, N-1>(data_, layout_.template slice_dimension<M>(i));
+        }
+
+        /*!
+         * \brief Slice the container along a dimension selecting a range of components from said dimension
+         * \tparam M is the dimension to be sliced. 0 is a row, 1 is a column, ...
+         * \param range_slice is the range of indices to be taken along the `M-th` dimension
+         * \return a HolorRef to the slice
+         */
+        template<size_t M> requires (M<N)
+        auto slice(range range_slice){
+            return HolorRef<T, N>(data_, layout_.template slice_dimension<M>(range_slice));
+        }
+
+        template<size_t M> requires (M<N)
+        auto slice(range range_slice) const{
+            return HolorRef<const value_type, N>(data_, layout_.template slice_dimension<M>(range_slice));
+        }
+
+
+    /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+                        PRIVATE MEMBERS AND FUNCTIONS
+    ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+    private:
+        impl::File file_;                       ///< \brief the mapped file, which is kept open to synchronize the mapping and to report the errors
+        impl::MemoryMap map_;                   ///< \brief the mapping of the whole file, including its header
+        Layout<N> layout_;                      ///< \brief the Layout of the elements in the file
+        T* data_ = nullptr;                     ///< \brief pointer to the first element in the mapping
+        MapMode mode_ = MapMode::read_only;     ///< \brief the way the file is mapped
+
+        /*!
+         * \brief Function that returns the position in the mapping of the element with a given index
+         */
+        size_t element_offset(std::ptrdiff_t index) const{
+            return static_cast<size_t>(reinterpret_cast<const unsigned char*>(data_ + index) - map_.data());
+        }
+
+        /*!
+         * \brief Function that verifies if an advice is ignored: `MADV_DONTNEED` drops the private pages of a copy-on-write mapping, so the elements that were written would silently return to the values in the file
+         */
+        bool ignores(MapAdvice advice) const{
+            return (advice == MapAdvice::dontneed) && (mode_ == MapMode::copy_on_write);
+        }
+};
+
+
+
+/*================================================================================================
+                                    CREATE MAPPED
+================================================================================================*/
+/*!
+ * \brief Function that creates a binary file with the given lengths, whose elements are zeros, and maps it in memory with a shared mapping.
+ * The file is created with a single call to `ftruncate`, so that its size can exceed the available memory and its pages are allocated on the device only when they are written.
+ * \tparam T type of the elements, which must be an arithmetic type
+ * \tparam N the number of dimensions
+ * \param path the path of the file, which is created or overwritten
+ * \param lengths the lengths of the container, which must be positive
+ * \exception holor::exception::HolorRuntimeError if a length is zero. The compiler flag DDEFINE_ASSERT_LEVEL in the CMakeLists can be set to AssertionLevel::no_checks to exclude this check.
+ * \exception holor::exception::HolorRuntimeError if the file cannot be created or mapped. This check does not depend on the compiler flag DDEFINE_ASSERT_LEVEL.
+ * \return a MappedHolor whose writes are carried through to the file
+ */
+template<typename T, size_t N> requires (std::is_arithmetic_v<T> && (alignof(T) <= 8) && (N>0))
+MappedHolor<T, N> create_mapped(const std::filesystem::path& path, const std::array<size_t, N>& lengths){
+    assert::dynamic_assert(std::ranges::all_of(lengths, [](size_t length){ return length > 0; }), EXCEPTION_MESSAGE("holor::create_mapped - The lengths must be positive."));
+    impl::BinaryHeader header{impl::element_type<T>(), std::endian::native, {lengths.begin(), lengths.end()}};
+    {
+        impl::File file(path, impl::File::write);
+        const auto bytes = header.encode();
+        file.write_all(bytes.data(), bytes.size());
+        file.resize(header.size() + header.elements()*sizeof(T));
+    }
+    return MappedHolor<T, N>(path, MapMode::shared);
+}
+
+} //namespace holor
+
+#endif // HOLOR_MAPPED_HOLOR_H
@@ -48,40 +48,20 @@ class Layout;
  
 namespace impl{
 
-    //IMPROVE==========================================================================================================================================
-    //IMPROVE: the slice_dimension operation is not very efficient, because it iterates over all dimensions and each time it returns a new layout
     /*!
-     * \brief helper functor that is used by `Layout<N>::operator()(Args&&... args)` to index a slice of a Layout. The functor implements a recursive algorithm that indexes a dimension at a time, until they are all processed. Each iteration produces a new, subLayout. This functor is implementd outside of the Layout<N> class because the result of a slicing operation may yeld a Layout with reduced dimensionality, that requires the function to operate on a different instatiation of the template class.
+     * \brief helper function that computes, at compile time, the position that each index of a slicing operation takes in the resulting Layout
+     * \tparam Args pack of indices used to slice a Layout
+     * \return an array whose element `i` is the number of `RangeIndex` arguments that precede the `i`-th argument, i.e., the dimension of the sliced Layout that corresponds to the `i`-th argument if it is a range. The last element of the array is the total number of `RangeIndex` arguments, i.e., the dimensionality of the sliced Layout.
      */
-    template<size_t Dim>
-    struct slice_helper{
-        /*!
-         * \brief recursive function used in slicing operatios
-         * \tparam Layout is the type of the (sub)Layout the function slices
-         * \tparam FirstArg is the type of the first `Index` in the parameter pack
-         * \tparam OtherArgs are the `Index` type of the other indices besides the first
-         * \param dim is an unsigned int that is used to unwind the recursion, depending on the type of indices.
-         */
-        template<typename Layout, Index FirstArg, typename... OtherArgs>
-        auto operator()(Layout layout, FirstArg&& first, OtherArgs&&... other) const{ //NOTE: can we pass by reference, to avoid copying?
-            if constexpr(RangeIndex<FirstArg>){
-                return slice_helper<Dim+1>()(layout.template slice_dimension<Dim>(std::forward<FirstArg>(first)), std::forward<OtherArgs>(other)...);
-            }else{
-                return slice_helper<Dim>()(layout.template slice_dimension<Dim>(std::forward<FirstArg>(first)), std::forward<OtherArgs>(other)...);
-            }
-        }
-
-        /*!
-         * \brief final step of the recursive function used in slicing operatios
-         * \tparam Layout is the type of the (sub)Layout the function slices
-         * \tparam FirstArg is the type of the first `Index` in the parameter pack
-         * \param dim is an unsigned int that is used to unwind the recursion, depending on the type of indices.
-         */
-        template<typename Layout, Index FirstArg>
-        auto operator()(Layout layout, FirstArg&& first) const{ //NOTE: can we pass by reference, to avoid copying?
-            return layout.template slice_dimension<Dim>(std::forward<FirstArg>(first));
+    template<typename... Args>
+    constexpr std::array<size_t, sizeof...(Args)+1> slice_positions(){
+        constexpr std::array<bool, sizeof...(Args)> is_range{RangeIndex<Args>...};
+        std::array<size_t, sizeof...(Args)+1> positions{};
+        for (size_t i = 0; i < sizeof...(Args); i++){
+            positions[i+1] = positions[i] + (is_range[i] ? 1 : 0);
         }
-    };
+        return positions;
+    }
 }
 
 
@@ -168,6 +148,21 @@ class Layout{
             update_strides_size();
         }
 
+        /*!
+         * \brief Constructor of a layout from its lengths, strides and offset. The strides can be negative, to traverse a dimension in reverse order, or zero, to repeat the same elements along a dimension (see `broadcast`).
+         * \param lengths the number of elements along each dimension of the layout
+         * \param strides the distance in memory between consecutive elements along each dimension of the layout
+         * \param offset the position in memory of the first element of the layout
+         * \exception holor::exception::HolorInvalidArgument if a length is zero
+         * \return a Layout
+         */
+        Layout(const std::array<size_t, N>& lengths, const std::array<std::ptrdiff_t, N>& strides, size_t offset = 0): lengths_{lengths}, size_{1}, offset_{offset}, strides_{strides}{
+            for (auto length : lengths_){
+                assert::dynamic_assert<assert::assertion_level(assert::AssertionLevel::release), exception::HolorInvalidArgument>(length>0, EXCEPTION_MESSAGE("Zero length is not allowed!"));
+                size_ *= length;
+            }
+        }
+
 
         /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
                                     COMPARISON FUNCTIONS
@@ -262,7 +257,7 @@ class Layout{
          * \brief Get the strides of the layout. This is a const function.
          * \return the strides of the layout
          */
-        std::array<size_t,N> strides() const{
+        std::array<std::ptrdiff_t,N> strides() const{
             return strides_;
         }
 
@@ -274,6 +269,33 @@ class Layout{
             return strides_[dim];
         }
 
+        /*!
+         * \brief Get the number of elements stored contiguously in memory at the end of every group of innermost dimensions, i.e., the length of the longest run of elements that can be accessed with a unitary step in memory. Singleton dimensions do not break the contiguity, regardless of their stride. This is a const function.
+         * \b Example: for a Layout with lengths [4, 5, 6] the result is 120, while for the slice obtained with the ranges [0:3, 1:3, 0:5] it is 18, i.e. the three consecutive rows of six elements selected for each index of the first dimension.
+         * \return the number of contiguous elements in the innermost dimensions of the layout
+         */
+        size_t contiguous_inner_extent() const{
+            size_t extent = 1;
+            for(int i = N-1; i>=0; --i){
+                if (lengths_[i] == 1){
+                    continue;
+                }
+                if (strides_[i] != static_cast<std::ptrdiff_t>(extent)){
+                    break;
+                }
+                extent *= lengths_[i];
+            }
+            return extent;
+        }
+
+        /*!
+         * \brief Verify if all the elements of the layout are stored contiguously in memory with a row-major ordering, so that they can be accessed as a flat sequence starting at `offset()`. This is a const function.
+         * \return true if the layout is contiguous, false otherwise
+         */
+        bool is_contiguous() const{
+            return contiguous_inner_extent() == size_;
+        }
+
         /*!
          * \brief Function that inverts the lengths and strides of the layout. It is useful to perfrom transpose operations
          */
@@ -289,7 +311,7 @@ class Layout{
         template <class Container> requires assert::RSTypedContainer<Container, size_t, N>
         void transpose(const Container& order){
             std::array<size_t, N> reordered_lengths;
-            std::array<size_t, N> reordered_strides;
+            std::array<std::ptrdiff_t, N> reordered_strides;
             for (auto i = 0; i < N; i++){
                 reordered_lengths[i] = lengths_[order[i]];
                 reordered_strides[i] = strides_[order[i]];
@@ -298,6 +320,39 @@ class Layout{
             std::copy(reordered_strides.begin(), reordered_strides.end(), strides_.begin()); 
         }
 
+        /*!
+         * \brief Function that broadcasts the layout to `M` dimensions with the given lengths, following the NumPy rules: the dimensions of the layout are aligned with the last `N` dimensions of the result,
+         * and each of them must have the same length of the corresponding dimension of the result or a single element. The dimensions that are added, or that are expanded from a single element, have a zero stride,
+         * so that the elements of the layout are repeated along them without being copied.
+         * \b Example: a Layout with lengths [1, 3] broadcast to the lengths [2, 4, 3] has strides [0, 0, 1].
+         * \tparam M is the number of dimensions of the result
+         * \param lengths the lengths of the result
+         * \exception holor::exception::HolorRuntimeError if the layout cannot be broadcast to the lengths. The compiler flag DDEFINE_ASSERT_LEVEL in the CMakeLists can be set to AssertionLevel::no_checks to exclude this check.
+         * \return the broadcast Layout, with the same offset
+         */
+        template<size_t M> requires (M>=N)
+        Layout<M> broadcast(const std::array<size_t, M>& lengths) const{
+            Layout<M> result;
+            result.offset_ = offset_;
+            result.size_ = 1;
+            result.lengths_ = lengths;
+            result.strides_.fill(0);
+            bool valid = true;
+            for (size_t i = 0; i < M; i++){
+                valid = valid && (lengths[i] > 0);
+                result.size_ *= lengths[i];
+            }
+            for (size_t i = 0; i < N; i++){
+                const size_t j = M - N + i;
+                valid = valid && ((lengths_[i] == lengths[j]) || (lengths_[i] == 1));
+                if (lengths_[i] == lengths[j]){
+                    result.strides_[j] = strides_[i];
+                }
+            }
+            assert::dynamic_assert(valid, EXCEPTION_MESSAGE("holor::Layout - The layout cannot be broadcast to the lengths."));
+            return result;
+        }
+
         /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
                             INDEXING AND SLICING
         ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
@@ -310,7 +365,7 @@ class Layout{
          */
         template<SingleIndex... Dims> requires ((sizeof...(Dims)==N) )
         size_t operator()(Dims&&... dims) const{
-            return offset_ + single_element_indexing_helper<0>(std::forward<Dims>(dims)...);
+            return single_element_indexing_helper(std::make_index_sequence<N>{}, static_cast<size_t>(dims)...);
         }
 
 
@@ -332,22 +387,6 @@ class Layout{
             return result;
         }
 
-        /*!
-         * \brief Specialization of the function Layout<N>::operator()(Dims&&... dims) for the case when `N=1, ..., 4`, for a more efficient implementation. For the general case Layout<N> this specialization is not defined.
-         */
-        template<SingleIndex Index>
-        size_t operator()(Index i) const;
-
-        template<SingleIndex Index>
-        size_t operator()(Index x, Index j) const;
-
-        template<SingleIndex Index>
-        size_t operator()(Index x, Index j, Index k) const;
-
-        template<SingleIndex Index>
-        size_t operator()(Index x, Index j, Index k, Index w) const;
-
-
         /*!
          * \brief Function for indexing a slice from the Layout. Singleton dimensions (dimensions that are reduced to a single element) are removed.
          * \b Example:
@@ -364,7 +403,7 @@ class Layout{
          */
         template<typename... Args> requires (impl::ranged_index_pack<Args...>() && (sizeof...(Args)==N) )
         auto operator()(Args&&... args) const{
-            return impl::slice_helper<0>()(*this, std::forward<Args>(args)...);
+            return slicing_helper(std::make_index_sequence<N>{}, std::forward<Args>(args)...);
         }
 
 
@@ -384,16 +423,9 @@ class Layout{
          */
         template<typename... Args> requires (impl::ranged_index_pack<Args...>() && (sizeof...(Args)==N) )
         Layout<N> slice_unreduced(Args&&... args) const{
-            Layout<N> result = *this;
-            slice_unreduced_helper<0>(result, std::forward<Args>(args)...);
-            return result;
+            return slice_unreduced_helper(std::make_index_sequence<N>{}, std::forward<Args>(args)...);
         }
         
-        //IMPROVE==========================================================================================================================================
-        //IMPROVE: the slice_dimension operation is not very efficient, because it iterates over all dimensions and each time it returns a new layout. We can look at different things to improve this:
-        //IMPROVE: 1) Coroutines, although it does not look an ideal solution
-        //IMPROVE: 2) Templatized operators, but this is not easily scalable
-        //IMPROVE: 3) We could use ranges, which support lazy evaluation, to operate on the lengths_ and size_ arrays. So that basically we can Chain operation on these ranges and, only at the end, after all arguments have been processed, create a Layout of the final size that evaluates these operations and outputs the resulting Layout.
         /*!
          * \brief Function for indexing a single dimension of the Layout
          * \tparam Dim dimension to be sliced. `Dim` must be a value in the range `[0, N-1]`.
@@ -404,9 +436,10 @@ class Layout{
          */
         template<size_t Dim> requires ( (Dim>=0) && (Dim <N))
         Layout<N> slice_dimension(range range) const{
-            assert::dynamic_assert( range.end_ < lengths_[Dim], EXCEPTION_MESSAGE("holor::Layout - Tried to index invalid range.") );
+            check_range<Dim>(range);
             Layout<N> res = *this;
-            res.lengths_[Dim] = range.end_-range.start_+1;
+            res.lengths_[Dim] = range.length();
+            res.strides_[Dim] = strides_[Dim]*range.step_;
             res.size_ = std::accumulate(res.lengths_.begin(), res.lengths_.end(), 1, std::multiplies<size_t>());
             res.offset_ = offset_ + range.start_*strides_[Dim];
             return res;
@@ -437,7 +470,6 @@ class Layout{
             res.offset_ = offset_ + num*strides_[Dim];
             return res;
         }
-        //IMPROVE==========================================================================================================================================
 
 
     /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
@@ -447,7 +479,7 @@ class Layout{
         std::array<size_t,N> lengths_; /*! number of elements in each dimension */
         size_t size_; /*! total number of elements of the layout */
         size_t offset_; /*! offset from the beginning of the array of elements of the tensor where the layout starts */
-        std::array<size_t,N> strides_; /*! distance between consecutive elements in each dimension */
+        std::array<std::ptrdiff_t,N> strides_; /*! distance between consecutive elements in each dimension. Strides are signed, so that a dimension can be traversed in reverse order, and can be zero, so that the same elements are repeated along a broadcast dimension */
 
         /*!
          * \brief Computes and sets the strides and total size of the Layout based on its lengths
@@ -455,77 +487,120 @@ class Layout{
         void update_strides_size(){
             size_ = 1;
             for(int i = N-1; i>=0; --i){
-                strides_[i] = size_;
+                strides_[i] = static_cast<std::ptrdiff_t>(size_);
                 size_ *= lengths_[i];
             }
         }
 
 
         /*!
-         * \brief Helper recursive template function that is used to index a single element of the layout. It uses a variadic template, where the indices for each dimension of the layout are unwind one at a time
-         * \tparam M dimension to be indexed by the `FirstArg`
-         * \tparam FirstArg first index of the parameter pack
-         * \tparam OtherArgs rest of the indices in the parameter pack
-         * \param first is the index to be considered for the dimension `M`
-         * \param other is the pack with the remaining indices that need to be unwind
-         * \exception holor::exception::HolorRuntimeError if `first` is not within the range [0, `lengths[M]). The compiler flag DDEFINE_ASSERT_LEVEL in the CMakeLists can be set to AssertionLevel::no_checks to exclude this check.
+         * \brief Helper function that verifies that a range of indices is valid for a dimension of the layout, i.e., that the first and the last indices of the range, whatever its direction, are within the length of the dimension
+         * \tparam Dim dimension of the layout that is indexed by the range
+         * \param indices the range of indices
+         * \exception holor::exception::HolorRuntimeError if the range is not valid. The compiler flag DDEFINE_ASSERT_LEVEL in the CMakeLists can be set to AssertionLevel::no_checks to exclude this check.
          */
-        template<size_t M, SingleIndex FirstArg, SingleIndex... OtherArgs>
-        size_t single_element_indexing_helper(FirstArg first, OtherArgs&&... other) const{
-            assert::dynamic_assert(first>=0 && first<lengths_[M], EXCEPTION_MESSAGE("holor::Layout - Tried to index invalid element.") );
-            return first * strides_[M] + single_element_indexing_helper<M+1>(std::forward<OtherArgs>(other)...);
+        template<size_t Dim>
+        void check_range(const range& indices) const{
+            assert::dynamic_assert( std::max(indices.start_, indices.last()) < lengths_[Dim], EXCEPTION_MESSAGE("holor::Layout - Tried to index invalid range.") );
         }
 
-        template<size_t M, SingleIndex FirstArg>
-        size_t single_element_indexing_helper(FirstArg first) const{
-            assert::dynamic_assert(first>=0 && first<lengths_[M], EXCEPTION_MESSAGE("holor::Layout - Tried to index invalid element.") );
-            return first * strides_[M];
+
+        /*!
+         * \brief Helper function that is used to index a single element of the layout. The indices of all the dimensions are processed at once with fold expressions, and their checks are combined with a bitwise and, so that a single branch is taken on the success path regardless of the number of dimensions
+         * \tparam Dims sequence `0, ..., N-1` of the dimensions of the layout
+         * \param dims the indices of the element, one for each dimension
+         * \exception holor::exception::HolorRuntimeError if any index is not within the range [0, `lengths[Dim]`). Negative indices are converted to large unsigned values and thus they fail the check as well. The compiler flag DDEFINE_ASSERT_LEVEL in the CMakeLists can be set to AssertionLevel::no_checks to exclude this check.
+         * \return the index in memory of the selected element
+         */
+        template<size_t... Dims>
+        size_t single_element_indexing_helper(std::index_sequence<Dims...>, std::convertible_to<size_t> auto... dims) const{
+            assert::dynamic_assert( static_cast<bool>((... & (dims<lengths_[Dims]))), EXCEPTION_MESSAGE("holor::Layout - Tried to index invalid element.") );
+            return offset_ + ((dims*strides_[Dims]) + ...);
         }
 
 
         /*!
-         * \brief Helper recursive template function that is used to slice a single subset of the layout without changing its dimensionality. This means that some dimensions of the resulting Layout may be singletons (collapse to a single element). This function uses a variadic template, where the indices for each dimension of the layout are unwind one at a time
-         * \tparam M dimension to be indexed by the `FirstArg`
-         * \tparam FirstArg first index of the parameter pack
-         * \tparam OtherArgs rest of the indices in the parameter pack
-         * \param first is the index to be considered for the dimension `Dim`
-         * \param other is the pack with the remaining indices that need to be unwind
-         * \exception holor::exception::HolorRuntimeError if `coordinate` is not within the range [0, `lengths[Dim]). The compiler flag DDEFINE_ASSERT_LEVEL in the CMakeLists can be set to AssertionLevel::no_checks to exclude this check.
+         * \brief Helper function that is used to slice the layout. The result is computed in a single pass: the dimensionality of the result and the position of each of its dimensions are determined at compile time from the types of the indices, and a fold expression processes all the indices writing directly into the resulting Layout.
+         * \tparam Dims sequence `0, ..., N-1` of the dimensions of the layout
+         * \tparam Args pack of indices, one for each dimension
+         * \param args the indices, each selecting either a single element or a range of elements in a dimension
+         * \exception holor::exception::HolorRuntimeError if any index is not valid. The compiler flag DDEFINE_ASSERT_LEVEL in the CMakeLists can be set to AssertionLevel::no_checks to exclude this check.
+         * \return the sliced Layout, whose dimensionality is the number of `RangeIndex` arguments
          */
-        template<size_t Dim, Index FirstArg, Index... OtherArgs>
-        static void slice_unreduced_helper(Layout<N>& result, FirstArg coordinate, OtherArgs&&... other){
-            if constexpr(SingleIndex<FirstArg>){
-                //this dimension becomes a singleton
-                assert::dynamic_assert(coordinate>=0 && coordinate<result.lengths_[Dim], EXCEPTION_MESSAGE("holor::Layout - Tried to index invalid element.") );
-                result.offset_ += coordinate*result.strides_[Dim];
-                result.lengths_[Dim] = 1;
-                result.strides_[Dim] = 0;
+        template<size_t... Dims, typename... Args>
+        auto slicing_helper(std::index_sequence<Dims...>, Args&&... args) const{
+            constexpr auto positions = impl::slice_positions<Args...>();
+            Layout<positions[N]> result;
+            result.offset_ = offset_;
+            result.size_ = 1;
+            (slice_argument<Dims, positions[Dims]>(result, args), ...);
+            return result;
+        }
+
+        /*!
+         * \brief Helper function that applies a single index of a slicing operation to the resulting Layout
+         * \tparam Dim dimension of this layout that is indexed
+         * \tparam Pos dimension of the resulting Layout that corresponds to `Dim`, if the index is a range
+         * \param result the Layout that is being computed
+         * \param index the index for the dimension `Dim`
+         * \exception holor::exception::HolorRuntimeError if `index` is not valid. The compiler flag DDEFINE_ASSERT_LEVEL in the CMakeLists can be set to AssertionLevel::no_checks to exclude this check.
+         */
+        template<size_t Dim, size_t Pos, size_t M, Index Arg>
+        void slice_argument(Layout<M>& result, const Arg& index) const{
+            if constexpr(RangeIndex<Arg>){
+                const range& indices = index;
+                check_range<Dim>(indices);
+                result.lengths_[Pos] = indices.length();
+                result.strides_[Pos] = strides_[Dim]*indices.step_;
+                result.offset_ += indices.start_*strides_[Dim];
+                result.size_ *= result.lengths_[Pos];
             }
             else{
-                //this dimension does not collapse to a single element
-                assert::dynamic_assert( coordinate.end_ < result.lengths_[Dim], EXCEPTION_MESSAGE("holor::Layout - Tried to index invalid range.") );
-                result.lengths_[Dim] = coordinate.end_ - coordinate.start_ + 1;
-                result.offset_ += coordinate.start_*result.strides_[Dim];
+                assert::dynamic_assert( static_cast<size_t>(index) < lengths_[Dim], EXCEPTION_MESSAGE("holor::Layout - Tried to index invalid element.") );
+                result.offset_ += static_cast<size_t>(index)*strides_[Dim];
             }
-            slice_unreduced_helper<Dim+1>(result, std::forward<OtherArgs>(other)...);
         }
 
-        template<size_t Dim, Index FirstArg>
-        static void slice_unreduced_helper(Layout<N>& result, FirstArg coordinate){
-            if constexpr(SingleIndex<FirstArg>){
+        /*!
+         * \brief Helper function that is used to slice a subset of the layout without changing its dimensionality. This means that some dimensions of the resulting Layout may be singletons (collapse to a single element). The indices are processed in a single pass with a fold expression.
+         * \tparam Dims sequence `0, ..., N-1` of the dimensions of the layout
+         * \tparam Args pack of indices, one for each dimension
+         * \param args the indices, each selecting either a single element or a range of elements in a dimension
+         * \exception holor::exception::HolorRuntimeError if any index is not valid. The compiler flag DDEFINE_ASSERT_LEVEL in the CMakeLists can be set to AssertionLevel::no_checks to exclude this check.
+         * \return the sliced Layout
+         */
+        template<size_t... Dims, typename... Args>
+        Layout<N> slice_unreduced_helper(std::index_sequence<Dims...>, Args&&... args) const{
+            Layout<N> result = *this;
+            (slice_unreduced_argument<Dims>(result, args), ...);
+            result.size_ = std::accumulate(result.lengths_.begin(), result.lengths_.end(), size_t{1}, std::multiplies<size_t>());
+            return result;
+        }
+
+        /*!
+         * \brief Helper function that applies a single index of a slicing operation that does not change the dimensionality of the layout
+         * \tparam Dim dimension of the layout that is indexed
+         * \param result the Layout that is being computed
+         * \param index the index for the dimension `Dim`
+         * \exception holor::exception::HolorRuntimeError if `index` is not valid. The compiler flag DDEFINE_ASSERT_LEVEL in the CMakeLists can be set to AssertionLevel::no_checks to exclude this check.
+         */
+        template<size_t Dim, Index Arg>
+        static void slice_unreduced_argument(Layout<N>& result, const Arg& index){
+            if constexpr(SingleIndex<Arg>){
                 //this dimension becomes a singleton
-                assert::dynamic_assert(coordinate>=0 && coordinate<result.lengths_[Dim], EXCEPTION_MESSAGE("holor::Layout - Tried to index invalid element.") );
-                result.offset_ += coordinate*result.strides_[Dim];
+                assert::dynamic_assert( static_cast<size_t>(index) < result.lengths_[Dim], EXCEPTION_MESSAGE("holor::Layout - Tried to index invalid element.") );
+                result.offset_ += static_cast<size_t>(index)*result.strides_[Dim];
                 result.lengths_[Dim] = 1;
                 result.strides_[Dim] = 0;
             }
             else{
                 //this dimension does not collapse to a single element
-                assert::dynamic_assert( coordinate.end_ < result.lengths_[Dim], EXCEPTION_MESSAGE("holor::Layout - Tried to index invalid range.") );
-                result.lengths_[Dim] = coordinate.end_ - coordinate.start_ + 1;
-                result.offset_ += coordinate.start_*result.strides_[Dim];
+                const range& indices = index;
+                result.template check_range<Dim>(indices);
+                result.lengths_[Dim] = indices.length();
+                result.offset_ += indices.start_*result.strides_[Dim];
+                result.strides_[Dim] *= indices.step_;
             }
-            result.size_ = std::accumulate(result.lengths_.begin(), result.lengths_.end(), 1, std::multiplies<size_t>());         
         }
 
 
@@ -556,73 +631,6 @@ class Layout{
 
 
 
-/*================================================================================================
-                                    LAYOUT INDEXING SPECIALIZATIONS
-================================================================================================*/
-/*!
- * \brief Specialization of the function for indexing a single element from Layout with dimension `N=1`
- * \tparam Index is the type of the index
- * \param i is the value of the index
- * \return the index of the subscripted element in the Holor
- */
-template<>
-template<SingleIndex Index> 
-size_t Layout<1>::operator()(Index i) const{
-    assert::dynamic_assert(i>=0 && i<lengths_[0], EXCEPTION_MESSAGE("holor::Layout - Tried to index invalid element.") );
-    return offset_ + i*strides_[0];
-}
-
-
-/*!
- * \brief Specialization of the function for indexing a single element from Layout with dimension `N=2`
- * \tparam Index is the type of the indexes
- * \param i is the value of the first index
- * \param j is the value of the second index
- * \return the index of the subscripted element in the Holor
- */
-template<>
-template<SingleIndex Index> 
-size_t Layout<2>::operator()(Index i, Index j) const{
-    assert::dynamic_assert( (i>=0 && i<lengths_[0]) && (j>=0 && j<lengths_[1]), EXCEPTION_MESSAGE("holor::Layout - Tried to index invalid element.") );
-    return offset_ + i*strides_[0] + j*strides_[1];
-}
-
-
-/*!
- * \brief Specialization of the function for indexing a single element from Layout with dimension `N=3`
- * \tparam Index is the type of the indexes
- * \param i is the value of the first 
- * \param j is the value of the second index
- * \param k is the value of the third index
- * \return the index of the subscripted element in the Holor
- */
-template<>
-template<SingleIndex Index> 
-size_t Layout<3>::operator()(Index i, Index j, Index k) const{
-    assert::dynamic_assert( (i>=0 && i<lengths_[0]) && (j>=0 && j<lengths_[1]) && (k>=0 && k<lengths_[2]), EXCEPTION_MESSAGE("holor::Layout - Tried to index invalid element.") );
-    return offset_ + i*strides_[0] + j*strides_[1] + k*strides_[2];
-}
-
-
-/*!
- * \brief Specialization of the function for indexing a single element from Layout with dimension `N=3`
- * \tparam Index is the type of the indexes
- * \param i is the value of the first 
- * \param j is the value of the second index
- * \param k is the value of the third index
- * \param w is the value of the fourth index
- * \return the index of the subscripted element in the Holor
- */
-template<>
-template<SingleIndex Index> 
-size_t Layout<4>::operator()(Index i, Index j, Index k, Index w) const{
-    assert::dynamic_assert( (i>=0 && i<lengths_[0]) && (j>=0 && j<lengths_[1]) && (k>=0 && k<lengths_[2]) && (w>=0 && w<lengths_[3]), EXCEPTION_MESSAGE("holor::Layout - Tried to index invalid element.") );
-    return offset_ + i*strides_[0] + j*strides_[1] + k*strides_[2] + w*strides_[3];
-}
-
-
-
-
 /*================================================================================================
                                     COMPARISONS
 ================================================================================================*/
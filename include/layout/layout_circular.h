@@ -201,7 +201,7 @@ class LayoutCircular{
          * \brief Get the strides of the layout. This is a const function.
          * \return the strides of the layout
          */
-        std::array<size_t,N> strides() const{
+        std::array<std::ptrdiff_t,N> strides() const{
             return strides_;
         }
 
@@ -229,7 +229,7 @@ class LayoutCircular{
         template <class Container> requires assert::RSTypedContainer<Container, size_t, N>
         void transpose(const Container& order){
             std::array<size_t, N> reordered_lengths;
-            std::array<size_t, N> reordered_strides;
+            std::array<std::ptrdiff_t, N> reordered_strides;
             for (auto i = 0; i < N; i++){
                 reordered_lengths[i] = lengths_[order[i]];
                 reordered_strides[i] = strides_[order[i]];
@@ -294,7 +294,7 @@ class LayoutCircular{
         std::vector<size_t> lengthsOG_; /*! number of elements in each dimension of the original container that is sliced circularly*/
         std::array<size_t,N> lengths_; /*! number of elements in each dimension */
         std::array<size_t,N> offsets_; /*! offset from the beginning of the array in memory where the elements of the tensor are stored */
-        std::array<size_t,N> strides_; /*! distance between consecutive elements in each dimension */
+        std::array<std::ptrdiff_t,N> strides_; /*! distance between consecutive elements in each dimension */
         size_t size_; /*! total number of elements of the layout */
 
         /*!
@@ -124,8 +124,8 @@ concept LayoutType = impl::LayoutWithOrder<T> && impl::IndexableLayout<T> && imp
     {layout.offset()}->std::same_as<size_t>;
     {layout.lengths()}->std::same_as<std::array<size_t,T::order>>;
     {layout.length(0)}->std::same_as<size_t>;
-    {layout.strides()}->std::same_as<std::array<size_t,T::order>>;
-    {layout.stride(0)}->std::same_as<size_t>;
+    {layout.strides()}->std::same_as<std::array<std::ptrdiff_t,T::order>>;
+    {layout.stride(0)}->std::same_as<std::ptrdiff_t>;
 };
 
 
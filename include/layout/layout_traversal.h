@@ -0,0 +1,228 @@
+// This file is part of Holor, a C++ header-only template library for multi-dimensional containers
+
+// Copyright 2020-2022 Carlo Masone
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+
+#ifndef HOLOR_LAYOUT_TRAVERSAL_H
+#define HOLOR_LAYOUT_TRAVERSAL_H
+
+/** \file layout_traversal.h
+ * \brief This header contains the utilities used to normalize one or more Layouts and to traverse their elements jointly with the fewest loop levels.
+ */
+
+#include <cstddef>
+#include <algorithm>
+#include <array>
+#include <utility>
+#include <concepts>
+
+#include "layout.h"
+#include "../common/runtime_assertions.h"
+
+
+namespace holor{
+
+namespace impl{
+
+
+/*================================================================================================
+                                    NORMALIZED LAYOUTS
+================================================================================================*/
+/*!
+ * \brief Structure that describes `M` layouts with the same lengths after their dimensions have been normalized, so that they can be traversed jointly.
+ *
+ * The normalization drops the dimensions with a single element and merges every pair of adjacent dimensions `i, i+1` that satisfy `stride[i] == stride[i+1]*length[i+1]` for all the layouts.
+ * For example, a Layout<5> obtained by slicing the outermost dimensions of a contiguous container is reduced to a single dimension, while a slice that takes a range of its innermost dimension is reduced to two dimensions.
+ * The normalized layouts have at least one dimension.
+ *
+ * \tparam N is the number of dimensions of the original layouts
+ * \tparam M is the number of layouts
+ */
+template<size_t N, size_t M>
+struct NormalizedLayouts{
+    size_t dimensions_;                                 /*! number of dimensions after the normalization */
+    size_t size_;                                       /*! total number of elements of the layouts */
+    std::array<size_t, N> lengths_;                     /*! lengths of the normalized dimensions. Only the first `dimensions_` values are meaningful */
+    std::array<std::array<std::ptrdiff_t, N>, M> strides_;  /*! strides of the normalized dimensions for each layout. Only the first `dimensions_` values are meaningful */
+    std::array<size_t, M> offsets_;                     /*! offsets of the layouts */
+};
+
+
+/*!
+ * \brief Function that normalizes `M` layouts with the same lengths, given their lengths, strides and offsets.
+ * \tparam N is the number of dimensions of the layouts
+ * \tparam M is the number of layouts
+ * \param lengths the lengths of the layouts
+ * \param strides the strides of each layout. A stride can be zero, for example to repeat the elements of a layout along a dimension
+ * \param offsets the offset of each layout
+ * \return the normalized layouts
+ */
+template<size_t N, size_t M>
+NormalizedLayouts<N,M> normalize_layouts(const std::array<size_t, N>& lengths, const std::array<std::array<std::ptrdiff_t, N>, M>& strides, const std::array<size_t, M>& offsets){
+    NormalizedLayouts<N,M> result;
+    result.dimensions_ = 0;
+    result.size_ = 1;
+    result.offsets_ = offsets;
+    for (size_t i = 0; i < N; i++){
+        result.size_ *= lengths[i];
+        if (lengths[i] == 1){
+            continue;
+        }
+        bool mergeable = (result.dimensions_ > 0);
+        for (size_t k = 0; k < M && mergeable; k++){
+            mergeable = (result.strides_[k][result.dimensions_-1] == strides[k][i]*static_cast<std::ptrdiff_t>(lengths[i]));
+        }
+        if (mergeable){
+            result.lengths_[result.dimensions_-1] *= lengths[i];
+            for (size_t k = 0; k < M; k++){
+                result.strides_[k][result.dimensions_-1] = strides[k][i];
+            }
+        } else{
+            result.lengths_[result.dimensions_] = lengths[i];
+            for (size_t k = 0; k < M; k++){
+                result.strides_[k][result.dimensions_] = strides[k][i];
+            }
+            result.dimensions_++;
+        }
+    }
+    if (result.dimensions_ == 0){
+        result.dimensions_ = 1;
+        result.lengths_[0] = 1;
+        for (size_t k = 0; k < M; k++){
+            result.strides_[k][0] = 0;
+        }
+    }
+    return result;
+}
+
+
+/*!
+ * \brief Function that normalizes a pack of layouts with the same lengths.
+ * \param first the first layout, that determines the lengths
+ * \param others the other layouts
+ * \exception holor::exception::HolorRuntimeError if the layouts have different lengths. The compiler flag DDEFINE_ASSERT_LEVEL in the CMakeLists can be set to AssertionLevel::no_checks to exclude this check.
+ * \return the normalized layouts
+ */
+template<size_t N, std::same_as<Layout<N>>... Layouts>
+NormalizedLayouts<N, 1+sizeof...(Layouts)> normalize_layouts(const Layout<N>& first, const Layouts&... others){
+    assert::dynamic_assert( ((first.lengths() == others.lengths()) && ...), EXCEPTION_MESSAGE("holor::normalize_layouts - The layouts have different lengths."));
+    return normalize_layouts<N, 1+sizeof...(Layouts)>(first.lengths(), {first.strides(), others.strides()...}, {first.offset(), others.offset()...});
+}
+
+
+/*!
+ * \brief Function that computes the lengths of the result of an element-wise operation between two operands with `NA` and `NB` dimensions, following the NumPy broadcasting rules:
+ * the lengths are aligned to the right, and each pair of aligned lengths must be equal or one of them must be 1, in which case the result takes the other length.
+ * The missing leading dimensions of the operand with fewer dimensions are treated as having length 1.
+ * \b Example: the lengths [4, 1, 3] and [5, 1] are broadcast to [4, 5, 3].
+ * \param a the lengths of the first operand
+ * \param b the lengths of the second operand
+ * \exception holor::exception::HolorRuntimeError if the lengths cannot be broadcast together. The compiler flag DDEFINE_ASSERT_LEVEL in the CMakeLists can be set to AssertionLevel::no_checks to exclude this check.
+ * \return the broadcast lengths, with `max(NA, NB)` dimensions
+ */
+template<size_t NA, size_t NB>
+std::array<size_t, std::max(NA, NB)> broadcast_lengths(const std::array<size_t, NA>& a, const std::array<size_t, NB>& b){
+    constexpr size_t N = std::max(NA, NB);
+    std::array<size_t, N> result;
+    bool valid = true;
+    for (size_t i = 0; i < N; i++){
+        const size_t la = (i + NA >= N) ? a[i + NA - N] : 1;
+        const size_t lb = (i + NB >= N) ? b[i + NB - N] : 1;
+        valid = valid && ((la == lb) || (la == 1) || (lb == 1));
+        result[i] = (la == 1) ? lb : la;
+    }
+    assert::dynamic_assert(valid, EXCEPTION_MESSAGE("holor::broadcast_lengths - The lengths cannot be broadcast together."));
+    return result;
+}
+
+
+/*================================================================================================
+                                    TRAVERSAL
+================================================================================================*/
+/*!
+ * \brief Function that traverses jointly the elements of normalized layouts in row-major order, calling a function with the memory indices of the elements of all the layouts.
+ * The outer dimensions are advanced like an odometer, while the innermost dimension is traversed with a tight loop, which is specialized for the case where all the layouts have unitary stride.
+ * \tparam N is the number of dimensions of the original layouts
+ * \tparam M is the number of layouts
+ * \tparam Func is the type of the function
+ * \param layouts the normalized layouts
+ * \param func the function, which is called with `M` arguments of type `size_t`, i.e., `func(index_0, ..., index_M-1)`
+ */
+template<size_t N, size_t M, class Func>
+void for_each_index(const NormalizedLayouts<N,M>& layouts, Func&& func){
+    if (layouts.size_ == 0){
+        return;
+    }
+    const size_t inner = layouts.dimensions_-1;
+    const size_t inner_length = layouts.lengths_[inner];
+    bool unit_strides = true;
+    std::array<std::ptrdiff_t, M> inner_strides;
+    for (size_t k = 0; k < M; k++){
+        inner_strides[k] = layouts.strides_[k][inner];
+        unit_strides = unit_strides && (inner_strides[k] == 1);
+    }
+
+    std::array<size_t, N> coordinates;
+    coordinates.fill(0);
+    std::array<size_t, M> base = layouts.offsets_;
+    while(true){
+        [&]<size_t... K>(std::index_sequence<K...>){
+            if (unit_strides){
+                for (size_t j = 0; j < inner_length; j++){
+                    func((base[K] + j)...);
+                }
+            } else{
+                for (size_t j = 0; j < inner_length; j++){
+                    func((base[K] + j*inner_strides[K])...);
+                }
+            }
+        }(std::make_index_sequence<M>{});
+
+        // advance the outer dimensions
+        size_t dim = inner;
+        while (dim > 0){
+            --dim;
+            if (++coordinates[dim] < layouts.lengths_[dim]){
+                for (size_t k = 0; k < M; k++){
+                    base[k] += layouts.strides_[k][dim];
+                }
+                break;
+            }
+            for (size_t k = 0; k < M; k++){
+                base[k] -= (layouts.lengths_[dim]-1)*layouts.strides_[k][dim];
+            }
+            coordinates[dim] = 0;
+            if (dim == 0){
+                return;
+            }
+        }
+        if (inner == 0){
+            return;
+        }
+    }
+}
+
+
+} //namespace impl
+
+} //namespace holor
+
+#endif // HOLOR_LAYOUT_TRAVERSAL_H
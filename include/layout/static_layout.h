@@ -0,0 +1,232 @@
+// This file is part of Holor, a C++ header-only template library for multi-dimensional containers
+
+// Copyright 2020-2022 Carlo Masone
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to 
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is 
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER 
+// DEALINGS IN THE SOFTWARE.
+
+
+
+#ifndef HOLOR_STATIC_LAYOUT_H
+#define HOLOR_STATIC_LAYOUT_H
+
+#include <cstddef>
+#include <array>
+#include <utility>
+#include <concepts>
+
+#include "layout.h"
+#include "../indexes/indexes.h"
+#include "../common/runtime_assertions.h"
+
+
+namespace holor{
+
+/*================================================================================================
+                                    STATIC LAYOUT CLASS
+================================================================================================*/
+/*!
+ * \brief Class that represents the memory layout of a container whose lengths are known at compile time.
+ *
+ * A StaticLayout describes the same row-major layout of a `Layout<N>` constructed with the lengths `Lengths...`, but its lengths, strides and size are constant expressions.
+ * As a consequence, a StaticLayout has no state, and indexing an element reduces to a sum of products by constants that the compiler can fold.
+ * A StaticLayout always describes a whole container, i.e. its offset is zero: the slicing operations return a dynamic `Layout` with the sliced lengths and strides.
+ *
+ * \tparam Lengths number of elements along each dimension of the layout. All lengths must be greater than zero.
+ */
+template<size_t... Lengths> requires ( (sizeof...(Lengths) > 0) && ((Lengths > 0) && ...) )
+class StaticLayout{
+    public:
+        /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+                                    ALIASES
+        ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+        static constexpr size_t order = sizeof...(Lengths); ///< \brief number of dimensions of the layout
+
+
+        /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+                                GET/SET FUNCTIONS
+        ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+        /*!
+         * \brief Get the number of dimensions of the layout
+         * \return the number of dimensions
+         */
+        static constexpr size_t dimensions(){
+            return order;
+        }
+
+        /*!
+         * \brief Get the total number of elements of the layout
+         * \return the size of the layout
+         */
+        static constexpr size_t size(){
+            return (Lengths * ...);
+        }
+
+        /*!
+         * \brief Get the offset of the layout, which is always zero
+         * \return the offset of the layout
+         */
+        static constexpr size_t offset(){
+            return 0;
+        }
+
+        /*!
+         * \brief Get the lengths of the layout
+         * \return the number of elements along each dimension
+         */
+        static constexpr std::array<size_t, order> lengths(){
+            return {Lengths...};
+        }
+
+        /*!
+         * \brief Get the length of a dimension of the layout
+         * \param dim the dimension
+         * \return the number of elements along the dimension
+         */
+        static constexpr size_t length(size_t dim){
+            return lengths()[dim];
+        }
+
+        /*!
+         * \brief Get the strides of the layout, computed at compile time from the lengths with a row-major ordering
+         * \return the strides of the layout
+         */
+        static constexpr std::array<std::ptrdiff_t, order> strides(){
+            constexpr std::array<size_t, order> lengths_v{Lengths...};
+            std::array<std::ptrdiff_t, order> result{};
+            std::ptrdiff_t stride = 1;
+            for (size_t i = order; i > 0; --i){
+                result[i-1] = stride;
+                stride *= static_cast<std::ptrdiff_t>(lengths_v[i-1]);
+            }
+            return result;
+        }
+
+        /*!
+         * \brief Get the stride along a dimension of the layout
+         * \param dim the dimension
+         * \return the stride along the dimension
+         */
+        static constexpr std::ptrdiff_t stride(size_t dim){
+            return strides()[dim];
+        }
+
+        /*!
+         * \brief A StaticLayout is always contiguous
+         * \return true
+         */
+        static constexpr bool is_contiguous(){
+            return true;
+        }
+
+        /*!
+         * \brief Get the dynamic Layout equivalent to this StaticLayout
+         * \return a `Layout` with the same lengths
+         */
+        static Layout<order> layout(){
+            return Layout<order>(lengths());
+        }
+
+
+        /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+                            INDEXING AND SLICING
+        ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+        /*!
+         * \brief Function for indexing a single element from the layout. The strides are constant expressions, so when the indices are known at compile time the whole computation is folded.
+         * \param dims pack of indices, one per dimension
+         * \exception holor::exception::HolorRuntimeError if any index is not within the range [0, `Lengths`). The compiler flag DDEFINE_ASSERT_LEVEL in the CMakeLists can be set to AssertionLevel::no_checks to exclude this check.
+         * \return the index in memory of the selected element
+         */
+        template<SingleIndex... Dims> requires (sizeof...(Dims) == order)
+        constexpr size_t operator()(Dims&&... dims) const{
+            return indexing_helper(std::make_index_sequence<order>{}, static_cast<size_t>(dims)...);
+        }
+
+        /*!
+         * \brief Function for indexing a single element from the layout given a container of indices
+         * \param dims a container of indices, one for each dimension of the layout
+         * \return the index in memory of the selected element
+         */
+        template <class Container> requires assert::RSContainer<Container, order> && SingleIndex<typename Container::value_type>
+        constexpr size_t operator()(const Container& dims) const{
+            if constexpr(assert::ResizeableContainer<Container>){
+                assert::dynamic_assert(dims.size()==order, EXCEPTION_MESSAGE("Wrong number of elements!"));
+            }
+            constexpr auto strides_v = strides();
+            size_t result = 0;
+            for (size_t i = 0; i < order; i++){
+                result += static_cast<size_t>(dims[i])*strides_v[i];
+            }
+            return result;
+        }
+
+        /*!
+         * \brief Function for indexing a slice from the layout. Singleton dimensions are removed.
+         * \param args parameters pack. Each element of the pack indexes either an element or a range of elements along a dimension of the layout.
+         * \exception holor::exception::HolorRuntimeError if the indices passed as arguments are invalid. The compiler flag DDEFINE_ASSERT_LEVEL in the CMakeLists can be set to AssertionLevel::no_checks to exclude this check.
+         * \return the dynamic Layout containing the indexed range of elements
+         */
+        template<typename... Args> requires (impl::ranged_index_pack<Args...>() && (sizeof...(Args) == order) )
+        auto operator()(Args&&... args) const{
+            return layout()(std::forward<Args>(args)...);
+        }
+
+        /*!
+         * \brief Function for indexing a single dimension of the layout
+         * \tparam Dim dimension to be sliced
+         * \param index the index or range of indices to be taken from the dimension `Dim`
+         * \return the dynamic Layout of the slice
+         */
+        template<size_t Dim, Index Arg> requires (Dim < order)
+        auto slice_dimension(Arg&& index) const{
+            return layout().template slice_dimension<Dim>(std::forward<Arg>(index));
+        }
+
+
+    /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+                        PRIVATE MEMBERS AND FUNCTIONS
+    ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+    private:
+        /*!
+         * \brief Helper function that is used to index a single element of the layout, processing all the indices with fold expressions
+         * \tparam Dims sequence `0, ..., order-1` of the dimensions of the layout
+         * \param dims the indices of the element, one for each dimension
+         * \return the index in memory of the selected element
+         */
+        template<size_t... Dims>
+        static constexpr size_t indexing_helper(std::index_sequence<Dims...>, std::convertible_to<size_t> auto... dims){
+            constexpr std::array<size_t, order> lengths_v{Lengths...};
+            constexpr auto strides_v = strides();
+            assert::dynamic_assert( static_cast<bool>((... & (dims < lengths_v[Dims]))), EXCEPTION_MESSAGE("holor::StaticLayout - Tried to index invalid element.") );
+            return ((dims*static_cast<size_t>(strides_v[Dims])) + ...);
+        }
+};
+
+
+/*!
+ * \brief Comparison between two static layouts, which are equal if they have the same lengths
+ */
+template<size_t... Lengths1, size_t... Lengths2>
+constexpr bool operator==(const StaticLayout<Lengths1...>&, const StaticLayout<Lengths2...>&){
+    return std::is_same_v<StaticLayout<Lengths1...>, StaticLayout<Lengths2...>>;
+}
+
+
+} //namespace holor
+
+#endif // HOLOR_STATIC_LAYOUT_H
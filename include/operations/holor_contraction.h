@@ -0,0 +1,502 @@
+// This file is part of Holor, a C++ header-only template library for multi-dimensional containers
+
+// Copyright 2020-2022 Carlo Masone
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to 
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is 
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER 
+// DEALINGS IN THE SOFTWARE.
+
+
+#ifndef HOLOR_CONTRACTION_H
+#define HOLOR_CONTRACTION_H
+
+/** \file holor_contraction.h
+ * \brief This header contains the matrix product of 2D containers (`matmul`) and the contractions of two containers over arbitrary pairs of dimensions: `contract`, which is analogous to `numpy.tensordot`, and `einsum`, which describes the contraction with a subscripts string.
+ *
+ * A contraction is mapped onto the GEMM kernel (see holor_gemm.h): the dimensions of the operands are grouped into the dimensions shared by the operands and the result (batch),
+ * the free dimensions of the first operand (rows), the free dimensions of the second operand (columns) and the contracted dimensions. When each group of dimensions of a container can be
+ * coalesced into a single dimension with a constant stride, as for contiguous containers and for most of their transposed views, the container is read in place as a matrix.
+ * Otherwise, its elements are first copied in a contiguous buffer with the dimensions permuted in the order of the groups.
+ */
+
+#include <cstddef>
+#include <array>
+#include <vector>
+#include <utility>
+#include <iterator>
+#include <initializer_list>
+#include <string_view>
+#include <type_traits>
+
+#include "../holor/holor.h"
+#include "../holor/holor_concepts.h"
+#include "../common/runtime_assertions.h"
+#include "../common/allocators.h"
+#include "../layout/layout_traversal.h"
+#include "holor_operations.h"
+#include "holor_gemm.h"
+
+
+namespace holor{
+
+namespace impl{
+
+/*================================================================================================
+                                    CONTRACTION PLAN
+================================================================================================*/
+/*!
+ * \brief Structure that describes a dimension involved in a contraction: its length and its strides in the first operand, in the second operand and in the result. The stride is zero in the containers that do not have the dimension.
+ */
+struct ContractionAxis{
+    size_t length_;                             /*! length of the dimension */
+    std::array<std::ptrdiff_t, 3> strides_;     /*! strides of the dimension in the first operand (index 0), in the second operand (index 1) and in the result (index 2) */
+};
+
+/*!
+ * \brief Structure that describes a contraction as a batch of matrix products: the dimensions are grouped into the batch dimensions, the rows (free dimensions of the first operand),
+ * the columns (free dimensions of the second operand) and the contracted dimensions. The dimensions of each group are listed from the outermost to the innermost.
+ */
+struct ContractionPlan{
+    std::vector<ContractionAxis> batch_;        /*! dimensions of the operands and of the result that are traversed by the batch of products */
+    std::vector<ContractionAxis> rows_;         /*! free dimensions of the first operand, that are the rows of the products */
+    std::vector<ContractionAxis> columns_;      /*! free dimensions of the second operand, that are the columns of the products */
+    std::vector<ContractionAxis> contracted_;   /*! dimensions of the operands that are summed over */
+};
+
+/*!
+ * \brief Function that coalesces a group of dimensions of a container into a single dimension with a constant stride
+ * \param axes the dimensions of the group, from the outermost to the innermost
+ * \param operand the index of the container (0 and 1 for the operands, 2 for the result)
+ * \param length used to return the length of the coalesced dimension
+ * \param stride used to return the stride of the coalesced dimension
+ * \return true if the dimensions can be coalesced, i.e., if the stride of each dimension is the stride of the next one multiplied by its length (ignoring the dimensions with a single element)
+ */
+inline bool coalesce_axes(const std::vector<ContractionAxis>& axes, size_t operand, size_t& length, std::ptrdiff_t& stride){
+    length = 1;
+    stride = 0;
+    bool found = false;
+    for (const auto& axis: axes){
+        length *= axis.length_;
+        if (axis.length_ == 1){
+            continue;
+        }
+        if (found && stride != axis.strides_[operand]*static_cast<std::ptrdiff_t>(axis.length_)){
+            return false;
+        }
+        stride = axis.strides_[operand];
+        found = true;
+    }
+    return true;
+}
+
+/*!
+ * \brief Function that collects the lengths and the strides of a container along a sequence of groups of dimensions, that must contain exactly its `N` dimensions
+ * \tparam N number of dimensions of the container
+ * \param groups the groups of dimensions, from the outermost to the innermost
+ * \param operand the index of the container (0 and 1 for the operands, 2 for the result)
+ * \return a pair with the lengths and the strides of the container in the order of the groups
+ */
+template<size_t N>
+std::pair<std::array<size_t, N>, std::array<std::ptrdiff_t, N>> gather_axes(std::initializer_list<std::vector<ContractionAxis>*> groups, size_t operand){
+    std::pair<std::array<size_t, N>, std::array<std::ptrdiff_t, N>> result;
+    result.first.fill(1);
+    result.second.fill(0);
+    size_t dim = 0;
+    for (auto group: groups){
+        for (const auto& axis: *group){
+            result.first[dim] = axis.length_;
+            result.second[dim] = axis.strides_[operand];
+            dim++;
+        }
+    }
+    return result;
+}
+
+/*!
+ * \brief Function that assigns row-major strides to a container along a sequence of groups of dimensions, as if its dimensions were permuted in the order of the groups and stored contiguously
+ * \param groups the groups of dimensions, from the outermost to the innermost
+ * \param operand the index of the container (0 and 1 for the operands, 2 for the result)
+ */
+inline void assign_contiguous_strides(std::initializer_list<std::vector<ContractionAxis>*> groups, size_t operand){
+    std::ptrdiff_t stride = 1;
+    for (auto group = std::rbegin(groups); group != std::rend(groups); ++group){
+        for (auto axis = (*group)->rbegin(); axis != (*group)->rend(); ++axis){
+            axis->strides_[operand] = stride;
+            stride *= static_cast<std::ptrdiff_t>(axis->length_);
+        }
+    }
+}
+
+/*!
+ * \brief Function that copies the elements of an operand of a contraction in a contiguous buffer, with its dimensions permuted in the order of the groups, and updates the strides of the plan accordingly
+ * \tparam N number of dimensions of the operand
+ * \param src pointer to the first element of the operand
+ * \param groups the groups of dimensions of the operand, from the outermost to the innermost
+ * \param operand the index of the operand (0 or 1)
+ * \return the buffer
+ */
+template<size_t N, typename T>
+std::vector<T, AlignedAllocator<T>> pack_operand(const T* src, std::initializer_list<std::vector<ContractionAxis>*> groups, size_t operand){
+    const auto [lengths, src_strides] = gather_axes<N>(groups, operand);
+    assign_contiguous_strides(groups, operand);
+    const auto dest_strides = gather_axes<N>(groups, operand).second;
+    size_t size = 1;
+    for (auto length: lengths){
+        size *= length;
+    }
+    std::vector<T, AlignedAllocator<T>> buffer(size);
+    impl::copy_transposed(buffer.data(), src, impl::normalize_layouts<N,2>(lengths, {dest_strides, src_strides}, {0, 0}));
+    return buffer;
+}
+
+/*!
+ * \brief Function that executes a contraction described by a plan whose groups of dimensions can be coalesced in all the containers, computing one matrix product for each element of the batch.
+ * When the batch has at least as many elements as the threads allowed by the policy, the batch is distributed across the threads and each product is computed sequentially; otherwise the products are computed one after the other, each one according to the policy.
+ * \param policy the execution policy
+ * \param plan the plan of the contraction
+ * \param a pointer to the first element of the first operand
+ * \param b pointer to the first element of the second operand
+ * \param c pointer to the first element of the result
+ */
+template<ExecutionPolicy Policy, typename T>
+void execute_contraction(const Policy& policy, const ContractionPlan& plan, const T* a, const T* b, T* c){
+    size_t m, n, k;
+    std::ptrdiff_t rsa, csa, rsb, csb, rsc, csc;
+    coalesce_axes(plan.rows_, 0, m, rsa);
+    coalesce_axes(plan.rows_, 2, m, rsc);
+    coalesce_axes(plan.columns_, 1, n, csb);
+    coalesce_axes(plan.columns_, 2, n, csc);
+    coalesce_axes(plan.contracted_, 0, k, csa);
+    coalesce_axes(plan.contracted_, 1, k, rsb);
+
+    size_t batch_size = 1;
+    for (const auto& axis: plan.batch_){
+        batch_size *= axis.length_;
+    }
+    auto batch_offsets = [&plan](size_t index){
+        std::array<std::ptrdiff_t, 3> offsets{0, 0, 0};
+        for (auto axis = plan.batch_.rbegin(); axis != plan.batch_.rend(); ++axis){
+            const auto coordinate = static_cast<std::ptrdiff_t>(index%axis->length_);
+            index /= axis->length_;
+            for (size_t k = 0; k < 3; k++){
+                offsets[k] += coordinate*axis->strides_[k];
+            }
+        }
+        return offsets;
+    };
+
+    const size_t work = batch_size*m*n*k;
+    if (batch_size > 1 && impl::partition_count(policy, batch_size, work) == impl::partition_count(policy, work, work)){
+        impl::parallel_partition(policy, batch_size, work, [&](size_t begin, size_t end, size_t){
+            for (size_t index = begin; index < end; index++){
+                const auto offsets = batch_offsets(index);
+                impl::gemm(execution::seq, m, n, k, T{1}, a + offsets[0], rsa, csa, b + offsets[1], rsb, csb, T{}, c + offsets[2], rsc, csc);
+            }
+        });
+    } else{
+        for (size_t index = 0; index < batch_size; index++){
+            const auto offsets = batch_offsets(index);
+            impl::gemm(policy, m, n, k, T{1}, a + offsets[0], rsa, csa, b + offsets[1], rsb, csb, T{}, c + offsets[2], rsc, csc);
+        }
+    }
+}
+
+/*!
+ * \brief Function that computes a contraction described by a plan, where the strides of the result are not set yet. The result is a new Holor whose elements are stored in row-major order,
+ * or a scalar if the result has no dimensions.
+ * \tparam NC number of dimensions of the result
+ * \param policy the execution policy
+ * \param a the first operand
+ * \param b the second operand
+ * \param plan the plan of the contraction. The strides of the result are assigned by the function
+ * \param lengths the lengths of the result
+ * \param result_dims for each dimension of the result, its group (0 for batch, 1 for rows, 2 for columns) and its index in the group
+ * \return the result of the contraction
+ */
+template<size_t NC, ExecutionPolicy Policy, HolorType A, HolorType B>
+auto contract_with_plan(const Policy& policy, const A& a, const B& b, ContractionPlan& plan, const std::array<size_t, NC>& lengths, const std::array<std::pair<size_t, size_t>, NC>& result_dims){
+    using T = typename A::value_type;
+    using result_type = std::conditional_t<(NC > 0), Holor<T, (NC > 0) ? NC : 1, typename impl::result_allocator<A>::type>, T>;
+
+    const T* a_ptr = a.data() + a.layout().offset();
+    const T* b_ptr = b.data() + b.layout().offset();
+    std::vector<T, AlignedAllocator<T>> a_buffer, b_buffer, c_buffer;
+    size_t length;
+    std::ptrdiff_t stride;
+    if (!coalesce_axes(plan.rows_, 0, length, stride) || !coalesce_axes(plan.contracted_, 0, length, stride)){
+        a_buffer = impl::pack_operand<A::dimensions>(a_ptr, {&plan.batch_, &plan.rows_, &plan.contracted_}, 0);
+        a_ptr = a_buffer.data();
+    }
+    if (!coalesce_axes(plan.contracted_, 1, length, stride) || !coalesce_axes(plan.columns_, 1, length, stride)){
+        b_buffer = impl::pack_operand<B::dimensions>(b_ptr, {&plan.batch_, &plan.contracted_, &plan.columns_}, 1);
+        b_ptr = b_buffer.data();
+    }
+
+    if constexpr(NC == 0){
+        T result{};
+        impl::execute_contraction(policy, plan, a_ptr, b_ptr, &result);
+        return result;
+    } else{
+        result_type result(holor::uninitialized, lengths);
+        const auto strides = result.layout().strides();
+        std::array<std::vector<ContractionAxis>*, 3> groups{&plan.batch_, &plan.rows_, &plan.columns_};
+        for (size_t i = 0; i < NC; i++){
+            (*groups[result_dims[i].first])[result_dims[i].second].strides_[2] = strides[i];
+        }
+        if (coalesce_axes(plan.rows_, 2, length, stride) && coalesce_axes(plan.columns_, 2, length, stride)){
+            impl::execute_contraction(policy, plan, a_ptr, b_ptr, result.data());
+        } else{
+            // compute the products in a contiguous buffer and permute its dimensions into the result
+            const auto [permuted_lengths, result_strides] = gather_axes<NC>({&plan.batch_, &plan.rows_, &plan.columns_}, 2);
+            assign_contiguous_strides({&plan.batch_, &plan.rows_, &plan.columns_}, 2);
+            const auto buffer_strides = gather_axes<NC>({&plan.batch_, &plan.rows_, &plan.columns_}, 2).second;
+            c_buffer.resize(result.size());
+            impl::execute_contraction(policy, plan, a_ptr, b_ptr, c_buffer.data());
+            impl::copy_transposed(result.data(), c_buffer.data(), impl::normalize_layouts<NC,2>(permuted_lengths, {result_strides, buffer_strides}, {0, 0}));
+        }
+        return result;
+    }
+}
+
+} //namespace impl
+
+
+
+/*================================================================================================
+                                    MATRIX PRODUCT
+================================================================================================*/
+/*!
+ * \brief Function that computes the matrix product `C = alpha*A*B + beta*C` of 2D containers with the GEMM kernel (see holor_gemm.h).
+ * The containers can be Holors or HolorRefs with arbitrary strides, such as the strided slices of a container or the views returned by `transpose_view`, which are read and written in place.
+ * \param policy the execution policy (optional). The parallel policies distribute the tiles of `C` across the threads of the global executor
+ * \param a the `m x k` matrix `A`
+ * \param b the `k x n` matrix `B`
+ * \param c the `m x n` matrix `C`, which must not overlap `A` or `B`. When `beta` is zero its elements are not read
+ * \param alpha the scalar that multiplies `A*B` (optional, 1 by default)
+ * \param beta the scalar that multiplies `C` (optional, 0 by default)
+ * \exception holor::exception::HolorRuntimeError if the lengths of the matrices are not compatible. The compiler flag DDEFINE_ASSERT_LEVEL in the CMakeLists can be set to AssertionLevel::no_checks to exclude this check.
+ */
+template<ExecutionPolicy Policy, HolorType A, HolorType B, HolorType C> requires ((A::dimensions == 2) && (B::dimensions == 2) && (C::dimensions == 2) && std::is_same_v<typename A::value_type, typename C::value_type> && std::is_same_v<typename B::value_type, typename C::value_type>)
+void matmul(const Policy& policy, const A& a, const B& b, C& c, typename C::value_type alpha = typename C::value_type(1), typename C::value_type beta = typename C::value_type(0)){
+    assert::dynamic_assert((a.length(1) == b.length(0)) && (c.length(0) == a.length(0)) && (c.length(1) == b.length(1)), EXCEPTION_MESSAGE("holor::matmul - The lengths of the matrices are not compatible."));
+    const auto strides_a = a.layout().strides();
+    const auto strides_b = b.layout().strides();
+    const auto strides_c = c.layout().strides();
+    impl::gemm(policy, c.length(0), c.length(1), a.length(1), alpha, a.data() + a.layout().offset(), strides_a[0], strides_a[1], b.data() + b.layout().offset(), strides_b[0], strides_b[1],
+        beta, c.data() + c.layout().offset(), strides_c[0], strides_c[1]);
+}
+
+template<HolorType A, HolorType B, HolorType C> requires ((A::dimensions == 2) && (B::dimensions == 2) && (C::dimensions == 2) && std::is_same_v<typename A::value_type, typename C::value_type> && std::is_same_v<typename B::value_type, typename C::value_type>)
+void matmul(const A& a, const B& b, C& c, typename C::value_type alpha = typename C::value_type(1), typename C::value_type beta = typename C::value_type(0)){
+    matmul(execution::seq, a, b, c, alpha, beta);
+}
+
+/*!
+ * \brief Function that computes the matrix product `A*B` of 2D containers with the GEMM kernel (see holor_gemm.h)
+ * \param policy the execution policy (optional)
+ * \param a the `m x k` matrix `A`
+ * \param b the `k x n` matrix `B`
+ * \exception holor::exception::HolorRuntimeError if the lengths of the matrices are not compatible. The compiler flag DDEFINE_ASSERT_LEVEL in the CMakeLists can be set to AssertionLevel::no_checks to exclude this check.
+ * \return a new `m x n` Holor whose elements are stored in row-major order
+ */
+template<ExecutionPolicy Policy, HolorType A, HolorType B> requires ((A::dimensions == 2) && (B::dimensions == 2) && std::is_same_v<typename A::value_type, typename B::value_type>)
+auto matmul(const Policy& policy, const A& a, const B& b){
+    impl::result_holor_t<A> result(holor::uninitialized, std::array<size_t, 2>{a.length(0), b.length(1)});
+    matmul(policy, a, b, result);
+    return result;
+}
+
+template<HolorType A, HolorType B> requires ((A::dimensions == 2) && (B::dimensions == 2) && std::is_same_v<typename A::value_type, typename B::value_type>)
+auto matmul(const A& a, const B& b){
+    return matmul(execution::seq, a, b);
+}
+
+
+
+/*================================================================================================
+                                    CONTRACT
+================================================================================================*/
+/*!
+ * \brief Function that contracts two containers over `K` pairs of dimensions, summing the products of their elements along the paired dimensions, as `numpy.tensordot`.
+ * The dimensions of the result are the dimensions of `a` that are not contracted, followed by the dimensions of `b` that are not contracted, in their original order.
+ * For example, `contract<1>(a, b, {1}, {0})` is the matrix product of two 2D containers, and `contract<2>(a, b, {0, 1}, {0, 1})` is the sum of the element-wise products of two 2D containers.
+ * The contraction is computed with the GEMM kernel, reading the containers in place whenever their free and contracted dimensions can be coalesced (see holor_contraction.h).
+ * \tparam K number of contracted pairs of dimensions
+ * \param a the first container
+ * \param b the second container, with the same type of elements of `a`
+ * \param axes_a the contracted dimensions of `a`
+ * \param axes_b the contracted dimensions of `b`. The dimension `axes_b[i]` is paired with the dimension `axes_a[i]`
+ * \exception holor::exception::HolorRuntimeError if the contracted dimensions are not valid and distinct, or if two paired dimensions have different lengths. The compiler flag DDEFINE_ASSERT_LEVEL in the CMakeLists can be set to AssertionLevel::no_checks to exclude this check.
+ * \return a new Holor with `A::dimensions + B::dimensions - 2K` dimensions whose elements are stored in row-major order, or a scalar if all the dimensions are contracted
+ */
+template<size_t K, ExecutionPolicy Policy, HolorType A, HolorType B> requires (std::is_same_v<typename A::value_type, typename B::value_type> && (K <= A::dimensions) && (K <= B::dimensions))
+auto contract(const Policy& policy, const A& a, const B& b, const std::array<size_t, K>& axes_a, const std::array<size_t, K>& axes_b){
+    constexpr size_t NA = A::dimensions;
+    constexpr size_t NB = B::dimensions;
+    constexpr size_t NC = NA + NB - 2*K;
+    const auto lengths_a = a.lengths();
+    const auto lengths_b = b.lengths();
+    const auto strides_a = a.layout().strides();
+    const auto strides_b = b.layout().strides();
+
+    std::array<bool, NA> contracted_a{};
+    std::array<bool, NB> contracted_b{};
+    bool valid = true;
+    for (size_t i = 0; i < K; i++){
+        valid = valid && (axes_a[i] < NA) && (axes_b[i] < NB) && !contracted_a[axes_a[i]] && !contracted_b[axes_b[i]] && (lengths_a[axes_a[i]] == lengths_b[axes_b[i]]);
+        if (!valid){
+            break;
+        }
+        contracted_a[axes_a[i]] = true;
+        contracted_b[axes_b[i]] = true;
+    }
+    assert::dynamic_assert(valid, EXCEPTION_MESSAGE("holor::contract - The contracted dimensions are not valid or have different lengths."));
+
+    impl::ContractionPlan plan;
+    std::array<size_t, NC> lengths;
+    std::array<std::pair<size_t, size_t>, NC> result_dims;
+    size_t dim = 0;
+    for (size_t i = 0; i < K; i++){
+        plan.contracted_.push_back({lengths_a[axes_a[i]], {strides_a[axes_a[i]], strides_b[axes_b[i]], 0}});
+    }
+    for (size_t i = 0; i < NA; i++){
+        if (!contracted_a[i]){
+            lengths[dim] = lengths_a[i];
+            result_dims[dim++] = {1, plan.rows_.size()};
+            plan.rows_.push_back({lengths_a[i], {strides_a[i], 0, 0}});
+        }
+    }
+    for (size_t i = 0; i < NB; i++){
+        if (!contracted_b[i]){
+            lengths[dim] = lengths_b[i];
+            result_dims[dim++] = {2, plan.columns_.size()};
+            plan.columns_.push_back({lengths_b[i], {0, strides_b[i], 0}});
+        }
+    }
+    return impl::contract_with_plan<NC>(policy, a, b, plan, lengths, result_dims);
+}
+
+template<size_t K, HolorType A, HolorType B> requires (std::is_same_v<typename A::value_type, typename B::value_type> && (K <= A::dimensions) && (K <= B::dimensions))
+auto contract(const A& a, const B& b, const std::array<size_t, K>& axes_a, const std::array<size_t, K>& axes_b){
+    return contract<K>(execution::seq, a, b, axes_a, axes_b);
+}
+
+
+
+/*================================================================================================
+                                    EINSUM
+================================================================================================*/
+/*!
+ * \brief Function that computes a contraction of two containers described by a subscripts string in the Einstein notation, as `numpy.einsum` with two operands and an explicit output.
+ * The string has the form `"<labels of a>,<labels of b>-><labels of the result>"`, with one letter for each dimension (spaces are ignored). A label that appears in both operands and not in the result is contracted,
+ * a label that appears in both operands and in the result is a batch dimension (e.g., `"bij,bjk->bik"` is a batch of matrix products), and a label that appears in one operand and in the result is a free dimension.
+ * The dimensions of the result can be in any order. A label cannot be repeated in an operand, and every label of an operand must appear in the other operand or in the result.
+ * \tparam NC number of dimensions of the result
+ * \param policy the execution policy (optional)
+ * \param subscripts the subscripts string
+ * \param a the first container
+ * \param b the second container, with the same type of elements of `a`
+ * \exception holor::exception::HolorRuntimeError if the subscripts string is not valid for the containers, or if the dimensions with the same label have different lengths. The compiler flag DDEFINE_ASSERT_LEVEL in the CMakeLists can be set to AssertionLevel::no_checks to exclude this check.
+ * \return a new Holor with `NC` dimensions whose elements are stored in row-major order, or a scalar if `NC` is zero
+ */
+template<size_t NC, ExecutionPolicy Policy, HolorType A, HolorType B> requires std::is_same_v<typename A::value_type, typename B::value_type>
+auto einsum(const Policy& policy, std::string_view subscripts, const A& a, const B& b){
+    constexpr size_t NA = A::dimensions;
+    constexpr size_t NB = B::dimensions;
+    constexpr size_t labels = 128;
+    constexpr size_t absent = static_cast<size_t>(-1);
+
+    // parse the subscripts: positions[k][label] is the dimension of the label in the first operand (k=0), in the second operand (k=1) and in the result (k=2)
+    std::array<std::array<size_t, labels>, 3> positions;
+    for (auto& p: positions){
+        p.fill(absent);
+    }
+    std::array<std::array<char, labels>, 3> order{};
+    std::array<size_t, 3> counts{0, 0, 0};
+    const std::array<size_t, 3> ranks{NA, NB, NC};
+    size_t operand = 0;
+    bool valid = true;
+    for (size_t i = 0; i < subscripts.size() && valid; i++){
+        const char ch = subscripts[i];
+        if (ch == ' '){
+            continue;
+        } else if (ch == ','){
+            valid = (operand == 0);
+            operand = 1;
+        } else if (ch == '-'){
+            valid = (operand == 1) && (i+1 < subscripts.size()) && (subscripts[i+1] == '>');
+            operand = 2;
+            i++;
+        } else{
+            const auto label = static_cast<unsigned char>(ch);
+            valid = ((ch >= 'a' && ch <= 'z') || (ch >= 'A' && ch <= 'Z')) && (positions[operand][label] == absent) && (counts[operand] < ranks[operand]);
+            if (valid){
+                positions[operand][label] = counts[operand];
+                order[operand][counts[operand]++] = ch;
+            }
+        }
+    }
+    valid = valid && (operand == 2) && (counts == ranks);
+    assert::dynamic_assert(valid, EXCEPTION_MESSAGE("holor::einsum - The subscripts are not valid for the operands."));
+
+    const auto lengths_a = a.lengths();
+    const auto lengths_b = b.lengths();
+    const auto strides_a = a.layout().strides();
+    const auto strides_b = b.layout().strides();
+    impl::ContractionPlan plan;
+    std::array<size_t, NC> lengths;
+    std::array<std::pair<size_t, size_t>, NC> result_dims;
+    for (size_t i = 0; i < NC && valid; i++){
+        const auto label = static_cast<unsigned char>(order[2][i]);
+        const size_t pa = positions[0][label];
+        const size_t pb = positions[1][label];
+        valid = (pa != absent || pb != absent) && (pa == absent || pb == absent || lengths_a[pa] == lengths_b[pb]);
+        if (!valid){
+            break;
+        }
+        lengths[i] = (pa != absent) ? lengths_a[pa] : lengths_b[pb];
+        impl::ContractionAxis axis{lengths[i], {(pa != absent) ? strides_a[pa] : 0, (pb != absent) ? strides_b[pb] : 0, 0}};
+        auto& group = (pa != absent && pb != absent) ? plan.batch_ : ((pa != absent) ? plan.rows_ : plan.columns_);
+        result_dims[i] = {(pa != absent && pb != absent) ? 0 : ((pa != absent) ? 1 : 2), group.size()};
+        group.push_back(axis);
+    }
+    for (size_t i = 0; i < NA && valid; i++){
+        const auto label = static_cast<unsigned char>(order[0][i]);
+        if (positions[2][label] == absent){
+            const size_t pb = positions[1][label];
+            valid = (pb != absent) && (lengths_a[i] == lengths_b[pb]);
+            if (valid){
+                plan.contracted_.push_back({lengths_a[i], {strides_a[i], strides_b[pb], 0}});
+            }
+        }
+    }
+    for (size_t i = 0; i < NB && valid; i++){
+        const auto label = static_cast<unsigned char>(order[1][i]);
+        valid = (positions[2][label] != absent) || (positions[0][label] != absent);
+    }
+    assert::dynamic_assert(valid, EXCEPTION_MESSAGE("holor::einsum - The labels of the subscripts do not match the dimensions of the operands."));
+    return impl::contract_with_plan<NC>(policy, a, b, plan, lengths, result_dims);
+}
+
+template<size_t NC, HolorType A, HolorType B> requires std::is_same_v<typename A::value_type, typename B::value_type>
+auto einsum(std::string_view subscripts, const A& a, const B& b){
+    return einsum<NC>(execution::seq, subscripts, a, b);
+}
+
+} //namespace holor
+
+#endif // HOLOR_CONTRACTION_H
@@ -0,0 +1,264 @@
+// This file is part of Holor, a C++ header-only template library for multi-dimensional containers
+
+// Copyright 2020-2022 Carlo Masone
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to 
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is 
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER 
+// DEALINGS IN THE SOFTWARE.
+
+
+
+#ifndef HOLOR_EXECUTION_H
+#define HOLOR_EXECUTION_H
+
+/** \file holor_execution.h
+ * \brief This header contains the execution policies accepted by the operations and the utilities that partition the work of an operation across the threads of the executor (see executor.h).
+ *
+ * The parallel overloads of the operations partition the outermost dimension of the traversed layouts into contiguous chunks, one per thread,
+ * so that each thread works on a contiguous block of memory when the containers are stored in row-major order.
+ * The header also contains `parallel_for_slices`, which runs a function on the slices of a container as tasks of an executor.
+ */
+
+#include <cstddef>
+#include <array>
+#include <algorithm>
+#include <type_traits>
+#include <utility>
+
+#include "../common/executor.h"
+#include "../layout/layout_traversal.h"
+#include "../holor/holor_concepts.h"
+#include "../holor/holor_ref.h"
+
+
+namespace holor{
+
+namespace execution{
+
+/*================================================================================================
+                                    EXECUTION POLICIES
+================================================================================================*/
+/*!
+ * \brief Policy that requires an operation to be executed sequentially by the calling thread. The operations called with this policy are equivalent to the overloads without policy.
+ */
+struct sequenced_policy{};
+
+/*!
+ * \brief Policy that allows an operation to be executed by multiple threads.
+ * The elements are partitioned along the outermost dimension into contiguous chunks that are assigned to different threads, so the function passed to the operation must be safe to call concurrently on different elements.
+ * The parallel reductions combine partial results computed by different threads, so they require an associative function.
+ */
+struct parallel_policy{
+    size_t threads_ = 0; ///< \brief maximum number of threads used by an operation. If zero, all the threads of the global executor are used
+
+    /*!
+     * \brief Function that returns a copy of the policy that uses at most `n` threads
+     * \param n maximum number of threads
+     * \return the new policy
+     */
+    constexpr parallel_policy with_threads(size_t n) const{
+        return parallel_policy{n};
+    }
+};
+
+/*!
+ * \brief Policy that allows an operation to be executed by multiple threads and to be vectorized within each thread, so the function passed to the operation must also not synchronize with other calls.
+ * The partition of the work is the same of `parallel_policy`.
+ */
+struct parallel_unsequenced_policy{
+    size_t threads_ = 0; ///< \brief maximum number of threads used by an operation. If zero, all the threads of the global executor are used
+
+    /*!
+     * \brief Function that returns a copy of the policy that uses at most `n` threads
+     * \param n maximum number of threads
+     * \return the new policy
+     */
+    constexpr parallel_unsequenced_policy with_threads(size_t n) const{
+        return parallel_unsequenced_policy{n};
+    }
+};
+
+inline constexpr sequenced_policy seq{};
+inline constexpr parallel_policy par{};
+inline constexpr parallel_unsequenced_policy par_unseq{};
+
+/*!
+ * \brief Minimum number of elements processed by a thread. Operations on containers with fewer elements than twice this value are executed sequentially, because the cost of waking the threads would exceed the gain.
+ */
+inline constexpr size_t min_elements_per_thread = 32768;
+
+} //namespace execution
+
+
+/*!
+ * \brief Concept that constrains the execution policies accepted by the operations
+ */
+template<class P>
+concept ExecutionPolicy = std::is_same_v<std::remove_cvref_t<P>, execution::sequenced_policy> || std::is_same_v<std::remove_cvref_t<P>, execution::parallel_policy> || std::is_same_v<std::remove_cvref_t<P>, execution::parallel_unsequenced_policy>;
+
+
+
+namespace impl{
+
+/*================================================================================================
+                                    PARTITION OF THE WORK
+================================================================================================*/
+/*!
+ * \brief Function that computes in how many chunks the work of an operation is partitioned
+ * \param policy the execution policy
+ * \param length the length of the partitioned dimension
+ * \param elements the total number of elements processed by the operation
+ * \return the number of chunks, which is at most the length of the partitioned dimension and at most the number of threads allowed by the policy
+ */
+template<ExecutionPolicy Policy>
+size_t partition_count(const Policy& policy, size_t length, size_t elements){
+    if constexpr(std::is_same_v<std::remove_cvref_t<Policy>, execution::sequenced_policy>){
+        return (length > 0) ? 1 : 0;
+    } else{
+        if (length == 0){
+            return 0;
+        }
+        size_t threads = (policy.threads_ > 0) ? policy.threads_ : executor::global().concurrency();
+        size_t by_work = std::max<size_t>(1, elements/execution::min_elements_per_thread);
+        return std::min({threads, length, by_work});
+    }
+}
+
+/*!
+ * \brief Function that partitions the range `[0, length)` into contiguous chunks of balanced size and calls a function on each chunk, using the threads of the global executor when the policy allows it.
+ * \param policy the execution policy
+ * \param length the length of the partitioned range
+ * \param elements the total number of elements processed by the operation, which determines how many threads are worth using
+ * \param func the function, which is called as `func(begin, end, chunk)` where `[begin, end)` is the chunk of the range and `chunk` is its index in the range `[0, partition_count(policy, length, elements))`
+ */
+template<ExecutionPolicy Policy, class Func>
+void parallel_partition(const Policy& policy, size_t length, size_t elements, Func&& func){
+    const size_t chunks = partition_count(policy, length, elements);
+    if (chunks == 0){
+        return;
+    }
+    if (chunks == 1){
+        func(size_t{0}, length, size_t{0});
+        return;
+    }
+    executor::global().parallel_for(0, chunks, 1, [&](size_t first, size_t last){
+        for (size_t k = first; k < last; k++){
+            func(k*length/chunks, (k+1)*length/chunks, k);
+        }
+    });
+}
+
+/*!
+ * \brief Function that restricts `M` layouts with the same lengths to the range `[begin, end)` of one of their dimensions, and normalizes them
+ * \param lengths the lengths of the layouts
+ * \param strides the strides of each layout
+ * \param offsets the offset of each layout
+ * \param dim the restricted dimension
+ * \param begin the first index of the range
+ * \param end the index past the last one of the range
+ * \return the normalized layouts of the range
+ */
+template<size_t N, size_t M>
+NormalizedLayouts<N,M> normalize_chunk(std::array<size_t, N> lengths, const std::array<std::array<std::ptrdiff_t, N>, M>& strides, std::array<size_t, M> offsets, size_t dim, size_t begin, size_t end){
+    lengths[dim] = end - begin;
+    for (size_t k = 0; k < M; k++){
+        offsets[k] += begin*strides[k][dim];
+    }
+    return normalize_layouts<N,M>(lengths, strides, offsets);
+}
+
+/*!
+ * \brief Function that traverses jointly the elements of `M` layouts with the same lengths, like `for_each_index`, partitioning one of their dimensions across the threads allowed by the execution policy.
+ * Each thread traverses the elements of its chunk in row-major order. Different threads must not write the same element, so the partitioned dimension must not have zero stride in a layout that is written.
+ * \tparam N is the number of dimensions of the layouts
+ * \tparam M is the number of layouts
+ * \param policy the execution policy
+ * \param lengths the lengths of the layouts
+ * \param strides the strides of each layout
+ * \param offsets the offset of each layout
+ * \param dim the partitioned dimension, which should be the outermost dimension that satisfies the constraint above
+ * \param func the function, which is called with `M` arguments of type `size_t`, i.e., `func(index_0, ..., index_M-1)`
+ */
+template<size_t N, size_t M, ExecutionPolicy Policy, class Func>
+void parallel_for_each_index(const Policy& policy, const std::array<size_t, N>& lengths, const std::array<std::array<std::ptrdiff_t, N>, M>& strides, const std::array<size_t, M>& offsets, size_t dim, Func&& func){
+    size_t elements = 1;
+    for (auto l : lengths){
+        elements *= l;
+    }
+    if (elements == 0){
+        return;
+    }
+    parallel_partition(policy, lengths[dim], elements, [&](size_t begin, size_t end, size_t){
+        for_each_index(normalize_chunk<N,M>(lengths, strides, offsets, dim, begin, end), func);
+    });
+}
+
+} //namespace impl
+
+
+/*================================================================================================
+                                    PARALLEL SLICES
+================================================================================================*/
+/*!
+ * \brief Function that partitions a container along a dimension into slices of consecutive indices, and calls a function on each slice as a task of an executor, waiting for the completion of all the tasks.
+ * The range of indices along `Dim` is split recursively in halves, so the threads that finish their slices early steal the largest halves left, and unbalanced or nested workloads are balanced without creating more threads than the executor has.
+ * The slices keep all the dimensions of the container, also when they have a single index along `Dim`. If the container has no elements, the function is not called.
+ * \tparam Dim is the dimension along which the container is partitioned
+ * \param exec is the executor that runs the tasks
+ * \param holor is the container
+ * \param func is the function, which is called as `func(slice)` or `func(slice, first)`, where `slice` is a HolorRef to a slice of the container and `first` is the index of the first element of the slice along `Dim`
+ * \param grain is the maximum number of indices along `Dim` of a slice. If it is zero, it is chosen so that each thread processes about four slices
+ * \exception the first exception thrown by the function, if any
+ */
+template<size_t Dim, HolorType Holor_t, class Func> requires (Dim < Holor_t::dimensions)
+void parallel_for_slices(executor& exec, Holor_t& holor, Func&& func, size_t grain = 0){
+    using Slice = HolorRef<typename Holor_t::value_type, Holor_t::dimensions>;
+    static_assert(std::invocable<Func&, Slice> || std::invocable<Func&, Slice, size_t>, "holor::parallel_for_slices - The function must be callable with a HolorRef, or with a HolorRef and an index.");
+    auto call = [&func](Slice slice, size_t first){
+        if constexpr(std::invocable<Func&, Slice, size_t>){
+            func(std::move(slice), first);
+        } else{
+            func(std::move(slice));
+        }
+    };
+    if (holor.size() == 0){
+        return;
+    }
+    const size_t length = holor.length(Dim);
+    if (grain == 0){
+        grain = (length + 4*exec.concurrency() - 1)/(4*exec.concurrency());
+    }
+    // the slices are built from their lengths and offset rather than with `slice<Dim>(range)`, since a range cannot select a single index
+    const auto& layout = holor.layout();
+    exec.parallel_for(0, length, grain, [&](size_t first, size_t last){
+        auto lengths = layout.lengths();
+        lengths[Dim] = last - first;
+        call(Slice(holor.data(), Layout<Holor_t::dimensions>(lengths, layout.strides(), layout.offset() + first*layout.stride(Dim))), first);
+    });
+}
+
+/*!
+ * \brief Overload of `parallel_for_slices` that runs the tasks on the global executor
+ */
+template<size_t Dim, HolorType Holor_t, class Func> requires (Dim < Holor_t::dimensions)
+void parallel_for_slices(Holor_t& holor, Func&& func, size_t grain = 0){
+    parallel_for_slices<Dim>(executor::global(), holor, std::forward<Func>(func), grain);
+}
+
+} //namespace holor
+
+#endif // HOLOR_EXECUTION_H
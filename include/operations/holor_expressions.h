@@ -0,0 +1,451 @@
+// This file is part of Holor, a C++ header-only template library for multi-dimensional containers
+
+// Copyright 2020-2022 Carlo Masone
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to 
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is 
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER 
+// DEALINGS IN THE SOFTWARE.
+
+#ifndef HOLOR_EXPRESSIONS_H
+#define HOLOR_EXPRESSIONS_H
+
+/** \file holor_expressions.h
+ * \brief This header contains the arithmetic operators and the math functions that can be applied element-wise to holor containers.
+ *
+ * The operators do not compute their result, but return a lazy expression that stores its operands. The expression is evaluated in a single loop
+ * over the elements when it is assigned to a Holor or a HolorRef (or when it is passed to `evaluate`), so that a compound expression like
+ * `a*x + y - 2.0` does not create any temporary container. The layouts of the destination and of all the operands are traversed jointly (see layout_traversal.h).
+ *
+ * The operands of a binary operation are broadcast following the NumPy rules (see `impl::broadcast_lengths`): their lengths are aligned to the right, and a dimension with a single element
+ * (or a missing leading dimension) is repeated along the corresponding dimension of the other operand through a zero stride, without copying it. For example, a `Holor<float,1>` bias of length `n`
+ * can be added to each row of a `Holor<float,2>` of lengths `[m, n]` with `x + bias`.
+ *
+ * An expression stores references to the containers that are passed as lvalues, which must outlive the expression, and copies of the containers passed as rvalues.
+ * The destination of an assignment can appear in the expression only in positions that access the same element being written, e.g., `a = a*2 + b` is allowed, while `a = transpose_view(a) + b` is not.
+ */
+
+
+#include "../holor/holor_concepts.h"
+#include "../holor/holor.h"
+#include "../common/runtime_assertions.h"
+#include "../layout/layout_traversal.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <concepts>
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+
+namespace holor{
+
+
+/*================================================================================================
+                                    EXPRESSION NODES
+================================================================================================*/
+namespace impl{
+
+    /*!
+     * \brief Constraints a type to be an operand of an element-wise expression with a number of dimensions, i.e., a holor container or another expression
+     */
+    template<typename T>
+    concept HolorOperand = HolorType<std::remove_cvref_t<T>> || HolorExpression<std::remove_cvref_t<T>>;
+
+    /*!
+     * \brief Constraints a type to be a scalar operand of an element-wise expression, that is combined with all the elements of the other operand
+     */
+    template<typename T>
+    concept ScalarOperand = (!HolorOperand<T>) && std::is_arithmetic_v<std::remove_cvref_t<T>>;
+
+
+    /*!
+     * \brief Base class of the expression nodes, which implements the evaluation of an expression into a destination container
+     * \tparam Derived is the type of the expression node
+     * \tparam N is the number of dimensions of the expression
+     */
+    template<typename Derived, size_t N>
+    struct ExpressionBase{
+        using expression_type = HolorExpressionTag;     ///< \brief tags the type as an expression
+        static constexpr size_t dimensions = N;         ///< \brief number of dimensions of the expression
+
+        /*!
+         * \brief Function that evaluates the expression into the memory of a destination container, with a single traversal of the destination and of all the operands
+         * \param dest pointer to the memory of the destination
+         * \param layout layout of the destination
+         * \exception holor::exception::HolorRuntimeError if the lengths of the destination are different from the (broadcast) lengths of the expression. The compiler flag DDEFINE_ASSERT_LEVEL in the CMakeLists can be set to AssertionLevel::no_checks to exclude this check.
+         */
+        template<typename U>
+        void evaluate_into(U* dest, const Layout<N>& layout) const{
+            const Derived& expression = static_cast<const Derived&>(*this);
+            assert::dynamic_assert(layout.lengths() == expression.lengths(), EXCEPTION_MESSAGE("holor::evaluate - The lengths of the destination are different from the lengths of the expression."));
+            constexpr size_t M = Derived::leaves + 1;
+            std::array<std::array<std::ptrdiff_t, N>, M> strides;
+            std::array<size_t, M> offsets;
+            strides[0] = layout.strides();
+            offsets[0] = layout.offset();
+            expression.template gather<1>(layout.lengths(), strides, offsets);
+            impl::for_each_index(impl::normalize_layouts<N, M>(layout.lengths(), strides, offsets), [dest, &expression](auto... indices){
+                const std::array<size_t, M> idx{indices...};
+                dest[idx[0]] = expression.template element<1>(idx);
+            });
+        }
+    };
+
+
+    /*!
+     * \brief Leaf of an expression that wraps a holor container
+     * \tparam H is `const Container&` for a container passed as lvalue, which is referenced, or `Container` for a container passed as rvalue, which is stored
+     */
+    template<typename H>
+    class ContainerNode: public ExpressionBase<ContainerNode<H>, std::remove_cvref_t<H>::dimensions>{
+        using container_type = std::remove_cvref_t<H>;
+
+        public:
+            using value_type = typename container_type::value_type;     ///< \brief type of the elements of the expression
+            static constexpr size_t leaves = 1;                         ///< \brief number of containers in the expression
+
+            explicit ContainerNode(H container): container_(std::forward<H>(container)) {}
+
+            auto lengths() const{
+                return container_.lengths();
+            }
+
+            /*!
+             * \brief Function that writes the strides and the offset of the container, broadcast to the lengths of the whole expression, in the position `Offset` of the arrays
+             */
+            template<size_t Offset, size_t N, size_t M>
+            void gather(const std::array<size_t, N>& lengths, std::array<std::array<std::ptrdiff_t, N>, M>& strides, std::array<size_t, M>& offsets) const{
+                const auto layout = container_.layout().broadcast(lengths);
+                strides[Offset] = layout.strides();
+                offsets[Offset] = layout.offset();
+            }
+
+            template<size_t Offset, size_t M>
+            const value_type& element(const std::array<size_t, M>& indices) const{
+                return container_.data()[indices[Offset]];
+            }
+
+        private:
+            H container_;
+    };
+
+
+    /*!
+     * \brief Leaf of an expression that wraps a scalar. It has no dimensions, and it is combined with all the elements of the other operand
+     * \tparam S is the type of the scalar
+     */
+    template<typename S>
+    class ScalarNode{
+        public:
+            using value_type = S;                       ///< \brief type of the scalar
+            static constexpr size_t dimensions = 0;     ///< \brief a scalar has no dimensions
+            static constexpr size_t leaves = 0;         ///< \brief number of containers in the expression
+
+            explicit ScalarNode(S value): value_(value) {}
+
+            template<size_t Offset, size_t N, size_t M>
+            void gather(const std::array<size_t, N>&, std::array<std::array<std::ptrdiff_t, N>, M>&, std::array<size_t, M>&) const {}
+
+            template<size_t Offset, size_t M>
+            const value_type& element(const std::array<size_t, M>&) const{
+                return value_;
+            }
+
+        private:
+            S value_;
+    };
+
+
+    /*!
+     * \brief Node of an expression that applies a unary function to the elements of its operand
+     * \tparam Op is the unary function
+     * \tparam E is the type of the operand node
+     */
+    template<class Op, class E>
+    class UnaryNode: public ExpressionBase<UnaryNode<Op, E>, E::dimensions>{
+        public:
+            using value_type = std::decay_t<std::invoke_result_t<const Op&, const typename E::value_type&>>;    ///< \brief type of the elements of the expression
+            static constexpr size_t leaves = E::leaves;                                                         ///< \brief number of containers in the expression
+
+            UnaryNode(Op op, E operand): op_(std::move(op)), operand_(std::move(operand)) {}
+
+            auto lengths() const{
+                return operand_.lengths();
+            }
+
+            template<size_t Offset, size_t N, size_t M>
+            void gather(const std::array<size_t, N>& lengths, std::array<std::array<std::ptrdiff_t, N>, M>& strides, std::array<size_t, M>& offsets) const{
+                operand_.template gather<Offset>(lengths, strides, offsets);
+            }
+
+            template<size_t Offset, size_t M>
+            value_type element(const std::array<size_t, M>& indices) const{
+                return std::invoke(op_, operand_.template element<Offset>(indices));
+            }
+
+        private:
+            Op op_;
+            E operand_;
+    };
+
+
+    /*!
+     * \brief Node of an expression that applies a binary function to the pairs of elements of its operands. One of the operands can be a scalar.
+     * The operands can have different lengths, and even different numbers of dimensions, if they can be broadcast together following the NumPy rules
+     * \tparam Op is the binary function
+     * \tparam L is the type of the left operand node
+     * \tparam R is the type of the right operand node
+     */
+    template<class Op, class L, class R>
+    class BinaryNode: public ExpressionBase<BinaryNode<Op, L, R>, std::max(L::dimensions, R::dimensions)>{
+        public:
+            using value_type = std::decay_t<std::invoke_result_t<const Op&, const typename L::value_type&, const typename R::value_type&>>; ///< \brief type of the elements of the expression
+            static constexpr size_t leaves = L::leaves + R::leaves;                                                                           ///< \brief number of containers in the expression
+
+            /*!
+             * \brief Constructor of the node from its operands
+             * \exception holor::exception::HolorRuntimeError if the lengths of the operands cannot be broadcast together. The compiler flag DDEFINE_ASSERT_LEVEL in the CMakeLists can be set to AssertionLevel::no_checks to exclude this check.
+             */
+            BinaryNode(Op op, L lhs, R rhs): op_(std::move(op)), lhs_(std::move(lhs)), rhs_(std::move(rhs)) {
+                if constexpr( (L::dimensions > 0) && (R::dimensions > 0) ){
+                    lengths_ = impl::broadcast_lengths(lhs_.lengths(), rhs_.lengths());
+                } else if constexpr(L::dimensions > 0){
+                    lengths_ = lhs_.lengths();
+                } else{
+                    lengths_ = rhs_.lengths();
+                }
+            }
+
+            auto lengths() const{
+                return lengths_;
+            }
+
+            template<size_t Offset, size_t N, size_t M>
+            void gather(const std::array<size_t, N>& lengths, std::array<std::array<std::ptrdiff_t, N>, M>& strides, std::array<size_t, M>& offsets) const{
+                lhs_.template gather<Offset>(lengths, strides, offsets);
+                rhs_.template gather<Offset + L::leaves>(lengths, strides, offsets);
+            }
+
+            template<size_t Offset, size_t M>
+            value_type element(const std::array<size_t, M>& indices) const{
+                return std::invoke(op_, lhs_.template element<Offset>(indices), rhs_.template element<Offset + L::leaves>(indices));
+            }
+
+        private:
+            Op op_;
+            L lhs_;
+            R rhs_;
+            std::array<size_t, std::max(L::dimensions, R::dimensions)> lengths_;   ///< \brief broadcast lengths of the operands
+    };
+
+
+    /*!
+     * \brief Function that wraps an operand into an expression node: expressions are copied, containers are wrapped into a ContainerNode and scalars into a ScalarNode
+     * \param operand the operand
+     * \return the expression node
+     */
+    template<typename T>
+    auto make_node(T&& operand){
+        using type = std::remove_cvref_t<T>;
+        if constexpr(HolorExpression<type>){
+            return type(std::forward<T>(operand));
+        } else if constexpr(HolorType<type>){
+            if constexpr(std::is_lvalue_reference_v<T>){
+                return ContainerNode<const type&>(operand);
+            } else{
+                return ContainerNode<type>(std::move(operand));
+            }
+        } else{
+            return ScalarNode<type>(operand);
+        }
+    }
+
+    /*!
+     * \brief Constraints the operands of a binary element-wise operation: at least one of them is a container or an expression, and the other one can be a scalar
+     */
+    template<typename L, typename R>
+    concept BinaryOperands = (HolorOperand<L> && HolorOperand<R>) || (HolorOperand<L> && ScalarOperand<R>) || (ScalarOperand<L> && HolorOperand<R>);
+
+    /*!
+     * \brief Function that creates the node of a binary operation
+     */
+    template<class Op, typename L, typename R>
+    auto make_binary(Op op, L&& lhs, R&& rhs){
+        auto lhs_node = make_node(std::forward<L>(lhs));
+        auto rhs_node = make_node(std::forward<R>(rhs));
+        return BinaryNode<Op, decltype(lhs_node), decltype(rhs_node)>(std::move(op), std::move(lhs_node), std::move(rhs_node));
+    }
+
+    /*!
+     * \brief Function that creates the node of a unary operation
+     */
+    template<class Op, typename E>
+    auto make_unary(Op op, E&& operand){
+        auto node = make_node(std::forward<E>(operand));
+        return UnaryNode<Op, decltype(node)>(std::move(op), std::move(node));
+    }
+
+
+    /*!
+     * \brief Function objects that implement the element-wise math functions
+     */
+    struct Abs{ template<typename X> auto operator()(const X& x) const{ using std::abs; return abs(x); } };
+    struct Sqrt{ template<typename X> auto operator()(const X& x) const{ using std::sqrt; return sqrt(x); } };
+    struct Exp{ template<typename X> auto operator()(const X& x) const{ using std::exp; return exp(x); } };
+    struct Log{ template<typename X> auto operator()(const X& x) const{ using std::log; return log(x); } };
+    struct Sin{ template<typename X> auto operator()(const X& x) const{ using std::sin; return sin(x); } };
+    struct Cos{ template<typename X> auto operator()(const X& x) const{ using std::cos; return cos(x); } };
+    struct Tan{ template<typename X> auto operator()(const X& x) const{ using std::tan; return tan(x); } };
+    struct Tanh{ template<typename X> auto operator()(const X& x) const{ using std::tanh; return tanh(x); } };
+    struct Pow{ template<typename X, typename Y> auto operator()(const X& x, const Y& y) const{ using std::pow; return pow(x, y); } };
+
+} //namespace impl
+
+
+
+/*================================================================================================
+                                    ARITHMETIC OPERATORS
+================================================================================================*/
+/*!
+ * \brief Element-wise sum of two holor containers or expressions whose lengths can be broadcast together, or of a container or expression and a scalar
+ * \param lhs left operand
+ * \param rhs right operand
+ * \exception holor::exception::HolorRuntimeError if the lengths of the operands cannot be broadcast together. The compiler flag DDEFINE_ASSERT_LEVEL in the CMakeLists can be set to AssertionLevel::no_checks to exclude this check.
+ * \return a lazy expression
+ */
+template<typename L, typename R> requires impl::BinaryOperands<L, R>
+auto operator+(L&& lhs, R&& rhs){
+    return impl::make_binary(std::plus<>{}, std::forward<L>(lhs), std::forward<R>(rhs));
+}
+
+/*!
+ * \brief Element-wise difference of two holor containers or expressions whose lengths can be broadcast together, or of a container or expression and a scalar
+ * \param lhs left operand
+ * \param rhs right operand
+ * \exception holor::exception::HolorRuntimeError if the lengths of the operands cannot be broadcast together. The compiler flag DDEFINE_ASSERT_LEVEL in the CMakeLists can be set to AssertionLevel::no_checks to exclude this check.
+ * \return a lazy expression
+ */
+template<typename L, typename R> requires impl::BinaryOperands<L, R>
+auto operator-(L&& lhs, R&& rhs){
+    return impl::make_binary(std::minus<>{}, std::forward<L>(lhs), std::forward<R>(rhs));
+}
+
+/*!
+ * \brief Element-wise product of two holor containers or expressions whose lengths can be broadcast together, or of a container or expression and a scalar
+ * \param lhs left operand
+ * \param rhs right operand
+ * \exception holor::exception::HolorRuntimeError if the lengths of the operands cannot be broadcast together. The compiler flag DDEFINE_ASSERT_LEVEL in the CMakeLists can be set to AssertionLevel::no_checks to exclude this check.
+ * \return a lazy expression
+ */
+template<typename L, typename R> requires impl::BinaryOperands<L, R>
+auto operator*(L&& lhs, R&& rhs){
+    return impl::make_binary(std::multiplies<>{}, std::forward<L>(lhs), std::forward<R>(rhs));
+}
+
+/*!
+ * \brief Element-wise division of two holor containers or expressions whose lengths can be broadcast together, or of a container or expression and a scalar
+ * \param lhs left operand
+ * \param rhs right operand
+ * \exception holor::exception::HolorRuntimeError if the lengths of the operands cannot be broadcast together. The compiler flag DDEFINE_ASSERT_LEVEL in the CMakeLists can be set to AssertionLevel::no_checks to exclude this check.
+ * \return a lazy expression
+ */
+template<typename L, typename R> requires impl::BinaryOperands<L, R>
+auto operator/(L&& lhs, R&& rhs){
+    return impl::make_binary(std::divides<>{}, std::forward<L>(lhs), std::forward<R>(rhs));
+}
+
+/*!
+ * \brief Element-wise negation of a holor container or expression
+ * \param operand the operand
+ * \return a lazy expression
+ */
+template<impl::HolorOperand E>
+auto operator-(E&& operand){
+    return impl::make_unary(std::negate<>{}, std::forward<E>(operand));
+}
+
+
+
+/*================================================================================================
+                                    MATH FUNCTIONS
+================================================================================================*/
+/*!
+ * \brief Function that applies a unary function element-wise to a holor container or expression
+ * \param operand the operand
+ * \param func the function, that is invoked on each element of the operand
+ * \return a lazy expression
+ */
+template<impl::HolorOperand E, class Func>
+auto map(E&& operand, Func func){
+    return impl::make_unary(std::move(func), std::forward<E>(operand));
+}
+
+/*!
+ * \brief Element-wise math functions of a holor container or expression, that return a lazy expression
+ */
+template<impl::HolorOperand E>
+auto abs(E&& operand){ return impl::make_unary(impl::Abs{}, std::forward<E>(operand)); }
+
+template<impl::HolorOperand E>
+auto sqrt(E&& operand){ return impl::make_unary(impl::Sqrt{}, std::forward<E>(operand)); }
+
+template<impl::HolorOperand E>
+auto exp(E&& operand){ return impl::make_unary(impl::Exp{}, std::forward<E>(operand)); }
+
+template<impl::HolorOperand E>
+auto log(E&& operand){ return impl::make_unary(impl::Log{}, std::forward<E>(operand)); }
+
+template<impl::HolorOperand E>
+auto sin(E&& operand){ return impl::make_unary(impl::Sin{}, std::forward<E>(operand)); }
+
+template<impl::HolorOperand E>
+auto cos(E&& operand){ return impl::make_unary(impl::Cos{}, std::forward<E>(operand)); }
+
+template<impl::HolorOperand E>
+auto tan(E&& operand){ return impl::make_unary(impl::Tan{}, std::forward<E>(operand)); }
+
+template<impl::HolorOperand E>
+auto tanh(E&& operand){ return impl::make_unary(impl::Tanh{}, std::forward<E>(operand)); }
+
+/*!
+ * \brief Element-wise power of a holor container or expression, with a scalar exponent or with the elements of another container or expression as exponents
+ */
+template<typename L, typename R> requires (impl::HolorOperand<L> && impl::BinaryOperands<L, R>)
+auto pow(L&& base, R&& exponent){
+    return impl::make_binary(impl::Pow{}, std::forward<L>(base), std::forward<R>(exponent));
+}
+
+
+
+/*================================================================================================
+                                    EVALUATION
+================================================================================================*/
+/*!
+ * \brief Function that evaluates an expression into a new Holor
+ * \param expression the expression
+ * \return a Holor with the lengths of the expression, whose elements are the values of the expression
+ */
+template<HolorExpression E>
+auto evaluate(const E& expression){
+    return Holor<typename E::value_type, E::dimensions>(expression);
+}
+
+
+} //namespace holor
+
+#endif // HOLOR_EXPRESSIONS_H
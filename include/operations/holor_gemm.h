@@ -0,0 +1,411 @@
+// This file is part of Holor, a C++ header-only template library for multi-dimensional containers
+
+// Copyright 2020-2022 Carlo Masone
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to 
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is 
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER 
+// DEALINGS IN THE SOFTWARE.
+
+
+#ifndef HOLOR_GEMM_H
+#define HOLOR_GEMM_H
+
+/** \file holor_gemm.h
+ * \brief This header contains the general matrix multiplication (GEMM) kernel used by the contractions of containers.
+ *
+ * The kernel computes `C = alpha*A*B + beta*C` for matrices described by a pointer and a row and a column stride, so that it works on transposed and strided views without copying them.
+ * It follows the structure of the high-performance BLAS libraries: the matrices are partitioned in blocks that fit in the caches, the blocks of `A` and `B` are packed in contiguous
+ * panels, and the product of a panel of `A` and a panel of `B` is computed by a micro-kernel that keeps a tile of `C` in the vector registers.
+ * With a parallel execution policy, the blocks of rows of `C` (and, when there are fewer blocks than threads, the panels of columns) are distributed across the threads of the global executor.
+ */
+
+#include <cstddef>
+#include <cstdlib>
+#include <algorithm>
+#include <vector>
+
+#include "../common/allocators.h"
+#include "holor_simd.h"
+#include "holor_execution.h"
+
+
+namespace holor{
+
+namespace impl{
+
+/*================================================================================================
+                                    BLOCKING PARAMETERS
+================================================================================================*/
+/*!
+ * \brief Structure that contains the sizes of the blocks used by the GEMM kernel for elements of type `T`
+ *
+ * The micro-kernel computes a tile of `mr x nr` elements of `C`: for the vectorizable types `nr` is two vector registers and `mr` is chosen so that the accumulators use most of the registers
+ * (12 of the 16 registers of SSE and AVX, 24 of the 32 registers of AVX-512). A panel of `kc x nr` elements of `B` fits in the L1 cache, a block of `mc x kc` elements of `A` in the L2 cache
+ * and a block of `kc x nc` elements of `B` in the L3 cache.
+ * \tparam T type of the elements
+ */
+template<typename T>
+struct gemm_blocking{
+    static constexpr size_t mr = 4;     ///< \brief rows of the tile computed by the micro-kernel
+    static constexpr size_t nr = 4;     ///< \brief columns of the tile computed by the micro-kernel
+    static constexpr size_t kc = 256;   ///< \brief depth of the packed panels
+    static constexpr size_t mc = 64;    ///< \brief rows of the packed blocks of A
+    static constexpr size_t nc = 1024;  ///< \brief columns of the packed blocks of B
+};
+
+#ifdef HOLOR_SIMD_VECTOR_EXTENSIONS
+template<simd::Vectorizable T>
+struct gemm_blocking<T>{
+    static constexpr size_t mr = (simd::register_bytes == 64) ? 12 : 6;
+    static constexpr size_t nr = 2*simd::lanes<T>;
+    static constexpr size_t kc = 256;
+    static constexpr size_t mc = 16*mr;
+    static constexpr size_t nc = 128*nr;
+};
+#endif
+
+
+
+/*!
+ * \brief Number of multiply-add operations (`m*n*k`) up to which the GEMM kernel computes the product directly with a loop nest, without packing the matrices
+ */
+inline constexpr size_t gemm_small_product = 16*16*16;
+
+
+
+/*================================================================================================
+                                    PACKING
+================================================================================================*/
+/*!
+ * \brief Function that packs a block of `A` in panels of `mr` rows. In each panel the `mr` elements of a column are contiguous, and the rows beyond the end of the block are filled with zeros.
+ * \param dest the buffer of the packed block, with at least `ceil(rows/mr)*mr*depth` elements
+ * \param a pointer to the first element of the block
+ * \param rows number of rows of the block
+ * \param depth number of columns of the block
+ * \param row_stride distance between two rows of `A`
+ * \param col_stride distance between two columns of `A`
+ */
+template<typename T>
+void gemm_pack_a(T* dest, const T* a, size_t rows, size_t depth, std::ptrdiff_t row_stride, std::ptrdiff_t col_stride){
+    constexpr size_t MR = gemm_blocking<T>::mr;
+    for (size_t i = 0; i < rows; i += MR){
+        const size_t panel_rows = std::min(MR, rows - i);
+        const T* src = a + static_cast<std::ptrdiff_t>(i)*row_stride;
+        if (row_stride == 1 && panel_rows == MR){
+            // the columns of a full panel are contiguous in the source
+            for (size_t p = 0; p < depth; p++){
+                std::copy_n(src + static_cast<std::ptrdiff_t>(p)*col_stride, MR, dest + p*MR);
+            }
+        } else if (std::abs(col_stride) <= std::abs(row_stride)){
+            // read the rows of the source contiguously
+            for (size_t r = 0; r < panel_rows; r++){
+                for (size_t p = 0; p < depth; p++){
+                    dest[p*MR + r] = src[static_cast<std::ptrdiff_t>(r)*row_stride + static_cast<std::ptrdiff_t>(p)*col_stride];
+                }
+            }
+        } else{
+            for (size_t p = 0; p < depth; p++){
+                for (size_t r = 0; r < panel_rows; r++){
+                    dest[p*MR + r] = src[static_cast<std::ptrdiff_t>(r)*row_stride + static_cast<std::ptrdiff_t>(p)*col_stride];
+                }
+            }
+        }
+        for (size_t r = panel_rows; r < MR; r++){
+            for (size_t p = 0; p < depth; p++){
+                dest[p*MR + r] = T{};
+            }
+        }
+        dest += MR*depth;
+    }
+}
+
+/*!
+ * \brief Function that packs a block of `B` in panels of `nr` columns. In each panel the `nr` elements of a row are contiguous, and the columns beyond the end of the block are filled with zeros.
+ * \param dest the buffer of the packed block, with at least `depth*ceil(cols/nr)*nr` elements
+ * \param b pointer to the first element of the block
+ * \param depth number of rows of the block
+ * \param cols number of columns of the block
+ * \param row_stride distance between two rows of `B`
+ * \param col_stride distance between two columns of `B`
+ */
+template<typename T>
+void gemm_pack_b(T* dest, const T* b, size_t depth, size_t cols, std::ptrdiff_t row_stride, std::ptrdiff_t col_stride){
+    constexpr size_t NR = gemm_blocking<T>::nr;
+    for (size_t j = 0; j < cols; j += NR){
+        const size_t panel_cols = std::min(NR, cols - j);
+        const T* src = b + static_cast<std::ptrdiff_t>(j)*col_stride;
+        if (col_stride == 1 && panel_cols == NR){
+            // the rows of a full panel are contiguous in the source
+            for (size_t p = 0; p < depth; p++){
+                std::copy_n(src + static_cast<std::ptrdiff_t>(p)*row_stride, NR, dest + p*NR);
+            }
+        } else if (std::abs(col_stride) <= std::abs(row_stride)){
+            for (size_t p = 0; p < depth; p++){
+                for (size_t c = 0; c < panel_cols; c++){
+                    dest[p*NR + c] = src[static_cast<std::ptrdiff_t>(p)*row_stride + static_cast<std::ptrdiff_t>(c)*col_stride];
+                }
+                for (size_t c = panel_cols; c < NR; c++){
+                    dest[p*NR + c] = T{};
+                }
+            }
+        } else{
+            // read the columns of the source contiguously
+            for (size_t c = 0; c < panel_cols; c++){
+                for (size_t p = 0; p < depth; p++){
+                    dest[p*NR + c] = src[static_cast<std::ptrdiff_t>(p)*row_stride + static_cast<std::ptrdiff_t>(c)*col_stride];
+                }
+            }
+            for (size_t p = 0; p < depth; p++){
+                for (size_t c = panel_cols; c < NR; c++){
+                    dest[p*NR + c] = T{};
+                }
+            }
+        }
+        dest += NR*depth;
+    }
+}
+
+
+
+/*================================================================================================
+                                    MICRO-KERNEL
+================================================================================================*/
+/*!
+ * \brief Function that updates a tile of `C` with a tile of the product stored in row-major order in a buffer, computing `C = alpha*acc + beta*C`. When `beta` is zero, the elements of `C` are not read.
+ * \param acc the buffer of `mr*nr` elements with the tile of the product
+ * \param rows number of rows of the tile of `C`, at most `mr`
+ * \param cols number of columns of the tile of `C`, at most `nr`
+ * \param alpha the scalar that multiplies the product
+ * \param beta the scalar that multiplies `C`
+ * \param c pointer to the first element of the tile of `C`
+ * \param rsc distance between two rows of `C`
+ * \param csc distance between two columns of `C`
+ */
+template<typename T>
+void gemm_update_tile(const T* acc, size_t rows, size_t cols, T alpha, T beta, T* c, std::ptrdiff_t rsc, std::ptrdiff_t csc){
+    constexpr size_t NR = gemm_blocking<T>::nr;
+    for (size_t r = 0; r < rows; r++){
+        T* c_row = c + static_cast<std::ptrdiff_t>(r)*rsc;
+        for (size_t col = 0; col < cols; col++){
+            T& dest = c_row[static_cast<std::ptrdiff_t>(col)*csc];
+            dest = (beta == T{}) ? alpha*acc[r*NR + col] : alpha*acc[r*NR + col] + beta*dest;
+        }
+    }
+}
+
+/*!
+ * \brief Function that multiplies a packed panel of `A` by a packed panel of `B` and updates the corresponding tile of `C`, computing `C = alpha*A*B + beta*C`.
+ * For the vectorizable types the tile is accumulated in vector registers: at each step of the depth, two vectors of `B` are loaded and each element of the column of `A` is broadcast and multiplied by them.
+ * A full tile of a matrix `C` with unitary column stride is updated directly from the registers; the other tiles are updated through a buffer.
+ * \param depth depth of the panels
+ * \param a the packed panel of `A`
+ * \param b the packed panel of `B`
+ * \param rows number of rows of the tile of `C`, at most `mr`
+ * \param cols number of columns of the tile of `C`, at most `nr`
+ * \param alpha the scalar that multiplies the product
+ * \param beta the scalar that multiplies `C`
+ * \param c pointer to the first element of the tile of `C`
+ * \param rsc distance between two rows of `C`
+ * \param csc distance between two columns of `C`
+ */
+template<typename T>
+void gemm_micro_kernel(size_t depth, const T* a, const T* b, size_t rows, size_t cols, T alpha, T beta, T* c, std::ptrdiff_t rsc, std::ptrdiff_t csc){
+    constexpr size_t MR = gemm_blocking<T>::mr;
+    constexpr size_t NR = gemm_blocking<T>::nr;
+    alignas(64) T acc[MR*NR];
+#ifdef HOLOR_SIMD_VECTOR_EXTENSIONS
+    if constexpr(simd::Vectorizable<T>){
+        using vector_type = simd::impl::vector_t<T>;
+        constexpr size_t L = simd::lanes<T>;
+        vector_type c0[MR], c1[MR];
+#pragma GCC unroll 16
+        for (size_t r = 0; r < MR; r++){
+            c0[r] = vector_type{};
+            c1[r] = vector_type{};
+        }
+        for (size_t p = 0; p < depth; p++){
+            const vector_type b0 = simd::impl::load(b);
+            const vector_type b1 = simd::impl::load(b + L);
+#pragma GCC unroll 16
+            for (size_t r = 0; r < MR; r++){
+                const vector_type ar = simd::impl::broadcast(a[r]);
+                c0[r] = simd::impl::multiply_add<T>(ar, b0, c0[r]);
+                c1[r] = simd::impl::multiply_add<T>(ar, b1, c1[r]);
+            }
+            a += MR;
+            b += NR;
+        }
+        if (rows == MR && cols == NR && csc == 1){
+            const vector_type va = simd::impl::broadcast(alpha);
+            if (beta == T{}){
+#pragma GCC unroll 16
+                for (size_t r = 0; r < MR; r++){
+                    simd::impl::store(c + static_cast<std::ptrdiff_t>(r)*rsc, va*c0[r]);
+                    simd::impl::store(c + static_cast<std::ptrdiff_t>(r)*rsc + L, va*c1[r]);
+                }
+            } else{
+                const vector_type vb = simd::impl::broadcast(beta);
+#pragma GCC unroll 16
+                for (size_t r = 0; r < MR; r++){
+                    T* c_row = c + static_cast<std::ptrdiff_t>(r)*rsc;
+                    simd::impl::store(c_row, simd::impl::multiply_add<T>(va, c0[r], vb*simd::impl::load(c_row)));
+                    simd::impl::store(c_row + L, simd::impl::multiply_add<T>(va, c1[r], vb*simd::impl::load(c_row + L)));
+                }
+            }
+            return;
+        }
+#pragma GCC unroll 16
+        for (size_t r = 0; r < MR; r++){
+            simd::impl::store(acc + r*NR, c0[r]);
+            simd::impl::store(acc + r*NR + L, c1[r]);
+        }
+        gemm_update_tile(acc, rows, cols, alpha, beta, c, rsc, csc);
+        return;
+    }
+#endif
+    for (size_t i = 0; i < MR*NR; i++){
+        acc[i] = T{};
+    }
+    for (size_t p = 0; p < depth; p++){
+        for (size_t r = 0; r < MR; r++){
+            for (size_t col = 0; col < NR; col++){
+                acc[r*NR + col] += a[r]*b[col];
+            }
+        }
+        a += MR;
+        b += NR;
+    }
+    gemm_update_tile(acc, rows, cols, alpha, beta, c, rsc, csc);
+}
+
+
+
+/*================================================================================================
+                                    GEMM
+================================================================================================*/
+/*!
+ * \brief Function that computes `C = alpha*A*B + beta*C`, where `A` is a `m x k` matrix, `B` is a `k x n` matrix and `C` is a `m x n` matrix.
+ * Each matrix is given by a pointer to its first element and by the distances between two consecutive rows and two consecutive columns, which can be arbitrary.
+ * When `beta` is zero, the elements of `C` are not read, so `C` can be uninitialized.
+ * \param policy the execution policy. The parallel policies distribute the blocks of `C` across the threads of the global executor
+ * \param m number of rows of `A` and `C`
+ * \param n number of columns of `B` and `C`
+ * \param k number of columns of `A` and rows of `B`
+ * \param alpha the scalar that multiplies `A*B`
+ * \param a pointer to the first element of `A`
+ * \param rsa distance between two rows of `A`
+ * \param csa distance between two columns of `A`
+ * \param b pointer to the first element of `B`
+ * \param rsb distance between two rows of `B`
+ * \param csb distance between two columns of `B`
+ * \param beta the scalar that multiplies `C`
+ * \param c pointer to the first element of `C`
+ * \param rsc distance between two rows of `C`
+ * \param csc distance between two columns of `C`
+ */
+template<ExecutionPolicy Policy, typename T>
+void gemm(const Policy& policy, size_t m, size_t n, size_t k, T alpha, const T* a, std::ptrdiff_t rsa, std::ptrdiff_t csa, const T* b, std::ptrdiff_t rsb, std::ptrdiff_t csb, T beta, T* c, std::ptrdiff_t rsc, std::ptrdiff_t csc){
+    using blocking = gemm_blocking<T>;
+    constexpr size_t MR = blocking::mr;
+    constexpr size_t NR = blocking::nr;
+    using buffer_type = std::vector<T, AlignedAllocator<T>>;
+    if (m == 0 || n == 0){
+        return;
+    }
+    auto element_c = [c, rsc, csc](size_t i, size_t j) -> T&{
+        return c[static_cast<std::ptrdiff_t>(i)*rsc + static_cast<std::ptrdiff_t>(j)*csc];
+    };
+    if (k == 0){
+        for (size_t i = 0; i < m; i++){
+            for (size_t j = 0; j < n; j++){
+                element_c(i, j) = (beta == T{}) ? T{} : beta*element_c(i, j);
+            }
+        }
+        return;
+    }
+
+    if (m*n*k <= gemm_small_product){
+        // the cost of packing would exceed the cost of the product
+        for (size_t i = 0; i < m; i++){
+            for (size_t j = 0; j < n; j++){
+                element_c(i, j) = (beta == T{}) ? T{} : beta*element_c(i, j);
+            }
+            T* c_row = c + static_cast<std::ptrdiff_t>(i)*rsc;
+            for (size_t p = 0; p < k; p++){
+                const T aip = alpha*a[static_cast<std::ptrdiff_t>(i)*rsa + static_cast<std::ptrdiff_t>(p)*csa];
+                const T* b_row = b + static_cast<std::ptrdiff_t>(p)*rsb;
+                if (csb == 1 && csc == 1){
+                    for (size_t j = 0; j < n; j++){
+                        c_row[j] += aip*b_row[j];
+                    }
+                } else{
+                    for (size_t j = 0; j < n; j++){
+                        c_row[static_cast<std::ptrdiff_t>(j)*csc] += aip*b_row[static_cast<std::ptrdiff_t>(j)*csb];
+                    }
+                }
+            }
+        }
+        return;
+    }
+
+    const size_t row_blocks = (m + blocking::mc - 1)/blocking::mc;
+    buffer_type packed_b(blocking::kc*((std::min(n, blocking::nc) + NR - 1)/NR)*NR);
+    for (size_t jc = 0; jc < n; jc += blocking::nc){
+        const size_t nc = std::min(blocking::nc, n - jc);
+        const size_t col_panels = (nc + NR - 1)/NR;
+        for (size_t pc = 0; pc < k; pc += blocking::kc){
+            const size_t kc = std::min(blocking::kc, k - pc);
+            const T beta_block = (pc == 0) ? beta : T{1};
+            gemm_pack_b(packed_b.data(), b + static_cast<std::ptrdiff_t>(pc)*rsb + static_cast<std::ptrdiff_t>(jc)*csb, kc, nc, rsb, csb);
+
+            // the tasks are the blocks of rows of C, split in groups of panels of columns when there are fewer blocks than threads
+            const size_t work = m*nc*kc;
+            const size_t threads = impl::partition_count(policy, row_blocks*col_panels, work);
+            const size_t col_groups = std::min(col_panels, (threads + row_blocks - 1)/row_blocks);
+            impl::parallel_partition(policy, row_blocks*col_groups, work, [&](size_t first, size_t last, size_t){
+                buffer_type packed_a(blocking::mc*kc);
+                size_t packed_block = row_blocks;
+                for (size_t task = first; task < last; task++){
+                    const size_t block = task/col_groups;
+                    const size_t group = task%col_groups;
+                    const size_t ic = block*blocking::mc;
+                    const size_t mc = std::min(blocking::mc, m - ic);
+                    if (packed_block != block){
+                        gemm_pack_a(packed_a.data(), a + static_cast<std::ptrdiff_t>(ic)*rsa + static_cast<std::ptrdiff_t>(pc)*csa, mc, kc, rsa, csa);
+                        packed_block = block;
+                    }
+                    const size_t panel_begin = group*col_panels/col_groups;
+                    const size_t panel_end = (group + 1)*col_panels/col_groups;
+                    for (size_t panel = panel_begin; panel < panel_end; panel++){
+                        const size_t jr = panel*NR;
+                        const size_t tile_cols = std::min(NR, nc - jr);
+                        for (size_t ir = 0; ir < mc; ir += MR){
+                            gemm_micro_kernel(kc, packed_a.data() + ir*kc, packed_b.data() + jr*kc, std::min(MR, mc - ir), tile_cols, alpha, beta_block, &element_c(ic + ir, jc + jr), rsc, csc);
+                        }
+                    }
+                }
+            });
+        }
+    }
+}
+
+
+} //namespace impl
+
+} //namespace holor
+
+#endif // HOLOR_GEMM_H
@@ -26,10 +26,16 @@
 
 #include "../holor/holor_concepts.h"
 #include "../common/runtime_assertions.h"
+#include "../layout/layout_traversal.h"
+#include "holor_simd.h"
+#include "holor_execution.h"
 #include <algorithm>
 #include <type_traits>
+#include <memory>
 #include <numeric>
+#include <vector>
 #include <cmath>
+#include <cstdlib>
 
 namespace holor{
 
@@ -37,6 +43,42 @@ namespace holor{
 /*================================================================================================
                                     Holor Operations
 ================================================================================================*/
+namespace impl{
+    /*!
+     * \brief helper function that inserts a dimension with zero stride in an array of strides, so that a slice of a container can be traversed jointly with the container, repeating its elements along the inserted dimension
+     * \tparam D is the position of the inserted dimension
+     * \param strides the strides of the slice
+     * \return the strides with the inserted dimension
+     */
+    template<size_t D, size_t M>
+    std::array<std::ptrdiff_t, M+1> insert_zero_stride(const std::array<std::ptrdiff_t, M>& strides){
+        std::array<std::ptrdiff_t, M+1> result;
+        for (size_t i = 0; i < M+1; i++){
+            result[i] = (i < D) ? strides[i] : ((i == D) ? 0 : strides[i-1]);
+        }
+        return result;
+    }
+
+    /*!
+     * \brief trait that gives the allocator of the Holor returned by an operation: the allocator of the source container if it has one, `std::allocator` otherwise
+     */
+    template<typename Source>
+    struct result_allocator{
+        using type = std::allocator<typename Source::value_type>;
+    };
+
+    template<typename Source> requires requires { typename Source::allocator_type; }
+    struct result_allocator<Source>{
+        using type = typename Source::allocator_type;
+    };
+
+    /*!
+     * \brief type of the Holor returned by an operation on a source container, which has the same type of elements, number of dimensions and allocator of the source
+     */
+    template<typename Source>
+    using result_holor_t = Holor<typename std::remove_cvref_t<Source>::value_type, std::remove_cvref_t<Source>::dimensions, typename result_allocator<std::remove_cvref_t<Source>>::type>;
+}
+
 
 
 /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
@@ -55,14 +97,36 @@ namespace holor{
 template <size_t D, HolorType Destination, HolorType Slice, class Op> requires ((D < Destination::dimensions) && (Slice::dimensions==Destination::dimensions-1) && (std::is_same_v<typename Destination::value_type, typename Slice::value_type>) && assert::Binaryfunction<typename Destination::value_type, typename Destination::value_type, typename Slice::value_type, Op>)
 void broadcast(Destination& dest, Slice source_slice, Op&& operation ){
     assert::dynamic_assert(dest.template slice<D>(0).lengths() == source_slice.lengths(), EXCEPTION_MESSAGE("The lengths of slice to be broadcasted are not consistent with the lengths of the destination container!"));
-    for( auto i = 0; i < dest.length(D); i++){
-        auto dest_slice = dest.template slice<D>(i);
-        std::ranges::transform(dest_slice, source_slice, dest_slice.begin(), std::forward<Op>(operation));
-    }
+    constexpr size_t N = Destination::dimensions;
+    auto layouts = impl::normalize_layouts<N,2>(dest.lengths(), {dest.layout().strides(), impl::insert_zero_stride<D>(source_slice.layout().strides())}, {dest.layout().offset(), source_slice.layout().offset()});
+    auto dest_ptr = dest.data();
+    auto slice_ptr = source_slice.data();
+    impl::for_each_index(layouts, [&](size_t i, size_t j){
+        dest_ptr[i] = std::invoke(operation, dest_ptr[i], slice_ptr[j]);
+    });
+}
+
+/*!
+ * \brief Overload of the `broadcast` function that is executed according to an execution policy. The parallel policies partition the outermost dimension of the destination across the threads.
+ * \param policy is the execution policy (see holor_execution.h)
+ * \param dest is the holor that is modified by the broadcast operation
+ * \param source_slice is the holor that is broadcasted
+ * \param operation is the function that is applied to the pairs of elements from dest and source_slice
+ */
+template <size_t D, ExecutionPolicy Policy, HolorType Destination, HolorType Slice, class Op> requires ((D < Destination::dimensions) && (Slice::dimensions==Destination::dimensions-1) && (std::is_same_v<typename Destination::value_type, typename Slice::value_type>) && assert::Binaryfunction<typename Destination::value_type, typename Destination::value_type, typename Slice::value_type, Op>)
+void broadcast(const Policy& policy, Destination& dest, Slice source_slice, Op&& operation ){
+    assert::dynamic_assert(dest.template slice<D>(0).lengths() == source_slice.lengths(), EXCEPTION_MESSAGE("The lengths of slice to be broadcasted are not consistent with the lengths of the destination container!"));
+    constexpr size_t N = Destination::dimensions;
+    auto dest_ptr = dest.data();
+    auto slice_ptr = source_slice.data();
+    impl::parallel_for_each_index<N,2>(policy, dest.lengths(), {dest.layout().strides(), impl::insert_zero_stride<D>(source_slice.layout().strides())}, {dest.layout().offset(), source_slice.layout().offset()}, 0, [&](size_t i, size_t j){
+        dest_ptr[i] = std::invoke(operation, dest_ptr[i], slice_ptr[j]);
+    });
 }
 
 /*!
  * \brief The `broadcast_all` function is an operation that modifies one holor by replacing all its elements with the results from applying to them and to another input element a binary function.
+ * If the destination is contiguous, its elements are of arithmetic type and the function is one of `std::plus`, `std::minus`, `std::multiplies`, `std::divides`, `simd::Min` and `simd::Max`, the operation uses a SIMD kernel (see holor_simd.h).
  * \tparam Destination is the type of the destination Holor container
  * \tparam ElementType is the type of the broadcasted element
  * \tparam OP is the binary function that is applied to the elements
@@ -72,17 +136,75 @@ void broadcast(Destination& dest, Slice source_slice, Op&& operation ){
  */
 template <HolorType Destination, class ElementType, class Op> requires ( (std::is_same_v<typename Destination::value_type, ElementType>) && assert::Binaryfunction<typename Destination::value_type, typename Destination::value_type, ElementType, Op>)
 void broadcast_all(Destination& dest, ElementType element, Op&& operation ){
+    if constexpr(impl::FlatAccessibleHolor<Destination> && simd::VectorizableOp<Op, ElementType>){
+        if (dest.is_contiguous()){
+            auto flat = dest.span();
+            simd::transform_scalar(flat.data(), element, flat.data(), flat.size(), operation);
+            return;
+        }
+    }
     for(auto& e : dest){
         e = std::invoke(std::forward<Op>(operation), e, element);
     }
 }
 
+/*!
+ * \brief Overload of the `broadcast_all` function that is executed according to an execution policy. The parallel policies partition the outermost dimension of the destination across the threads.
+ * \param policy is the execution policy (see holor_execution.h)
+ * \param dest is the holor that is modified by the broadcast operation
+ * \param element is the element that is broadcasted
+ * \param operation is the function that is applied to the pairs of elements
+ */
+template <ExecutionPolicy Policy, HolorType Destination, class ElementType, class Op> requires ( (std::is_same_v<typename Destination::value_type, ElementType>) && assert::Binaryfunction<typename Destination::value_type, typename Destination::value_type, ElementType, Op>)
+void broadcast_all(const Policy& policy, Destination& dest, ElementType element, Op&& operation ){
+    if constexpr(impl::FlatAccessibleHolor<Destination>){
+        if (dest.is_contiguous()){
+            auto flat = dest.span();
+            impl::parallel_partition(policy, flat.size(), flat.size(), [&](size_t begin, size_t end, size_t){
+                if constexpr(simd::VectorizableOp<Op, ElementType>){
+                    simd::transform_scalar(flat.data()+begin, element, flat.data()+begin, end-begin, operation);
+                } else{
+                    for (size_t i = begin; i < end; i++){
+                        flat[i] = std::invoke(operation, flat[i], element);
+                    }
+                }
+            });
+            return;
+        }
+    }
+    auto dest_ptr = dest.data();
+    impl::parallel_for_each_index<Destination::dimensions,1>(policy, dest.lengths(), {dest.layout().strides()}, {dest.layout().offset()}, 0, [&](size_t i){
+        dest_ptr[i] = std::invoke(operation, dest_ptr[i], element);
+    });
+}
+
+/*!
+ * \brief The `broadcast_to` function returns a view of a holor with `M` dimensions and the given lengths, without copying its elements, following the NumPy broadcasting rules:
+ * the dimensions of the source are aligned with the last dimensions of the view, and each of them must have the same length of the corresponding dimension of the view or a single element.
+ * The dimensions that are added, or that are expanded from a single element, have a zero stride, so that the same elements are repeated along them.
+ * For example, a bias of lengths `[n]` broadcast to `[m, n]` is a view whose rows are all the bias, and can be added to a `[m, n]` container in a single traversal.
+ * Writing to the view writes the same element of the source multiple times.
+ * \tparam M is the number of dimensions of the view
+ * \tparam Source is the type of the holor
+ * \param source is the holor that is broadcast
+ * \param lengths are the lengths of the view
+ * \exception holor::exception::HolorRuntimeError if the holor cannot be broadcast to the lengths. The compiler flag DDEFINE_ASSERT_LEVEL in the CMakeLists can be set to AssertionLevel::no_checks to exclude this check.
+ * \return a HolorRef with the given lengths, that refers to the elements of the source
+ */
+template <size_t M, HolorType Source> requires (M >= Source::dimensions)
+auto broadcast_to(Source& source, const std::array<size_t, M>& lengths){
+    HolorRef<std::remove_pointer_t<decltype(source.data())>, M> result(source.data(), source.layout().broadcast(lengths));
+    return result;
+}
+
 
 /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
                     REDUCE
 ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
 /*!
  * \brief The `reduce_all` function is an operation that takes an holor and reduces it to a single scalar value obtained by applying a binary function to all the elements of the container.
+ * If the source is contiguous, its elements are of arithmetic type and the function is one of `std::plus`, `std::multiplies`, `simd::Min` and `simd::Max`, the operation uses a SIMD kernel (see holor_simd.h) that
+ * combines the elements in a different order than a sequential loop, so the result of a floating point sum can differ by rounding errors.
  * \tparam Source is the Holor container to be reduced
  * \tparam ElementType is the type of the result
  * \tparam OP is the binary function that is applied to the elements
@@ -91,9 +213,68 @@ void broadcast_all(Destination& dest, ElementType element, Op&& operation ){
  * \param operation is the function that is applied to the pairs of elements
  */
 template <HolorType Source, class ElementType, class Op> requires ( (std::is_same_v<typename Source::value_type, ElementType>) && assert::Binaryfunction<ElementType, typename Source::value_type, ElementType, Op> )
-auto reduce_all(Source source, ElementType result, Op&& operation ){
-    for(auto& e : source){
-        result = std::invoke(std::forward<Op>(operation), e, result);
+auto reduce_all(const Source& source, ElementType result, Op&& operation ){
+    if constexpr(impl::FlatAccessibleHolor<Source> && simd::VectorizableReduction<Op, ElementType>){
+        if (source.is_contiguous()){
+            auto flat = source.span();
+            return simd::reduce(flat.data(), flat.size(), result, operation);
+        }
+    }
+    for(auto it = source.cbegin(); it != source.cend(); ++it){
+        result = std::invoke(operation, *it, result);
+    }
+    return result;
+}
+
+/*!
+ * \brief Overload of the `reduce_all` function that is executed according to an execution policy. The parallel policies partition the outermost dimension of the source across the threads,
+ * reduce each chunk starting from its first element and then combine the partial results with `result` in the order of the chunks, so the function must be associative.
+ * \param policy is the execution policy (see holor_execution.h)
+ * \param source is the holor that is reduced
+ * \param result is the initial value from which the result is computed
+ * \param operation is the function that is applied to the pairs of elements
+ */
+template <ExecutionPolicy Policy, HolorType Source, class ElementType, class Op> requires ( (std::is_same_v<typename Source::value_type, ElementType>) && assert::Binaryfunction<ElementType, typename Source::value_type, ElementType, Op> )
+auto reduce_all(const Policy& policy, const Source& source, ElementType result, Op&& operation ){
+    if (source.size() == 0){
+        return result;
+    }
+    constexpr size_t N = Source::dimensions;
+    const auto& layout = source.layout();
+    const bool flat = [&]{
+        if constexpr(impl::FlatAccessibleHolor<Source>){
+            return source.is_contiguous();
+        } else{
+            return false;
+        }
+    }();
+    const size_t length = flat ? source.size() : layout.length(0);
+    std::vector<ElementType> partials(impl::partition_count(policy, length, source.size()), result);
+    auto source_ptr = source.data();
+    impl::parallel_partition(policy, length, source.size(), [&](size_t begin, size_t end, size_t chunk){
+        ElementType partial = source_ptr[flat ? begin : layout.offset()+begin*layout.strides()[0]];
+        bool first = true;
+        if (flat){
+            if constexpr(simd::VectorizableReduction<Op, ElementType>){
+                partial = simd::reduce(source_ptr+begin+1, end-begin-1, partial, operation);
+            } else{
+                for (size_t i = begin+1; i < end; i++){
+                    partial = std::invoke(operation, source_ptr[i], partial);
+                }
+            }
+        } else{
+            impl::for_each_index(impl::normalize_chunk<N,1>(layout.lengths(), {layout.strides()}, {layout.offset()}, 0, begin, end), [&](size_t i){
+                if (first){
+                    first = false;
+                    return;
+                }
+                partial = std::invoke(operation, source_ptr[i], partial);
+            });
+        }
+        partials[chunk] = partial;
+    });
+    for (const auto& partial : partials){
+        result = std::invoke(operation, partial, result);
     }
     return result;
 }
@@ -111,10 +292,33 @@ auto reduce_all(Source source, ElementType result, Op&& operation ){
 template <size_t D, HolorType Source, HolorType InitHolor, class Op> requires ((D < Source::dimensions) && (InitHolor::dimensions==Source::dimensions-1) && (std::is_same_v<typename Source::value_type, typename InitHolor::value_type>) && assert::Binaryfunction<typename Source::value_type, typename Source::value_type, typename InitHolor::value_type, Op>)
 auto reduce(Source source, InitHolor result, Op&& operation ){
     assert::dynamic_assert(source.template slice<D>(0).lengths() == result.lengths(), EXCEPTION_MESSAGE("The lenghts of the result container are not consistent with the dimensions of the source container!"));
-    for( auto i = 0; i < source.length(D); i++){
-        auto source_slice = source.template slice<D>(i);
-        std::ranges::transform(result, source_slice, result.begin(), std::forward<Op>(operation));
-    }
+    constexpr size_t N = Source::dimensions;
+    auto layouts = impl::normalize_layouts<N,2>(source.lengths(), {impl::insert_zero_stride<D>(result.layout().strides()), source.layout().strides()}, {result.layout().offset(), source.layout().offset()});
+    auto result_ptr = result.data();
+    auto source_ptr = source.data();
+    impl::for_each_index(layouts, [&](size_t i, size_t j){
+        result_ptr[i] = std::invoke(operation, result_ptr[i], source_ptr[j]);
+    });
+    return result;
+}
+
+/*!
+ * \brief Overload of the `reduce` function that is executed according to an execution policy. The parallel policies partition the outermost dimension of the source that differs from `D` across the threads,
+ * so each element of the result is computed by a single thread in the same order of the sequential overload. When `D` is the first dimension, each thread traverses all the rows of the source but only a contiguous block of each row.
+ * \param policy is the execution policy (see holor_execution.h)
+ * \param source is the holor that is reduced
+ * \param result is the initial value from which the result is computed
+ * \param operation is the function that is applied to the pairs of elements
+ */
+template <size_t D, ExecutionPolicy Policy, HolorType Source, HolorType InitHolor, class Op> requires ((D < Source::dimensions) && (InitHolor::dimensions==Source::dimensions-1) && (std::is_same_v<typename Source::value_type, typename InitHolor::value_type>) && assert::Binaryfunction<typename Source::value_type, typename Source::value_type, typename InitHolor::value_type, Op>)
+auto reduce(const Policy& policy, Source source, InitHolor result, Op&& operation ){
+    assert::dynamic_assert(source.template slice<D>(0).lengths() == result.lengths(), EXCEPTION_MESSAGE("The lenghts of the result container are not consistent with the dimensions of the source container!"));
+    constexpr size_t N = Source::dimensions;
+    auto result_ptr = result.data();
+    auto source_ptr = source.data();
+    impl::parallel_for_each_index<N,2>(policy, source.lengths(), {impl::insert_zero_stride<D>(result.layout().strides()), source.layout().strides()}, {result.layout().offset(), source.layout().offset()}, (D == 0) ? 1 : 0, [&](size_t i, size_t j){
+        result_ptr[i] = std::invoke(operation, result_ptr[i], source_ptr[j]);
+    });
     return result;
 }
 
@@ -131,7 +335,74 @@ auto reduce(Source source, InitHolor result, Op&& operation ){
  */
 template <HolorType Destination, class Op> requires assert::Unaryfunction<typename Destination::value_type, typename Destination::value_type, Op>
 void apply(Destination& dest, Op&& operation ){
-    std::ranges::transform(dest, dest.begin(), std::forward<Op>(operation));
+    if constexpr(impl::FlatAccessibleHolor<Destination>){
+        if (dest.is_contiguous()){
+            auto flat = dest.span();
+            std::ranges::transform(flat, flat.begin(), std::forward<Op>(operation));
+            return;
+        }
+    }
+    auto dest_ptr = dest.data();
+    impl::for_each_index(impl::normalize_layouts(dest.layout()), [&](size_t i){
+        dest_ptr[i] = std::invoke(operation, dest_ptr[i]);
+    });
+}
+
+/*!
+ * \brief Overload of the `apply` function that is executed according to an execution policy. The parallel policies partition the outermost dimension of the destination across the threads.
+ * \param policy is the execution policy (see holor_execution.h)
+ * \param dest is the holor that is modified
+ * \param operation is the function that is applied to the elements in the container
+ */
+template <ExecutionPolicy Policy, HolorType Destination, class Op> requires assert::Unaryfunction<typename Destination::value_type, typename Destination::value_type, Op>
+void apply(const Policy& policy, Destination& dest, Op&& operation ){
+    if constexpr(impl::FlatAccessibleHolor<Destination>){
+        if (dest.is_contiguous()){
+            auto flat = dest.span();
+            impl::parallel_partition(policy, flat.size(), flat.size(), [&](size_t begin, size_t end, size_t){
+                std::transform(flat.begin()+begin, flat.begin()+end, flat.begin()+begin, operation);
+            });
+            return;
+        }
+    }
+    auto dest_ptr = dest.data();
+    impl::parallel_for_each_index<Destination::dimensions,1>(policy, dest.lengths(), {dest.layout().strides()}, {dest.layout().offset()}, 0, [&](size_t i){
+        dest_ptr[i] = std::invoke(operation, dest_ptr[i]);
+    });
+}
+
+
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+                    AXPY
+~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+/*!
+ * \brief The `axpy` function is an operation that adds to a holor another holor multiplied by a scalar, i.e., `y = alpha*x + y`.
+ * If both containers are contiguous and their elements are of arithmetic type, the operation uses a SIMD kernel with fused multiply-add instructions when they are available (see holor_simd.h).
+ * \tparam X is the type of the Holor container that is multiplied
+ * \tparam Y is the type of the Holor container that is modified
+ * \param alpha is the scalar multiplier
+ * \param x is the holor that is multiplied
+ * \param y is the holor that is modified
+ * \exception holor::exception::HolorRuntimeError if the containers have different lengths. The compiler flag DDEFINE_ASSERT_LEVEL in the CMakeLists can be set to AssertionLevel::no_checks to exclude this check.
+ */
+template <HolorType X, HolorType Y> requires ((X::dimensions == Y::dimensions) && (std::is_same_v<typename X::value_type, typename Y::value_type>))
+void axpy(typename Y::value_type alpha, const X& x, Y& y){
+    assert::dynamic_assert(x.lengths() == y.lengths(), EXCEPTION_MESSAGE("holor::axpy - The containers have different lengths."));
+    using T = typename Y::value_type;
+    if constexpr(impl::FlatAccessibleHolor<X> && impl::FlatAccessibleHolor<Y> && simd::Vectorizable<T>){
+        if (x.is_contiguous() && y.is_contiguous()){
+            auto x_flat = x.span();
+            auto y_flat = y.span();
+            simd::multiply_add(alpha, x_flat.data(), y_flat.data(), y_flat.data(), y_flat.size());
+            return;
+        }
+    }
+    auto x_ptr = x.data();
+    auto y_ptr = y.data();
+    impl::for_each_index(impl::normalize_layouts(y.layout(), x.layout()), [&](size_t i, size_t j){
+        y_ptr[i] = alpha*x_ptr[j] + y_ptr[i];
+    });
 }
 
 
@@ -147,17 +418,17 @@ namespace impl_concatenate{
      *\brief helper function to verify that the arguments of the concatenate function have consistent dimensions and lengths
      */
     template <class Container, DecaysToHolorType First_Arg> requires (assert::IterableContainer<Container>)
-    void check_lengths(Container lengths, First_Arg first_arg){
-        static_assert(std::is_same_v<decltype(lengths), decltype(first_arg.lengths())>, "The arguments of the concatenation have different dimensions!" );
-        if constexpr(std::is_same_v<decltype(lengths), decltype(first_arg.lengths())>){
+    void check_lengths(const Container& lengths, const First_Arg& first_arg){
+        static_assert(std::is_same_v<Container, std::remove_cvref_t<decltype(first_arg.lengths())>>, "The arguments of the concatenation have different dimensions!" );
+        if constexpr(std::is_same_v<Container, std::remove_cvref_t<decltype(first_arg.lengths())>>){
             assert::dynamic_assert(lengths==first_arg.lengths(), EXCEPTION_MESSAGE("The arguments of the concatenation have different lengths!"));
         }
     }
 
     template <class Container, DecaysToHolorType First_Arg, DecaysToHolorType... Args> requires (assert::IterableContainer<Container>)
-    void check_lengths(Container lengths, First_Arg first_arg, Args&&... args){
-        static_assert(std::is_same_v<decltype(lengths), decltype(first_arg.lengths())>, "The arguments of the concatenation have different dimensions!" );
-        if constexpr(std::is_same_v<decltype(lengths), decltype(first_arg.lengths())>){
+    void check_lengths(const Container& lengths, const First_Arg& first_arg, Args&&... args){
+        static_assert(std::is_same_v<Container, std::remove_cvref_t<decltype(first_arg.lengths())>>, "The arguments of the concatenation have different dimensions!" );
+        if constexpr(std::is_same_v<Container, std::remove_cvref_t<decltype(first_arg.lengths())>>){
             assert::dynamic_assert(lengths==first_arg.lengths(), EXCEPTION_MESSAGE("The arguments of the concatenation have different lengths!"));
         }
         check_lengths(lengths, std::forward<Args>(args)...);
@@ -167,12 +438,12 @@ namespace impl_concatenate{
      *\brief helper function to verify that the arguments of the concatenate function have consistent type
      */
     template<typename T, DecaysToHolorType First_Arg>
-    void check_type(First_Arg arg){
+    void check_type(const First_Arg& arg){
         static_assert(std::is_same_v<T, typename std::decay_t<First_Arg>::value_type>, "The arguments of the concatenation have inconsistent value_type");
     }
 
     template<typename T, DecaysToHolorType First_Arg, DecaysToHolorType... Args>
-    void check_type(First_Arg arg, Args&&... args){
+    void check_type(const First_Arg& arg, Args&&... args){
         static_assert(std::is_same_v<T, typename std::decay_t<First_Arg>::value_type>, "The arguments of the concatenation have inconsistent value_type");
         check_type<T>(std::forward<Args>(args)...);
     }
@@ -181,28 +452,28 @@ namespace impl_concatenate{
      *\brief helper function to verify that the arguments of the concatenate function are consistent and to initialize the result Holor
      */
     template <size_t Dim, DecaysToHolorType First_Arg, DecaysToHolorType... Args>
-    auto check_args(First_Arg first_arg, Args&&... args){
+    auto check_args(const First_Arg& first_arg, Args&&... args){
         auto lengths = first_arg.lengths();
         check_lengths(lengths, std::forward<Args>(args)...);
         check_type<typename std::decay_t<First_Arg>::value_type>(std::forward<Args>(args)...);
         static_assert(Dim<lengths.size(), "Invalid dimension for the concatenation.");
         constexpr auto N_concatenate = sizeof...(Args);
         lengths[Dim] *=(N_concatenate+1);
-        return Holor<typename First_Arg::value_type, First_Arg::dimensions> (lengths);
+        return impl::result_holor_t<First_Arg>(holor::uninitialized, lengths);
     }
 
     /*!
      *\brief helper function to iterate through all the arguments and concatenate them
      */
     template <size_t Dim, size_t M, DecaysToHolorType Result, DecaysToHolorType First_Arg>
-    void do_concatenation(Result& result, First_Arg first_arg){
+    void do_concatenation(Result& result, const First_Arg& first_arg){
         auto length = first_arg.length(Dim);
         auto slice_result = result.template slice<Dim>(holor::range{M*length, (M+1)*length-1});
         slice_result.substitute(first_arg);
     }
 
     template <size_t Dim, size_t M, DecaysToHolorType Result, DecaysToHolorType First_Arg, DecaysToHolorType... Args>
-    void do_concatenation(Result& result, First_Arg first_arg, Args&&... args){
+    void do_concatenation(Result& result, const First_Arg& first_arg, Args&&... args){
         auto length = first_arg.length(Dim);
         auto slice_result = result.template slice<Dim>(holor::range{M*length, (M+1)*length-1});
         slice_result.substitute(first_arg);
@@ -224,39 +495,188 @@ auto concatenate(Args&&... args){
 }
 
 
+/*!
+ * \brief Overload of the `concatenate` function that is executed according to an execution policy. The parallel policies copy each argument into the result partitioning its outermost dimension across the threads.
+ * \param policy is the execution policy (see holor_execution.h)
+ * \param args the Holors to be concatenated passed as a parameter pack
+ * \return a new Holor that concatenates all the input ones
+ */
+template <size_t Dim, ExecutionPolicy Policy, DecaysToHolorType... Args> requires (sizeof...(Args)>=2)
+auto concatenate(const Policy& policy, Args&&... args){
+    auto result = impl_concatenate::check_args<Dim>(std::forward<Args>(args)...);
+    constexpr size_t N = decltype(result)::dimensions;
+    auto result_ptr = result.data();
+    const auto& result_strides = result.layout().strides();
+    size_t position = 0;
+    auto copy_arg = [&](const auto& arg){
+        const auto& layout = arg.layout();
+        auto arg_ptr = arg.data();
+        impl::parallel_for_each_index<N,2>(policy, layout.lengths(), {result_strides, layout.strides()}, {result.layout().offset() + position*result_strides[Dim], layout.offset()}, 0, [&](size_t i, size_t j){
+            result_ptr[i] = arg_ptr[j];
+        });
+        position += layout.length(Dim);
+    };
+    (copy_arg(args), ...);
+    return result;
+}
+
 
 /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
                     TRANSPOSE
 ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+namespace impl{
+    /*!
+     * \brief helper function that copies the elements of a container into another one whose layout traverses the memory in a different order, as in a transposition.
+     * The copy is blocked: the dimension along which the destination has the smallest stride and the one along which the source has the smallest stride are traversed by square tiles that fit in the L1 cache,
+     * so that both containers are accessed by contiguous runs of elements. When both strides are unitary and the elements are arithmetic types of 4 or 8 bytes, the tiles are copied with the SIMD kernel `simd::transpose_block`.
+     * If the source and the destination have the smallest stride along the same dimension, the elements are copied in row-major order.
+     * \param dest pointer to the memory of the destination
+     * \param src pointer to the memory of the source
+     * \param layouts the normalized layouts of the destination (index 0) and of the source (index 1)
+     */
+    template <size_t N, typename T, typename U>
+    void copy_transposed(T* dest, const U* src, const NormalizedLayouts<N,2>& layouts){
+        const size_t D = layouts.dimensions_;
+        const auto& dest_strides = layouts.strides_[0];
+        const auto& src_strides = layouts.strides_[1];
+        auto smallest_stride = [&](const std::array<std::ptrdiff_t, N>& strides, size_t excluded){
+            size_t dim = D;
+            for (size_t d = D; d-- > 0;){
+                if (d != excluded && (dim == D || std::abs(strides[d]) < std::abs(strides[dim]))){
+                    dim = d;
+                }
+            }
+            return dim;
+        };
+        const size_t dj = smallest_stride(dest_strides, D);
+        const size_t di = (D > 1) ? smallest_stride(src_strides, dj) : D;
+        if (layouts.size_ == 0 || di == D || std::abs(src_strides[dj]) <= std::abs(src_strides[di])){
+            impl::for_each_index(layouts, [dest, src](size_t i, size_t j){
+                dest[i] = src[j];
+            });
+            return;
+        }
+
+        constexpr size_t tile = std::clamp<size_t>(256/sizeof(T), 8, 64);
+        const size_t length_i = layouts.lengths_[di];
+        const size_t length_j = layouts.lengths_[dj];
+        const std::ptrdiff_t dest_i = dest_strides[di], dest_j = dest_strides[dj];
+        const std::ptrdiff_t src_i = src_strides[di], src_j = src_strides[dj];
+
+        auto copy_tile = [&](T* d, const U* s, size_t n_i, size_t n_j){
+            size_t vector_i = 0, vector_j = 0;
+            if constexpr(std::is_same_v<T, U> && simd::Vectorizable<T> && (sizeof(T) == 4 || sizeof(T) == 8)){
+                if (dest_j == 1 && src_i == 1){
+                    constexpr size_t B = simd::transpose_block_size<T>;
+                    vector_i = n_i - n_i%B;
+                    vector_j = n_j - n_j%B;
+                    for (size_t ii = 0; ii < vector_i; ii += B){
+                        for (size_t jj = 0; jj < vector_j; jj += B){
+                            simd::transpose_block(s + jj*src_j + ii, src_j, d + ii*dest_i + jj, dest_i);
+                        }
+                    }
+                }
+            }
+            // the elements outside the blocks copied by the SIMD kernel
+            for (size_t ii = 0; ii < n_i; ii++){
+                for (size_t jj = (ii < vector_i) ? vector_j : 0; jj < n_j; jj++){
+                    d[ii*dest_i + jj*dest_j] = s[ii*src_i + jj*src_j];
+                }
+            }
+        };
+
+        auto outer = layouts;
+        outer.lengths_[di] = 1;
+        outer.lengths_[dj] = 1;
+        outer.size_ = layouts.size_/(length_i*length_j);
+        impl::for_each_index(outer, [&](size_t dest_offset, size_t src_offset){
+            for (size_t ib = 0; ib < length_i; ib += tile){
+                for (size_t jb = 0; jb < length_j; jb += tile){
+                    copy_tile(dest + dest_offset + ib*dest_i + jb*dest_j, src + src_offset + ib*src_i + jb*src_j, std::min(tile, length_i - ib), std::min(tile, length_j - jb));
+                }
+            }
+        });
+    }
+
+    /*!
+     * \brief helper function that copies the elements of a container into a new Holor with row-major layout, reading them through a transposed layout of the source
+     * \param source is the holor that is transposed
+     * \param layout is the transposed layout of the source
+     * \return a new Holor with the lengths of the transposed layout
+     */
+    template <HolorType Source>
+    auto transpose_copy(Source& source, const Layout<Source::dimensions>& layout){
+        impl::result_holor_t<Source> result(holor::uninitialized, layout.lengths());
+        impl::copy_transposed(result.data(), source.data(), impl::normalize_layouts(result.layout(), layout));
+        return result;
+    }
+
+    /*!
+     * \brief helper function that implements `transpose_copy` according to an execution policy, partitioning the outermost dimension of the result across the threads
+     */
+    template <ExecutionPolicy Policy, HolorType Source>
+    auto transpose_copy(const Policy& policy, Source& source, const Layout<Source::dimensions>& layout){
+        constexpr size_t N = Source::dimensions;
+        impl::result_holor_t<Source> result(holor::uninitialized, layout.lengths());
+        auto result_ptr = result.data();
+        auto source_ptr = source.data();
+        const auto lengths = layout.lengths();
+        if (result.size() == 0){
+            return result;
+        }
+        impl::parallel_partition(policy, lengths[0], result.size(), [&](size_t begin, size_t end, size_t){
+            impl::copy_transposed(result_ptr, source_ptr, impl::normalize_chunk<N,2>(lengths, {result.layout().strides(), layout.strides()}, {result.layout().offset(), layout.offset()}, 0, begin, end));
+        });
+        return result;
+    }
+}
+
 /*!
  * \brief The `transpose` function is an operation that changes the coordinates of a Holor container (e.g. inverting them)
  * \param source is the holor that is transposed
  * \param order is the (optional) array of indices that specify the reordering of the Holor coordinates. There is no check on the values of these indices. If this parameter is not given the coordinates of the holor are inverted
- * \return a new Holor that is equal to the original one but transposed
+ * \return a new Holor that is equal to the original one but transposed. The elements of the new Holor are stored in row-major order
  */
 template <HolorType Source, class Container> requires assert::SizedTypedContainer<Container, size_t, Source::dimensions>
 auto transpose(Source& source, Container order){
     auto layout = source.layout();
     layout.transpose(order);
-    Holor<typename Source::value_type, Source::dimensions> result(layout);
-    std::copy(source.begin(), source.end(), result.data());
-    return result;
+    return impl::transpose_copy(source, layout);
 }
 
 template <HolorType Source>
 auto transpose(Source& source){
     auto layout = source.layout();
     layout.transpose();
-    Holor<typename Source::value_type, Source::dimensions> result(layout);
-    std::copy(source.begin(), source.end(), result.data());
-    return result;
+    return impl::transpose_copy(source, layout);
+}
+
+/*!
+ * \brief Overloads of the `transpose` function that are executed according to an execution policy. The parallel policies partition the outermost dimension of the result across the threads.
+ * \param policy is the execution policy (see holor_execution.h)
+ * \param source is the holor that is transposed
+ * \param order is the (optional) array of indices that specify the reordering of the Holor coordinates
+ * \return a new Holor that is equal to the original one but transposed. The elements of the new Holor are stored in row-major order
+ */
+template <ExecutionPolicy Policy, HolorType Source, class Container> requires assert::SizedTypedContainer<Container, size_t, Source::dimensions>
+auto transpose(const Policy& policy, Source& source, Container order){
+    auto layout = source.layout();
+    layout.transpose(order);
+    return impl::transpose_copy(policy, source, layout);
+}
+
+template <ExecutionPolicy Policy, HolorType Source>
+auto transpose(const Policy& policy, Source& source){
+    auto layout = source.layout();
+    layout.transpose();
+    return impl::transpose_copy(policy, source, layout);
 }
 
 template <HolorType Source, class Container> requires assert::SizedTypedContainer<Container, size_t, Source::dimensions>
 auto transpose_view(Source& source, Container order){
     auto layout = source.layout();
     layout.transpose(order);
-    HolorRef<typename Source::value_type, Source::dimensions> result(source.data(), layout);
+    HolorRef<std::remove_pointer_t<decltype(source.data())>, Source::dimensions> result(source.data(), layout);
     return result;
 }
 
@@ -264,15 +684,219 @@ template <HolorType Source>
 auto transpose_view(Source& source){
     auto layout = source.layout();
     layout.transpose();
-    HolorRef<typename Source::value_type, Source::dimensions> result(source.data(), layout);
+    HolorRef<std::remove_pointer_t<decltype(source.data())>, Source::dimensions> result(source.data(), layout);
     return result;
 }
 
 
 
+namespace impl{
+    /*!
+     * \brief helper function that transposes in place a square matrix stored in row-major order, swapping the elements of pairs of tiles that are symmetric with respect to the diagonal.
+     * If the elements are arithmetic types of 4 or 8 bytes, the tiles are swapped by blocks transposed in registers with the SIMD kernel `simd::transpose_block`.
+     * \param a pointer to the first element of the matrix
+     * \param n number of rows and columns of the matrix
+     */
+    template <typename T>
+    void transpose_square_inplace(T* a, size_t n){
+        constexpr size_t tile = std::clamp<size_t>(256/sizeof(T), 8, 64);
+        const std::ptrdiff_t stride = n;
+        auto swap_tiles = [&](size_t ib, size_t ie, size_t jb, size_t je){
+            size_t vector_i = ib, vector_j = jb;
+            if constexpr(simd::Vectorizable<T> && (sizeof(T) == 4 || sizeof(T) == 8)){
+                constexpr size_t B = simd::transpose_block_size<T>;
+                vector_i = ib + (ie - ib) - (ie - ib)%B;
+                vector_j = jb + (je - jb) - (je - jb)%B;
+                T buffer[B*B];
+                for (size_t i = ib; i < vector_i; i += B){
+                    for (size_t j = (ib == jb) ? i : jb; j < vector_j; j += B){
+                        T* upper = a + i*stride + j;
+                        T* lower = a + j*stride + i;
+                        simd::transpose_block(upper, stride, buffer, B);
+                        if (i != j){
+                            simd::transpose_block(lower, stride, upper, stride);
+                        }
+                        for (size_t k = 0; k < B; k++){
+                            std::copy(buffer + k*B, buffer + (k+1)*B, lower + k*stride);
+                        }
+                    }
+                }
+            }
+            // the elements outside the blocks swapped by the SIMD kernel
+            for (size_t i = ib; i < ie; i++){
+                size_t j = (ib == jb) ? i + 1 : jb;
+                if (i < vector_i){
+                    j = std::max(j, vector_j);
+                }
+                for (; j < je; j++){
+                    std::swap(a[i*stride + j], a[j*stride + i]);
+                }
+            }
+        };
+        for (size_t ib = 0; ib < n; ib += tile){
+            const size_t ie = std::min(ib + tile, n);
+            for (size_t jb = ib; jb < n; jb += tile){
+                swap_tiles(ib, ie, jb, std::min(jb + tile, n));
+            }
+        }
+    }
+
+    /*!
+     * \brief helper function that permutes in place the elements of a contiguous container, following the cycles of the permutation. The element with index `q` in row-major order of the result
+     * is the one with index `transposed(coordinates of q)` in the original container, and a bitmap marks the elements that have already been moved.
+     * \param data pointer to the elements of the container
+     * \param transposed the transposed layout of the container
+     */
+    template <typename T, size_t N>
+    void permute_inplace(T* data, const Layout<N>& transposed){
+        const auto lengths = transposed.lengths();
+        const auto strides = transposed.strides();
+        const size_t size = transposed.size();
+        auto source_index = [&](size_t q){
+            size_t index = 0;
+            for (size_t d = N; d-- > 0;){
+                index += (q % lengths[d])*strides[d];
+                q /= lengths[d];
+            }
+            return index;
+        };
+        std::vector<bool> visited(size, false);
+        for (size_t start = 0; start < size; start++){
+            if (visited[start]){
+                continue;
+            }
+            visited[start] = true;
+            size_t q = start;
+            size_t p = source_index(q);
+            if (p == start){
+                continue;
+            }
+            T first = std::move(data[start]);
+            while (p != start){
+                data[q] = std::move(data[p]);
+                visited[p] = true;
+                q = p;
+                p = source_index(q);
+            }
+            data[q] = std::move(first);
+        }
+    }
+}
+
+/*!
+ * \brief The `transpose_inplace` function is an operation that changes the coordinates of a Holor, like `transpose`, moving its elements in place instead of copying them into a new container.
+ * The lengths of the Holor are permuted and its elements are stored in row-major order for the new lengths, so the result is equal to the one of `transpose`.
+ * If the permutation swaps the last two dimensions and they have the same length (e.g., a square matrix or a batch of square matrices), the elements are swapped by tiles across the diagonal of each matrix.
+ * Otherwise, the elements are moved along the cycles of the permutation, which needs a bitmap with one bit per element.
+ * \param holor is the Holor that is transposed
+ * \param order is the (optional) array of indices that specify the reordering of the Holor coordinates. If this parameter is not given the coordinates of the holor are inverted
+ * \exception holor::exception::HolorRuntimeError if `order` is not a permutation of the dimensions. The compiler flag DDEFINE_ASSERT_LEVEL in the CMakeLists can be set to AssertionLevel::no_checks to exclude this check.
+ */
+template <typename T, size_t N, class Allocator, class Container> requires assert::SizedTypedContainer<Container, size_t, N>
+void transpose_inplace(Holor<T, N, Allocator>& holor, Container order){
+    std::array<bool, N> used{};
+    bool is_permutation = true;
+    for (size_t i = 0; i < N; i++){
+        is_permutation = is_permutation && (order[i] < N) && !used[order[i]];
+        if (order[i] < N){
+            used[order[i]] = true;
+        }
+    }
+    assert::dynamic_assert(is_permutation, EXCEPTION_MESSAGE("holor::transpose_inplace - The order is not a permutation of the dimensions."));
+
+    auto layout = holor.layout();
+    layout.transpose(order);
+    bool identity = true;
+    bool swaps_last_two = (N >= 2) && (holor.length(N-1) == holor.length(N-2)) && (order[N-1] == N-2) && (order[N-2] == N-1);
+    for (size_t i = 0; i < N; i++){
+        identity = identity && (order[i] == i);
+        swaps_last_two = swaps_last_two && (i >= N-2 || order[i] == i);
+    }
+    if (!identity && holor.size() > 1){
+        if (swaps_last_two){
+            const size_t n = holor.length(N-1);
+            for (size_t offset = 0; offset < holor.size(); offset += n*n){
+                impl::transpose_square_inplace(holor.data() + offset, n);
+            }
+        } else{
+            impl::permute_inplace(holor.data(), layout);
+        }
+    }
+    holor.set_lengths(layout.lengths());
+}
+
+template <typename T, size_t N, class Allocator>
+void transpose_inplace(Holor<T, N, Allocator>& holor){
+    std::array<size_t, N> order;
+    for (size_t i = 0; i < N; i++){
+        order[i] = N-1-i;
+    }
+    transpose_inplace(holor, order);
+}
+
+
 /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
                     SHIFT
 ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+namespace impl{
+    /*!
+     * \brief helper function that copies the components of a container along a dimension into a new Holor in the order given by a function, according to an execution policy.
+     * If `Dim` is the first dimension the components are partitioned across the threads, otherwise the first dimension is partitioned. In both cases the result is written in row-major order by each thread.
+     * \tparam Dim is the direction along which the components are selected
+     * \param policy is the execution policy
+     * \param source is the holor whose components are copied
+     * \param order is a function that gives the index of the component of the source that is copied into the `i`-th component of the result
+     * \return a new Holor that is the result of the copy
+     */
+    template <size_t Dim, ExecutionPolicy Policy, HolorType Source, class Order>
+    auto permute_copy(const Policy& policy, const Source& source, Order&& order){
+        constexpr size_t N = Source::dimensions;
+        impl::result_holor_t<Source> result(holor::uninitialized, Layout<N>(source.lengths()));
+        const auto& layout = source.layout();
+        const auto& result_strides = result.layout().strides();
+        auto result_ptr = result.data();
+        auto source_ptr = source.data();
+
+        // the components are blocks that span the dimensions after Dim
+        auto tail_lengths = layout.lengths();
+        for (size_t d = 0; d <= Dim; d++){
+            tail_lengths[d] = 1;
+        }
+        const auto tail = impl::normalize_layouts<N,2>(tail_lengths, {result_strides, layout.strides()}, {0, 0});
+        auto copy_components = [&](size_t result_base, size_t source_base, size_t begin, size_t end){
+            for (size_t i = begin; i < end; i++){
+                const size_t result_offset = result_base + i*result_strides[Dim];
+                const size_t source_offset = source_base + order(i)*layout.strides()[Dim];
+                if (tail.size_ == 1){
+                    result_ptr[result_offset] = source_ptr[source_offset];
+                } else{
+                    auto component = tail;
+                    component.offsets_ = {result_offset, source_offset};
+                    impl::for_each_index(component, [result_ptr, source_ptr](size_t r, size_t s){
+                        result_ptr[r] = source_ptr[s];
+                    });
+                }
+            }
+        };
+
+        impl::parallel_partition(policy, layout.length(0), source.size(), [&](size_t begin, size_t end, size_t){
+            if constexpr(Dim == 0){
+                copy_components(0, layout.offset(), begin, end);
+            } else{
+                // the dimensions before Dim are traversed in row-major order, copying all the components for each of their indices
+                auto head_lengths = layout.lengths();
+                for (size_t d = Dim; d < N; d++){
+                    head_lengths[d] = 1;
+                }
+                impl::for_each_index(impl::normalize_chunk<N,2>(head_lengths, {result_strides, layout.strides()}, {0, layout.offset()}, 0, begin, end), [&](size_t r, size_t s){
+                    copy_components(r, s, 0, layout.length(Dim));
+                });
+            }
+        });
+        return result;
+    }
+}
+
 /*!
  * \brief The `shift` function is an operation that shifts the content of a Holor along a certain direction
  * \tparam Dim is the direction along which the Holor is shifted
@@ -283,7 +907,7 @@ auto transpose_view(Source& source){
 template <size_t Dim, HolorType Source> requires (Dim<Source::dimensions)
 auto shift(Source source, int n){
     int length = source.length(Dim);
-    Holor<typename Source::value_type, Source::dimensions> result(source.layout());
+    impl::result_holor_t<Source> result(holor::uninitialized, Layout<Source::dimensions>(source.lengths()));
     for (int i = 0; i < length; i++){
         auto source_slice = source.template slice<Dim>(i);
         int shift = (i+n)%length;
@@ -296,6 +920,22 @@ auto shift(Source source, int n){
     return result;
 }
 
+/*!
+ * \brief Overload of the `shift` function that is executed according to an execution policy. The parallel policies partition the outermost dimension of the container across the threads.
+ * \param policy is the execution policy (see holor_execution.h)
+ * \param source is the holor that is shifted
+ * \param n indicates how many places the content should be shifted
+ * \return a new Holor that is equal to the original one but shifted
+ */
+template <size_t Dim, ExecutionPolicy Policy, HolorType Source> requires (Dim<Source::dimensions)
+auto shift(const Policy& policy, const Source& source, int n){
+    const size_t length = source.length(Dim);
+    const size_t places = (length == 0) ? 0 : static_cast<size_t>((n%static_cast<int>(length) + static_cast<int>(length)) % static_cast<int>(length));
+    return impl::permute_copy<Dim>(policy, source, [length, places](size_t i){
+        return (i + length - places) % length;
+    });
+}
+
 
 /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
                     PERMUTATION
@@ -312,7 +952,7 @@ auto shift(Source source, int n){
  */
 template <size_t Dim, HolorType Source, class Container> requires (assert::TypedContainer<Container, size_t> && (Dim < Source::dimensions))
 auto permutation(Source& source, Container order){
-    Holor<typename Source::value_type, Source::dimensions> result(source);
+    impl::result_holor_t<Source> result(source);
     assert::dynamic_assert(order.size() == source.length(Dim), EXCEPTION_MESSAGE("The indices of the permutation do not match the length of the container!"));
     for (auto i =0; i < source.length(Dim); i++){
         auto result_slice = result.template slice<Dim>(i);  
@@ -323,7 +963,7 @@ auto permutation(Source& source, Container order){
 
 template <size_t Dim, HolorType Source> requires (Dim < Source::dimensions)
 auto permutation_pair(Source& source, size_t n1, size_t n2){
-    Holor<typename Source::value_type, Source::dimensions> result(source);
+    impl::result_holor_t<Source> result(source);
     auto result_slice1 = result.template slice<Dim>(n1);
     auto result_slice2 = result.template slice<Dim>(n2);
     result_slice1.substitute(source.template slice<Dim>(n2));
@@ -331,6 +971,29 @@ auto permutation_pair(Source& source, size_t n1, size_t n2){
     return result;
 }
 
+/*!
+ * \brief Overloads of the `permutation` and `permutation_pair` functions that are executed according to an execution policy. The parallel policies partition the components along `Dim` across the threads if `Dim` is the first dimension,
+ * and the first dimension otherwise.
+ * \param policy is the execution policy (see holor_execution.h)
+ * \param source is the holor which is permuted.
+ * \param order is a container with the indices of the components along the selected dimension
+ * \return a new Holor that is the result of the permutation operation
+ */
+template <size_t Dim, ExecutionPolicy Policy, HolorType Source, class Container> requires (assert::TypedContainer<Container, size_t> && (Dim < Source::dimensions))
+auto permutation(const Policy& policy, const Source& source, Container order){
+    assert::dynamic_assert(order.size() == source.length(Dim), EXCEPTION_MESSAGE("The indices of the permutation do not match the length of the container!"));
+    return impl::permute_copy<Dim>(policy, source, [&order](size_t i){
+        return static_cast<size_t>(order[i]);
+    });
+}
+
+template <size_t Dim, ExecutionPolicy Policy, HolorType Source> requires (Dim < Source::dimensions)
+auto permutation_pair(const Policy& policy, const Source& source, size_t n1, size_t n2){
+    return impl::permute_copy<Dim>(policy, source, [n1, n2](size_t i){
+        return (i == n1) ? n2 : ((i == n2) ? n1 : i);
+    });
+}
+
 
 } //namespace holor
 
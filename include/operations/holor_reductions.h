@@ -0,0 +1,655 @@
+// This file is part of Holor, a C++ header-only template library for multi-dimensional containers
+
+// Copyright 2020-2022 Carlo Masone
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to 
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is 
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER 
+// DEALINGS IN THE SOFTWARE.
+
+
+#ifndef HOLOR_REDUCTIONS_H
+#define HOLOR_REDUCTIONS_H
+
+/** \file holor_reductions.h
+ * \brief This header contains the reductions of a container along one or more of its dimensions: `sum`, `prod`, `min`, `max`, `mean` and `var`.
+ *
+ * The dimensions of the source are normalized (see layout_traversal.h) and sorted by decreasing stride, so that the innermost loop runs along the dimension with the smallest stride.
+ * If that dimension is reduced, each element of the result is computed from contiguous runs of the source with a SIMD kernel; otherwise, the runs of the source are accumulated element-wise
+ * into rows of the result. The sums of floating point elements use pairwise summation within a run and Kahan compensated summation across runs, so their rounding errors do not grow
+ * linearly with the number of elements. With a parallel policy, the work is partitioned along the outermost dimension that is not reduced, so that each element of the result is computed by a single thread.
+ */
+
+#include <cstddef>
+#include <array>
+#include <algorithm>
+#include <concepts>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <type_traits>
+#include <vector>
+
+#include "../holor/holor.h"
+#include "../holor/holor_concepts.h"
+#include "../common/runtime_assertions.h"
+#include "../layout/layout_traversal.h"
+#include "holor_simd.h"
+#include "holor_execution.h"
+#include "holor_operations.h"
+
+
+namespace holor{
+
+namespace impl{
+
+/*================================================================================================
+                                    REDUCERS
+================================================================================================*/
+/*!
+ * \brief type of the elements of the result of `mean` and `var`: the type of the source for floating point types, `double` for the integer types
+ */
+template<typename T>
+using floating_result_t = std::conditional_t<std::is_floating_point_v<T>, T, double>;
+
+/*!
+ * \brief Reducer that sums the elements of the source (or the squares of their differences from a mean, if `Squares` is true) into accumulators of type `Acc`.
+ * A reducer provides the initial value of the accumulators, a function that reduces a run of the source into a value, a function that combines such a value with an accumulator,
+ * and a function that accumulates a run of the source element-wise into a run of accumulators. For floating point accumulators, the runs are summed with pairwise summation
+ * and the accumulators are updated with Kahan compensated summation.
+ */
+template<typename T, typename Acc, bool Squares = false>
+struct SumReducer{
+    static constexpr bool compensated = std::is_floating_point_v<Acc>;
+    const Acc* mean_ = nullptr;     /*! the means subtracted from the elements when `Squares` is true, with the same layout of the accumulators */
+
+    Acc initial() const{
+        return Acc{};
+    }
+
+    Acc term(T x, size_t index) const{
+        if constexpr(Squares){
+            const Acc d = static_cast<Acc>(x) - mean_[index];
+            return d*d;
+        } else{
+            return static_cast<Acc>(x);
+        }
+    }
+
+    Acc reduce_run(const T* x, size_t n, std::ptrdiff_t stride, size_t index) const{
+        if constexpr(std::is_same_v<T, Acc> && simd::Vectorizable<T>){
+            if (stride == 1){
+                if constexpr(Squares){
+                    return simd::pairwise_sum_squares(x, n, mean_[index]);
+                } else{
+                    return simd::pairwise_sum(x, n);
+                }
+            }
+        }
+        if (n <= simd::pairwise_block){
+            Acc acc[4] = {Acc{}, Acc{}, Acc{}, Acc{}};
+            size_t i = 0;
+            for (; i + 4 <= n; i += 4){
+                for (size_t l = 0; l < 4; l++){
+                    acc[l] += term(x[static_cast<std::ptrdiff_t>(i + l)*stride], index);
+                }
+            }
+            for (; i < n; i++){
+                acc[0] += term(x[static_cast<std::ptrdiff_t>(i)*stride], index);
+            }
+            return (acc[0] + acc[1]) + (acc[2] + acc[3]);
+        }
+        const size_t half = n/2;
+        return reduce_run(x, half, stride, index) + reduce_run(x + static_cast<std::ptrdiff_t>(half)*stride, n - half, stride, index);
+    }
+
+    void combine(Acc& acc, Acc& comp, Acc value) const{
+        if constexpr(compensated){
+            const Acc y = value - comp;
+            const Acc t = acc + y;
+            comp = (t - acc) - y;
+            acc = t;
+        } else{
+            acc += value;
+        }
+    }
+
+    void accumulate_run(Acc* acc, Acc* comp, std::ptrdiff_t acc_stride, const T* x, std::ptrdiff_t stride, size_t n, size_t index) const{
+        if constexpr(compensated && std::is_same_v<T, Acc> && simd::Vectorizable<T>){
+            if (acc_stride == 1 && stride == 1){
+                if constexpr(Squares){
+                    simd::compensated_add_squares(acc, comp, x, mean_ + index, n);
+                } else{
+                    simd::compensated_add(acc, comp, x, n);
+                }
+                return;
+            }
+        }
+        for (size_t i = 0; i < n; i++){
+            const auto j = static_cast<std::ptrdiff_t>(i)*acc_stride;
+            combine(acc[j], comp[j], term(x[static_cast<std::ptrdiff_t>(i)*stride], index + j));
+        }
+    }
+};
+
+/*!
+ * \brief Reducer that folds the elements of the source with an associative and commutative function (`std::multiplies`, `simd::Min` or `simd::Max`), starting from its identity element.
+ * The runs with unitary stride are reduced and accumulated with the SIMD kernels.
+ */
+template<typename T, class Op>
+struct FoldReducer{
+    static constexpr bool compensated = false;
+
+    T initial() const{
+        if constexpr(std::is_same_v<Op, simd::Min>){
+            return std::numeric_limits<T>::has_infinity ? std::numeric_limits<T>::infinity() : std::numeric_limits<T>::max();
+        } else if constexpr(std::is_same_v<Op, simd::Max>){
+            return std::numeric_limits<T>::has_infinity ? -std::numeric_limits<T>::infinity() : std::numeric_limits<T>::lowest();
+        } else{
+            return T{1};
+        }
+    }
+
+    T reduce_run(const T* x, size_t n, std::ptrdiff_t stride, size_t) const{
+        if constexpr(simd::VectorizableReduction<Op, T>){
+            if (stride == 1){
+                return simd::reduce(x, n, initial(), Op{});
+            }
+        }
+        T result = initial();
+        for (size_t i = 0; i < n; i++){
+            result = Op{}(result, x[static_cast<std::ptrdiff_t>(i)*stride]);
+        }
+        return result;
+    }
+
+    void combine(T& acc, T&, T value) const{
+        acc = Op{}(acc, value);
+    }
+
+    void accumulate_run(T* acc, T*, std::ptrdiff_t acc_stride, const T* x, std::ptrdiff_t stride, size_t n, size_t) const{
+        if constexpr(simd::VectorizableOp<Op, T>){
+            if (acc_stride == 1 && stride == 1){
+                simd::transform(acc, x, acc, n, Op{});
+                return;
+            }
+        }
+        for (size_t i = 0; i < n; i++){
+            T& a = acc[static_cast<std::ptrdiff_t>(i)*acc_stride];
+            a = Op{}(a, x[static_cast<std::ptrdiff_t>(i)*stride]);
+        }
+    }
+};
+
+
+
+/*================================================================================================
+                                    REDUCTION ALONG DIMENSIONS
+================================================================================================*/
+/*!
+ * \brief Function that sorts the dimensions of normalized layouts by decreasing stride of the source (the layout of index 1), keeping the order of the dimensions with equal strides
+ * \param layouts the normalized layouts of the result (index 0) and of the source (index 1)
+ * \return the sorted layouts
+ */
+template<size_t N>
+NormalizedLayouts<N,2> sort_by_source_stride(const NormalizedLayouts<N,2>& layouts){
+    std::array<size_t, N> order;
+    std::iota(order.begin(), order.begin() + layouts.dimensions_, size_t{0});
+    std::stable_sort(order.begin(), order.begin() + layouts.dimensions_, [&](size_t i, size_t j){
+        return std::abs(layouts.strides_[1][i]) > std::abs(layouts.strides_[1][j]);
+    });
+    auto sorted = layouts;
+    for (size_t d = 0; d < layouts.dimensions_; d++){
+        sorted.lengths_[d] = layouts.lengths_[order[d]];
+        sorted.strides_[0][d] = layouts.strides_[0][order[d]];
+        sorted.strides_[1][d] = layouts.strides_[1][order[d]];
+    }
+    return sorted;
+}
+
+/*!
+ * \brief Function that reduces the source into the accumulators, traversing sorted normalized layouts. The innermost dimension is traversed by runs:
+ * if it is reduced (the accumulators have zero stride along it), each run is reduced into a value that is combined with its accumulator; otherwise, each run is accumulated element-wise into a run of accumulators.
+ * \param layouts the sorted normalized layouts of the accumulators (index 0) and of the source (index 1)
+ * \param source pointer to the memory of the source
+ * \param acc pointer to the accumulators
+ * \param comp pointer to the compensations of the accumulators, with the same layout
+ * \param reducer the reducer
+ */
+template<size_t N, typename T, typename Acc, class Reducer>
+void reduce_runs(const NormalizedLayouts<N,2>& layouts, const T* source, Acc* acc, Acc* comp, const Reducer& reducer){
+    if (layouts.size_ == 0){
+        return;
+    }
+    const size_t inner = layouts.dimensions_ - 1;
+    const size_t length = layouts.lengths_[inner];
+    const std::ptrdiff_t acc_stride = layouts.strides_[0][inner];
+    const std::ptrdiff_t stride = layouts.strides_[1][inner];
+    auto outer = layouts;
+    if (inner > 0){
+        outer.dimensions_ = inner;
+    } else{
+        outer.lengths_[0] = 1;
+    }
+    outer.size_ = layouts.size_/length;
+    if (acc_stride == 0){
+        impl::for_each_index(outer, [&](size_t i, size_t j){
+            reducer.combine(acc[i], comp[i], reducer.reduce_run(source + j, length, stride, i));
+        });
+    } else{
+        impl::for_each_index(outer, [&](size_t i, size_t j){
+            reducer.accumulate_run(acc + i, comp + i, acc_stride, source + j, stride, length, i);
+        });
+    }
+}
+
+/*!
+ * \brief Function that reduces a container along a set of dimensions into a contiguous array of accumulators, according to an execution policy.
+ * The parallel policies partition the outermost sorted dimension that is not reduced across the threads; if all the dimensions are reduced, each thread reduces a chunk of the outermost dimension into its own accumulator and the partial results are combined at the end.
+ * \param policy the execution policy
+ * \param source the container
+ * \param reduced for each dimension of the source, true if it is reduced
+ * \param result pointer to the accumulators, which are stored in row-major order with the lengths of the dimensions that are not reduced, and are initialized by the function
+ * \param reducer the reducer
+ */
+template<ExecutionPolicy Policy, HolorType Source, typename Acc, class Reducer>
+void reduce_dimensions(const Policy& policy, const Source& source, const std::array<bool, Source::dimensions>& reduced, Acc* result, const Reducer& reducer){
+    constexpr size_t N = Source::dimensions;
+    const auto lengths = source.lengths();
+    std::array<std::ptrdiff_t, N> result_strides;
+    std::ptrdiff_t stride = 1;
+    size_t result_size = 1;
+    for (size_t d = N; d-- > 0;){
+        result_strides[d] = reduced[d] ? 0 : stride;
+        if (!reduced[d]){
+            stride *= static_cast<std::ptrdiff_t>(lengths[d]);
+            result_size *= lengths[d];
+        }
+    }
+    std::fill(result, result + result_size, reducer.initial());
+    std::vector<Acc> comp(Reducer::compensated ? result_size : 0, Acc{});
+    Acc* comp_ptr = Reducer::compensated ? comp.data() : result;
+    const auto layouts = impl::sort_by_source_stride(impl::normalize_layouts<N,2>(lengths, {result_strides, source.layout().strides()}, {0, source.layout().offset()}));
+    const auto* source_ptr = source.data();
+
+    size_t dim = 0;
+    while (dim < layouts.dimensions_ && layouts.strides_[0][dim] == 0){
+        dim++;
+    }
+    auto chunk_layouts = [&](size_t d, size_t begin, size_t end){
+        auto chunk = layouts;
+        chunk.lengths_[d] = end - begin;
+        chunk.size_ = layouts.size_/layouts.lengths_[d]*(end - begin);
+        chunk.offsets_[0] += begin*layouts.strides_[0][d];
+        chunk.offsets_[1] += begin*layouts.strides_[1][d];
+        return chunk;
+    };
+    if (dim < layouts.dimensions_){
+        impl::parallel_partition(policy, layouts.lengths_[dim], layouts.size_, [&](size_t begin, size_t end, size_t){
+            impl::reduce_runs(chunk_layouts(dim, begin, end), source_ptr, result, comp_ptr, reducer);
+        });
+    } else{
+        // all the dimensions are reduced into a single accumulator
+        const size_t chunks = impl::partition_count(policy, layouts.lengths_[0], layouts.size_);
+        std::vector<Acc> partials(chunks, reducer.initial());
+        std::vector<Acc> partial_comps(chunks, Acc{});
+        impl::parallel_partition(policy, layouts.lengths_[0], layouts.size_, [&](size_t begin, size_t end, size_t chunk){
+            impl::reduce_runs(chunk_layouts(0, begin, end), source_ptr, &partials[chunk], &partial_comps[chunk], reducer);
+        });
+        for (size_t chunk = 0; chunk < chunks; chunk++){
+            reducer.combine(result[0], comp_ptr[0], partials[chunk]);
+            if constexpr(Reducer::compensated){
+                reducer.combine(result[0], comp_ptr[0], -partial_comps[chunk]);
+            }
+        }
+    }
+}
+
+/*!
+ * \brief Function that reduces a container along `K` of its dimensions with a reducer, returning a new Holor with the other dimensions, or a scalar if all the dimensions are reduced
+ * \param policy the execution policy
+ * \param source the container
+ * \param axes the reduced dimensions
+ * \param reducer the reducer
+ * \param name the name of the calling function, used in the message of the exception
+ * \return the result of the reduction
+ */
+template<typename Acc, size_t K, ExecutionPolicy Policy, HolorType Source, class Reducer>
+auto reduce_axes(const Policy& policy, const Source& source, const std::array<size_t, K>& axes, const Reducer& reducer){
+    constexpr size_t N = Source::dimensions;
+    std::array<bool, N> reduced{};
+    bool valid = true;
+    for (auto axis : axes){
+        valid = valid && (axis < N) && !reduced[axis];
+        if (valid){
+            reduced[axis] = true;
+        }
+    }
+    assert::dynamic_assert(valid, EXCEPTION_MESSAGE("holor::reduction - The reduced dimensions are not valid and distinct."));
+    if constexpr(K == N){
+        Acc result;
+        impl::reduce_dimensions(policy, source, reduced, &result, reducer);
+        return result;
+    } else{
+        using allocator_type = typename std::allocator_traits<typename impl::result_allocator<Source>::type>::template rebind_alloc<Acc>;
+        std::array<size_t, N-K> lengths{};
+        for (size_t d = 0, i = 0; d < N; d++){
+            if (!reduced[d]){
+                lengths[i++] = source.length(d);
+            }
+        }
+        Holor<Acc, N-K, allocator_type> result(holor::uninitialized, lengths);
+        impl::reduce_dimensions(policy, source, reduced, result.data(), reducer);
+        return result;
+    }
+}
+
+/*!
+ * \brief Function that returns the array of all the dimensions of a container, `{0, 1, ..., N-1}`
+ */
+template<size_t N>
+constexpr std::array<size_t, N> all_axes(){
+    std::array<size_t, N> axes;
+    std::iota(axes.begin(), axes.end(), size_t{0});
+    return axes;
+}
+
+/*!
+ * \brief Function that returns the number of elements of a container that are reduced into each element of the result
+ */
+template<size_t K, HolorType Source>
+size_t reduced_count(const Source& source, const std::array<size_t, K>& axes){
+    size_t count = 1;
+    for (auto axis : axes){
+        count *= (axis < Source::dimensions) ? source.length(axis) : 1;
+    }
+    return count;
+}
+
+/*!
+ * \brief Function that divides the elements of the result of a reduction (a Holor or a scalar) by a value
+ */
+template<typename R, typename Acc>
+void divide_result(R& result, Acc divisor){
+    if constexpr(std::is_arithmetic_v<R>){
+        result /= divisor;
+    } else{
+        for (auto& x : result){
+            x /= divisor;
+        }
+    }
+}
+
+} //namespace impl
+
+
+
+/*================================================================================================
+                                    SUM AND PRODUCT
+================================================================================================*/
+/*!
+ * \brief Function that sums the elements of a container along `K` of its dimensions. The sums of floating point elements use pairwise and Kahan compensated summation.
+ * \tparam K number of reduced dimensions
+ * \param policy the execution policy
+ * \param source the container
+ * \param axes the reduced dimensions
+ * \exception holor::exception::HolorRuntimeError if the reduced dimensions are not valid and distinct. The compiler flag DDEFINE_ASSERT_LEVEL in the CMakeLists can be set to AssertionLevel::no_checks to exclude this check.
+ * \return a new Holor with the dimensions of the source that are not reduced, whose elements are stored in row-major order, or a scalar if all the dimensions are reduced
+ */
+template<size_t K, ExecutionPolicy Policy, HolorType Source> requires (std::is_arithmetic_v<typename Source::value_type> && (K <= Source::dimensions))
+auto sum(const Policy& policy, const Source& source, const std::array<size_t, K>& axes){
+    using T = typename Source::value_type;
+    return impl::reduce_axes<T>(policy, source, axes, impl::SumReducer<T, T>{});
+}
+
+template<size_t K, HolorType Source> requires (std::is_arithmetic_v<typename Source::value_type> && (K <= Source::dimensions))
+auto sum(const Source& source, const std::array<size_t, K>& axes){
+    return sum<K>(execution::seq, source, axes);
+}
+
+/*!
+ * \brief Function that sums all the elements of a container. The sums of floating point elements use pairwise and Kahan compensated summation.
+ * \param policy the execution policy
+ * \param source the container
+ * \return the sum of the elements
+ */
+template<ExecutionPolicy Policy, HolorType Source> requires std::is_arithmetic_v<typename Source::value_type>
+auto sum(const Policy& policy, const Source& source){
+    return sum<Source::dimensions>(policy, source, impl::all_axes<Source::dimensions>());
+}
+
+template<HolorType Source> requires std::is_arithmetic_v<typename Source::value_type>
+auto sum(const Source& source){
+    return sum(execution::seq, source);
+}
+
+
+/*!
+ * \brief Function that multiplies the elements of a container along `K` of its dimensions.
+ * \tparam K number of reduced dimensions
+ * \param policy the execution policy
+ * \param source the container
+ * \param axes the reduced dimensions
+ * \exception holor::exception::HolorRuntimeError if the reduced dimensions are not valid and distinct. The compiler flag DDEFINE_ASSERT_LEVEL in the CMakeLists can be set to AssertionLevel::no_checks to exclude this check.
+ * \return a new Holor with the dimensions of the source that are not reduced, whose elements are stored in row-major order, or a scalar if all the dimensions are reduced
+ */
+template<size_t K, ExecutionPolicy Policy, HolorType Source> requires (std::is_arithmetic_v<typename Source::value_type> && (K <= Source::dimensions))
+auto prod(const Policy& policy, const Source& source, const std::array<size_t, K>& axes){
+    using T = typename Source::value_type;
+    return impl::reduce_axes<T>(policy, source, axes, impl::FoldReducer<T, std::multiplies<>>{});
+}
+
+template<size_t K, HolorType Source> requires (std::is_arithmetic_v<typename Source::value_type> && (K <= Source::dimensions))
+auto prod(const Source& source, const std::array<size_t, K>& axes){
+    return prod<K>(execution::seq, source, axes);
+}
+
+/*!
+ * \brief Function that multiplies all the elements of a container.
+ * \param policy the execution policy
+ * \param source the container
+ * \return the product of the elements
+ */
+template<ExecutionPolicy Policy, HolorType Source> requires std::is_arithmetic_v<typename Source::value_type>
+auto prod(const Policy& policy, const Source& source){
+    return prod<Source::dimensions>(policy, source, impl::all_axes<Source::dimensions>());
+}
+
+template<HolorType Source> requires std::is_arithmetic_v<typename Source::value_type>
+auto prod(const Source& source){
+    return prod(execution::seq, source);
+}
+
+
+
+/*================================================================================================
+                                    MINIMUM AND MAXIMUM
+================================================================================================*/
+/*!
+ * \brief Function that computes the minimum of the elements of a container along `K` of its dimensions.
+ * \tparam K number of reduced dimensions
+ * \param policy the execution policy
+ * \param source the container
+ * \param axes the reduced dimensions
+ * \exception holor::exception::HolorRuntimeError if the reduced dimensions are not valid and distinct. The compiler flag DDEFINE_ASSERT_LEVEL in the CMakeLists can be set to AssertionLevel::no_checks to exclude this check.
+ * \return a new Holor with the dimensions of the source that are not reduced, whose elements are stored in row-major order, or a scalar if all the dimensions are reduced
+ */
+template<size_t K, ExecutionPolicy Policy, HolorType Source> requires (std::is_arithmetic_v<typename Source::value_type> && (K <= Source::dimensions))
+auto min(const Policy& policy, const Source& source, const std::array<size_t, K>& axes){
+    using T = typename Source::value_type;
+    return impl::reduce_axes<T>(policy, source, axes, impl::FoldReducer<T, simd::Min>{});
+}
+
+template<size_t K, HolorType Source> requires (std::is_arithmetic_v<typename Source::value_type> && (K <= Source::dimensions))
+auto min(const Source& source, const std::array<size_t, K>& axes){
+    return min<K>(execution::seq, source, axes);
+}
+
+/*!
+ * \brief Function that computes the minimum of all the elements of a container.
+ * \param policy the execution policy
+ * \param source the container
+ * \return the minimum element
+ */
+template<ExecutionPolicy Policy, HolorType Source> requires std::is_arithmetic_v<typename Source::value_type>
+auto min(const Policy& policy, const Source& source){
+    return min<Source::dimensions>(policy, source, impl::all_axes<Source::dimensions>());
+}
+
+template<HolorType Source> requires std::is_arithmetic_v<typename Source::value_type>
+auto min(const Source& source){
+    return min(execution::seq, source);
+}
+
+
+/*!
+ * \brief Function that computes the maximum of the elements of a container along `K` of its dimensions.
+ * \tparam K number of reduced dimensions
+ * \param policy the execution policy
+ * \param source the container
+ * \param axes the reduced dimensions
+ * \exception holor::exception::HolorRuntimeError if the reduced dimensions are not valid and distinct. The compiler flag DDEFINE_ASSERT_LEVEL in the CMakeLists can be set to AssertionLevel::no_checks to exclude this check.
+ * \return a new Holor with the dimensions of the source that are not reduced, whose elements are stored in row-major order, or a scalar if all the dimensions are reduced
+ */
+template<size_t K, ExecutionPolicy Policy, HolorType Source> requires (std::is_arithmetic_v<typename Source::value_type> && (K <= Source::dimensions))
+auto max(const Policy& policy, const Source& source, const std::array<size_t, K>& axes){
+    using T = typename Source::value_type;
+    return impl::reduce_axes<T>(policy, source, axes, impl::FoldReducer<T, simd::Max>{});
+}
+
+template<size_t K, HolorType Source> requires (std::is_arithmetic_v<typename Source::value_type> && (K <= Source::dimensions))
+auto max(const Source& source, const std::array<size_t, K>& axes){
+    return max<K>(execution::seq, source, axes);
+}
+
+/*!
+ * \brief Function that computes the maximum of all the elements of a container.
+ * \param policy the execution policy
+ * \param source the container
+ * \return the maximum element
+ */
+template<ExecutionPolicy Policy, HolorType Source> requires std::is_arithmetic_v<typename Source::value_type>
+auto max(const Policy& policy, const Source& source){
+    return max<Source::dimensions>(policy, source, impl::all_axes<Source::dimensions>());
+}
+
+template<HolorType Source> requires std::is_arithmetic_v<typename Source::value_type>
+auto max(const Source& source){
+    return max(execution::seq, source);
+}
+
+
+
+/*================================================================================================
+                                    MEAN AND VARIANCE
+================================================================================================*/
+/*!
+ * \brief Function that computes the mean of the elements of a container along `K` of its dimensions. The elements of the result are of the same type of the source for floating point types, and `double` for integer types.
+ * \tparam K number of reduced dimensions
+ * \param policy the execution policy
+ * \param source the container
+ * \param axes the reduced dimensions
+ * \exception holor::exception::HolorRuntimeError if the reduced dimensions are not valid and distinct. The compiler flag DDEFINE_ASSERT_LEVEL in the CMakeLists can be set to AssertionLevel::no_checks to exclude this check.
+ * \return a new Holor with the dimensions of the source that are not reduced, whose elements are stored in row-major order, or a scalar if all the dimensions are reduced
+ */
+template<size_t K, ExecutionPolicy Policy, HolorType Source> requires (std::is_arithmetic_v<typename Source::value_type> && (K <= Source::dimensions))
+auto mean(const Policy& policy, const Source& source, const std::array<size_t, K>& axes){
+    using T = typename Source::value_type;
+    using Acc = impl::floating_result_t<T>;
+    auto result = impl::reduce_axes<Acc>(policy, source, axes, impl::SumReducer<T, Acc>{});
+    impl::divide_result(result, static_cast<Acc>(impl::reduced_count<K>(source, axes)));
+    return result;
+}
+
+template<size_t K, HolorType Source> requires (std::is_arithmetic_v<typename Source::value_type> && (K <= Source::dimensions))
+auto mean(const Source& source, const std::array<size_t, K>& axes){
+    return mean<K>(execution::seq, source, axes);
+}
+
+/*!
+ * \brief Function that computes the mean of all the elements of a container. The result is of the same type of the source for floating point types, and `double` for integer types.
+ * \param policy the execution policy
+ * \param source the container
+ * \return the mean of the elements
+ */
+template<ExecutionPolicy Policy, HolorType Source> requires std::is_arithmetic_v<typename Source::value_type>
+auto mean(const Policy& policy, const Source& source){
+    return mean<Source::dimensions>(policy, source, impl::all_axes<Source::dimensions>());
+}
+
+template<HolorType Source> requires std::is_arithmetic_v<typename Source::value_type>
+auto mean(const Source& source){
+    return mean(execution::seq, source);
+}
+
+
+/*!
+ * \brief Function that computes the variance of the elements of a container along `K` of its dimensions, as the sum of the squared differences from the mean divided by `n - ddof`, where `n` is the number of reduced elements.
+ * The variance is computed with two passes over the source, the first computing the mean, so that it does not suffer from the cancellation of the single-pass formula.
+ * The elements of the result are of the same type of the source for floating point types, and `double` for integer types.
+ * \tparam K number of reduced dimensions
+ * \param policy the execution policy
+ * \param source the container
+ * \param axes the reduced dimensions
+ * \param ddof the delta degrees of freedom: 0 for the population variance, 1 for the unbiased sample variance
+ * \exception holor::exception::HolorRuntimeError if the reduced dimensions are not valid and distinct, or if `ddof` is not smaller than the number of reduced elements. The compiler flag DDEFINE_ASSERT_LEVEL in the CMakeLists can be set to AssertionLevel::no_checks to exclude this check.
+ * \return a new Holor with the dimensions of the source that are not reduced, whose elements are stored in row-major order, or a scalar if all the dimensions are reduced
+ */
+template<size_t K, ExecutionPolicy Policy, HolorType Source> requires (std::is_arithmetic_v<typename Source::value_type> && (K <= Source::dimensions))
+auto var(const Policy& policy, const Source& source, const std::array<size_t, K>& axes, size_t ddof = 0){
+    using T = typename Source::value_type;
+    using Acc = impl::floating_result_t<T>;
+    const size_t count = impl::reduced_count<K>(source, axes);
+    assert::dynamic_assert(ddof < count, EXCEPTION_MESSAGE("holor::var - The delta degrees of freedom must be smaller than the number of reduced elements."));
+    const auto means = mean<K>(policy, source, axes);
+    impl::SumReducer<T, Acc, true> reducer;
+    if constexpr(K == Source::dimensions){
+        reducer.mean_ = &means;
+    } else{
+        reducer.mean_ = means.data();
+    }
+    auto result = impl::reduce_axes<Acc>(policy, source, axes, reducer);
+    impl::divide_result(result, static_cast<Acc>(count - ddof));
+    return result;
+}
+
+template<size_t K, HolorType Source> requires (std::is_arithmetic_v<typename Source::value_type> && (K <= Source::dimensions))
+auto var(const Source& source, const std::array<size_t, K>& axes, size_t ddof = 0){
+    return var<K>(execution::seq, source, axes, ddof);
+}
+
+/*!
+ * \brief Function that computes the variance of all the elements of a container, as the sum of the squared differences from the mean divided by `n - ddof`, where `n` is the number of elements.
+ * The result is of the same type of the source for floating point types, and `double` for integer types.
+ * \param policy the execution policy
+ * \param source the container
+ * \param ddof the delta degrees of freedom: 0 for the population variance, 1 for the unbiased sample variance
+ * \exception holor::exception::HolorRuntimeError if `ddof` is not smaller than the number of elements. The compiler flag DDEFINE_ASSERT_LEVEL in the CMakeLists can be set to AssertionLevel::no_checks to exclude this check.
+ * \return the variance of the elements
+ */
+template<ExecutionPolicy Policy, HolorType Source> requires std::is_arithmetic_v<typename Source::value_type>
+auto var(const Policy& policy, const Source& source, size_t ddof = 0){
+    return var<Source::dimensions>(policy, source, impl::all_axes<Source::dimensions>(), ddof);
+}
+
+template<HolorType Source> requires std::is_arithmetic_v<typename Source::value_type>
+auto var(const Source& source, size_t ddof = 0){
+    return var(execution::seq, source, ddof);
+}
+
+} //namespace holor
+
+#endif // HOLOR_REDUCTIONS_H
@@ -0,0 +1,566 @@
+// This file is part of Holor, a C++ header-only template library for multi-dimensional containers
+
+// Copyright 2020-2022 Carlo Masone
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to 
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is 
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER 
+// DEALINGS IN THE SOFTWARE.
+
+#ifndef HOLOR_SIMD_H
+#define HOLOR_SIMD_H
+
+/** \file holor_simd.h
+ * \brief This header contains the SIMD kernels that are used by the operations on contiguous containers of arithmetic types.
+ *
+ * The kernels work on flat arrays. They are written with the vector extensions of GCC and Clang, so that the compiler emits the instructions of the widest
+ * instruction set enabled at compile time (e.g., SSE with the default flags, AVX2 with `-mavx2` or `-march=haswell`, AVX-512 with `-mavx512f`).
+ * With other compilers the kernels fall back to scalar loops.
+ */
+
+#include <cstddef>
+#include <cstring>
+#include <cstdint>
+#include <concepts>
+#include <functional>
+#include <type_traits>
+
+#if (defined(__GNUC__) || defined(__clang__)) && !defined(HOLOR_DISABLE_SIMD)
+#define HOLOR_SIMD_VECTOR_EXTENSIONS
+#if (defined(__FMA__) || defined(__AVX512F__)) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#endif
+#endif
+
+
+namespace holor{
+
+namespace simd{
+
+
+/*================================================================================================
+                                    VECTOR TYPES
+================================================================================================*/
+/*!
+ * \brief Size in bytes of the vector registers used by the kernels, which depends on the instruction set enabled at compile time
+ */
+#if defined(__AVX512F__)
+inline constexpr size_t register_bytes = 64;
+#elif defined(__AVX__)
+inline constexpr size_t register_bytes = 32;
+#else
+inline constexpr size_t register_bytes = 16;
+#endif
+
+/*!
+ * \brief Constraints the types of elements that are processed with vector instructions: `float`, `double` and the integer types
+ */
+template<typename T>
+concept Vectorizable = (std::is_same_v<T, float> || std::is_same_v<T, double> || (std::is_integral_v<T> && !std::is_same_v<T, bool>));
+
+/*!
+ * \brief Number of elements of type `T` in a vector register
+ */
+template<Vectorizable T>
+inline constexpr size_t lanes = register_bytes/sizeof(T);
+
+
+namespace impl{
+#ifdef HOLOR_SIMD_VECTOR_EXTENSIONS
+    /*!
+     * \brief Vector of `lanes<T>` elements of type `T`, that supports the arithmetic and comparison operators element-wise
+     */
+    template<Vectorizable T>
+    struct vector{
+        typedef T type __attribute__((vector_size(register_bytes)));
+    };
+
+    template<Vectorizable T>
+    using vector_t = typename vector<T>::type;
+
+    template<Vectorizable T>
+    inline vector_t<T> load(const T* ptr){
+        vector_t<T> v;
+        std::memcpy(&v, ptr, sizeof(v));
+        return v;
+    }
+
+    template<Vectorizable T>
+    inline void store(T* ptr, const vector_t<T>& v){
+        std::memcpy(ptr, &v, sizeof(v));
+    }
+
+    /*!
+     * \brief returns a vector with all the elements equal to `value`. Subtracting zero (instead of adding it) is exact also for negative zeros, so the compiler emits a single broadcast instruction
+     */
+    template<Vectorizable T>
+    inline vector_t<T> broadcast(T value){
+        return value - vector_t<T>{};
+    }
+
+    /*!
+     * \brief computes `a*b + c` element-wise, with fused multiply-add instructions when they are available
+     */
+    template<Vectorizable T>
+    inline vector_t<T> multiply_add(const vector_t<T>& a, const vector_t<T>& b, const vector_t<T>& c){
+#if defined(__FMA__) && (defined(__x86_64__) || defined(__i386__))
+        if constexpr(std::is_same_v<T, float> && register_bytes == 16){
+            return _mm_fmadd_ps(a, b, c);
+        } else if constexpr(std::is_same_v<T, double> && register_bytes == 16){
+            return _mm_fmadd_pd(a, b, c);
+        } else if constexpr(std::is_same_v<T, float> && register_bytes == 32){
+            return _mm256_fmadd_ps(a, b, c);
+        } else if constexpr(std::is_same_v<T, double> && register_bytes == 32){
+            return _mm256_fmadd_pd(a, b, c);
+        }
+#endif
+#if defined(__AVX512F__) && (defined(__x86_64__) || defined(__i386__))
+        if constexpr(std::is_same_v<T, float> && register_bytes == 64){
+            return _mm512_fmadd_ps(a, b, c);
+        } else if constexpr(std::is_same_v<T, double> && register_bytes == 64){
+            return _mm512_fmadd_pd(a, b, c);
+        }
+#endif
+        return a*b + c;
+    }
+#endif
+} //namespace impl
+
+
+
+/*================================================================================================
+                                    OPERATIONS
+================================================================================================*/
+/*!
+ * \brief Function object that returns the minimum of its arguments. It can be used with `reduce_all` and `broadcast_all` on both scalars and vectors
+ */
+struct Min{
+    template<typename X>
+    X operator()(const X& a, const X& b) const{
+        return b < a ? b : a;
+    }
+};
+
+/*!
+ * \brief Function object that returns the maximum of its arguments. It can be used with `reduce_all` and `broadcast_all` on both scalars and vectors
+ */
+struct Max{
+    template<typename X>
+    X operator()(const X& a, const X& b) const{
+        return a < b ? b : a;
+    }
+};
+
+namespace impl{
+    /*!
+     * \brief trait that maps the function objects of the standard library and the Min/Max functions to function objects that can be applied to vectors.
+     * It is not defined for the function objects that have no vectorized kernel
+     */
+    template<typename Op, typename T>
+    struct vector_op{};
+
+    template<typename T> struct vector_op<std::plus<T>, T>{ using type = std::plus<>; static constexpr bool associative = true; };
+    template<typename T> struct vector_op<std::plus<>, T>{ using type = std::plus<>; static constexpr bool associative = true; };
+    template<typename T> struct vector_op<std::multiplies<T>, T>{ using type = std::multiplies<>; static constexpr bool associative = true; };
+    template<typename T> struct vector_op<std::multiplies<>, T>{ using type = std::multiplies<>; static constexpr bool associative = true; };
+    template<typename T> struct vector_op<std::minus<T>, T>{ using type = std::minus<>; static constexpr bool associative = false; };
+    template<typename T> struct vector_op<std::minus<>, T>{ using type = std::minus<>; static constexpr bool associative = false; };
+    template<typename T> struct vector_op<std::divides<T>, T>{ using type = std::divides<>; static constexpr bool associative = false; };
+    template<typename T> struct vector_op<std::divides<>, T>{ using type = std::divides<>; static constexpr bool associative = false; };
+    template<typename T> struct vector_op<Min, T>{ using type = Min; static constexpr bool associative = true; };
+    template<typename T> struct vector_op<Max, T>{ using type = Max; static constexpr bool associative = true; };
+}
+
+/*!
+ * \brief Constraints a binary function to have a vectorized kernel for elements of type `T`: `std::plus`, `std::minus`, `std::multiplies`, `std::divides`, `Min` and `Max`
+ */
+template<typename Op, typename T>
+concept VectorizableOp = Vectorizable<T> && requires{
+    typename impl::vector_op<std::remove_cvref_t<Op>, T>::type;
+};
+
+/*!
+ * \brief Constraints a binary function to have a vectorized kernel for elements of type `T` and to be associative and commutative, so that it can be used in a vectorized reduction: `std::plus`, `std::multiplies`, `Min` and `Max`
+ */
+template<typename Op, typename T>
+concept VectorizableReduction = VectorizableOp<Op, T> && impl::vector_op<std::remove_cvref_t<Op>, T>::associative;
+
+
+
+/*================================================================================================
+                                    KERNELS
+================================================================================================*/
+/*!
+ * \brief Kernel that applies a binary function element-wise to two arrays, i.e., `dest[i] = op(a[i], b[i])`. The destination can be equal to one of the sources
+ * \param a pointer to the first array
+ * \param b pointer to the second array
+ * \param dest pointer to the destination array
+ * \param n number of elements
+ * \param op the binary function
+ */
+template<Vectorizable T, class Op> requires VectorizableOp<Op, T>
+void transform(const T* a, const T* b, T* dest, size_t n, Op op){
+    using vop = typename impl::vector_op<std::remove_cvref_t<Op>, T>::type;
+    size_t i = 0;
+#ifdef HOLOR_SIMD_VECTOR_EXTENSIONS
+    constexpr size_t L = lanes<T>;
+    for (; i + L <= n; i += L){
+        impl::store(dest + i, vop{}(impl::load(a + i), impl::load(b + i)));
+    }
+#endif
+    for (; i < n; i++){
+        dest[i] = vop{}(a[i], b[i]);
+    }
+}
+
+/*!
+ * \brief Kernel that applies a binary function element-wise to an array and a scalar, i.e., `dest[i] = op(a[i], value)`. The destination can be equal to the source
+ * \param a pointer to the array
+ * \param value the scalar
+ * \param dest pointer to the destination array
+ * \param n number of elements
+ * \param op the binary function
+ */
+template<Vectorizable T, class Op> requires VectorizableOp<Op, T>
+void transform_scalar(const T* a, T value, T* dest, size_t n, Op op){
+    using vop = typename impl::vector_op<std::remove_cvref_t<Op>, T>::type;
+    size_t i = 0;
+#ifdef HOLOR_SIMD_VECTOR_EXTENSIONS
+    constexpr size_t L = lanes<T>;
+    const auto v = impl::broadcast(value);
+    for (; i + L <= n; i += L){
+        impl::store(dest + i, vop{}(impl::load(a + i), v));
+    }
+#endif
+    for (; i < n; i++){
+        dest[i] = vop{}(a[i], value);
+    }
+}
+
+/*!
+ * \brief Kernel that computes the fused multiply-add `dest[i] = alpha*x[i] + y[i]`. The destination can be equal to one of the sources
+ * \param alpha the scalar multiplier
+ * \param x pointer to the array that is multiplied
+ * \param y pointer to the array that is added
+ * \param dest pointer to the destination array
+ * \param n number of elements
+ */
+template<Vectorizable T>
+void multiply_add(T alpha, const T* x, const T* y, T* dest, size_t n){
+    size_t i = 0;
+#ifdef HOLOR_SIMD_VECTOR_EXTENSIONS
+    constexpr size_t L = lanes<T>;
+    const auto va = impl::broadcast(alpha);
+    for (; i + L <= n; i += L){
+        impl::store(dest + i, impl::multiply_add<T>(va, impl::load(x + i), impl::load(y + i)));
+    }
+#endif
+    for (; i < n; i++){
+        dest[i] = alpha*x[i] + y[i];
+    }
+}
+
+/*!
+ * \brief Kernel that reduces an array with an associative and commutative binary function, using several independent accumulators.
+ * The order in which the elements are combined differs from a sequential loop, so the result of a floating point sum can differ by rounding errors.
+ * \param a pointer to the array
+ * \param n number of elements
+ * \param init the initial value of the reduction
+ * \param op the binary function
+ * \return the result of the reduction
+ */
+template<Vectorizable T, class Op> requires VectorizableReduction<Op, T>
+T reduce(const T* a, size_t n, T init, Op op){
+    using vop = typename impl::vector_op<std::remove_cvref_t<Op>, T>::type;
+    T result = init;
+    size_t i = 0;
+#ifdef HOLOR_SIMD_VECTOR_EXTENSIONS
+    constexpr size_t L = lanes<T>;
+    if (n >= 4*L){
+        auto acc0 = impl::load(a);
+        auto acc1 = impl::load(a + L);
+        auto acc2 = impl::load(a + 2*L);
+        auto acc3 = impl::load(a + 3*L);
+        for (i = 4*L; i + 4*L <= n; i += 4*L){
+            acc0 = vop{}(acc0, impl::load(a + i));
+            acc1 = vop{}(acc1, impl::load(a + i + L));
+            acc2 = vop{}(acc2, impl::load(a + i + 2*L));
+            acc3 = vop{}(acc3, impl::load(a + i + 3*L));
+        }
+        const auto acc = vop{}(vop{}(acc0, acc1), vop{}(acc2, acc3));
+        for (size_t l = 0; l < L; l++){
+            result = vop{}(result, static_cast<T>(acc[l]));
+        }
+    }
+#endif
+    for (; i < n; i++){
+        result = vop{}(result, a[i]);
+    }
+    return result;
+}
+
+/*!
+ * \brief Kernel that checks whether two arrays have the same elements
+ * \param a pointer to the first array
+ * \param b pointer to the second array
+ * \param n number of elements
+ * \return true if `a[i] == b[i]` for all the elements
+ */
+template<Vectorizable T>
+bool equal(const T* a, const T* b, size_t n){
+    size_t i = 0;
+#ifdef HOLOR_SIMD_VECTOR_EXTENSIONS
+    constexpr size_t L = lanes<T>;
+    for (; i + 4*L <= n; i += 4*L){
+        const auto diff = (impl::load(a + i) != impl::load(b + i)) | (impl::load(a + i + L) != impl::load(b + i + L))
+                        | (impl::load(a + i + 2*L) != impl::load(b + i + 2*L)) | (impl::load(a + i + 3*L) != impl::load(b + i + 3*L));
+        for (size_t l = 0; l < L; l++){
+            if (diff[l]){
+                return false;
+            }
+        }
+    }
+#endif
+    for (; i < n; i++){
+        if (!(a[i] == b[i])){
+            return false;
+        }
+    }
+    return true;
+}
+
+/*!
+ * \brief Number of elements that `pairwise_sum` adds with independent accumulators before splitting an array in halves
+ */
+inline constexpr size_t pairwise_block = 1024;
+
+namespace impl{
+    /*!
+     * \brief sums the elements of a block (or the squares of their differences from `shift`, if `Squares` is true) with four vector accumulators
+     */
+    template<bool Squares, Vectorizable T>
+    T block_sum(const T* a, size_t n, T shift){
+        auto term = [shift](auto x){
+            if constexpr(Squares){
+                const auto d = x - shift;
+                return d*d;
+            } else{
+                return x;
+            }
+        };
+        T result{};
+        size_t i = 0;
+#ifdef HOLOR_SIMD_VECTOR_EXTENSIONS
+        constexpr size_t L = lanes<T>;
+        if (n >= 4*L){
+            vector_t<T> acc0{}, acc1{}, acc2{}, acc3{};
+            for (; i + 4*L <= n; i += 4*L){
+                acc0 += term(load(a + i));
+                acc1 += term(load(a + i + L));
+                acc2 += term(load(a + i + 2*L));
+                acc3 += term(load(a + i + 3*L));
+            }
+            const auto acc = (acc0 + acc1) + (acc2 + acc3);
+            for (size_t l = 0; l < L; l++){
+                result += static_cast<T>(acc[l]);
+            }
+        }
+#endif
+        for (; i < n; i++){
+            result += term(a[i]);
+        }
+        return result;
+    }
+
+    template<bool Squares, Vectorizable T>
+    T pairwise_sum(const T* a, size_t n, T shift){
+        if (n <= pairwise_block){
+            return block_sum<Squares>(a, n, shift);
+        }
+        const size_t half = n/2;
+        return pairwise_sum<Squares>(a, half, shift) + pairwise_sum<Squares>(a + half, n - half, shift);
+    }
+
+    /*!
+     * \brief adds the elements of an array (or the squares of their differences from the elements of `shift`, if `Squares` is true) to an array of sums, with Kahan compensated summation
+     */
+    template<bool Squares, Vectorizable T>
+    void compensated_add(T* sum, T* comp, const T* x, const T* shift, size_t n){
+        auto term = [](auto value, auto s){
+            if constexpr(Squares){
+                const auto d = value - s;
+                return d*d;
+            } else{
+                return value;
+            }
+        };
+        size_t i = 0;
+#ifdef HOLOR_SIMD_VECTOR_EXTENSIONS
+        constexpr size_t L = lanes<T>;
+        for (; i + L <= n; i += L){
+            const auto s = load(sum + i);
+            const auto y = term(load(x + i), Squares ? load(shift + i) : vector_t<T>{}) - load(comp + i);
+            const auto t = s + y;
+            store(comp + i, (t - s) - y);
+            store(sum + i, t);
+        }
+#endif
+        for (; i < n; i++){
+            const T y = term(x[i], Squares ? shift[i] : T{}) - comp[i];
+            const T t = sum[i] + y;
+            comp[i] = (t - sum[i]) - y;
+            sum[i] = t;
+        }
+    }
+}
+
+/*!
+ * \brief Kernel that sums the elements of an array with pairwise summation: the array is split in halves recursively, and the blocks of `pairwise_block` elements are summed with several independent accumulators.
+ * The rounding error of a floating point sum grows with the logarithm of the number of elements, instead of linearly as in a sequential loop.
+ * \param a pointer to the array
+ * \param n number of elements
+ * \return the sum of the elements
+ */
+template<Vectorizable T>
+T pairwise_sum(const T* a, size_t n){
+    return impl::pairwise_sum<false>(a, n, T{});
+}
+
+/*!
+ * \brief Kernel that sums the squares of the differences between the elements of an array and a value, with pairwise summation (see `pairwise_sum`)
+ * \param a pointer to the array
+ * \param n number of elements
+ * \param shift the value subtracted from the elements
+ * \return the sum of `(a[i] - shift)^2`
+ */
+template<Vectorizable T>
+T pairwise_sum_squares(const T* a, size_t n, T shift){
+    return impl::pairwise_sum<true>(a, n, shift);
+}
+
+/*!
+ * \brief Kernel that adds an array to an array of sums with Kahan compensated summation, i.e., `sum[i] += x[i]` where the rounding error of each addition is accumulated in `comp[i]` and subtracted from the next one.
+ * It is used to accumulate many rows of a container in a row of sums without losing the accuracy of the small terms.
+ * \param sum pointer to the array of sums
+ * \param comp pointer to the array of compensations, which must be zero before the first addition
+ * \param x pointer to the added array
+ * \param n number of elements
+ */
+template<Vectorizable T> requires std::floating_point<T>
+void compensated_add(T* sum, T* comp, const T* x, size_t n){
+    impl::compensated_add<false>(sum, comp, x, x, n);
+}
+
+/*!
+ * \brief Kernel that adds the squares of the differences between two arrays to an array of sums with Kahan compensated summation, i.e., `sum[i] += (x[i] - shift[i])^2` (see `compensated_add`)
+ * \param sum pointer to the array of sums
+ * \param comp pointer to the array of compensations, which must be zero before the first addition
+ * \param x pointer to the array
+ * \param shift pointer to the array subtracted from `x`
+ * \param n number of elements
+ */
+template<Vectorizable T> requires std::floating_point<T>
+void compensated_add_squares(T* sum, T* comp, const T* x, const T* shift, size_t n){
+    impl::compensated_add<true>(sum, comp, x, shift, n);
+}
+
+/*!
+ * \brief Number of rows and columns of the square blocks transposed in registers by `transpose_block`, so that a row of the block fills a vector register of at most 32 bytes.
+ * For example, with AVX the blocks are 8x8 for elements of 4 bytes and 4x4 for elements of 8 bytes
+ */
+template<Vectorizable T> requires (sizeof(T) == 4 || sizeof(T) == 8)
+inline constexpr size_t transpose_block_size = ((register_bytes < 32) ? register_bytes : 32)/sizeof(T);
+
+/*!
+ * \brief Kernel that transposes a square block of `transpose_block_size<T>` rows and columns, i.e., `dest[j*dest_stride + i] = src[i*src_stride + j]`.
+ * The rows are loaded in vector registers and transposed with shuffles, so each row of the source and of the destination is read or written with a single vector access
+ * \param src pointer to the first element of the source block
+ * \param src_stride distance between the rows of the source block
+ * \param dest pointer to the first element of the destination block
+ * \param dest_stride distance between the rows of the destination block
+ */
+template<Vectorizable T> requires (sizeof(T) == 4 || sizeof(T) == 8)
+void transpose_block(const T* src, std::ptrdiff_t src_stride, T* dest, std::ptrdiff_t dest_stride){
+    constexpr size_t B = transpose_block_size<T>;
+#if defined(HOLOR_SIMD_VECTOR_EXTENSIONS) && (defined(__clang__) || __GNUC__ >= 12)
+    // the elements are moved as unsigned integers of the same size, since the shuffles only move bits
+    using U = std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t>;
+    typedef U row_t __attribute__((vector_size(B*sizeof(T))));
+    auto load_row = [src, src_stride](size_t i){
+        row_t row;
+        std::memcpy(&row, src + i*src_stride, sizeof(row_t));
+        return row;
+    };
+    auto store_row = [dest, dest_stride](size_t j, const row_t& row){
+        std::memcpy(dest + j*dest_stride, &row, sizeof(row_t));
+    };
+    if constexpr(B == 8){
+        const row_t r0 = load_row(0), r1 = load_row(1), r2 = load_row(2), r3 = load_row(3);
+        const row_t r4 = load_row(4), r5 = load_row(5), r6 = load_row(6), r7 = load_row(7);
+        const row_t t0 = __builtin_shufflevector(r0, r1, 0, 8, 1, 9, 4, 12, 5, 13);
+        const row_t t1 = __builtin_shufflevector(r0, r1, 2, 10, 3, 11, 6, 14, 7, 15);
+        const row_t t2 = __builtin_shufflevector(r2, r3, 0, 8, 1, 9, 4, 12, 5, 13);
+        const row_t t3 = __builtin_shufflevector(r2, r3, 2, 10, 3, 11, 6, 14, 7, 15);
+        const row_t t4 = __builtin_shufflevector(r4, r5, 0, 8, 1, 9, 4, 12, 5, 13);
+        const row_t t5 = __builtin_shufflevector(r4, r5, 2, 10, 3, 11, 6, 14, 7, 15);
+        const row_t t6 = __builtin_shufflevector(r6, r7, 0, 8, 1, 9, 4, 12, 5, 13);
+        const row_t t7 = __builtin_shufflevector(r6, r7, 2, 10, 3, 11, 6, 14, 7, 15);
+        const row_t u0 = __builtin_shufflevector(t0, t2, 0, 1, 8, 9, 4, 5, 12, 13);
+        const row_t u1 = __builtin_shufflevector(t0, t2, 2, 3, 10, 11, 6, 7, 14, 15);
+        const row_t u2 = __builtin_shufflevector(t1, t3, 0, 1, 8, 9, 4, 5, 12, 13);
+        const row_t u3 = __builtin_shufflevector(t1, t3, 2, 3, 10, 11, 6, 7, 14, 15);
+        const row_t u4 = __builtin_shufflevector(t4, t6, 0, 1, 8, 9, 4, 5, 12, 13);
+        const row_t u5 = __builtin_shufflevector(t4, t6, 2, 3, 10, 11, 6, 7, 14, 15);
+        const row_t u6 = __builtin_shufflevector(t5, t7, 0, 1, 8, 9, 4, 5, 12, 13);
+        const row_t u7 = __builtin_shufflevector(t5, t7, 2, 3, 10, 11, 6, 7, 14, 15);
+        store_row(0, __builtin_shufflevector(u0, u4, 0, 1, 2, 3, 8, 9, 10, 11));
+        store_row(1, __builtin_shufflevector(u1, u5, 0, 1, 2, 3, 8, 9, 10, 11));
+        store_row(2, __builtin_shufflevector(u2, u6, 0, 1, 2, 3, 8, 9, 10, 11));
+        store_row(3, __builtin_shufflevector(u3, u7, 0, 1, 2, 3, 8, 9, 10, 11));
+        store_row(4, __builtin_shufflevector(u0, u4, 4, 5, 6, 7, 12, 13, 14, 15));
+        store_row(5, __builtin_shufflevector(u1, u5, 4, 5, 6, 7, 12, 13, 14, 15));
+        store_row(6, __builtin_shufflevector(u2, u6, 4, 5, 6, 7, 12, 13, 14, 15));
+        store_row(7, __builtin_shufflevector(u3, u7, 4, 5, 6, 7, 12, 13, 14, 15));
+    } else if constexpr(B == 4){
+        const row_t r0 = load_row(0), r1 = load_row(1), r2 = load_row(2), r3 = load_row(3);
+        const row_t t0 = __builtin_shufflevector(r0, r1, 0, 4, 2, 6);
+        const row_t t1 = __builtin_shufflevector(r0, r1, 1, 5, 3, 7);
+        const row_t t2 = __builtin_shufflevector(r2, r3, 0, 4, 2, 6);
+        const row_t t3 = __builtin_shufflevector(r2, r3, 1, 5, 3, 7);
+        store_row(0, __builtin_shufflevector(t0, t2, 0, 1, 4, 5));
+        store_row(1, __builtin_shufflevector(t1, t3, 0, 1, 4, 5));
+        store_row(2, __builtin_shufflevector(t0, t2, 2, 3, 6, 7));
+        store_row(3, __builtin_shufflevector(t1, t3, 2, 3, 6, 7));
+    } else{
+        const row_t r0 = load_row(0), r1 = load_row(1);
+        store_row(0, __builtin_shufflevector(r0, r1, 0, 2));
+        store_row(1, __builtin_shufflevector(r0, r1, 1, 3));
+    }
+#else
+    for (size_t j = 0; j < B; j++){
+        for (size_t i = 0; i < B; i++){
+            dest[j*dest_stride + i] = src[i*src_stride + j];
+        }
+    }
+#endif
+}
+
+
+} //namespace simd
+
+} //namespace holor
+
+#endif // HOLOR_SIMD_H
@@ -0,0 +1,72 @@
+// This file is part of Holor, a C++ header-only template library for multi-dimensional containers
+
+// Copyright 2020-2022 Carlo Masone
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to 
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is 
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER 
+// DEALINGS IN THE SOFTWARE.
+#ifndef HOLOR_TEST_UTILS_H
+#define HOLOR_TEST_UTILS_H
+
+/** \file test_utils.h
+ * \brief This header contains the utilities shared by the tests.
+ */
+
+#include <filesystem>
+#include <string>
+#include <system_error>
+
+
+/*=================================================================================
+                                Utilities
+=================================================================================*/
+/*!
+ * path of a temporary file used by a test, which is removed when the object is destroyed
+ */
+struct TemporaryFile{
+    std::filesystem::path path_;
+
+    /*!
+     * \param prefix identifies the test suite that creates the file, so that suites running concurrently do not share files
+     * \param name name of the file within the suite
+     */
+    TemporaryFile(const std::string& prefix, const std::string& name): path_{std::filesystem::temp_directory_path() / ("holor_test_" + prefix + "_" + name)} {}
+
+    ~TemporaryFile(){
+        std::error_code error;
+        std::filesystem::remove(path_, error);
+    }
+};
+
+
+/*!
+ * fills a container with a deterministic sequence of small integer values, in the order of its iterators
+ * \param h container to be filled
+ * \param start first value of the sequence
+ * \param modulus the values are in the range `[-modulus/2, modulus - 1 - modulus/2]`
+ * \param step increment between consecutive values of the sequence
+ */
+template<class H>
+void fill_pattern(H& h, int start = 0, int modulus = 101, int step = 7){
+    int value = start;
+    for (auto& x : h){
+        x = static_cast<typename H::value_type>(value%modulus - modulus/2);
+        value += step;
+    }
+}
+
+#endif // HOLOR_TEST_UTILS_H
@@ -0,0 +1,265 @@
+// This file is part of Holor, a C++ header-only template library for multi-dimensional containers
+
+// Copyright 2020-2022 Carlo Masone
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to 
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is 
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER 
+// DEALINGS IN THE SOFTWARE.
+
+
+
+
+
+#include <cstdint>
+#include <filesystem>
+#include <random>
+#include <string>
+#include <vector>
+#include <holor/holor_full.h>
+#include <io/chunked_holor.h>
+#include <io/mapped_holor.h>
+#include <gtest/gtest.h>
+#include "test_utils.h"
+
+using namespace holor;
+
+
+
+/*=================================================================================
+                                Utilities
+=================================================================================*/
+/*!
+ * compress and decompress a sequence of bytes, and verify that it is restored
+ */
+bool roundtrip(const std::vector<unsigned char>& data){
+    std::vector<unsigned char> compressed(impl::lz_compress_bound(data.size()));
+    const size_t size = impl::lz_compress(data.data(), data.size(), compressed.data());
+    std::vector<unsigned char> restored(data.size());
+    return impl::lz_decompress(compressed.data(), size, restored.data(), restored.size()) && (restored == data);
+}
+
+
+
+/*=================================================================================
+                                Tests
+=================================================================================*/
+TEST(TestChunked, CheckCompression){
+    std::mt19937 generator(7);
+    std::vector<unsigned char> random(10000);
+    for (auto& x : random){
+        x = static_cast<unsigned char>(generator());
+    }
+    std::vector<unsigned char> runs(100000);
+    for (size_t i = 0; i < runs.size(); i++){
+        runs[i] = static_cast<unsigned char>((i/300)%5);
+    }
+    EXPECT_TRUE( roundtrip({}) );
+    EXPECT_TRUE( roundtrip({1, 2, 3}) );
+    EXPECT_TRUE( roundtrip(random) );
+    EXPECT_TRUE( roundtrip(runs) );
+    EXPECT_TRUE( roundtrip(std::vector<unsigned char>(70000, 0)) );
+
+    std::vector<unsigned char> compressed(impl::lz_compress_bound(runs.size()));
+    const size_t size = impl::lz_compress(runs.data(), runs.size(), compressed.data());
+    EXPECT_LT( size, runs.size()/20 );
+
+    // corrupted or truncated inputs are detected
+    std::vector<unsigned char> restored(runs.size());
+    EXPECT_FALSE( impl::lz_decompress(compressed.data(), size - 1, restored.data(), restored.size()) );
+    EXPECT_FALSE( impl::lz_decompress(compressed.data(), size, restored.data(), restored.size() - 1) );
+    compressed[1] = 0xff;
+    compressed[2] = 0xff;
+    EXPECT_FALSE( impl::lz_decompress(compressed.data(), size, restored.data(), restored.size()) );
+
+    // shuffling the bytes groups the bytes with the same significance
+    const std::vector<uint16_t> values{0x0102, 0x0304, 0x0506};
+    std::vector<unsigned char> shuffled(6);
+    impl::shuffle_bytes(reinterpret_cast<const unsigned char*>(values.data()), shuffled.data(), 3, 2);
+    std::vector<uint16_t> unshuffled(3);
+    impl::unshuffle_bytes(shuffled.data(), reinterpret_cast<unsigned char*>(unshuffled.data()), 3, 2);
+    EXPECT_EQ( unshuffled, values );
+    EXPECT_EQ( shuffled[0], reinterpret_cast<const unsigned char*>(values.data())[0] );
+    EXPECT_EQ( shuffled[1], reinterpret_cast<const unsigned char*>(values.data())[2] );
+}
+
+
+TEST(TestChunked, CheckRoundtrip){
+    for (auto codec : {ChunkCodec::none, ChunkCodec::lz, ChunkCodec::shuffle_lz}){
+        TemporaryFile file("chunked", "roundtrip");
+        Holor<double, 3> h{std::array<size_t, 3>{11, 6, 9}};
+        fill_pattern(h);
+        save_chunked(file.path_, h, {4, 6, 2}, codec);
+
+        ChunkedHolorFile<double, 3> chunked(file.path_);
+        EXPECT_EQ( chunked.lengths(), h.lengths() );
+        EXPECT_EQ( (chunked.chunk_lengths()), (std::array<size_t, 3>{4, 6, 2}) );
+        EXPECT_EQ( (chunked.grid()), (std::array<size_t, 3>{3, 1, 5}) );
+        EXPECT_EQ( chunked.codec(), codec );
+        auto loaded = chunked.read();
+        EXPECT_TRUE( (loaded == h) );
+    }
+
+    // the compression reduces the size of regular data
+    TemporaryFile raw("chunked", "raw");
+    TemporaryFile compressed("chunked", "compressed");
+    Holor<int32_t, 2> h{std::array<size_t, 2>{256, 256}};
+    for (size_t i = 0; i < 256; i++){
+        for (size_t j = 0; j < 256; j++){
+            h(i, j) = static_cast<int32_t>(i + j);
+        }
+    }
+    save_chunked(raw.path_, h, {64, 64}, ChunkCodec::none);
+    save_chunked(compressed.path_, h, {64, 64});
+    EXPECT_LT( 4*std::filesystem::file_size(compressed.path_), std::filesystem::file_size(raw.path_) );
+    EXPECT_TRUE( ((ChunkedHolorFile<int32_t, 2>(compressed.path_).read()) == h) );
+
+    // views and mapped containers can be written
+    TemporaryFile view("chunked", "view");
+    save_chunked(view.path_, h(range{200, 10, -3}, range{5, 250}), {16, 100});
+    EXPECT_TRUE( ((ChunkedHolorFile<int32_t, 2>(view.path_).read()) == (h(range{200, 10, -3}, range{5, 250}))) );
+
+    TemporaryFile mapped_file("chunked", "mapped_source");
+    TemporaryFile mapped_chunked("chunked", "mapped");
+    auto mapped = create_mapped<int32_t, 2>(mapped_file.path_, {40, 30});
+    fill_pattern(mapped);
+    save_chunked(mapped_chunked.path_, mapped, {8, 8});
+    auto loaded = ChunkedHolorFile<int32_t, 2>(mapped_chunked.path_).read();
+    EXPECT_TRUE( std::equal(loaded.begin(), loaded.end(), mapped.begin()) );
+}
+
+
+TEST(TestChunked, CheckPartialReads){
+    TemporaryFile file("chunked", "partial");
+    Holor<float, 3> h{std::array<size_t, 3>{13, 7, 10}};
+    fill_pattern(h);
+    save_chunked(file.path_, h, {4, 3, 4});
+    ChunkedHolorFile<float, 3> chunked(file.path_);
+
+    EXPECT_TRUE( ((chunked.read(range{2, 9}, range{0, 6}, range{3, 8})) == (Holor<float, 3>(h(range{2, 9}, range{0, 6}, range{3, 8})))) );
+    EXPECT_TRUE( ((chunked.read(range{12, 1, -3}, 2, range{0, 9, 2})) == (Holor<float, 2>(h(range{12, 1, -3}, 2, range{0, 9, 2})))) );
+    EXPECT_TRUE( ((chunked.read(5, range{6, 0, -1}, 9)) == (Holor<float, 1>(h(5, range{6, 0, -1}, 9)))) );
+    EXPECT_TRUE( ((chunked.read(range{0, 12, 6}, range{1, 6, 5}, range{0, 9, 9})) == (Holor<float, 3>(h(range{0, 12, 6}, range{1, 6, 5}, range{0, 9, 9})))) );
+
+    // only the chunks that overlap with the slice are decompressed
+    chunked.clear_cache();
+    const auto before = chunked.statistics();
+    auto row = chunked.read(5, 4, range{0, 9});
+    EXPECT_TRUE( (row == (Holor<float, 1>(h(5, 4, range{0, 9})))) );
+    EXPECT_EQ( chunked.statistics().misses_ - before.misses_, 3 );
+
+    // a step larger than the chunks skips the chunks in between
+    chunked.clear_cache();
+    const auto skipped = chunked.statistics();
+    auto column = chunked.read(range{0, 12, 12}, 0, 0);
+    EXPECT_TRUE( (column == (Holor<float, 1>(h(range{0, 12, 12}, 0, 0)))) );
+    EXPECT_EQ( chunked.statistics().misses_ - skipped.misses_, 2 );
+
+    EXPECT_THROW( chunked.read(range{0, 13}, 0, 0), holor::exception::HolorRuntimeError );
+    EXPECT_THROW( chunked.read(0, 7, range{0, 1}), holor::exception::HolorRuntimeError );
+}
+
+
+TEST(TestChunked, CheckCache){
+    TemporaryFile file("chunked", "cache");
+    Holor<int16_t, 2> h{std::array<size_t, 2>{20, 20}};
+    fill_pattern(h);
+    save_chunked(file.path_, h, {10, 10});
+
+    // the cache holds two chunks of 10x10 elements
+    ChunkedHolorFile<int16_t, 2> chunked(file.path_, 2*100*sizeof(int16_t));
+    chunked.read(range{0, 9}, range{0, 9});
+    chunked.read(range{0, 9}, range{10, 19});
+    EXPECT_EQ( chunked.statistics().misses_, 2 );
+    EXPECT_EQ( chunked.statistics().bytes_, 400 );
+    chunked.read(range{2, 3}, range{2, 3});
+    EXPECT_EQ( chunked.statistics().hits_, 1 );
+
+    // the least recently used chunk is evicted
+    chunked.read(range{10, 19}, range{0, 9});
+    chunked.read(range{0, 9}, range{0, 9});
+    EXPECT_EQ( chunked.statistics().hits_, 2 );
+    chunked.read(range{0, 9}, range{10, 19});
+    EXPECT_EQ( chunked.statistics().misses_, 4 );
+    EXPECT_EQ( chunked.statistics().bytes_, 400 );
+
+    chunked.set_cache_capacity(200);
+    EXPECT_EQ( chunked.cache_capacity(), 200 );
+    EXPECT_EQ( chunked.statistics().bytes_, 200 );
+    chunked.clear_cache();
+    EXPECT_EQ( chunked.statistics().bytes_, 0 );
+    EXPECT_TRUE( (chunked.read() == h) );
+}
+
+
+TEST(TestChunked, CheckWriter){
+    TemporaryFile file("chunked", "writer");
+    {
+        ChunkedHolorWriter<uint8_t, 2> writer(file.path_, {5, 7}, {2, 4});
+        EXPECT_EQ( (writer.grid()), (std::array<size_t, 2>{3, 2}) );
+        EXPECT_EQ( (writer.chunk_extent({2, 1})), (std::array<size_t, 2>{1, 3}) );
+        Holor<uint8_t, 2> tile{std::array<size_t, 2>{1, 3}};
+        tile(0, 0) = 1;
+        tile(0, 1) = 2;
+        tile(0, 2) = 3;
+        writer.write_chunk({2, 1}, tile);
+        Holor<uint8_t, 2> wrong{std::array<size_t, 2>{2, 4}};
+        EXPECT_THROW( writer.write_chunk({2, 1}, wrong), holor::exception::HolorRuntimeError );
+        EXPECT_THROW( writer.write_chunk({3, 0}, wrong), holor::exception::HolorRuntimeError );
+        // the file cannot be read until the writer is closed
+        EXPECT_THROW( (ChunkedHolorFile<uint8_t, 2>(file.path_)), holor::exception::HolorRuntimeError );
+    }
+
+    // the chunks that have not been written are zeros
+    ChunkedHolorFile<uint8_t, 2> chunked(file.path_);
+    auto loaded = chunked.read();
+    Holor<uint8_t, 2> expected{std::array<size_t, 2>{5, 7}};
+    std::fill(expected.begin(), expected.end(), 0);
+    expected(4, 4) = 1;
+    expected(4, 5) = 2;
+    expected(4, 6) = 3;
+    EXPECT_TRUE( (loaded == expected) );
+}
+
+
+TEST(TestChunked, CheckErrors){
+    TemporaryFile file("chunked", "errors");
+    Holor<float, 2> h{std::array<size_t, 2>{8, 8}};
+    fill_pattern(h);
+    save_chunked(file.path_, h, {4, 4});
+    EXPECT_THROW( (ChunkedHolorFile<double, 2>(file.path_)), holor::exception::HolorRuntimeError );
+    EXPECT_THROW( (ChunkedHolorFile<float, 3>(file.path_)), holor::exception::HolorRuntimeError );
+    EXPECT_THROW( (ChunkedHolorFile<float, 2>(file.path_.string() + ".missing")), holor::exception::HolorRuntimeError );
+    EXPECT_THROW( (save_chunked(file.path_, h, {0, 4})), holor::exception::HolorRuntimeError );
+
+    // a corrupted chunk is detected when it is read
+    save_chunked(file.path_, h, {4, 4});
+    {
+        impl::File corrupt(file.path_, impl::File::update);
+        const unsigned char garbage[4] = {0xff, 0xff, 0xff, 0xff};
+        corrupt.pwrite_all(garbage, 4, impl::ChunkedHeader<2>::size());
+    }
+    ChunkedHolorFile<float, 2> chunked(file.path_);
+    EXPECT_THROW( chunked.read(range{0, 3}, range{0, 3}), holor::exception::HolorRuntimeError );
+    EXPECT_TRUE( ((chunked.read(range{4, 7}, range{4, 7})) == (Holor<float, 2>(h(range{4, 7}, range{4, 7})))) );
+}
+
+
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,289 @@
+// This file is part of Holor, a C++ header-only template library for multi-dimensional containers
+
+// Copyright 2020-2022 Carlo Masone
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to 
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is 
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER 
+// DEALINGS IN THE SOFTWARE.
+
+
+
+
+#include <complex>
+#include <numeric>
+#include <vector>
+#include <holor/holor_full.h>
+#include <gtest/gtest.h>
+#include "test_utils.h"
+
+using namespace holor;
+
+
+
+/*=================================================================================
+                                Utilities
+=================================================================================*/
+/*!
+ * reference matrix product C = alpha*A*B + beta*C, with the matrices given by pointers and strides
+ */
+template<typename T>
+void reference_gemm(size_t m, size_t n, size_t k, T alpha, const T* a, std::ptrdiff_t rsa, std::ptrdiff_t csa, const T* b, std::ptrdiff_t rsb, std::ptrdiff_t csb, T beta, T* c, std::ptrdiff_t rsc, std::ptrdiff_t csc){
+    for (size_t i = 0; i < m; i++){
+        for (size_t j = 0; j < n; j++){
+            T sum{};
+            for (size_t p = 0; p < k; p++){
+                sum += a[i*rsa + p*csa]*b[p*rsb + j*csb];
+            }
+            c[i*rsc + j*csc] = alpha*sum + beta*c[i*rsc + j*csc];
+        }
+    }
+}
+
+template<typename T, ExecutionPolicy Policy>
+void check_gemm(const Policy& policy, size_t m, size_t n, size_t k, bool transpose_a, bool transpose_b, T alpha, T beta){
+    std::vector<T> a(m*k), b(k*n), c(m*n), expected(m*n);
+    int value = 0;
+    for (auto* v : {&a, &b, &c}){
+        for (auto& x : *v){
+            x = static_cast<T>(value%7 - 3);
+            value += 3;
+        }
+    }
+    expected = c;
+    const std::ptrdiff_t rsa = transpose_a ? 1 : k, csa = transpose_a ? m : 1;
+    const std::ptrdiff_t rsb = transpose_b ? 1 : n, csb = transpose_b ? k : 1;
+    impl::gemm(policy, m, n, k, alpha, a.data(), rsa, csa, b.data(), rsb, csb, beta, c.data(), n, 1);
+    reference_gemm(m, n, k, alpha, a.data(), rsa, csa, b.data(), rsb, csb, beta, expected.data(), n, 1);
+    EXPECT_EQ(c, expected);
+}
+
+
+
+/*=================================================================================
+                                Tests
+=================================================================================*/
+TEST(TestContraction, CheckGemm){
+    // sizes that are not multiples of the blocks, and depths that span several panels
+    for (auto [m, n, k] : {std::array<size_t, 3>{1, 1, 1}, std::array<size_t, 3>{7, 5, 3}, std::array<size_t, 3>{37, 53, 300}, std::array<size_t, 3>{200, 70, 9}, std::array<size_t, 3>{13, 1100, 20}}){
+        for (bool ta : {false, true}){
+            for (bool tb : {false, true}){
+                check_gemm<double>(execution::seq, m, n, k, ta, tb, 1.0, 0.0);
+                check_gemm<float>(execution::seq, m, n, k, ta, tb, 2.0f, -1.0f);
+            }
+        }
+        check_gemm<int32_t>(execution::seq, m, n, k, false, false, 1, 1);
+        check_gemm<int64_t>(execution::seq, m, n, k, true, false, 3, 0);
+        check_gemm<double>(execution::par.with_threads(4), m, n, k, false, true, 1.0, 0.0);
+    }
+    check_gemm<double>(execution::par.with_threads(3), 300, 300, 300, false, false, 1.0, 2.0);
+    check_gemm<float>(execution::par, 20, 300, 600, true, true, 1.0f, 0.0f);
+
+    // the elements of C are not read when beta is zero
+    std::vector<double> a(6, 1.0), b(6, 1.0), c(4, std::numeric_limits<double>::quiet_NaN());
+    impl::gemm(execution::seq, 2, 2, 3, 1.0, a.data(), 3, 1, b.data(), 2, 1, 0.0, c.data(), 2, 1);
+    EXPECT_EQ(c, std::vector<double>(4, 3.0));
+
+    // elements that are not vectorizable use the scalar micro-kernel
+    using complex = std::complex<double>;
+    std::vector<complex> ca(12), cb(12), cc(9), ce(9);
+    for (size_t i = 0; i < 12; i++){
+        ca[i] = complex(i, 1.0);
+        cb[i] = complex(1.0, -double(i));
+    }
+    impl::gemm(execution::seq, 3, 3, 4, complex(1.0), ca.data(), 4, 1, cb.data(), 3, 1, complex(0.0), cc.data(), 3, 1);
+    reference_gemm(3, 3, 4, complex(1.0), ca.data(), 4, 1, cb.data(), 3, 1, complex(0.0), ce.data(), 3, 1);
+    EXPECT_EQ(cc, ce);
+}
+
+
+TEST(TestContraction, CheckMatmul){
+    Holor<double, 2> a{{1, 2, 3}, {4, 5, 6}};
+    Holor<double, 2> b{{1, 2}, {3, 4}, {5, 6}};
+    Holor<double, 2> c(std::vector<size_t>{2, 2});
+    matmul(a, b, c);
+    EXPECT_TRUE((c == Holor<double, 2>{{22, 28}, {49, 64}}));
+    matmul(a, b, c, 2.0, -1.0);
+    EXPECT_TRUE((c == Holor<double, 2>{{22, 28}, {49, 64}}));
+    EXPECT_TRUE((matmul(b, a) == Holor<double, 2>{{9, 12, 15}, {19, 26, 33}, {29, 40, 51}}));
+
+    // transposed and strided views, and a result that is a view of a larger container
+    for (size_t n : {5, 67, 300}){
+        Holor<float, 2> x(std::vector<size_t>{2*n, n + 3});
+        Holor<float, 2> y(std::vector<size_t>{n + 1, 2*n});
+        fill_pattern(x, 1, 7, 5);
+        fill_pattern(y, 2, 7, 5);
+        auto xs = x(range{0, 2*n - 1, 2}, range{1, n});                   // n x n, strided rows
+        auto yt = transpose_view(y, std::array<size_t, 2>{1, 0});          // 2n x (n+1)
+        auto ys = yt(range{1, n}, range{0, n});                            // n x (n+1), unit row stride
+        Holor<float, 2> big(std::vector<size_t>{n + 2, 3*n});
+        fill_pattern(big, 3, 7, 5);
+        const Holor<float, 2> original(big);
+        auto cs = big(range{1, n}, range{0, 3*n - 1, 3});                  // n x n, strided columns
+        auto ct = transpose_view(cs, std::array<size_t, 2>{1, 0});
+        auto expected = contract<1>(xs, ys, {1}, {0});
+        Holor<float, 2> result(std::vector<size_t>{n, n + 1});
+        matmul(xs, ys, result);
+        EXPECT_TRUE((result == expected));
+        matmul(execution::par.with_threads(3), xs, ys, result);
+        EXPECT_TRUE((result == expected));
+
+        auto square = ys(range{0, n - 1}, range{0, n - 1});
+        auto expected_square = contract<1>(xs, square, {1}, {0});
+        matmul(xs, square, ct, 1.0f, 1.0f);
+        for (size_t i = 0; i < n; i++){
+            for (size_t j = 0; j < n; j++){
+                EXPECT_EQ(ct(j, i), expected_square(j, i) + original(1 + i, 3*j));
+            }
+        }
+        // the elements of the container outside the view are unchanged
+        EXPECT_EQ(big(0, 0), original(0, 0));
+        EXPECT_EQ(big(1, 1), original(1, 1));
+        EXPECT_EQ(big(n + 1, 3*n - 1), original(n + 1, 3*n - 1));
+    }
+
+    EXPECT_THROW(matmul(a, a, c), holor::exception::HolorRuntimeError);
+    EXPECT_THROW(matmul(b, a, c), holor::exception::HolorRuntimeError);
+}
+
+
+TEST(TestContraction, CheckContract){
+    // matrix product
+    Holor<double, 2> a{{1, 2, 3}, {4, 5, 6}};
+    Holor<double, 2> b{{1, 2}, {3, 4}, {5, 6}};
+    EXPECT_TRUE((contract<1>(a, b, {1}, {0}) == Holor<double, 2>{{22, 28}, {49, 64}}));
+    EXPECT_TRUE((contract<1>(b, a, {1}, {0}) == Holor<double, 2>{{9, 12, 15}, {19, 26, 33}, {29, 40, 51}}));
+    EXPECT_TRUE((contract<1>(a, a, {1}, {1}) == Holor<double, 2>{{14, 32}, {32, 77}}));
+    EXPECT_EQ(contract<2>(a, a, {0, 1}, {0, 1}), 91.0);
+    auto outer = contract<0>(a, b, {}, {});
+    EXPECT_EQ(outer.lengths(), (std::array<size_t, 4>{2, 3, 3, 2}));
+    EXPECT_EQ(outer(1, 2, 2, 1), 36.0);
+
+    // contraction of 3D containers over two pairs of dimensions, in different orders
+    Holor<int, 3> x(std::vector<size_t>{4, 5, 6});
+    Holor<int, 3> y(std::vector<size_t>{6, 3, 5});
+    fill_pattern(x, 0, 7, 5);
+    fill_pattern(y, 1, 7, 5);
+    Holor<int, 2> expected(std::vector<size_t>{4, 3});
+    for (size_t i = 0; i < 4; i++){
+        for (size_t j = 0; j < 3; j++){
+            int sum = 0;
+            for (size_t p = 0; p < 5; p++){
+                for (size_t q = 0; q < 6; q++){
+                    sum += x(i, p, q)*y(q, j, p);
+                }
+            }
+            expected(i, j) = sum;
+        }
+    }
+    EXPECT_TRUE((contract<2>(x, y, {1, 2}, {2, 0}) == expected));
+    EXPECT_TRUE((contract<2>(x, y, {2, 1}, {0, 2}) == expected));
+    EXPECT_TRUE((contract<2>(execution::par.with_threads(3), x, y, {1, 2}, {2, 0}) == expected));
+
+    // strided and transposed views, that are packed before the product
+    Holor<double, 2> big(std::vector<size_t>{40, 50});
+    fill_pattern(big, 2, 7, 5);
+    auto strided = big(range{1, 39, 2}, range{0, 48, 3});
+    Holor<double, 2> other(std::vector<size_t>{30, strided.length(1)});
+    fill_pattern(other, 3, 7, 5);
+    auto transposed = transpose_view(other, std::array<size_t, 2>{1, 0});
+    auto product = contract<1>(strided, transposed, {1}, {0});
+    ASSERT_EQ(product.lengths(), (std::array<size_t, 2>{strided.length(0), 30}));
+    for (size_t i = 0; i < product.length(0); i++){
+        for (size_t j = 0; j < product.length(1); j++){
+            double sum = 0;
+            for (size_t p = 0; p < strided.length(1); p++){
+                sum += strided(i, p)*transposed(p, j);
+            }
+            EXPECT_EQ(product(i, j), sum);
+        }
+    }
+
+    // invalid dimensions
+    EXPECT_THROW((contract<1>(a, b, {0}, {0})), holor::exception::HolorRuntimeError);
+    EXPECT_THROW((contract<1>(a, b, {2}, {0})), holor::exception::HolorRuntimeError);
+    EXPECT_THROW((contract<2>(a, b, {1, 1}, {0, 1})), holor::exception::HolorRuntimeError);
+}
+
+
+TEST(TestContraction, CheckEinsum){
+    Holor<double, 2> a{{1, 2, 3}, {4, 5, 6}};
+    Holor<double, 2> b{{1, 2}, {3, 4}, {5, 6}};
+    EXPECT_TRUE((einsum<2>("ij,jk->ik", a, b) == contract<1>(a, b, {1}, {0})));
+    EXPECT_TRUE((einsum<2>("ij, jk -> ki", a, b) == Holor<double, 2>{{22, 49}, {28, 64}}));
+    EXPECT_EQ(einsum<0>("ij,ij->", a, a), 91.0);
+
+    Holor<double, 1> u{1, 2, 3};
+    Holor<double, 1> v{4, 5};
+    EXPECT_TRUE((einsum<2>("i,j->ji", u, v) == Holor<double, 2>{{4, 8, 12}, {5, 10, 15}}));
+    EXPECT_EQ(einsum<0>("i,i->", u, u), 14.0);
+    EXPECT_TRUE((einsum<1>("ij,j->i", a, u) == Holor<double, 1>{14, 32}));
+
+    // batch of matrix products, with the batch dimension in different positions
+    Holor<int, 3> x(std::vector<size_t>{7, 4, 5});
+    Holor<int, 3> y(std::vector<size_t>{5, 7, 3});
+    fill_pattern(x, 3, 7, 5);
+    fill_pattern(y, 4, 7, 5);
+    Holor<int, 3> expected(std::vector<size_t>{7, 4, 3});
+    for (size_t n = 0; n < 7; n++){
+        for (size_t i = 0; i < 4; i++){
+            for (size_t j = 0; j < 3; j++){
+                int sum = 0;
+                for (size_t p = 0; p < 5; p++){
+                    sum += x(n, i, p)*y(p, n, j);
+                }
+                expected(n, i, j) = sum;
+            }
+        }
+    }
+    EXPECT_TRUE((einsum<3>("bik,kbj->bij", x, y) == expected));
+    EXPECT_TRUE((einsum<3>(execution::par.with_threads(4), "bik,kbj->bij", x, y) == expected));
+    EXPECT_TRUE((einsum<3>("bik,kbj->jbi", x, y) == transpose(expected, std::array<size_t, 3>{2, 0, 1})));
+
+    // free dimensions of an operand that are not adjacent in the result
+    Holor<int, 3> z(std::vector<size_t>{3, 4, 5});
+    Holor<int, 2> w(std::vector<size_t>{5, 6});
+    fill_pattern(z, 5, 7, 5);
+    fill_pattern(w, 6, 7, 5);
+    auto r = einsum<3>("abc,cd->adb", z, w);
+    ASSERT_EQ(r.lengths(), (std::array<size_t, 3>{3, 6, 4}));
+    for (size_t i = 0; i < 3; i++){
+        for (size_t j = 0; j < 6; j++){
+            for (size_t k = 0; k < 4; k++){
+                int sum = 0;
+                for (size_t p = 0; p < 5; p++){
+                    sum += z(i, k, p)*w(p, j);
+                }
+                EXPECT_EQ(r(i, j, k), sum);
+            }
+        }
+    }
+
+    // invalid subscripts
+    EXPECT_THROW((einsum<2>("ij,jk", a, b)), holor::exception::HolorRuntimeError);
+    EXPECT_THROW((einsum<2>("ij,jk->ikl", a, b)), holor::exception::HolorRuntimeError);
+    EXPECT_THROW((einsum<2>("ii,jk->jk", a, b)), holor::exception::HolorRuntimeError);
+    EXPECT_THROW((einsum<2>("ij,kl->ik", a, b)), holor::exception::HolorRuntimeError);
+    EXPECT_THROW((einsum<2>("ij,ik->jk", a, b)), holor::exception::HolorRuntimeError);
+    EXPECT_THROW((einsum<1>("ij,jk->x", a, b)), holor::exception::HolorRuntimeError);
+}
+
+
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
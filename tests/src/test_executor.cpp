@@ -0,0 +1,217 @@
+// This file is part of Holor, a C++ header-only template library for multi-dimensional containers
+
+// Copyright 2020-2022 Carlo Masone
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to 
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is 
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER 
+// DEALINGS IN THE SOFTWARE.
+
+
+
+#include <algorithm>
+#include <atomic>
+#include <numeric>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include <holor/holor_full.h>
+#include <gtest/gtest.h>
+
+using namespace holor;
+
+
+
+/*=================================================================================
+                                Tests
+=================================================================================*/
+TEST(TestExecutor, CheckDeque){
+    impl::WorkStealingDeque deque;
+    std::vector<impl::Task> tasks(10);
+    EXPECT_EQ(deque.pop(), nullptr);
+    EXPECT_EQ(deque.steal(), nullptr);
+    for (auto& task : tasks){
+        EXPECT_TRUE(deque.push(&task));
+    }
+    EXPECT_EQ(deque.pop(), &tasks[9]);
+    EXPECT_EQ(deque.steal(), &tasks[0]);
+    EXPECT_EQ(deque.steal(), &tasks[1]);
+    EXPECT_EQ(deque.pop(), &tasks[8]);
+    for (size_t i = 2; i < 8; i++){
+        EXPECT_EQ(deque.pop(), &tasks[9-i]);
+    }
+    EXPECT_EQ(deque.pop(), nullptr);
+    EXPECT_TRUE(deque.empty());
+
+    // concurrent thieves take every task exactly once
+    std::vector<impl::Task> many(impl::WorkStealingDeque::capacity);
+    for (auto& task : many){
+        EXPECT_TRUE(deque.push(&task));
+    }
+    EXPECT_FALSE(deque.push(&tasks[0]));
+    std::vector<std::atomic<int>> taken(many.size());
+    auto take = [&](bool owner){
+        while (auto task = (owner ? deque.pop() : deque.steal())){
+            taken[task - many.data()]++;
+        }
+    };
+    std::vector<std::thread> thieves;
+    for (int i = 0; i < 3; i++){
+        thieves.emplace_back(take, false);
+    }
+    take(true);
+    for (auto& thief : thieves){
+        thief.join();
+    }
+    while (auto task = deque.steal()){
+        taken[task - many.data()]++;
+    }
+    EXPECT_TRUE(std::ranges::all_of(taken, [](const auto& t){ return t.load() == 1; }));
+}
+
+
+TEST(TestExecutor, CheckTaskGroup){
+    executor exec(4);
+    EXPECT_EQ(exec.concurrency(), 4);
+    std::atomic<int> count = 0;
+    {
+        task_group group(exec);
+        for (int i = 0; i < 1000; i++){
+            group.run([&]{ count++; });
+        }
+        group.wait();
+        EXPECT_EQ(count, 1000);
+    }
+
+    // the first exception is rethrown, and the other tasks are executed anyway
+    task_group group(exec);
+    for (int i = 0; i < 100; i++){
+        group.run([&, i]{
+            count++;
+            if (i == 50){
+                throw std::runtime_error("task failure");
+            }
+        });
+    }
+    EXPECT_THROW(group.wait(), std::runtime_error);
+    EXPECT_EQ(count, 1100);
+    EXPECT_NO_THROW(group.wait());
+}
+
+
+TEST(TestExecutor, CheckParallelFor){
+    for (size_t threads : {1, 2, 4}){
+        executor exec(threads, true);
+        std::vector<int> counts(10000, 0);
+        exec.parallel_for(0, counts.size(), 16, [&](size_t first, size_t last){
+            EXPECT_LE(last - first, 16);
+            for (size_t i = first; i < last; i++){
+                counts[i]++;
+            }
+        });
+        EXPECT_TRUE(std::ranges::all_of(counts, [](int c){ return c == 1; }));
+
+        // nested and unbalanced loops
+        std::vector<std::atomic<size_t>> sums(64);
+        exec.parallel_for(0, sums.size(), 1, [&](size_t first, size_t last){
+            for (size_t i = first; i < last; i++){
+                exec.parallel_for(0, 100*i, 7, [&](size_t a, size_t b){
+                    sums[i] += b - a;
+                });
+            }
+        });
+        for (size_t i = 0; i < sums.size(); i++){
+            EXPECT_EQ(sums[i], 100*i);
+        }
+
+        EXPECT_THROW(exec.parallel_for(0, 1000, 10, [](size_t first, size_t){
+            if (first >= 500){
+                throw std::runtime_error("loop failure");
+            }
+        }), std::runtime_error);
+    }
+}
+
+
+TEST(TestExecutor, CheckParallelForSlices){
+    executor exec(4);
+    Holor<int, 3> h(std::vector<size_t>{37, 5, 6});
+    std::ranges::fill(h, 0);
+
+    parallel_for_slices<0>(exec, h, [](HolorRef<int, 3> slice, size_t first){
+        EXPECT_LE(slice.length(0), 3);
+        for (size_t i = 0; i < slice.length(0); i++){
+            auto row = slice.slice<0>(i);
+            std::ranges::fill(row, static_cast<int>(first + i));
+        }
+    });
+    for (size_t i = 0; i < 37; i++){
+        EXPECT_TRUE(std::ranges::all_of(h.slice<0>(i), [i](int x){ return x == static_cast<int>(i); }));
+    }
+
+    parallel_for_slices<2>(exec, h, [](HolorRef<int, 3> slice){
+        for (auto& x : slice){
+            x += 1;
+        }
+    }, 1);
+    EXPECT_EQ(std::accumulate(h.cbegin(), h.cend(), 0), 30*(36*37/2) + 37*30);
+
+    // a dimension of length one is passed as a whole
+    Holor<int, 2> row(std::vector<size_t>{1, 10});
+    std::ranges::fill(row, 0);
+    size_t calls = 0;
+    parallel_for_slices<0>(row, [&](HolorRef<int, 2> slice){
+        calls++;
+        EXPECT_EQ(slice.length(0), 1);
+        std::ranges::fill(slice, 3);
+    });
+    EXPECT_EQ(calls, 1);
+    EXPECT_EQ(std::accumulate(row.cbegin(), row.cend(), 0), 30);
+
+    // a single worker runs the slices in order, and slices of a single index are allowed
+    executor single(1);
+    Holor<int, 2> small(std::vector<size_t>{4, 2});
+    std::ranges::fill(small, 0);
+    std::vector<size_t> firsts;
+    parallel_for_slices<0>(single, small, [&](HolorRef<int, 2> slice, size_t first){
+        EXPECT_EQ(slice.length(1), 2);
+        firsts.push_back(first);
+        for (size_t i = 0; i < slice.length(0); i++){
+            std::ranges::fill(slice.row(i), static_cast<int>(first + i));
+        }
+    });
+    EXPECT_TRUE( (small == Holor<int, 2>{ {0, 0}, {1, 1}, {2, 2}, {3, 3} }) );
+    EXPECT_TRUE(std::ranges::is_sorted(firsts));
+    firsts.clear();
+    parallel_for_slices<0>(single, small, [&](HolorRef<int, 2> slice, size_t first){
+        EXPECT_EQ(slice.length(0), 1);
+        firsts.push_back(first);
+    }, 1);
+    EXPECT_EQ(firsts, (std::vector<size_t>{0, 1, 2, 3}));
+    calls = 0;
+    parallel_for_slices<1>(single, small, [&](HolorRef<int, 2> slice){
+        calls++;
+        EXPECT_LE(slice.length(1), 1);
+    }, 1);
+    EXPECT_EQ(calls, 2);
+}
+
+
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
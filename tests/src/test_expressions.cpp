@@ -0,0 +1,202 @@
+// This file is part of Holor, a C++ header-only template library for multi-dimensional containers
+
+// Copyright 2020-2022 Carlo Masone
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to 
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is 
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER 
+// DEALINGS IN THE SOFTWARE.
+
+
+
+#include <algorithm>
+#include <array>
+#include <vector>
+#include <cmath>
+#include <type_traits>
+#include <holor/holor_full.h>
+#include <gtest/gtest.h>
+
+using namespace holor;
+
+
+/*=================================================================================
+                                Expression Types
+=================================================================================*/
+TEST(TestExpressions, CheckTypes){
+    Holor<double, 2> a{ {1,2,3}, {4,5,6} };
+    Holor<int, 2> b{ {1,2,3}, {4,5,6} };
+
+    auto e1 = a + a;
+    EXPECT_TRUE( (HolorExpression<decltype(e1)>) );
+    EXPECT_FALSE( (HolorType<decltype(e1)>) );
+    EXPECT_EQ( decltype(e1)::dimensions, 2 );
+    EXPECT_TRUE( (std::is_same_v<decltype(e1)::value_type, double>) );
+    EXPECT_EQ( e1.lengths(), (std::array<size_t,2>{2,3}) );
+
+    auto e2 = b * 2;
+    EXPECT_TRUE( (std::is_same_v<decltype(e2)::value_type, int>) );
+    auto e3 = b * 0.5;
+    EXPECT_TRUE( (std::is_same_v<decltype(e3)::value_type, double>) );
+    auto e4 = sqrt(a) + exp(a - 1.0);
+    EXPECT_TRUE( (HolorExpression<decltype(e4)>) );
+
+    // operands with different lengths
+    Holor<double, 2> c{ {1,2}, {3,4} };
+    EXPECT_THROW( a + c, holor::exception::HolorRuntimeError );
+    EXPECT_THROW( (a + a) * (c - 1.0), holor::exception::HolorRuntimeError );
+}
+
+
+TEST(TestExpressions, CheckBroadcasting){
+    Holor<double, 2> x{ {1,2,3}, {4,5,6} };
+    Holor<double, 1> bias{10,20,30};
+    Holor<double, 2> column{ {100}, {200} };
+
+    auto e = x + bias;
+    EXPECT_EQ( decltype(e)::dimensions, 2 );
+    EXPECT_EQ( e.lengths(), (std::array<size_t,2>{2,3}) );
+    EXPECT_TRUE( (Holor<double, 2>(e) == Holor<double, 2>{ {11,22,33}, {14,25,36} }) );
+    EXPECT_TRUE( (Holor<double, 2>(bias - x) == Holor<double, 2>{ {9,18,27}, {6,15,24} }) );
+    EXPECT_TRUE( (Holor<double, 2>(x*2.0 + column) == Holor<double, 2>{ {102,104,106}, {208,210,212} }) );
+
+    // both operands are expanded, and the result can have more dimensions than the operands
+    EXPECT_TRUE( (Holor<double, 2>(column + bias) == Holor<double, 2>{ {110,120,130}, {210,220,230} }) );
+    Holor<double, 3> cube(std::vector<size_t>{4, 2, 3});
+    cube = x + Holor<double, 3>(std::vector<size_t>{4, 1, 1}) * 0.0;
+    for (size_t i = 0; i < 4; i++){
+        EXPECT_TRUE( (cube.slice<0>(i) == x) );
+    }
+
+    // normalization of the rows of a matrix with broadcast statistics
+    Holor<double, 2> normalized = (x - mean<1>(x, {0})) / sqrt(var<1>(x, {0}));
+    EXPECT_TRUE( (normalized == Holor<double, 2>{ {-1,-1,-1}, {1,1,1} }) );
+
+    // strided and transposed views are broadcast with their own strides
+    Holor<double, 2> big{ {1,2,3,4}, {5,6,7,8}, {9,10,11,12} };
+    auto t = transpose_view(big);
+    Holor<double, 2> shifted = t + big.col(0);
+    EXPECT_TRUE( (shifted == Holor<double, 2>{ {2,10,18}, {3,11,19}, {4,12,20}, {5,13,21} }) );
+
+    // incompatible lengths
+    EXPECT_THROW( (x + Holor<double, 1>{1,2}), holor::exception::HolorRuntimeError );
+    EXPECT_THROW( (x + Holor<double, 2>{ {1}, {2}, {3} }), holor::exception::HolorRuntimeError );
+}
+
+/*=================================================================================
+                                Evaluation Tests
+=================================================================================*/
+TEST(TestExpressions, CheckArithmetic){
+    Holor<double, 2> a{ {1,2,3}, {4,5,6} };
+    Holor<double, 2> b{ {6,5,4}, {3,2,1} };
+
+    {
+        Holor<double, 2> c = a + b;
+        EXPECT_TRUE( (c == Holor<double, 2>{ {7,7,7}, {7,7,7} }) );
+        Holor<double, 2> d = a - b;
+        EXPECT_TRUE( (d == Holor<double, 2>{ {-5,-3,-1}, {1,3,5} }) );
+        Holor<double, 2> e = a * b;
+        EXPECT_TRUE( (e == Holor<double, 2>{ {6,10,12}, {12,10,6} }) );
+        Holor<double, 2> f = a / b;
+        EXPECT_TRUE( (f == Holor<double, 2>{ {1.0/6,2.0/5,3.0/4}, {4.0/3,5.0/2,6.0/1} }) );
+        Holor<double, 2> g = -a;
+        EXPECT_TRUE( (g == Holor<double, 2>{ {-1,-2,-3}, {-4,-5,-6} }) );
+    }
+
+    // scalars on both sides and compound expressions
+    {
+        Holor<double, 2> c = 2.0*a + b/2.0 - 1.0;
+        EXPECT_TRUE( (c == Holor<double, 2>{ {4,5.5,7}, {8.5,10,11.5} }) );
+        Holor<double, 2> d = 10.0 - (a + 1.0)*(b - a);
+        EXPECT_TRUE( (d == Holor<double, 2>{ {0,1,6}, {15,28,45} }) );
+        auto e = evaluate(1.0/(a*a));
+        EXPECT_TRUE( (std::is_same_v<decltype(e), Holor<double, 2>>) );
+        EXPECT_DOUBLE_EQ( e(1,1), 1.0/25 );
+    }
+
+    // math functions
+    {
+        Holor<double, 1> x{0.0, 0.25, 1.0, 4.0};
+        Holor<double, 1> y = sqrt(x) + exp(x) - abs(-x);
+        for (size_t i = 0; i < x.length(0); i++){
+            EXPECT_DOUBLE_EQ( y(i), std::sqrt(x(i)) + std::exp(x(i)) - x(i) );
+        }
+        Holor<double, 1> z = pow(x, 2.0) + map(x, [](double v){ return 3*v; });
+        for (size_t i = 0; i < x.length(0); i++){
+            EXPECT_DOUBLE_EQ( z(i), x(i)*x(i) + 3*x(i) );
+        }
+        Holor<double, 1> w = log(exp(x)) + sin(x)*sin(x) + cos(x)*cos(x) + tanh(x) - tan(x);
+        for (size_t i = 0; i < x.length(0); i++){
+            EXPECT_NEAR( w(i), x(i) + 1.0 + std::tanh(x(i)) - std::tan(x(i)), 1e-12 );
+        }
+    }
+}
+
+
+TEST(TestExpressions, CheckViewsAndAssignments){
+    Holor<int, 2> a{ {1,2,3,4}, {5,6,7,8}, {9,10,11,12} };
+    Holor<int, 2> b{ {1,1,1,1}, {2,2,2,2}, {3,3,3,3} };
+
+    // operands that are views with different layouts
+    {
+        Holor<int, 1> c = a.row(1) + b.row(2);
+        EXPECT_TRUE( (c == Holor<int, 1>{8,9,10,11}) );
+        Holor<int, 2> d = a(range(0,1), range(0,1)) * 2;
+        EXPECT_TRUE( (d == Holor<int, 2>{ {2,4}, {10,12} }) );
+        Holor<int, 2> e = a(range(0,2,2), range(3,0,-3)) + b(range(0,2,2), range(0,3,3));
+        EXPECT_TRUE( (e == Holor<int, 2>{ {5,2}, {15,12} }) );
+        Holor<int, 2> f = transpose_view(a) - transpose_view(b);
+        Holor<int, 2> g = a - b;
+        EXPECT_TRUE( (f == transpose(g)) );
+    }
+
+    // assignment into a Holor, in place or with resize
+    {
+        Holor<int, 2> c = a;
+        auto ptr = c.data();
+        c = c*2 + b;
+        EXPECT_EQ( c.data(), ptr );
+        EXPECT_TRUE( (c == Holor<int, 2>{ {3,5,7,9}, {12,14,16,18}, {21,23,25,27} }) );
+        Holor<int, 2> d;
+        d = a - b;
+        EXPECT_TRUE( (d == Holor<int, 2>{ {0,1,2,3}, {3,4,5,6}, {6,7,8,9} }) );
+    }
+
+    // assignment into a HolorRef writes the referenced elements
+    {
+        Holor<int, 2> c = a;
+        c.row(0) = a.row(2) - a.row(0);
+        EXPECT_TRUE( (c == Holor<int, 2>{ {8,8,8,8}, {5,6,7,8}, {9,10,11,12} }) );
+        auto col = c.col(3);
+        col = col * 10;
+        EXPECT_TRUE( (c == Holor<int, 2>{ {8,8,8,80}, {5,6,7,80}, {9,10,11,120} }) );
+        EXPECT_THROW( (c.row(0) = a.col(0) + 1), holor::exception::HolorRuntimeError );
+    }
+
+    // operands passed as rvalues are stored in the expression
+    {
+        auto e = Holor<int, 1>{1,2,3} + Holor<int, 1>{10,20,30};
+        Holor<int, 1> c = e * e;
+        EXPECT_TRUE( (c == Holor<int, 1>{121,484,1089}) );
+    }
+}
+
+
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -25,6 +25,7 @@
 #include <algorithm>
 #include <array>
 #include <vector>
+#include <cstdint>
 #include <holor/holor_full.h>
 #include <gtest/gtest.h>
 
@@ -204,6 +205,26 @@ TEST(TestHolor, CheckConstructors){
         EXPECT_DOUBLE_EQ(my_data[4], 5.5);
         EXPECT_DOUBLE_EQ(my_data[5], 6.6);
     }
+
+    //test for constructors with and without initialization of the elements
+    {
+        Holor<double,2> h1(std::vector<size_t>{3,4});
+        EXPECT_TRUE( std::all_of(h1.cbegin(), h1.cend(), [](double x){ return x == 0.0; }) );
+        Holor<double,2> h2(Layout<2>{3,4});
+        EXPECT_TRUE( std::all_of(h2.cbegin(), h2.cend(), [](double x){ return x == 0.0; }) );
+
+        Holor<double,2> h3(holor::uninitialized, std::vector<size_t>{3,4});
+        EXPECT_EQ(h3.layout(), (Layout<2>{3,4}));
+        EXPECT_EQ(h3.size(), 12);
+        Holor<double,2, AlignedAllocator<double>> h4(holor::uninitialized, Layout<2>{3,4});
+        EXPECT_EQ(h4.layout(), (Layout<2>{3,4}));
+        std::fill(h4.begin(), h4.end(), 1.5);
+        EXPECT_TRUE( std::all_of(h4.cbegin(), h4.cend(), [](double x){ return x == 1.5; }) );
+
+        // non trivial types are always value-initialized
+        Holor<std::vector<int>,1> h5(holor::uninitialized, std::array<size_t,1>{5});
+        EXPECT_TRUE( std::all_of(h5.cbegin(), h5.cend(), [](const auto& x){ return x.empty(); }) );
+    }
     
 };
 
@@ -269,6 +290,73 @@ TEST(TestHolor, Resize){
 }
 
 
+TEST(TestHolor, Append){
+    // single rows, slabs of rows and views of the container
+    {
+        Holor<int, 2> my_holor;
+        EXPECT_EQ(my_holor.capacity(), 0);
+        my_holor.append(Holor<int, 1>{1, 2, 3});
+        my_holor.append(Holor<int, 2>{ {4, 5, 6}, {7, 8, 9} });
+        EXPECT_EQ(my_holor.lengths(), (std::array<size_t, 2>{3, 3}));
+        EXPECT_TRUE( (my_holor == Holor<int, 2>{ {1, 2, 3}, {4, 5, 6}, {7, 8, 9} }) );
+        my_holor.append(my_holor.col(2));
+        my_holor.append(my_holor(range{2, 0, -2}, range{0, 2}));
+        EXPECT_TRUE( (my_holor == Holor<int, 2>{ {1, 2, 3}, {4, 5, 6}, {7, 8, 9}, {3, 6, 9}, {7, 8, 9}, {1, 2, 3} }) );
+        EXPECT_THROW( my_holor.append(Holor<int, 1>{1, 2}), holor::exception::HolorRuntimeError );
+        EXPECT_THROW( my_holor.append(Holor<int, 2>{ {1, 2} }), holor::exception::HolorRuntimeError );
+
+        // a slab without rows does not change the container
+        Holor<int, 2> empty(std::array<size_t, 2>{0, 3});
+        my_holor.append(empty);
+        EXPECT_EQ(my_holor.lengths(), (std::array<size_t, 2>{6, 3}));
+        Holor<int, 2> adopted;
+        adopted.append(empty);
+        EXPECT_EQ(adopted.lengths(), (std::array<size_t, 2>{0, 3}));
+        EXPECT_EQ(adopted.size(), 0);
+    }
+
+    // the capacity grows geometrically, and the strides do not change
+    {
+        Holor<float, 3> my_holor(std::array<size_t, 3>{0, 4, 5});
+        const auto strides = my_holor.strides();
+        size_t reallocations = 0;
+        const float* data = my_holor.data();
+        for (size_t i = 0; i < 1000; i++){
+            auto rows = my_holor.append_rows(1);
+            std::fill(rows.begin(), rows.end(), static_cast<float>(i));
+            if (my_holor.data() != data){
+                reallocations++;
+                data = my_holor.data();
+            }
+        }
+        EXPECT_EQ(my_holor.length(0), 1000);
+        EXPECT_GE(my_holor.capacity(), 1000);
+        EXPECT_LE(reallocations, 12);
+        EXPECT_EQ(my_holor.strides(), strides);
+        EXPECT_EQ(my_holor(999, 3, 4), 999.0f);
+        EXPECT_EQ(my_holor(500, 0, 0), 500.0f);
+
+        my_holor.reserve(3000);
+        EXPECT_GE(my_holor.capacity(), 3000);
+        data = my_holor.data();
+        my_holor.append_rows(2000);
+        EXPECT_EQ(my_holor.data(), data);
+        my_holor.shrink_to_fit();
+        EXPECT_EQ(my_holor.capacity(), 3000);
+        EXPECT_THROW( my_holor.append_rows(0), holor::exception::HolorRuntimeError );
+    }
+
+    // single elements
+    {
+        Holor<double, 1> my_holor;
+        for (int i = 0; i < 5; i++){
+            my_holor.append(i);
+        }
+        EXPECT_TRUE( (my_holor == Holor<double, 1>{0, 1, 2, 3, 4}) );
+    }
+}
+
+
 
 
 /*=================================================================================
@@ -394,6 +482,70 @@ TEST(TestHolor, CheckSlicing){
 
 
 
+/*=================================================================================
+                                Allocators Tests
+=================================================================================*/
+TEST(TestHolor, CheckAllocators){
+    // aliases and concepts
+    {
+        EXPECT_TRUE( (std::is_same_v<Holor<int, 2>::allocator_type, std::allocator<int>>) );
+        EXPECT_TRUE( (std::is_same_v<Holor<int, 2, AlignedAllocator<int>>::allocator_type, AlignedAllocator<int>>) );
+        EXPECT_TRUE( (HolorType<Holor<double, 3, AlignedAllocator<double, 128>>>) );
+        EXPECT_TRUE( (HolorType<Holor<double, 3, HugePageAllocator<double>>>) );
+    }
+
+    // aligned storage
+    {
+        Holor<double, 2, AlignedAllocator<double>> h1{ {1,2,3}, {4,5,6} };
+        EXPECT_EQ( reinterpret_cast<std::uintptr_t>(h1.data()) % 64, 0 );
+        Holor<float, 3, AlignedAllocator<float, 256>> h2(std::vector<size_t>{3, 5, 7});
+        EXPECT_EQ( reinterpret_cast<std::uintptr_t>(h2.data()) % 256, 0 );
+        h2.set_lengths(10, 10, 10);
+        EXPECT_EQ( reinterpret_cast<std::uintptr_t>(h2.data()) % 256, 0 );
+        auto h3 = h1;
+        EXPECT_EQ( reinterpret_cast<std::uintptr_t>(h3.data()) % 64, 0 );
+        EXPECT_TRUE( (h3 == h1) );
+    }
+
+    // huge pages are requested only for large buffers
+    {
+        Holor<double, 2, HugePageAllocator<double>> h1(std::vector<size_t>{4, 4});
+        EXPECT_EQ( reinterpret_cast<std::uintptr_t>(h1.data()) % 64, 0 );
+        Holor<double, 2, HugePageAllocator<double>> h2(std::vector<size_t>{512, 1024});
+        EXPECT_EQ( reinterpret_cast<std::uintptr_t>(h2.data()) % HugePageAllocator<double>::huge_page_size, 0 );
+        h2(511, 1023) = 3.0;
+        EXPECT_EQ( h2(511, 1023), 3.0 );
+    }
+
+    // conversions and comparisons between different allocators
+    {
+        Holor<int, 2> h1{ {1,2,3}, {4,5,6} };
+        Holor<int, 2, AlignedAllocator<int>> h2(h1);
+        EXPECT_TRUE( (h1 == h2) );
+        EXPECT_TRUE( (h2.row(1) == h1.row(1)) );
+        EXPECT_TRUE( (h1 == Holor<int, 2>(h2)) );
+        h2(0, 0) = 10;
+        EXPECT_TRUE( (h1 != h2) );
+
+        Holor<int, 1, AlignedAllocator<int>> h3(h1.col(1));
+        EXPECT_EQ( reinterpret_cast<std::uintptr_t>(h3.data()) % 64, 0 );
+        EXPECT_TRUE( (h3 == h1.col(1)) );
+        EXPECT_TRUE( (h3 == Holor<int, 1>{2, 5}) );
+    }
+
+    // operations preserve the allocator of their source
+    {
+        Holor<int, 2, AlignedAllocator<int>> h1{ {1,2,3}, {4,5,6} };
+        auto h2 = transpose(h1);
+        EXPECT_TRUE( (std::is_same_v<decltype(h2), Holor<int, 2, AlignedAllocator<int>>>) );
+        EXPECT_TRUE( (h2 == Holor<int, 2>{ {1,4}, {2,5}, {3,6} }) );
+        auto h3 = concatenate<0>(h1, h1);
+        EXPECT_TRUE( (std::is_same_v<decltype(h3), Holor<int, 2, AlignedAllocator<int>>>) );
+        EXPECT_TRUE( (h3 == Holor<int, 2>{ {1,2,3}, {4,5,6}, {1,2,3}, {4,5,6} }) );
+    }
+}
+
+
 
 int main(int argc, char **argv) {
     ::testing::InitGoogleTest(&argc, argv);
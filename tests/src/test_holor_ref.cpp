@@ -305,10 +305,126 @@ TEST(TestHolorRef, CheckSlicing){
         EXPECT_EQ(slice1.length(1), 3);
         EXPECT_TRUE( (slice1==h2) );
     }
+
+    // strided and reversed slicing
+    {
+        std::vector<int> vec{1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,16,17,18,19,20,21,22,23,24,25,26,27};
+        HolorRef<int,3> h1{ vec.data(), Layout<3>{3,3,3} };
+        auto slice1 = h1(range(2,0,-2), 1, range(0,2,2));
+        EXPECT_TRUE( (std::is_same_v<decltype(slice1), HolorRef<int, 2>>) );
+        Holor<int,2> h2{ {22,24}, {4,6} };
+        EXPECT_TRUE( (slice1==h2) );
+        EXPECT_FALSE( slice1.is_contiguous() );
+        std::vector<int> visited(slice1.begin(), slice1.end());
+        EXPECT_EQ(visited, (std::vector<int>{22,24,4,6}));
+        std::vector<int> reversed(slice1.rbegin(), slice1.rend());
+        EXPECT_EQ(reversed, (std::vector<int>{6,4,24,22}));
+    }
+
+    {
+        std::vector<int> vec{1,2,3,4,5,6,7,8};
+        HolorRef<int,1> h1{ vec.data(), Layout<1>{8} };
+        auto flipped = h1(range(7,0,-1));
+        EXPECT_EQ(flipped.length(0), 8);
+        EXPECT_EQ(flipped(0), 8);
+        EXPECT_EQ(flipped(7), 1);
+        std::vector<int> visited(flipped.begin(), flipped.end());
+        EXPECT_EQ(visited, (std::vector<int>{8,7,6,5,4,3,2,1}));
+        // the flipped view writes into the original data
+        flipped.substitute(Holor<int,1>{10,20,30,40,50,60,70,80});
+        EXPECT_EQ(vec, (std::vector<int>{80,70,60,50,40,30,20,10}));
+        auto decimated = h1(range(1,7,3));
+        EXPECT_EQ(decimated.length(0), 3);
+        EXPECT_TRUE( (decimated==Holor<int,1>{70,40,10}) );
+    }
+
+    {
+        // a view reversed on its innermost dimension is traversed by the iterators
+        Holor<int,2> h{ {1,2,3}, {4,5,6} };
+        auto r = h(range(0,1), range(2,0,-1));
+        EXPECT_FALSE( r.begin() == r.end() );
+        EXPECT_EQ( r.end() - r.begin(), 6 );
+        std::vector<int> visited;
+        for (auto x : r){
+            visited.push_back(x);
+        }
+        EXPECT_EQ(visited, (std::vector<int>{3,2,1,6,5,4}));
+        std::vector<int> reversed(r.rbegin(), r.rend());
+        EXPECT_EQ(reversed, (std::vector<int>{4,5,6,1,2,3}));
+        auto last = r.end();
+        --last;
+        EXPECT_EQ(*last, 4);
+        EXPECT_EQ(*(r.begin() + 5), 4);
+        EXPECT_TRUE( (r.begin() + 6) == r.end() );
+    }
 }
 
 
 
+/*=================================================================================
+//                                 Contiguity Tests
+// =================================================================================*/
+TEST(TestHolorRef, CheckContiguity){
+    {
+        Holor<int,3> h{ {{1,2,3}, {4,5,6}}, {{7,8,9}, {10,11,12}} };
+        auto row = h.row(1);
+        EXPECT_TRUE( row.is_contiguous() );
+        auto flat = row.span();
+        EXPECT_EQ( flat.size(), 6 );
+        EXPECT_TRUE( (std::ranges::equal(flat, std::vector<int>{7,8,9,10,11,12})) );
+        EXPECT_TRUE( (std::ranges::equal(h.span(), std::vector<int>{1,2,3,4,5,6,7,8,9,10,11,12})) );
+
+        auto col = h.col(1);
+        EXPECT_FALSE( col.is_contiguous() );
+        EXPECT_THROW( col.span(), holor::exception::HolorRuntimeError );
+    }
+
+    // substitute and comparisons between contiguous and strided containers
+    {
+        Holor<int,2> h{ {1,2,3}, {4,5,6}, {7,8,9} };
+        Holor<int,2> other{ {10,20,30}, {40,50,60}, {70,80,90} };
+        auto rows = h.slice<0>(range{0,1});
+        auto other_rows = other.slice<0>(range{1,2});
+        EXPECT_TRUE( rows.is_contiguous() );
+        EXPECT_TRUE( other_rows.is_contiguous() );
+        rows.substitute(other_rows);
+        EXPECT_TRUE( (h == Holor<int,2>{ {40,50,60}, {70,80,90}, {7,8,9} }) );
+        EXPECT_TRUE( (rows == other_rows) );
+
+        auto cols = h.slice<1>(range{1,2});
+        EXPECT_FALSE( cols.is_contiguous() );
+        cols.substitute(Holor<int,2>{ {-1,-2}, {-3,-4}, {-5,-6} });
+        EXPECT_TRUE( (h == Holor<int,2>{ {40,-1,-2}, {70,-3,-4}, {7,-5,-6} }) );
+        EXPECT_TRUE( (cols == Holor<int,2>{ {-1,-2}, {-3,-4}, {-5,-6} }) );
+        EXPECT_FALSE( (cols == rows) );
+
+        Holor<int,2> copy_rows(rows);
+        EXPECT_TRUE( (copy_rows == Holor<int,2>{ {40,-1,-2}, {70,-3,-4} }) );
+        Holor<int,2> copy_cols(cols);
+        EXPECT_TRUE( (copy_cols == Holor<int,2>{ {-1,-2}, {-3,-4}, {-5,-6} }) );
+    }
+}
+
+
+
+TEST(TestHolorRef, CheckReadOnly){
+    // a HolorRef<const T, N> is a read-only view, whose value_type is T
+    {
+        Holor<int,2> h{ {1,2,3}, {4,5,6} };
+        HolorRef<const int,2> view(h.data(), h.layout());
+        EXPECT_TRUE( (std::is_same_v<typename HolorRef<const int,2>::value_type, int>) );
+        EXPECT_TRUE( (HolorType<HolorRef<const int,2>>) );
+        EXPECT_EQ( view(1,2), 6 );
+        EXPECT_EQ( view.row(1)(0), 4 );
+        EXPECT_EQ( view.col(2)(0), 3 );
+        auto transposed = transpose_view(view);
+        EXPECT_TRUE( (std::is_same_v<decltype(transposed), HolorRef<const int,2>>) );
+        EXPECT_EQ( transposed(2,0), 3 );
+        Holor<int,2> copy(view);
+        EXPECT_TRUE( (copy == h) );
+    }
+}
+
 
 int main(int argc, char **argv) {
     ::testing::InitGoogleTest(&argc, argv);
@@ -25,6 +25,7 @@
 #include <algorithm>
 #include <array>
 #include <vector>
+#include <numeric>
 #include <holor/holor_full.h>
 #include <gtest/gtest.h>
 
@@ -117,6 +118,89 @@ TEST(TestIterators, CheckHolorRefIterators){
 
 
 
+TEST(TestIterators, CheckHolorRefRandomAccess){
+    EXPECT_TRUE( (std::random_access_iterator<HolorRef<int,2>::iterator>) );
+    EXPECT_TRUE( (std::random_access_iterator<HolorRef<int,2>::const_iterator>) );
+
+    {
+        Holor<int,3> holor{{{1,2,3}, {4,5,6}}, {{7,8,9}, {10,11,12}}};
+        auto hr = holor.slice<2>(range{1,2});
+        auto begin = hr.cbegin();
+        auto end = hr.cend();
+        EXPECT_EQ( end-begin, 8);
+        EXPECT_EQ( *(begin+3), 6);
+        EXPECT_EQ( *(3+begin), 6);
+        EXPECT_EQ( *(end-1), 12);
+        EXPECT_EQ( *(end-8), 2);
+        EXPECT_TRUE( (begin+8 == end) );
+        EXPECT_TRUE( (end-8 == begin) );
+        EXPECT_TRUE( (begin+20 == end) );
+        EXPECT_TRUE( (end-20 == begin) );
+        for (auto i = 0; i < 8; i++){
+            auto it = begin;
+            std::advance(it, i);
+            EXPECT_EQ( it-begin, i );
+            EXPECT_EQ( *it, begin[i] );
+            EXPECT_EQ( *(it+(-i)), 2 );
+            EXPECT_EQ( *(end-(8-i)), *it );
+        }
+        EXPECT_TRUE( (begin < begin+1) );
+        EXPECT_TRUE( (begin+5 > begin+4) );
+        EXPECT_TRUE( (begin+2 <= begin+2) );
+        EXPECT_TRUE( (end >= begin) );
+    }
+
+    {
+        Holor<int,2> holor{{5,1}, {3,2}, {4,3}, {1,4}, {2,5}};
+        auto column = holor.col(0);
+        std::sort(column.begin(), column.end());
+        Holor<int,2> expected{{1,1}, {2,2}, {3,3}, {4,4}, {5,5}};
+        EXPECT_TRUE( (holor == expected) );
+
+        auto transposed = transpose_view(holor);
+        std::ranges::sort(transposed, std::greater<int>{});
+        Holor<int,2> expected_sorted{{5,3}, {5,2}, {4,2}, {4,1}, {3,1}};
+        EXPECT_TRUE( (holor == expected_sorted) );
+    }
+}
+
+
+TEST(TestIterators, CheckHolorRefTraversal){
+    std::vector<int> vec(4*3*5*2);
+    std::iota(vec.begin(), vec.end(), 0);
+    HolorRef<int,4> holor(vec.data(), Layout<4>{4,3,5,2});
+    auto hr = holor(range{1,3}, range{0,2}, range{1,3}, 1);
+
+    std::vector<int> expected;
+    for (size_t i = 0; i < hr.length(0); i++){
+        for (size_t j = 0; j < hr.length(1); j++){
+            for (size_t k = 0; k < hr.length(2); k++){
+                expected.push_back(hr(i,j,k));
+            }
+        }
+    }
+
+    std::vector<int> forward(hr.begin(), hr.end());
+    EXPECT_EQ(forward, expected);
+
+    std::vector<int> backward;
+    for (auto it = hr.end(); it != hr.begin(); ){
+        --it;
+        backward.push_back(*it);
+    }
+    std::reverse(backward.begin(), backward.end());
+    EXPECT_EQ(backward, expected);
+
+    auto it = hr.begin();
+    for (size_t cnt = 0; cnt < expected.size(); cnt++){
+        EXPECT_EQ( *it, expected[cnt] );
+        EXPECT_TRUE( (it == hr.begin() + cnt) );
+        it++;
+    }
+    EXPECT_TRUE( (it == hr.end()) );
+}
+
+
 
 int main(int argc, char **argv) {
     ::testing::InitGoogleTest(&argc, argv);
@@ -25,6 +25,7 @@
 #include <algorithm>
 #include <array>
 #include <vector>
+#include <numeric>
 #include <type_traits>
 #include <holor/holor_full.h>
 #include <gtest/gtest.h>
@@ -348,6 +349,155 @@ TEST(TestLayout, Resize){
     }
 }
 
+TEST(TestLayout, CheckContiguity){
+    {
+        Layout<3> layout(4, 5, 6);
+        EXPECT_TRUE(layout.is_contiguous());
+        EXPECT_EQ(layout.contiguous_inner_extent(), 120);
+    }
+    {
+        Layout<3> layout(4, 5, 6);
+        auto slice = layout.slice_dimension<0>(range{1,2});
+        EXPECT_TRUE(slice.is_contiguous());
+        EXPECT_EQ(slice.contiguous_inner_extent(), 60);
+        auto row = layout.slice_dimension<0>(3);
+        EXPECT_TRUE(row.is_contiguous());
+        EXPECT_EQ(row.contiguous_inner_extent(), 30);
+    }
+    {
+        Layout<3> layout(4, 5, 6);
+        auto slice = layout(range{0,3}, range{1,2}, range{0,5});
+        EXPECT_FALSE(slice.is_contiguous());
+        EXPECT_EQ(slice.contiguous_inner_extent(), 12);
+        // the example in the documentation of contiguous_inner_extent
+        EXPECT_EQ(layout(range{0,3}, range{1,3}, range{0,5}).contiguous_inner_extent(), 18);
+        auto col = layout.slice_dimension<2>(1);
+        EXPECT_FALSE(col.is_contiguous());
+        EXPECT_EQ(col.contiguous_inner_extent(), 1);
+    }
+    {
+        Layout<3> layout(4, 5, 6);
+        auto slice = layout.slice_unreduced(range{1,2}, 3, range{0,5});
+        EXPECT_FALSE(slice.is_contiguous());
+        EXPECT_EQ(slice.contiguous_inner_extent(), 6);
+        auto plane = layout.slice_unreduced(2, range{0,4}, range{0,5});
+        EXPECT_TRUE(plane.is_contiguous());
+    }
+}
+
+TEST(TestLayout, CheckNormalization){
+    {
+        Layout<5> layout(2, 3, 4, 5, 6);
+        auto normalized = impl::normalize_layouts(layout);
+        EXPECT_EQ(normalized.dimensions_, 1);
+        EXPECT_EQ(normalized.lengths_[0], 720);
+        EXPECT_EQ(normalized.strides_[0][0], 1);
+    }
+    {
+        Layout<4> layout(3, 4, 5, 6);
+        auto slice = layout(1, range{0,3}, 2, range{1,4});
+        auto normalized = impl::normalize_layouts(slice);
+        EXPECT_EQ(normalized.dimensions_, 2);
+        EXPECT_EQ(normalized.lengths_[0], 4);
+        EXPECT_EQ(normalized.lengths_[1], 4);
+        EXPECT_EQ(normalized.strides_[0][0], 30);
+        EXPECT_EQ(normalized.strides_[0][1], 1);
+        EXPECT_EQ(normalized.offsets_[0], slice.offset());
+    }
+    {
+        Layout<3> layout(1, 1, 1);
+        auto normalized = impl::normalize_layouts(layout);
+        EXPECT_EQ(normalized.dimensions_, 1);
+        EXPECT_EQ(normalized.lengths_[0], 1);
+    }
+    {
+        // two layouts are merged only where both of them can be merged
+        Layout<3> layout1(4, 5, 6);
+        Layout<3> layout2(4, 5, 6);
+        layout2.transpose(std::array<size_t,3>{0, 2, 1});
+        Layout<3> layout3(4, 6, 5);
+        auto normalized = impl::normalize_layouts(layout3, layout2);
+        EXPECT_EQ(normalized.dimensions_, 3);
+        normalized = impl::normalize_layouts(layout1, layout1.slice_unreduced(range{0,3}, range{0,4}, range{0,5}));
+        EXPECT_EQ(normalized.dimensions_, 1);
+    }
+    {
+        // the joint traversal visits the elements in row-major order
+        Layout<4> layout(3, 4, 5, 6);
+        auto slice = layout(range{0,2}, 1, range{1,3}, range{2,5});
+        Layout<3> dense(3, 3, 4);
+        std::vector<size_t> visited;
+        std::vector<size_t> dense_visited;
+        impl::for_each_index(impl::normalize_layouts(slice, dense), [&](size_t i, size_t j){
+            visited.push_back(i);
+            dense_visited.push_back(j);
+        });
+        std::vector<size_t> expected;
+        for (size_t i = 0; i < 3; i++){
+            for (size_t j = 0; j < 3; j++){
+                for (size_t k = 0; k < 4; k++){
+                    expected.push_back(slice(i, j, k));
+                }
+            }
+        }
+        EXPECT_EQ(visited, expected);
+        std::vector<size_t> dense_expected(36);
+        std::iota(dense_expected.begin(), dense_expected.end(), 0);
+        EXPECT_EQ(dense_visited, dense_expected);
+    }
+}
+
+
+TEST(TestLayout, CheckBroadcasting){
+    {
+        // layouts with explicit strides, that can be zero or negative
+        Layout<2> layout(std::array<size_t,2>{3, 4}, std::array<std::ptrdiff_t,2>{0, -1}, 3);
+        EXPECT_EQ(layout.size(), 12);
+        EXPECT_EQ(layout.offset(), 3);
+        EXPECT_EQ(layout(2, 0), 3);
+        EXPECT_EQ(layout(1, 3), 0);
+        EXPECT_FALSE(layout.is_contiguous());
+        EXPECT_THROW( (Layout<2>(std::array<size_t,2>{3, 0}, std::array<std::ptrdiff_t,2>{1, 1})), holor::exception::HolorInvalidArgument );
+    }
+    {
+        // the added dimensions and the dimensions with a single element have zero stride
+        Layout<2> layout(1, 3);
+        auto broadcast = layout.broadcast(std::array<size_t,3>{2, 4, 3});
+        EXPECT_EQ(broadcast.lengths(), (std::array<size_t,3>{2, 4, 3}));
+        EXPECT_EQ(broadcast.strides(), (std::array<std::ptrdiff_t,3>{0, 0, 1}));
+        EXPECT_EQ(broadcast.size(), 24);
+        EXPECT_EQ(broadcast(1, 2, 2), 2);
+
+        auto slice = Layout<3>(4, 5, 6)(range{1,3}, 2, range{0,4,2});
+        auto expanded = slice.broadcast(std::array<size_t,3>{7, 3, 3});
+        EXPECT_EQ(expanded.strides(), (std::array<std::ptrdiff_t,3>{0, 30, 2}));
+        EXPECT_EQ(expanded.offset(), slice.offset());
+        EXPECT_EQ(layout.broadcast(std::array<size_t,2>{1, 3}), layout);
+        EXPECT_THROW( layout.broadcast(std::array<size_t,2>{2, 4}), holor::exception::HolorRuntimeError );
+        EXPECT_THROW( slice.broadcast(std::array<size_t,2>{1, 3}), holor::exception::HolorRuntimeError );
+    }
+    {
+        EXPECT_EQ( (impl::broadcast_lengths(std::array<size_t,3>{4, 1, 3}, std::array<size_t,2>{5, 1})), (std::array<size_t,3>{4, 5, 3}) );
+        EXPECT_EQ( (impl::broadcast_lengths(std::array<size_t,1>{1}, std::array<size_t,2>{2, 6})), (std::array<size_t,2>{2, 6}) );
+        EXPECT_THROW( (impl::broadcast_lengths(std::array<size_t,2>{2, 3}, std::array<size_t,1>{2})), holor::exception::HolorRuntimeError );
+    }
+    {
+        // the normalization merges the broadcast dimensions, which are traversed repeating the same elements
+        Layout<1> row(4);
+        auto broadcast = row.broadcast(std::array<size_t,3>{2, 3, 4});
+        auto normalized = impl::normalize_layouts(broadcast);
+        EXPECT_EQ(normalized.dimensions_, 2);
+        EXPECT_EQ(normalized.lengths_[0], 6);
+        EXPECT_EQ(normalized.strides_[0][0], 0);
+        std::vector<size_t> visited;
+        impl::for_each_index(normalized, [&](size_t i){ visited.push_back(i); });
+        ASSERT_EQ(visited.size(), 24);
+        for (size_t i = 0; i < visited.size(); i++){
+            EXPECT_EQ(visited[i], i%4);
+        }
+    }
+}
+
 /*=================================================================================
                                 Indexing Tests
 =================================================================================*/
@@ -471,6 +621,55 @@ TEST(TestLayout, CheckSlicing){
         EXPECT_EQ(test_slice.stride(0), 3);
         EXPECT_EQ(test_slice.stride(1), 1);
     }
+
+    // strided and reversed ranges
+    {
+        Layout<2> layout{6, 8};
+        auto test_slice = layout(range(0,5,2), range(7,0,-3));
+        EXPECT_TRUE( (std::is_same_v<decltype(test_slice),Layout<2>>) );
+        EXPECT_EQ(test_slice.offset(), 7);
+        EXPECT_EQ(test_slice.size(), 9);
+        EXPECT_EQ(test_slice.length(0), 3);
+        EXPECT_EQ(test_slice.length(1), 3);
+        EXPECT_EQ(test_slice.stride(0), 16);
+        EXPECT_EQ(test_slice.stride(1), -3);
+        EXPECT_EQ(test_slice(0,0), 7);
+        EXPECT_EQ(test_slice(1,1), 20);
+        EXPECT_EQ(test_slice(2,2), 33);
+        EXPECT_FALSE(test_slice.is_contiguous());
+    }
+    {
+        Layout<3> layout{3, 4, 5};
+        auto test_slice = layout.slice_dimension<2>(range(4,0,-1));
+        EXPECT_EQ(test_slice.offset(), 4);
+        EXPECT_EQ(test_slice.length(2), 5);
+        EXPECT_EQ(test_slice.stride(2), -1);
+        EXPECT_EQ(test_slice(2,3,4), 55);
+        auto test_slice2 = layout.slice_unreduced(1, range(3,0,-2), range(0,4,4));
+        EXPECT_EQ(test_slice2.offset(), 35);
+        EXPECT_EQ(test_slice2.length(1), 2);
+        EXPECT_EQ(test_slice2.length(2), 2);
+        EXPECT_EQ(test_slice2.stride(1), -10);
+        EXPECT_EQ(test_slice2.stride(2), 4);
+        EXPECT_EQ(test_slice2(0,1,1), 29);
+        // slicing a reversed layout again
+        auto test_slice3 = test_slice(range(2,0,-1), 0, range(1,3));
+        EXPECT_EQ(test_slice3.stride(0), -20);
+        EXPECT_EQ(test_slice3.stride(1), -1);
+        EXPECT_EQ(test_slice3(0,0), 43);
+    }
+    {
+        EXPECT_EQ(range(0, 7, 3).length(), 3);
+        EXPECT_EQ(range(0, 7, 3).last(), 6);
+        EXPECT_EQ(range(9, 2, -4).length(), 2);
+        EXPECT_EQ(range(9, 2, -4).last(), 5);
+        EXPECT_THROW(range(2, 5, -1), holor::exception::HolorRuntimeError);
+        EXPECT_THROW(range(5, 2), holor::exception::HolorRuntimeError);
+        EXPECT_THROW(range(2, 5, 0), holor::exception::HolorRuntimeError);
+        Layout<2> layout{6, 8};
+        EXPECT_THROW(layout(range(7,1,-2), 0), holor::exception::HolorRuntimeError);
+        EXPECT_NO_THROW(layout(range(1,6,2), 0));
+    }
 }
 
 
@@ -0,0 +1,193 @@
+// This file is part of Holor, a C++ header-only template library for multi-dimensional containers
+
+// Copyright 2020-2022 Carlo Masone
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to 
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is 
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER 
+// DEALINGS IN THE SOFTWARE.
+
+
+
+
+
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <holor/holor_full.h>
+#include <io/mapped_holor.h>
+#include <gtest/gtest.h>
+#include "test_utils.h"
+
+using namespace holor;
+
+
+
+/*=================================================================================
+                                Tests
+=================================================================================*/
+TEST(TestMappedHolor, CheckConcepts){
+    EXPECT_TRUE( (HolorType<MappedHolor<float, 2>>) );
+    EXPECT_TRUE( (HolorType<MappedHolor<const double, 3>>) );
+    EXPECT_TRUE( (std::is_same_v<typename MappedHolor<const double, 3>::value_type, double>) );
+    EXPECT_FALSE( (std::is_copy_constructible_v<MappedHolor<float, 2>>) );
+}
+
+
+TEST(TestMappedHolor, CheckCreate){
+    TemporaryFile file("mapped", "create");
+    {
+        auto mapped = create_mapped<int32_t, 2>(file.path_, {30, 40});
+        EXPECT_EQ(mapped.lengths(), (std::array<size_t, 2>{30, 40}));
+        EXPECT_EQ(mapped.mode(), MapMode::shared);
+        EXPECT_TRUE( std::all_of(mapped.begin(), mapped.end(), [](int32_t x){ return x == 0; }) );
+        fill_pattern(mapped);
+        mapped(2, 3) = 1000;
+        mapped.flush();
+    }
+    EXPECT_EQ(std::filesystem::file_size(file.path_), 16 + 8*2 + 30*40*sizeof(int32_t));
+    Holor<int32_t, 2> expected(std::vector<size_t>{30, 40});
+    fill_pattern(expected);
+    expected(2, 3) = 1000;
+    EXPECT_TRUE( (load<int32_t, 2>(file.path_) == expected) );
+}
+
+
+TEST(TestMappedHolor, CheckModes){
+    TemporaryFile file("mapped", "modes");
+    Holor<double, 3> h(std::vector<size_t>{5, 6, 7});
+    fill_pattern(h);
+    save(file.path_, h);
+
+    // a read-only mapping sees the elements of the file
+    MappedHolor<const double, 3> readonly(file.path_);
+    EXPECT_EQ(readonly.mode(), MapMode::read_only);
+    EXPECT_EQ(readonly.lengths(), h.lengths());
+    EXPECT_TRUE( (Holor<double, 3>(readonly.view()) == h) );
+
+    // the writes to a copy-on-write mapping are not carried through to the file
+    MappedHolor<double, 3> private_copy(file.path_, MapMode::copy_on_write);
+    private_copy(1, 2, 3) = -1.5;
+    private_copy.flush();
+    EXPECT_EQ(private_copy(1, 2, 3), -1.5);
+    EXPECT_EQ(readonly(1, 2, 3), h(1, 2, 3));
+    // the advice dontneed would discard the private pages, so it is ignored
+    private_copy.advise(MapAdvice::dontneed);
+    private_copy.advise(private_copy.row(1), MapAdvice::dontneed);
+    EXPECT_EQ(private_copy(1, 2, 3), -1.5);
+    EXPECT_TRUE( (load<double, 3>(file.path_) == h) );
+
+    // the writes to a shared mapping are visible to the other mappings and are carried through to the file
+    MappedHolor<double, 3> shared(file.path_);
+    shared(4, 5, 6) = 42;
+    shared.row(0) = shared.row(0) * 2.0;
+    shared.flush();
+    h(4, 5, 6) = 42;
+    h.row(0) = h.row(0) * 2.0;
+    EXPECT_EQ(readonly(4, 5, 6), 42);
+    EXPECT_TRUE( (load<double, 3>(file.path_) == h) );
+
+    // a file without elements
+    save(file.path_, Holor<double, 3>(std::array<size_t, 3>{2, 0, 5}));
+    MappedHolor<const double, 3> empty(file.path_);
+    EXPECT_EQ(empty.lengths(), (std::array<size_t, 3>{2, 0, 5}));
+    EXPECT_EQ(empty.size(), 0);
+    EXPECT_EQ(empty.begin(), empty.end());
+}
+
+
+TEST(TestMappedHolor, CheckSlicing){
+    TemporaryFile file("mapped", "slicing");
+    Holor<float, 3> h(std::vector<size_t>{8, 9, 10});
+    fill_pattern(h);
+    save(file.path_, h);
+    MappedHolor<float, 3> mapped(file.path_);
+
+    EXPECT_EQ(mapped(3, 4, 5), h(3, 4, 5));
+    EXPECT_EQ(mapped(std::array<size_t, 3>{7, 8, 9}), h(7, 8, 9));
+    EXPECT_TRUE( (mapped.row(2) == h.row(2)) );
+    EXPECT_TRUE( (mapped.col(5) == h.col(5)) );
+    EXPECT_TRUE( (mapped.slice<2>(9) == h.slice<2>(9)) );
+    EXPECT_TRUE( (mapped.slice<1>(range{2, 6}) == h.slice<1>(range{2, 6})) );
+    EXPECT_TRUE( (mapped(range{1, 6, 2}, 3, range{0, 9}) == h(range{1, 6, 2}, 3, range{0, 9})) );
+    EXPECT_TRUE( std::equal(mapped.crbegin(), mapped.crend(), h.crbegin()) );
+
+    // the slices of a const container are read-only views, like those of a const Holor
+    const auto& cmapped = mapped;
+    const auto& ch = h;
+    EXPECT_TRUE( (std::is_same_v<decltype(cmapped.row(2)), HolorRef<const float, 2>>) );
+    EXPECT_TRUE( (cmapped.row(2) == ch.row(2)) );
+    EXPECT_TRUE( (cmapped.col(5) == ch.col(5)) );
+    EXPECT_TRUE( (cmapped.slice<2>(9) == ch.slice<2>(9)) );
+    EXPECT_TRUE( (cmapped.slice<1>(range{2, 6}) == ch.slice<1>(range{2, 6})) );
+    EXPECT_TRUE( (Holor<float, 2>(cmapped(range{1, 6, 2}, 3, range{0, 9})) == Holor<float, 2>(h(range{1, 6, 2}, 3, range{0, 9}))) );
+
+    // the operations accept a MappedHolor as any other container
+    EXPECT_EQ(sum(mapped), sum(h));
+    EXPECT_TRUE( (sum<1>(mapped, {1}) == sum<1>(h, {1})) );
+    EXPECT_TRUE( (Holor<float, 3>(transpose_view(mapped)) == Holor<float, 3>(transpose_view(h))) );
+
+    // the slices remain valid after the MappedHolor is moved
+    auto slice = mapped.row(7);
+    MappedHolor<float, 3> moved = std::move(mapped);
+    EXPECT_TRUE( (slice == h.row(7)) );
+    EXPECT_EQ(moved.data(), slice.data());
+}
+
+
+TEST(TestMappedHolor, CheckAdvice){
+    TemporaryFile file("mapped", "advice");
+    Holor<int64_t, 2> h(std::vector<size_t>{1000, 300});
+    fill_pattern(h);
+    save(file.path_, h);
+
+    MappedHolor<const int64_t, 2> mapped(file.path_, MapMode::read_only, MapAdvice::sequential);
+    EXPECT_NO_THROW( mapped.advise(MapAdvice::random) );
+    EXPECT_NO_THROW( mapped.advise(mapped.view().row(500), MapAdvice::willneed) );
+    EXPECT_NO_THROW( mapped.advise(mapped.view()(range{10, 900, 5}, range{3, 200}), MapAdvice::willneed) );
+    EXPECT_NO_THROW( mapped.advise(transpose_view(mapped).row(299), MapAdvice::willneed) );
+    EXPECT_NO_THROW( mapped.advise(MapAdvice::dontneed) );
+    EXPECT_TRUE( (Holor<int64_t, 2>(mapped.view()) == h) );
+    EXPECT_THROW( mapped.advise(h.row(0), MapAdvice::willneed), holor::exception::HolorRuntimeError );
+}
+
+
+TEST(TestMappedHolor, CheckErrors){
+    TemporaryFile file("mapped", "errors");
+    Holor<float, 2> h{ {1, 2, 3}, {4, 5, 6} };
+    save(file.path_, h);
+
+    // wrong mode, type of the elements or number of dimensions
+    EXPECT_THROW( (MappedHolor<float, 2>(file.path_, MapMode::read_only)), holor::exception::HolorRuntimeError );
+    EXPECT_THROW( (MappedHolor<const float, 2>(file.path_, MapMode::shared)), holor::exception::HolorRuntimeError );
+    EXPECT_THROW( (MappedHolor<const double, 2>(file.path_)), holor::exception::HolorRuntimeError );
+    EXPECT_THROW( (MappedHolor<const float, 1>(file.path_)), holor::exception::HolorRuntimeError );
+
+    // truncated file and missing file
+    std::filesystem::resize_file(file.path_, std::filesystem::file_size(file.path_) - 1);
+    EXPECT_THROW( (MappedHolor<const float, 2>(file.path_)), holor::exception::HolorRuntimeError );
+    EXPECT_THROW( (MappedHolor<const float, 2>(file.path_.string() + ".missing")), holor::exception::HolorRuntimeError );
+    EXPECT_THROW( (create_mapped<float, 2>(file.path_, {0, 3})), holor::exception::HolorRuntimeError );
+}
+
+
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,262 @@
+// This file is part of Holor, a C++ header-only template library for multi-dimensional containers
+
+// Copyright 2020-2022 Carlo Masone
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to 
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is 
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER 
+// DEALINGS IN THE SOFTWARE.
+
+
+
+
+
+
+#include <bit>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <holor/holor_full.h>
+#include <io/holor_npy.h>
+#include <gtest/gtest.h>
+#include "test_utils.h"
+
+using namespace holor;
+
+
+
+/*=================================================================================
+                                Utilities
+=================================================================================*/
+/*!
+ * writes a file with the layout produced by numpy.save: the magic string, the version, the length of the header and the dictionary padded to a multiple of 64 bytes, followed by the elements
+ */
+template<typename T>
+void write_numpy_file(const std::filesystem::path& path, const std::string& dictionary, const std::vector<T>& elements, unsigned major = 1){
+    const size_t prefix = (major == 1) ? 10 : 12;
+    std::string header = dictionary;
+    header.append((64 - (prefix + header.size() + 1) % 64) % 64, ' ');
+    header += '\n';
+    std::ofstream os(path, std::ios::binary);
+    os.write("\x93NUMPY", 6);
+    os.put(static_cast<char>(major));
+    os.put(0);
+    for (size_t i = 0; i < prefix - 8; i++){
+        os.put(static_cast<char>((header.size() >> (8*i)) & 0xFF));
+    }
+    os << header;
+    os.write(reinterpret_cast<const char*>(elements.data()), elements.size()*sizeof(T));
+}
+
+std::string native_order(){
+    return (std::endian::native == std::endian::little) ? "<" : ">";
+}
+
+std::string foreign_order(){
+    return (std::endian::native == std::endian::little) ? ">" : "<";
+}
+
+
+
+/*=================================================================================
+                                Tests
+=================================================================================*/
+TEST(TestNpy, CheckHeader){
+    TemporaryFile file("npy", "header");
+    Holor<double, 2> h{ {1, 2, 3}, {4, 5, 6} };
+    save_npy(file.path_, h);
+    std::ifstream is(file.path_, std::ios::binary);
+    std::string content((std::istreambuf_iterator<char>(is)), std::istreambuf_iterator<char>());
+    ASSERT_EQ(content.size(), 128 + 6*sizeof(double));
+    EXPECT_EQ(content.substr(0, 8), std::string("\x93NUMPY\x01\x00", 8));
+    EXPECT_EQ(static_cast<unsigned char>(content[8]) + 256*static_cast<unsigned char>(content[9]), 118);
+    const std::string dictionary = "{'descr': '" + native_order() + "f8', 'fortran_order': False, 'shape': (2, 3), }";
+    EXPECT_EQ(content.substr(10, dictionary.size()), dictionary);
+    EXPECT_EQ(content[127], '\n');
+
+    Holor<uint8_t, 1> v{1, 2, 3, 4, 5};
+    save_npy(file.path_, v);
+    auto header = impl::read_npy_header(impl::File(file.path_, impl::File::read));
+    EXPECT_EQ(header.type_, (impl::ElementType{'u', 1}));
+    EXPECT_EQ(header.lengths_, (std::vector<size_t>{5}));
+    EXPECT_FALSE(header.fortran_order_);
+    EXPECT_EQ(header.data_offset_, 128);
+}
+
+
+TEST(TestNpy, CheckRoundtrip){
+    TemporaryFile file("npy", "roundtrip");
+    Holor<float, 1> h1(std::vector<size_t>{1000});
+    fill_pattern(h1);
+    save_npy(file.path_, h1);
+    EXPECT_TRUE( (load_npy<float, 1>(file.path_) == h1) );
+
+    Holor<int64_t, 3> h3(std::vector<size_t>{4, 5, 6});
+    fill_pattern(h3);
+    save_npy(file.path_, h3);
+    EXPECT_TRUE( (load_npy<int64_t, 3>(file.path_) == h3) );
+
+    // a slice is written in C order
+    auto slice = h3(range{1, 3}, 2, range{0, 5, 2});
+    save_npy(file.path_, slice);
+    EXPECT_FALSE( (map_npy<int64_t, 2>(file.path_).fortran_order()) );
+    EXPECT_TRUE( (load_npy<int64_t, 2>(file.path_) == Holor<int64_t, 2>(slice)) );
+
+    // an empty array
+    Holor<int16_t, 2> empty(std::vector<size_t>{0, 3});
+    save_npy(file.path_, empty);
+    auto loaded = load_npy<int16_t, 2>(file.path_);
+    EXPECT_EQ(loaded.lengths(), (std::array<size_t, 2>{0, 3}));
+    EXPECT_EQ( (map_npy<int16_t, 2>(file.path_).view().size()), 0 );
+}
+
+
+TEST(TestNpy, CheckNumpyFiles){
+    TemporaryFile file("npy", "numpy");
+
+    // C order, as written by numpy.save(np.arange(6, dtype=np.int32).reshape(2, 3))
+    write_numpy_file<int32_t>(file.path_, "{'descr': '" + native_order() + "i4', 'fortran_order': False, 'shape': (2, 3), }", {0, 1, 2, 3, 4, 5});
+    Holor<int32_t, 2> expected{ {0, 1, 2}, {3, 4, 5} };
+    EXPECT_TRUE( (load_npy<int32_t, 2>(file.path_) == expected) );
+
+    // Fortran order, as written by numpy.save(np.asfortranarray(...)): the elements are stored by columns
+    write_numpy_file<int32_t>(file.path_, "{'descr': '" + native_order() + "i4', 'fortran_order': True, 'shape': (2, 3), }", {0, 3, 1, 4, 2, 5});
+    EXPECT_TRUE( (load_npy<int32_t, 2>(file.path_) == expected) );
+    auto mapped = map_npy<int32_t, 2>(file.path_);
+    EXPECT_TRUE(mapped.fortran_order());
+    EXPECT_FALSE(mapped.view().layout().is_contiguous());
+    EXPECT_TRUE( (Holor<int32_t, 2>(mapped.view()) == expected) );
+
+    // version 2.0, single byte elements and a one-dimensional shape
+    write_numpy_file<uint8_t>(file.path_, "{'descr': '|u1', 'fortran_order': False, 'shape': (4,), }", {9, 8, 7, 6}, 2);
+    EXPECT_TRUE( (load_npy<uint8_t, 1>(file.path_) == Holor<uint8_t, 1>{9, 8, 7, 6}) );
+
+    // a larger Fortran order array, copied with the blocked transposition
+    Holor<double, 3> h(std::vector<size_t>{30, 40, 50});
+    fill_pattern(h);
+    auto columns = transpose_view(h);
+    std::vector<double> elements(h.data(), h.data() + h.size());
+    write_numpy_file<double>(file.path_, "{'descr': '" + native_order() + "f8', 'fortran_order': True, 'shape': (50, 40, 30), }", elements);
+    EXPECT_TRUE( (load_npy<double, 3>(file.path_) == Holor<double, 3>(columns)) );
+}
+
+
+TEST(TestNpy, CheckFortranOrder){
+    // the transposition of a contiguous container is written in Fortran order, directly from its memory
+    TemporaryFile file("npy", "fortran");
+    Holor<float, 3> h(std::vector<size_t>{7, 8, 9});
+    fill_pattern(h);
+    auto transposed = transpose_view(h);
+    save_npy(file.path_, transposed);
+    auto header = impl::read_npy_header(impl::File(file.path_, impl::File::read));
+    EXPECT_TRUE(header.fortran_order_);
+    EXPECT_EQ(header.lengths_, (std::vector<size_t>{9, 8, 7}));
+
+    auto loaded = load_npy<float, 3>(file.path_);
+    EXPECT_TRUE( (loaded == Holor<float, 3>(transposed)) );
+    auto mapped = map_npy<float, 3>(file.path_);
+    EXPECT_EQ(mapped.view().lengths(), (std::array<size_t, 3>{9, 8, 7}));
+    EXPECT_EQ(mapped.view()(8, 1, 6), h(6, 1, 8));
+    EXPECT_EQ(mapped.view().data()[5], h.data()[5]);
+
+    // files whose slabs are larger than the chunks read at once, or that end with a chunk of a single slab
+    for (auto lengths : {std::vector<size_t>{3, 200000}, std::vector<size_t>{131073, 2}}){
+        Holor<double, 2> columns(lengths);
+        fill_pattern(columns);
+        save_npy(file.path_, transpose_view(columns));
+        EXPECT_TRUE(impl::read_npy_header(impl::File(file.path_, impl::File::read)).fortran_order_);
+        EXPECT_TRUE( (load_npy<double, 2>(file.path_) == Holor<double, 2>(transpose_view(columns))) );
+    }
+}
+
+
+TEST(TestNpy, CheckMapped){
+    TemporaryFile file("npy", "mapped");
+    Holor<double, 3> h(std::vector<size_t>{10, 20, 30});
+    fill_pattern(h);
+    save_npy(file.path_, h);
+
+    auto mapped = map_npy<double, 3>(file.path_);
+    HolorRef<const double, 3> view = mapped.view();
+    EXPECT_EQ(mapped.lengths(), h.lengths());
+    EXPECT_TRUE(view.layout().is_contiguous());
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(view.data()) % 64, 0);
+    EXPECT_TRUE( (Holor<double, 3>(view) == h) );
+
+    // the view can be sliced with the layout functions, and it remains valid after the mapping is moved
+    EXPECT_EQ(view.row(3)(4, 5), h(3, 4, 5));
+    EXPECT_EQ(view(range{2, 5}, 7, range{0, 29, 4})(1, 2), h(3, 7, 8));
+    EXPECT_EQ(sum(view.slice<1>(4)), sum(h.slice<1>(4)));
+    auto moved = std::move(mapped);
+    EXPECT_EQ(view(9, 19, 29), h(9, 19, 29));
+    EXPECT_EQ(moved.view().data(), view.data());
+
+    // the mapping does not depend on the file being open, and it sees the file as it was mapped
+    std::filesystem::remove(file.path_);
+    EXPECT_EQ(view(1, 2, 3), h(1, 2, 3));
+}
+
+
+TEST(TestNpy, CheckByteOrder){
+    // the elements are converted when they are loaded, but a file with a different byte order cannot be mapped
+    TemporaryFile file("npy", "byteorder");
+    Holor<uint32_t, 1> h{1, 0x01020304, 0xA0B0C0D0};
+    std::vector<uint32_t> swapped(h.data(), h.data() + h.size());
+    impl::byteswap(swapped.data(), swapped.size(), sizeof(uint32_t));
+    write_numpy_file<uint32_t>(file.path_, "{'descr': '" + foreign_order() + "u4', 'fortran_order': False, 'shape': (3,), }", swapped);
+    EXPECT_TRUE( (load_npy<uint32_t, 1>(file.path_) == h) );
+    EXPECT_THROW( (map_npy<uint32_t, 1>(file.path_)), holor::exception::HolorRuntimeError );
+}
+
+
+TEST(TestNpy, CheckErrors){
+    TemporaryFile file("npy", "errors");
+    Holor<float, 2> h{ {1, 2, 3}, {4, 5, 6} };
+    save_npy(file.path_, h);
+
+    // wrong type of the elements or number of dimensions
+    EXPECT_THROW( (load_npy<double, 2>(file.path_)), holor::exception::HolorRuntimeError );
+    EXPECT_THROW( (load_npy<int32_t, 2>(file.path_)), holor::exception::HolorRuntimeError );
+    EXPECT_THROW( (load_npy<float, 1>(file.path_)), holor::exception::HolorRuntimeError );
+    EXPECT_THROW( (map_npy<float, 3>(file.path_)), holor::exception::HolorRuntimeError );
+
+    // truncated file, unsupported type and file with a different format
+    std::filesystem::resize_file(file.path_, std::filesystem::file_size(file.path_) - 1);
+    EXPECT_THROW( (load_npy<float, 2>(file.path_)), holor::exception::HolorRuntimeError );
+    EXPECT_THROW( (map_npy<float, 2>(file.path_)), holor::exception::HolorRuntimeError );
+    write_numpy_file<float>(file.path_, "{'descr': [('x', '<f4'), ('y', '<f4')], 'fortran_order': False, 'shape': (1,), }", {1, 2});
+    EXPECT_THROW( (load_npy<float, 1>(file.path_)), holor::exception::HolorRuntimeError );
+    write_numpy_file<float>(file.path_, "{'descr': '<f4', 'fortran_order': False, }", {1, 2});
+    EXPECT_THROW( (load_npy<float, 1>(file.path_)), holor::exception::HolorRuntimeError );
+    {
+        std::ofstream os(file.path_);
+        os << "this is not a npy file";
+    }
+    EXPECT_THROW( (load_npy<float, 2>(file.path_)), holor::exception::HolorRuntimeError );
+
+    // missing file
+    EXPECT_THROW( (load_npy<float, 2>(file.path_.string() + ".missing")), holor::exception::HolorRuntimeError );
+    EXPECT_THROW( (map_npy<float, 2>(file.path_.string() + ".missing")), holor::exception::HolorRuntimeError );
+}
+
+
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,409 @@
+// This file is part of Holor, a C++ header-only template library for multi-dimensional containers
+
+// Copyright 2020-2022 Carlo Masone
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to 
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is 
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER 
+// DEALINGS IN THE SOFTWARE.
+
+
+
+#include <algorithm>
+#include <array>
+#include <vector>
+#include <numeric>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <holor/holor_full.h>
+#include <gtest/gtest.h>
+
+using namespace holor;
+
+
+/*=================================================================================
+                                SIMD Kernels
+=================================================================================*/
+template<typename T>
+void check_kernels(size_t n){
+    std::vector<T> a(n), b(n), dest(n);
+    for (size_t i = 0; i < n; i++){
+        a[i] = static_cast<T>(i%13 + 1);
+        b[i] = static_cast<T>(i%7 + 2);
+    }
+
+    simd::transform(a.data(), b.data(), dest.data(), n, std::plus<>{});
+    for (size_t i = 0; i < n; i++){ EXPECT_EQ(dest[i], static_cast<T>(a[i] + b[i])); }
+    simd::transform(a.data(), b.data(), dest.data(), n, std::minus<T>{});
+    for (size_t i = 0; i < n; i++){ EXPECT_EQ(dest[i], static_cast<T>(a[i] - b[i])); }
+    simd::transform(a.data(), b.data(), dest.data(), n, std::multiplies<>{});
+    for (size_t i = 0; i < n; i++){ EXPECT_EQ(dest[i], static_cast<T>(a[i] * b[i])); }
+    simd::transform(a.data(), b.data(), dest.data(), n, std::divides<>{});
+    for (size_t i = 0; i < n; i++){ EXPECT_EQ(dest[i], static_cast<T>(a[i] / b[i])); }
+    simd::transform(a.data(), b.data(), dest.data(), n, simd::Min{});
+    for (size_t i = 0; i < n; i++){ EXPECT_EQ(dest[i], std::min(a[i], b[i])); }
+    simd::transform_scalar(a.data(), T(3), dest.data(), n, simd::Max{});
+    for (size_t i = 0; i < n; i++){ EXPECT_EQ(dest[i], std::max(a[i], T(3))); }
+    simd::multiply_add(T(2), a.data(), b.data(), dest.data(), n);
+    for (size_t i = 0; i < n; i++){ EXPECT_EQ(dest[i], static_cast<T>(2*a[i] + b[i])); }
+
+    EXPECT_EQ( simd::reduce(a.data(), n, T(0), std::plus<>{}), std::accumulate(a.begin(), a.end(), T(0)) );
+    EXPECT_EQ( simd::reduce(a.data(), n, T(0), simd::Max{}), n > 0 ? std::max(T(0), *std::max_element(a.begin(), a.end())) : T(0) );
+    EXPECT_EQ( simd::reduce(a.data(), n, T(100), simd::Min{}), n > 0 ? std::min(T(100), *std::min_element(a.begin(), a.end())) : T(100) );
+    EXPECT_TRUE( simd::equal(a.data(), a.data(), n) );
+    if (n > 0){
+        std::vector<T> c = a;
+        c[n-1] += 1;
+        EXPECT_FALSE( simd::equal(a.data(), c.data(), n) );
+        c = a;
+        c[0] += 1;
+        EXPECT_FALSE( simd::equal(a.data(), c.data(), n) );
+    }
+}
+
+TEST(TestOperations, CheckSimdKernels){
+    // sizes that are smaller than a vector, that are multiples of the vector lengths, and that have a remainder
+    for (size_t n : {0, 1, 3, 16, 63, 64, 65, 257}){
+        check_kernels<float>(n);
+        check_kernels<double>(n);
+        check_kernels<int32_t>(n);
+        check_kernels<int64_t>(n);
+        check_kernels<int16_t>(n);
+        check_kernels<uint8_t>(n);
+    }
+}
+
+
+/*=================================================================================
+                                Element-wise Operations
+=================================================================================*/
+TEST(TestOperations, CheckBroadcastAll){
+    // contiguous containers use the SIMD kernels, views with strides use the generic loop
+    Holor<float, 2> h1(std::vector<size_t>{9, 11});
+    std::iota(h1.begin(), h1.end(), 0.0f);
+    Holor<float, 2> h2 = h1;
+    broadcast_all(h1, 2.0f, std::multiplies<float>());
+    auto view = h2(range(0, 8), range(0, 10));
+    broadcast_all(view, 2.0f, [](float x, float y){ return x*y; });
+    EXPECT_TRUE( (h1 == h2) );
+
+    Holor<int, 1> h3{5, -3, 8, 0, 12};
+    broadcast_all(h3, 4, simd::Min{});
+    EXPECT_TRUE( (h3 == Holor<int, 1>{4, -3, 4, 0, 4}) );
+    auto col = h1.col(0);
+    broadcast_all(col, 1.0f, std::minus<>());
+    EXPECT_FLOAT_EQ( h1(3, 0), 65.0f );
+    EXPECT_FLOAT_EQ( h1(3, 1), 68.0f );
+}
+
+TEST(TestOperations, CheckBroadcastTo){
+    Holor<int, 1> row{1, 2, 3};
+    auto view = broadcast_to<2>(row, {4, 3});
+    EXPECT_TRUE( (std::is_same_v<decltype(view), HolorRef<int, 2>>) );
+    EXPECT_EQ(view.layout().strides(), (std::array<std::ptrdiff_t,2>{0, 1}));
+    EXPECT_EQ(view.data(), row.data());
+    EXPECT_TRUE( (Holor<int, 2>(view) == Holor<int, 2>{ {1,2,3}, {1,2,3}, {1,2,3}, {1,2,3} }) );
+
+    Holor<int, 2> column{ {1}, {2} };
+    auto expanded = broadcast_to<3>(column, {3, 2, 4});
+    EXPECT_EQ(expanded(2, 1, 3), 2);
+    EXPECT_EQ(sum(expanded), 36);
+
+    // the iterators visit all the elements of a view broadcast along its inner dimension
+    auto repeated = broadcast_to<2>(column, {2, 3});
+    std::vector<int> visited;
+    for (auto it = repeated.begin(); it != repeated.end(); ++it){
+        visited.push_back(*it);
+    }
+    EXPECT_EQ(visited, (std::vector<int>{1, 1, 1, 2, 2, 2}));
+    visited.clear();
+    for (auto x : repeated){
+        visited.push_back(x);
+    }
+    EXPECT_EQ(visited, (std::vector<int>{1, 1, 1, 2, 2, 2}));
+    EXPECT_EQ(std::ranges::distance(repeated), 6);
+    EXPECT_EQ(std::ranges::count(repeated, 2), 3);
+
+    Holor<int, 2> dest(std::vector<size_t>{4, 3});
+    std::ranges::fill(dest, 10);
+    dest = dest - view;
+    EXPECT_TRUE( (dest == Holor<int, 2>{ {9,8,7}, {9,8,7}, {9,8,7}, {9,8,7} }) );
+
+    EXPECT_THROW( (broadcast_to<2>(row, {3, 2})), holor::exception::HolorRuntimeError );
+}
+
+
+TEST(TestOperations, CheckReduceAll){
+    Holor<double, 2> h1(std::vector<size_t>{17, 5});
+    std::iota(h1.begin(), h1.end(), 1.0);
+    EXPECT_DOUBLE_EQ( reduce_all(h1, 0.0, std::plus<double>()), 85.0*86.0/2 );
+    EXPECT_DOUBLE_EQ( reduce_all(h1, 0.0, simd::Max{}), 85.0 );
+    EXPECT_DOUBLE_EQ( reduce_all(h1, 1000.0, simd::Min{}), 1.0 );
+    EXPECT_DOUBLE_EQ( reduce_all(h1.col(4), 0.0, std::plus<>()), 5.0*17*18/2 );
+    EXPECT_DOUBLE_EQ( reduce_all(h1.col(4), 0.0, [](double x, double y){ return x + y; }), 5.0*17*18/2 );
+
+    Holor<int64_t, 3> h2(std::vector<size_t>{3, 4, 5});
+    std::fill(h2.begin(), h2.end(), 2);
+    EXPECT_EQ( reduce_all(h2, int64_t(1), std::multiplies<>()), int64_t(1) << 60 );
+}
+
+TEST(TestOperations, CheckAxpy){
+    Holor<float, 2> x(std::vector<size_t>{6, 7});
+    Holor<float, 2> y(std::vector<size_t>{6, 7});
+    std::iota(x.begin(), x.end(), 0.0f);
+    std::fill(y.begin(), y.end(), 1.0f);
+    axpy(3.0f, x, y);
+    for (size_t i = 0; i < 6; i++){
+        for (size_t j = 0; j < 7; j++){
+            EXPECT_FLOAT_EQ( y(i,j), 3.0f*x(i,j) + 1.0f );
+        }
+    }
+
+    // strided views
+    auto y_col = y.col(2);
+    axpy(-1.0f, x.col(5), y_col);
+    for (size_t i = 0; i < 6; i++){
+        EXPECT_FLOAT_EQ( y(i,2), 3.0f*x(i,2) + 1.0f - x(i,5) );
+    }
+
+    Holor<float, 2> z(std::vector<size_t>{7, 6});
+    EXPECT_THROW( axpy(1.0f, z, y), holor::exception::HolorRuntimeError );
+}
+
+TEST(TestOperations, CheckEquality){
+    Holor<int, 2> h1(std::vector<size_t>{8, 9});
+    std::iota(h1.begin(), h1.end(), 0);
+    Holor<int, 2> h2 = h1;
+    EXPECT_TRUE( (h1 == h2) );
+    h2(7, 8) = -1;
+    EXPECT_FALSE( (h1 == h2) );
+    EXPECT_TRUE( (h1.row(3) == h2.row(3)) );
+    EXPECT_FALSE( (h1.row(7) == h2.row(7)) );
+    EXPECT_TRUE( (h1.col(2) == h2.col(2)) );
+    EXPECT_FALSE( (h1.col(8) == h2.col(8)) );
+}
+
+TEST(TestOperations, CheckExecutionPolicies){
+    const auto par = execution::par.with_threads(4);
+    EXPECT_EQ(impl::partition_count(execution::seq, 1000, 1<<20), 1);
+    EXPECT_EQ(impl::partition_count(par, 1000, 1<<20), 4);
+    EXPECT_EQ(impl::partition_count(par, 3, 1<<20), 3);
+    EXPECT_EQ(impl::partition_count(par, 1000, 100), 1);
+    EXPECT_EQ(impl::partition_count(par, 0, 100), 0);
+
+    Holor<double, 3> h(std::vector<size_t>{96, 40, 36});
+    std::iota(h.begin(), h.end(), 0.0);
+    auto sub = h.slice<2>(range{1, 30});
+
+    // broadcast and reduce along every dimension, on contiguous and strided containers
+    {
+        auto expected = h;
+        auto result = h;
+        Holor<double, 2> slice0 = h.slice<0>(5);
+        broadcast<0>(expected, slice0, std::plus<double>());
+        broadcast<0>(par, result, slice0, std::plus<double>());
+        EXPECT_TRUE((result == expected));
+        Holor<double, 2> slice2 = h.slice<2>(7);
+        broadcast<2>(expected, slice2, std::multiplies<double>());
+        broadcast<2>(execution::par_unseq.with_threads(4), result, slice2, std::multiplies<double>());
+        EXPECT_TRUE((result == expected));
+    }
+    {
+        Holor<double, 2> init(std::vector<size_t>{40, 36});
+        std::ranges::fill(init, 0.0);
+        EXPECT_TRUE((reduce<0>(par, h, init, std::plus<double>()) == reduce<0>(h, init, std::plus<double>())));
+        Holor<double, 2> init1(std::vector<size_t>{96, 30});
+        std::ranges::fill(init1, 0.0);
+        EXPECT_TRUE((reduce<1>(par, sub, init1, std::plus<double>()) == reduce<1>(sub, init1, std::plus<double>())));
+    }
+    {
+        EXPECT_DOUBLE_EQ(reduce_all(par, h, 1.0, std::plus<double>()), reduce_all(h, 1.0, std::plus<double>()));
+        EXPECT_DOUBLE_EQ(reduce_all(par, sub, 1.0, std::plus<double>()), reduce_all(sub, 1.0, std::plus<double>()));
+        EXPECT_DOUBLE_EQ(reduce_all(par, sub, -1.0, simd::Max()), sub(95, 39, 29));
+        EXPECT_DOUBLE_EQ(reduce_all(par, sub, 1e9, [](double a, double b){ return std::min(a, b); }), sub(0, 0, 0));
+    }
+
+    // element-wise operations
+    {
+        auto expected = h;
+        auto result = h;
+        apply(expected, [](double x){ return 2*x + 1; });
+        apply(par, result, [](double x){ return 2*x + 1; });
+        EXPECT_TRUE((result == expected));
+        auto sub_expected = expected.slice<2>(range{1, 30});
+        auto sub_result = result.slice<2>(range{1, 30});
+        apply(sub_expected, [](double x){ return -x; });
+        apply(par, sub_result, [](double x){ return -x; });
+        EXPECT_TRUE((result == expected));
+        broadcast_all(sub_expected, 3.0, std::minus<double>());
+        broadcast_all(par, sub_result, 3.0, std::minus<double>());
+        broadcast_all(expected, 0.5, std::multiplies<double>());
+        broadcast_all(par, result, 0.5, std::multiplies<double>());
+        EXPECT_TRUE((result == expected));
+    }
+
+    // operations that return a new container
+    {
+        EXPECT_TRUE((transpose(par, h) == transpose(h)));
+        EXPECT_TRUE((transpose(par, sub, std::array<size_t, 3>{1, 2, 0}) == transpose(sub, std::array<size_t, 3>{1, 2, 0})));
+        EXPECT_TRUE((shift<0>(par, h, 7) == shift<0>(h, 7)));
+        EXPECT_TRUE((shift<1>(par, h, -3) == shift<1>(h, -3)));
+        EXPECT_TRUE((shift<2>(par, sub, 100) == shift<2>(sub, 100)));
+        std::vector<size_t> order(96);
+        std::iota(order.rbegin(), order.rend(), 0);
+        EXPECT_TRUE((permutation<0>(par, h, order) == permutation<0>(h, order)));
+        std::vector<size_t> order1(40);
+        std::iota(order1.begin(), order1.end(), 0);
+        std::swap(order1[3], order1[31]);
+        EXPECT_TRUE((permutation<1>(par, sub, order1) == permutation<1>(sub, order1)));
+        EXPECT_TRUE((permutation_pair<2>(par, h, 0, 35) == permutation_pair<2>(h, 0, 35)));
+        EXPECT_TRUE((concatenate<0>(par, h, h, h) == concatenate<0>(h, h, h)));
+        Holor<double, 3> g(sub);
+        EXPECT_TRUE((concatenate<1>(par, g, sub, g) == concatenate<1>(g, g, g)));
+        EXPECT_TRUE((concatenate<2>(execution::seq, g, sub) == concatenate<2>(g, g)));
+    }
+}
+
+
+
+/*!
+ * reference transposition, that copies the elements of a transposed view in row-major order
+ */
+template<class H, class Order>
+auto reference_transpose(H& source, Order order){
+    auto view = transpose_view(source, order);
+    Holor<typename H::value_type, H::dimensions> result(view.lengths());
+    std::copy(view.cbegin(), view.cend(), result.begin());
+    return result;
+}
+
+template<typename T>
+void check_transpositions(){
+    Holor<T, 2> h2(std::vector<size_t>{67, 133});
+    std::iota(h2.begin(), h2.end(), T(1));
+    EXPECT_TRUE((transpose(h2) == reference_transpose(h2, std::array<size_t, 2>{1, 0})));
+    auto s2 = h2.template slice<1>(range{3, 120, 2});
+    EXPECT_TRUE((transpose(s2) == reference_transpose(s2, std::array<size_t, 2>{1, 0})));
+
+    Holor<T, 3> h3(std::vector<size_t>{9, 70, 41});
+    std::iota(h3.begin(), h3.end(), T(1));
+    for (auto order : {std::array<size_t, 3>{0, 2, 1}, std::array<size_t, 3>{2, 1, 0}, std::array<size_t, 3>{1, 2, 0}, std::array<size_t, 3>{2, 0, 1}, std::array<size_t, 3>{1, 0, 2}}){
+        EXPECT_TRUE((transpose(h3, order) == reference_transpose(h3, order)));
+        EXPECT_TRUE((transpose(execution::par.with_threads(3), h3, order) == reference_transpose(h3, order)));
+    }
+
+    Holor<T, 4> h4(std::vector<size_t>{5, 16, 3, 24});
+    std::iota(h4.begin(), h4.end(), T(1));
+    for (auto order : {std::array<size_t, 4>{3, 2, 1, 0}, std::array<size_t, 4>{0, 3, 2, 1}, std::array<size_t, 4>{1, 3, 0, 2}}){
+        EXPECT_TRUE((transpose(h4, order) == reference_transpose(h4, order)));
+    }
+    auto s4 = h4.template slice<3>(range{1, 22});
+    EXPECT_TRUE((transpose(s4) == reference_transpose(s4, std::array<size_t, 4>{3, 2, 1, 0})));
+}
+
+TEST(TestOperations, CheckBlockedTranspose){
+    check_transpositions<float>();
+    check_transpositions<double>();
+    check_transpositions<int32_t>();
+    check_transpositions<int64_t>();
+    check_transpositions<int16_t>();
+
+    // elements that are not arithmetic are copied by the scalar tiles
+    Holor<std::string, 2> strings(std::vector<size_t>{20, 30});
+    for (size_t i = 0; i < 20; i++){
+        for (size_t j = 0; j < 30; j++){
+            strings(i, j) = std::to_string(i) + "," + std::to_string(j);
+        }
+    }
+    auto transposed = transpose(strings);
+    EXPECT_EQ(transposed(29, 19), "19,29");
+    EXPECT_EQ(transposed(3, 7), "7,3");
+
+    // SIMD kernel on a single block
+    constexpr size_t B = simd::transpose_block_size<float>;
+    std::array<float, 2*B*B> src, dest;
+    std::iota(src.begin(), src.end(), 0.0f);
+    simd::transpose_block(src.data(), 2*B, dest.data(), 2*B);
+    for (size_t i = 0; i < B; i++){
+        for (size_t j = 0; j < B; j++){
+            EXPECT_EQ(dest[j*2*B + i], src[i*2*B + j]);
+        }
+    }
+}
+
+
+template<typename T, size_t N>
+void check_transpose_inplace(const std::array<size_t, N>& lengths, const std::array<size_t, N>& order){
+    Holor<T, N> h(lengths);
+    std::iota(h.begin(), h.end(), T(1));
+    auto expected = transpose(h, order);
+    auto data = h.data();
+    transpose_inplace(h, order);
+    EXPECT_TRUE((h == expected));
+    EXPECT_EQ(h.lengths(), expected.lengths());
+    EXPECT_EQ(h.data(), data);
+}
+
+TEST(TestOperations, CheckTransposeInplace){
+    // square matrices and batches of square matrices
+    for (size_t n : {1, 2, 7, 8, 31, 64, 67, 130}){
+        check_transpose_inplace<float, 2>({n, n}, {1, 0});
+        check_transpose_inplace<double, 2>({n, n}, {1, 0});
+        check_transpose_inplace<int16_t, 2>({n, n}, {1, 0});
+    }
+    check_transpose_inplace<float, 3>({3, 45, 45}, {0, 2, 1});
+    check_transpose_inplace<int64_t, 4>({2, 3, 20, 20}, {0, 1, 3, 2});
+
+    // rectangular matrices and general permutations
+    check_transpose_inplace<float, 2>({1, 17}, {1, 0});
+    check_transpose_inplace<float, 2>({33, 70}, {1, 0});
+    check_transpose_inplace<double, 2>({128, 3}, {1, 0});
+    check_transpose_inplace<int, 3>({5, 6, 7}, {2, 1, 0});
+    check_transpose_inplace<int, 3>({5, 6, 7}, {1, 2, 0});
+    check_transpose_inplace<int, 3>({5, 6, 6}, {2, 0, 1});
+    check_transpose_inplace<float, 4>({4, 9, 2, 5}, {3, 0, 2, 1});
+    check_transpose_inplace<float, 3>({4, 5, 6}, {0, 1, 2});
+
+    // the default order inverts the coordinates
+    Holor<double, 3> h(std::vector<size_t>{3, 4, 5});
+    std::iota(h.begin(), h.end(), 0.0);
+    auto expected = transpose(h);
+    transpose_inplace(h);
+    EXPECT_TRUE((h == expected));
+
+    // elements that are not trivially copyable are moved
+    Holor<std::string, 2> strings(std::vector<size_t>{3, 4});
+    for (size_t i = 0; i < 3; i++){
+        for (size_t j = 0; j < 4; j++){
+            strings(i, j) = std::to_string(i) + "," + std::to_string(j);
+        }
+    }
+    transpose_inplace(strings);
+    EXPECT_EQ(strings.lengths(), (std::array<size_t, 2>{4, 3}));
+    EXPECT_EQ(strings(3, 1), "1,3");
+    EXPECT_EQ(strings(0, 2), "2,0");
+
+    EXPECT_THROW(transpose_inplace(h, std::array<size_t, 3>{0, 0, 1}), holor::exception::HolorRuntimeError);
+    EXPECT_THROW(transpose_inplace(h, std::array<size_t, 3>{0, 1, 3}), holor::exception::HolorRuntimeError);
+}
+
+
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,263 @@
+// This file is part of Holor, a C++ header-only template library for multi-dimensional containers
+
+// Copyright 2020-2022 Carlo Masone
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to 
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is 
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER 
+// DEALINGS IN THE SOFTWARE.
+
+
+
+
+
+
+#include <cmath>
+#include <limits>
+#include <vector>
+#include <holor/holor_full.h>
+#include <gtest/gtest.h>
+#include "test_utils.h"
+
+using namespace holor;
+
+
+
+/*=================================================================================
+                                Utilities
+=================================================================================*/
+/*!
+ * reference reduction of a 3D container along the dimensions flagged in `reduced`, computed in long double with the reduced indices set to zero in the result
+ */
+template<class H, class Op>
+Holor<long double, 3> reference_reduce(const H& h, std::array<bool, 3> reduced, long double init, Op op){
+    std::vector<size_t> lengths;
+    for (size_t d = 0; d < 3; d++){
+        lengths.push_back(reduced[d] ? 1 : h.length(d));
+    }
+    Holor<long double, 3> result(lengths);
+    for (auto& x : result){
+        x = init;
+    }
+    for (size_t i = 0; i < h.length(0); i++){
+        for (size_t j = 0; j < h.length(1); j++){
+            for (size_t k = 0; k < h.length(2); k++){
+                auto& r = result(reduced[0] ? 0 : i, reduced[1] ? 0 : j, reduced[2] ? 0 : k);
+                r = op(r, static_cast<long double>(h(i, j, k)));
+            }
+        }
+    }
+    return result;
+}
+
+/*!
+ * checks the sum, product, minimum and maximum of a 3D container along every pair of dimensions against the reference
+ */
+template<class H, ExecutionPolicy Policy>
+void check_reductions(const Policy& policy, const H& h){
+    using T = typename H::value_type;
+    auto plus = [](long double a, long double b){ return a + b; };
+    auto minimum = [](long double a, long double b){ return std::min(a, b); };
+    auto maximum = [](long double a, long double b){ return std::max(a, b); };
+    for (size_t d = 0; d < 3; d++){
+        std::array<bool, 3> reduced{};
+        reduced[d] = true;
+        auto expected = reference_reduce(h, reduced, 0, plus);
+        auto expected_min = reference_reduce(h, reduced, std::numeric_limits<long double>::infinity(), minimum);
+        auto expected_max = reference_reduce(h, reduced, -std::numeric_limits<long double>::infinity(), maximum);
+        auto s = sum<1>(policy, h, {d});
+        auto lo = min<1>(policy, h, {d});
+        auto hi = max<1>(policy, h, {d});
+        ASSERT_EQ(s.size()*h.length(d), h.size());
+        auto e = expected.data();
+        auto e_min = expected_min.data();
+        auto e_max = expected_max.data();
+        for (size_t i = 0; i < s.size(); i++){
+            EXPECT_EQ(s.data()[i], static_cast<T>(e[i]));
+            EXPECT_EQ(lo.data()[i], static_cast<T>(e_min[i]));
+            EXPECT_EQ(hi.data()[i], static_cast<T>(e_max[i]));
+        }
+
+        reduced.fill(true);
+        reduced[d] = false;
+        auto expected_pair = reference_reduce(h, reduced, 0, plus);
+        auto s_pair = sum<2>(policy, h, {(d+2)%3, (d+1)%3});
+        ASSERT_EQ(s_pair.size(), h.length(d));
+        for (size_t i = 0; i < s_pair.size(); i++){
+            EXPECT_EQ(s_pair(i), static_cast<T>(expected_pair.data()[i]));
+        }
+    }
+    EXPECT_EQ(sum(policy, h), static_cast<T>(reference_reduce(h, {true, true, true}, 0, plus)(0, 0, 0)));
+    EXPECT_EQ(min(policy, h), static_cast<T>(reference_reduce(h, {true, true, true}, std::numeric_limits<long double>::infinity(), minimum)(0, 0, 0)));
+    EXPECT_EQ(max(policy, h), static_cast<T>(reference_reduce(h, {true, true, true}, -std::numeric_limits<long double>::infinity(), maximum)(0, 0, 0)));
+}
+
+
+
+/*=================================================================================
+                                Tests
+=================================================================================*/
+TEST(TestReductions, CheckSumMinMax){
+    Holor<int, 2> a{{1, 2, 3}, {4, 5, 6}};
+    EXPECT_EQ(sum(a), 21);
+    EXPECT_TRUE((sum<1>(a, {0}) == Holor<int, 1>{5, 7, 9}));
+    EXPECT_TRUE((sum<1>(a, {1}) == Holor<int, 1>{6, 15}));
+    EXPECT_EQ((sum<2>(a, {1, 0})), 21);
+    EXPECT_TRUE((min<1>(a, {0}) == Holor<int, 1>{1, 2, 3}));
+    EXPECT_TRUE((max<1>(a, {1}) == Holor<int, 1>{3, 6}));
+    EXPECT_EQ(min(a), 1);
+    EXPECT_EQ(max(a), 6);
+
+    // every order of the dimensions, with contiguous containers and with strided and transposed views
+    Holor<float, 3> f(std::vector<size_t>{9, 13, 70});
+    fill_pattern(f, 0, 11, 7);
+    check_reductions(execution::seq, f);
+    check_reductions(execution::seq, f(range{1, 7, 2}, range{0, 12, 3}, range{2, 69}));
+    check_reductions(execution::seq, transpose_view(f, std::array<size_t, 3>{2, 0, 1}));
+    Holor<int, 3> n(std::vector<size_t>{6, 5, 2100});
+    fill_pattern(n, 3, 11, 7);
+    check_reductions(execution::seq, n);
+    check_reductions(execution::seq, transpose_view(n, std::array<size_t, 3>{1, 2, 0}));
+
+    // parallel reductions, that partition the dimension that is not reduced or compute partial results
+    Holor<double, 3> big(std::vector<size_t>{40, 30, 200});
+    fill_pattern(big, 1, 11, 7);
+    check_reductions(execution::par.with_threads(4), big);
+    check_reductions(execution::par.with_threads(3), transpose_view(big, std::array<size_t, 3>{2, 1, 0}));
+
+    // invalid dimensions
+    EXPECT_THROW((sum<1>(a, {2})), holor::exception::HolorRuntimeError);
+    EXPECT_THROW((max<2>(a, {1, 1})), holor::exception::HolorRuntimeError);
+}
+
+
+TEST(TestReductions, CheckProd){
+    Holor<int, 2> a{{1, 2, 3}, {4, 5, 6}};
+    EXPECT_EQ(prod(a), 720);
+    EXPECT_TRUE((prod<1>(a, {0}) == Holor<int, 1>{4, 10, 18}));
+    EXPECT_TRUE((prod<1>(a, {1}) == Holor<int, 1>{6, 120}));
+
+    Holor<double, 2> b(std::vector<size_t>{100, 300});
+    for (size_t i = 0; i < b.length(0); i++){
+        for (size_t j = 0; j < b.length(1); j++){
+            b(i, j) = ((i + j)%3 == 0) ? 2.0 : (((i*j)%5 == 0) ? 0.5 : 1.0);
+        }
+    }
+    auto rows = prod<1>(execution::par.with_threads(4), b, {1});
+    auto columns = prod<1>(b, {0});
+    for (size_t i = 0; i < b.length(0); i++){
+        double expected = 1;
+        for (size_t j = 0; j < b.length(1); j++){
+            expected *= b(i, j);
+        }
+        EXPECT_EQ(rows(i), expected);
+    }
+    for (size_t j = 0; j < b.length(1); j++){
+        double expected = 1;
+        for (size_t i = 0; i < b.length(0); i++){
+            expected *= b(i, j);
+        }
+        EXPECT_EQ(columns(j), expected);
+    }
+}
+
+
+TEST(TestReductions, CheckMeanVar){
+    Holor<int, 2> a{{1, 2, 3}, {4, 5, 7}};
+    EXPECT_EQ(mean(a), 22.0/6);
+    EXPECT_TRUE((mean<1>(a, {0}) == Holor<double, 1>{2.5, 3.5, 5.0}));
+    EXPECT_TRUE((var<1>(a, {0}) == Holor<double, 1>{2.25, 2.25, 4.0}));
+    EXPECT_TRUE((var<1>(a, {0}, 1) == Holor<double, 1>{4.5, 4.5, 8.0}));
+    EXPECT_DOUBLE_EQ(var<1>(a, {1})(1), 14.0/9);
+
+    // the two-pass variance is accurate for values with a large mean
+    Holor<float, 2> f(std::vector<size_t>{64, 3000});
+    fill_pattern(f, 2, 11, 7);
+    for (auto& x : f){
+        x += 10000.0f;
+    }
+    for (auto policy_threads : {size_t{1}, size_t{4}}){
+        auto policy = execution::par.with_threads(policy_threads);
+        auto means = mean<1>(policy, f, {1});
+        auto vars = var<1>(policy, f, {1}, 1);
+        auto column_vars = var<1>(policy, f, {0});
+        for (size_t i = 0; i < f.length(0); i++){
+            double m = 0;
+            for (size_t j = 0; j < f.length(1); j++){
+                m += f(i, j);
+            }
+            m /= f.length(1);
+            double v = 0;
+            for (size_t j = 0; j < f.length(1); j++){
+                v += (f(i, j) - m)*(f(i, j) - m);
+            }
+            v /= f.length(1) - 1;
+            EXPECT_NEAR(means(i), m, 1e-3);
+            EXPECT_NEAR(vars(i), v, 1e-4*v);
+        }
+        for (size_t j = 0; j < f.length(1); j++){
+            double m = 0;
+            for (size_t i = 0; i < f.length(0); i++){
+                m += f(i, j);
+            }
+            m /= f.length(0);
+            double v = 0;
+            for (size_t i = 0; i < f.length(0); i++){
+                v += (f(i, j) - m)*(f(i, j) - m);
+            }
+            v /= f.length(0);
+            EXPECT_NEAR(column_vars(j), v, 1e-4*v + 1e-6);
+        }
+        EXPECT_NEAR(var(policy, f), 10.0, 0.1);
+    }
+
+    EXPECT_THROW((var<1>(a, {0}, 2)), holor::exception::HolorRuntimeError);
+    EXPECT_THROW((mean<1>(a, {3})), holor::exception::HolorRuntimeError);
+}
+
+
+TEST(TestReductions, CheckAccuracy){
+    // the naive sum of a million copies of 0.1f drifts by about 1%, the pairwise and compensated sums are exact to the precision of a float
+    Holor<float, 1> v(std::vector<size_t>{1000000});
+    for (auto& x : v){
+        x = 0.1f;
+    }
+    const double expected = 1000000*static_cast<double>(0.1f);
+    EXPECT_NEAR(sum(v), expected, 1e-6*expected);
+    EXPECT_NEAR(sum(execution::par.with_threads(4), v), expected, 1e-6*expected);
+    EXPECT_NEAR(mean(v), 0.1f, 1e-7);
+
+    // accumulation of the rows of a container into the sums of its columns
+    Holor<float, 2> m(std::vector<size_t>{200000, 5});
+    for (auto& x : m){
+        x = 0.1f;
+    }
+    auto columns = sum<1>(m, {0});
+    for (auto x : columns){
+        EXPECT_NEAR(x, 200000*static_cast<double>(0.1f), 1e-6*200000*0.1);
+    }
+    auto strided_columns = sum<1>(m(range{0, 199999, 2}, range{0, 4}), {0});
+    for (auto x : strided_columns){
+        EXPECT_NEAR(x, 100000*static_cast<double>(0.1f), 1e-6*100000*0.1);
+    }
+}
+
+
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,170 @@
+// This file is part of Holor, a C++ header-only template library for multi-dimensional containers
+
+// Copyright 2020-2022 Carlo Masone
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to 
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is 
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER 
+// DEALINGS IN THE SOFTWARE.
+
+
+
+
+
+
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+#include <holor/holor_full.h>
+#include <io/holor_serialization.h>
+#include <gtest/gtest.h>
+#include "test_utils.h"
+
+using namespace holor;
+
+
+
+/*=================================================================================
+                                Utilities
+=================================================================================*/
+template<typename T, size_t N>
+void check_roundtrip(const std::vector<size_t>& lengths){
+    TemporaryFile file("serialization", "roundtrip");
+    Holor<T, N> h(lengths);
+    fill_pattern(h);
+    save(file.path_, h);
+    EXPECT_EQ(std::filesystem::file_size(file.path_), 16 + 8*N + h.size()*sizeof(T));
+    auto loaded = load<T, N>(file.path_);
+    EXPECT_TRUE( (loaded == h) );
+}
+
+
+
+/*=================================================================================
+                                Tests
+=================================================================================*/
+TEST(TestSerialization, CheckRoundtrip){
+    check_roundtrip<float, 1>({1000});
+    check_roundtrip<double, 2>({17, 33});
+    check_roundtrip<int8_t, 3>({4, 5, 6});
+    check_roundtrip<uint16_t, 3>({2, 1, 9});
+    check_roundtrip<int64_t, 4>({2, 3, 4, 5});
+    check_roundtrip<float, 2>({700, 900});
+
+    // containers without elements
+    check_roundtrip<float, 2>({0, 4});
+    check_roundtrip<int32_t, 3>({3, 0, 2});
+}
+
+
+TEST(TestSerialization, CheckViews){
+    Holor<double, 3> h(std::vector<size_t>{6, 70, 90});
+    fill_pattern(h);
+    TemporaryFile file("serialization", "views");
+
+    // a slice with long contiguous runs, that are gathered in the same write
+    auto slice = h(range{1, 4}, range{2, 60, 3}, range{0, 85});
+    save(file.path_, slice);
+    EXPECT_TRUE( (load<double, 3>(file.path_) == slice) );
+
+    // a transposed view, whose elements are copied to a buffer
+    auto transposed = transpose_view(h);
+    save(file.path_, transposed);
+    auto loaded = load<double, 3>(file.path_);
+    EXPECT_EQ(loaded.lengths(), (std::array<size_t, 3>{90, 70, 6}));
+    EXPECT_TRUE( (loaded == transposed) );
+
+    // transposed views whose slabs fill the buffer one at a time, or leave a tail of a single slab
+    for (size_t rows : {50000, 100000}){
+        Holor<double, 2> tall(std::vector<size_t>{rows, 3});
+        fill_pattern(tall);
+        save(file.path_, transpose_view(tall));
+        auto loaded_tall = load<double, 2>(file.path_);
+        EXPECT_EQ(loaded_tall.lengths(), (std::array<size_t, 2>{3, rows}));
+        EXPECT_TRUE( (loaded_tall == transpose_view(tall)) );
+    }
+
+    // a strided view with a single dimension, whose elements are copied one at a time
+    Holor<int64_t, 1> v(std::vector<size_t>{1000});
+    fill_pattern(v);
+    auto strided = v(range{1, 998, 3});
+    save(file.path_, strided);
+    EXPECT_TRUE( (load<int64_t, 1>(file.path_) == strided) );
+
+    // a view with fewer dimensions, and a broadcast view
+    save(file.path_, h.slice<0>(2));
+    EXPECT_TRUE( (load<double, 2>(file.path_) == h.slice<0>(2)) );
+    Holor<int, 1> row{1, 2, 3};
+    save(file.path_, broadcast_to<2>(row, {400, 3}));
+    auto expanded = load<int, 2>(file.path_);
+    EXPECT_EQ(expanded.lengths(), (std::array<size_t, 2>{400, 3}));
+    EXPECT_EQ(sum<1>(expanded, {0})(2), 1200);
+}
+
+
+TEST(TestSerialization, CheckByteOrder){
+    // a file written with the opposite byte order is converted when it is loaded
+    TemporaryFile file("serialization", "byteorder");
+    Holor<uint32_t, 2> h{ {1, 2, 3}, {0x01020304, 0xA0B0C0D0, 7} };
+    impl::BinaryHeader header{impl::element_type<uint32_t>(), (std::endian::native == std::endian::little) ? std::endian::big : std::endian::little, {2, 3}};
+    auto bytes = header.encode();
+    Holor<uint32_t, 2> swapped = h;
+    impl::byteswap(swapped.data(), swapped.size(), sizeof(uint32_t));
+    {
+        std::ofstream os(file.path_, std::ios::binary);
+        os.write(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+        os.write(reinterpret_cast<const char*>(swapped.data()), swapped.size()*sizeof(uint32_t));
+    }
+    EXPECT_TRUE( (load<uint32_t, 2>(file.path_) == h) );
+}
+
+
+TEST(TestSerialization, CheckErrors){
+    TemporaryFile file("serialization", "errors");
+    Holor<float, 2> h{ {1, 2, 3}, {4, 5, 6} };
+    save(file.path_, h);
+
+    // wrong type of the elements or number of dimensions
+    EXPECT_THROW( (load<double, 2>(file.path_)), holor::exception::HolorRuntimeError );
+    EXPECT_THROW( (load<int32_t, 2>(file.path_)), holor::exception::HolorRuntimeError );
+    EXPECT_THROW( (load<float, 3>(file.path_)), holor::exception::HolorRuntimeError );
+
+    // truncated file and file with a different format
+    std::filesystem::resize_file(file.path_, std::filesystem::file_size(file.path_) - 1);
+    EXPECT_THROW( (load<float, 2>(file.path_)), holor::exception::HolorRuntimeError );
+    {
+        std::ofstream os(file.path_);
+        os << "this is not a holor";
+    }
+    EXPECT_THROW( (load<float, 2>(file.path_)), holor::exception::HolorRuntimeError );
+    {
+        std::ofstream os(file.path_);
+    }
+    EXPECT_THROW( (load<float, 2>(file.path_)), holor::exception::HolorRuntimeError );
+
+    // missing file and directory that cannot be written
+    EXPECT_THROW( (load<float, 2>(file.path_.string() + ".missing")), holor::exception::HolorRuntimeError );
+    EXPECT_THROW( save(std::filesystem::temp_directory_path() / "holor_missing_directory" / "file", h), holor::exception::HolorRuntimeError );
+}
+
+
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,158 @@
+// This file is part of Holor, a C++ header-only template library for multi-dimensional containers
+
+// Copyright 2020-2022 Carlo Masone
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to 
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is 
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER 
+// DEALINGS IN THE SOFTWARE.
+
+
+
+#include <algorithm>
+#include <array>
+#include <vector>
+#include <numeric>
+#include <type_traits>
+#include <holor/holor_full.h>
+#include <gtest/gtest.h>
+
+using namespace holor;
+
+
+
+
+/*=================================================================================
+                                Static Layout Tests
+=================================================================================*/
+TEST(TestStaticHolor, CheckStaticLayout){
+    using layout_type = StaticLayout<3, 4, 5>;
+    static_assert(layout_type::order == 3);
+    static_assert(layout_type::size() == 60);
+    static_assert(layout_type::stride(0) == 20);
+    static_assert(layout_type::stride(1) == 5);
+    static_assert(layout_type::stride(2) == 1);
+    static_assert(layout_type{}(2, 3, 4) == 59);
+    static_assert(layout_type{}(1, 0, 2) == 22);
+
+    Layout<3> dynamic_layout(3, 4, 5);
+    EXPECT_EQ(layout_type::layout(), dynamic_layout);
+    EXPECT_EQ(layout_type{}(std::array<size_t,3>{1,2,3}), dynamic_layout(1,2,3));
+    EXPECT_EQ(layout_type{}(range(0,2), 1, range(1,3)), dynamic_layout(range(0,2), 1, range(1,3)));
+    EXPECT_EQ(layout_type{}.slice_dimension<1>(2), dynamic_layout.slice_dimension<1>(2));
+    EXPECT_THROW(layout_type{}(3, 0, 0), holor::exception::HolorRuntimeError);
+}
+
+
+/*=================================================================================
+                                Static Holor Tests
+=================================================================================*/
+TEST(TestStaticHolor, CheckAliases){
+    using holor_type = StaticHolor<float, 3, 3>;
+    EXPECT_TRUE( (HolorType<holor_type>) );
+    EXPECT_TRUE( (std::is_same_v<holor_type::value_type, float>) );
+    EXPECT_EQ( holor_type::dimensions, 2 );
+    EXPECT_EQ( sizeof(holor_type), 9*sizeof(float) );
+    EXPECT_TRUE( (std::is_trivially_copyable_v<holor_type>) );
+}
+
+
+TEST(TestStaticHolor, CheckConstructors){
+    {
+        StaticHolor<int, 2, 3> h;
+        EXPECT_EQ(h.size(), 6);
+        EXPECT_EQ(h.length(0), 2);
+        EXPECT_EQ(h.length(1), 3);
+        EXPECT_TRUE(std::ranges::all_of(h, [](int i){return i==0;}));
+    }
+    {
+        StaticHolor<int, 2, 3> h{{1, 2, 3}, {4, 5, 6}};
+        std::vector<int> elements(h.begin(), h.end());
+        EXPECT_EQ(elements, (std::vector<int>{1, 2, 3, 4, 5, 6}));
+        EXPECT_THROW( (StaticHolor<int, 2, 3>{{1, 2}, {4, 5}}), holor::exception::HolorRuntimeError);
+    }
+    {
+        Holor<int, 2> dynamic{{1, 2, 3}, {4, 5, 6}, {7, 8, 9}};
+        StaticHolor<int, 3, 2> h(dynamic(range(0,2), range(1,2)));
+        EXPECT_TRUE( (h == StaticHolor<int, 3, 2>{{2, 3}, {5, 6}, {8, 9}}) );
+        EXPECT_THROW( (StaticHolor<int, 2, 2>(dynamic)), holor::exception::HolorRuntimeError);
+        Holor<int, 1> copy(h.row(1));
+        EXPECT_TRUE( (copy == Holor<int, 1>{5, 6}) );
+    }
+}
+
+
+TEST(TestStaticHolor, CheckIndexing){
+    StaticHolor<int, 2, 3, 4> h;
+    std::iota(h.begin(), h.end(), 0);
+    EXPECT_EQ(h(0, 0, 0), 0);
+    EXPECT_EQ(h(1, 2, 3), 23);
+    EXPECT_EQ(h(std::array<size_t,3>{1, 0, 2}), 14);
+    h(1, 1, 1) = 100;
+    EXPECT_EQ(h.data()[17], 100);
+    EXPECT_THROW(h(2, 0, 0), holor::exception::HolorRuntimeError);
+    const auto& ch = h;
+    EXPECT_EQ(ch(0, 1, 2), 6);
+}
+
+
+TEST(TestStaticHolor, CheckSlicing){
+    StaticHolor<int, 3, 3> h{{1, 2, 3}, {4, 5, 6}, {7, 8, 9}};
+    auto row = h.row(1);
+    EXPECT_TRUE( (std::is_same_v<decltype(row), HolorRef<int, 1>>) );
+    EXPECT_TRUE( (row == Holor<int,1>{4, 5, 6}) );
+    auto col = h.col(2);
+    EXPECT_TRUE( (col == Holor<int,1>{3, 6, 9}) );
+    auto block = h(range(0,1), range(1,2));
+    EXPECT_TRUE( (block == Holor<int,2>{{2, 3}, {5, 6}}) );
+    block(1, 1) = 60;
+    EXPECT_EQ(h(1, 2), 60);
+    auto flipped = h.slice<0>(range(2,0,-1));
+    EXPECT_TRUE( (flipped == Holor<int,2>{{7, 8, 9}, {4, 5, 60}, {1, 2, 3}}) );
+
+    // the slices of a const container are read-only views, like those of a const Holor
+    const auto& ch = h;
+    const Holor<int, 2> dynamic(h(range(0,2), range(0,2)));
+    auto const_row = ch.row(1);
+    EXPECT_TRUE( (std::is_same_v<decltype(const_row), HolorRef<const int, 1>>) );
+    EXPECT_TRUE( (std::is_same_v<decltype(const_row), decltype(dynamic.row(1))>) );
+    EXPECT_TRUE( (const_row == dynamic.row(1)) );
+    EXPECT_TRUE( (Holor<int,1>(ch.col(2)) == Holor<int,1>{3, 60, 9}) );
+    EXPECT_TRUE( (ch.slice<1>(0) == dynamic.slice<1>(0)) );
+    EXPECT_TRUE( (ch.slice<0>(range(2,0,-1)) == dynamic.slice<0>(range(2,0,-1))) );
+    auto const_block = ch(range(0,1), 2);
+    EXPECT_TRUE( (std::is_same_v<decltype(const_block), HolorRef<const int, 1>>) );
+    EXPECT_TRUE( (const_block == dynamic.col(2).slice<0>(range(0,1))) );
+    EXPECT_TRUE( (Holor<int,2>(ch.slice<0>(range(2,0,-1))) == Holor<int,2>(flipped)) );
+}
+
+
+TEST(TestStaticHolor, CheckOperations){
+    StaticHolor<int, 2, 3> h{{1, 2, 3}, {4, 5, 6}};
+    auto h_tr = transpose(h);
+    EXPECT_TRUE( (std::is_same_v<decltype(h_tr), Holor<int, 2>>) );
+    EXPECT_TRUE( (h_tr == Holor<int,2>{{1, 4}, {2, 5}, {3, 6}}) );
+    apply(h, [](int x){return 2*x;});
+    EXPECT_TRUE( (h == StaticHolor<int, 2, 3>{{2, 4, 6}, {8, 10, 12}}) );
+    EXPECT_FALSE( (h != StaticHolor<int, 2, 3>{{2, 4, 6}, {8, 10, 12}}) );
+}
+
+
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
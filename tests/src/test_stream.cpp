@@ -0,0 +1,144 @@
+// This file is part of Holor, a C++ header-only template library for multi-dimensional containers
+
+// Copyright 2020-2022 Carlo Masone
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to 
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is 
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER 
+// DEALINGS IN THE SOFTWARE.
+
+
+
+
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <holor/holor_full.h>
+#include <io/holor_serialization.h>
+#include <io/holor_stream.h>
+#include <io/mapped_holor.h>
+#include <gtest/gtest.h>
+#include "test_utils.h"
+
+using namespace holor;
+
+
+
+/*=================================================================================
+                                Tests
+=================================================================================*/
+TEST(TestStream, CheckAppend){
+    TemporaryFile file("stream", "append");
+    Holor<float, 3> expected(std::array<size_t, 3>{0, 3, 4});
+    {
+        HolorStreamWriter<float, 3> writer(file.path_, {3, 4});
+        EXPECT_EQ(writer.rows(), 0);
+        for (int i = 0; i < 10; i++){
+            Holor<float, 2> sample(std::array<size_t, 2>{3, 4});
+            fill_pattern(sample, i);
+            writer.append(sample);
+            expected.append(sample);
+        }
+        Holor<float, 3> slab(std::array<size_t, 3>{5, 3, 4});
+        fill_pattern(slab, 100);
+        writer.append(slab);
+        expected.append(slab);
+        // strided views are appended in row-major order
+        writer.append(slab(range{4, 0, -2}, range{0, 2}, range{0, 3}));
+        expected.append(slab(range{4, 0, -2}, range{0, 2}, range{0, 3}));
+        EXPECT_EQ(writer.rows(), 18);
+        EXPECT_THROW( writer.append(Holor<float, 2>(std::array<size_t, 2>{4, 3})), holor::exception::HolorRuntimeError );
+        writer.close();
+        EXPECT_THROW( writer.append(slab), holor::exception::HolorRuntimeError );
+    }
+    // the completed file is a binary file
+    EXPECT_TRUE( (load<float, 3>(file.path_) == expected) );
+    MappedHolor<const float, 3> mapped(file.path_);
+    EXPECT_TRUE( (Holor<float, 3>(mapped.view()) == expected) );
+
+    // a file closed without rows is a binary file without elements
+    HolorStreamWriter<float, 3>(file.path_, {3, 4}).close();
+    auto empty = load<float, 3>(file.path_);
+    EXPECT_EQ(empty.lengths(), (std::array<size_t, 3>{0, 3, 4}));
+    EXPECT_EQ(empty.size(), 0);
+}
+
+
+TEST(TestStream, CheckGrowingFile){
+    TemporaryFile file("stream", "growing");
+    // the buffer holds 4 rows of 8 int32
+    HolorStreamWriter<int32_t, 2> writer(file.path_, {8}, 4*8*sizeof(int32_t));
+    HolorStreamReader<int32_t, 2> reader(file.path_);
+    EXPECT_EQ(reader.rows(), 0);
+    EXPECT_EQ(reader.lengths(), (std::array<size_t, 2>{0, 8}));
+
+    Holor<int32_t, 2> rows(std::array<size_t, 2>{10, 8});
+    fill_pattern(rows);
+    for (size_t i = 0; i < 3; i++){
+        writer.append(rows.row(i));
+    }
+    // the rows in the buffer are not visible to the readers
+    EXPECT_EQ(writer.committed_rows(), 0);
+    EXPECT_EQ(reader.refresh(), 0);
+    writer.append(rows.row(3));
+    EXPECT_EQ(writer.committed_rows(), 4);
+    EXPECT_EQ(reader.refresh(), 4);
+    EXPECT_TRUE( (reader.read(0, 4) == Holor<int32_t, 2>(rows(range{0, 3}, range{0, 7}))) );
+
+    // a slab larger than the buffer is written in parts
+    writer.append(rows(range{4, 9}, range{0, 7}));
+    EXPECT_EQ(writer.committed_rows(), 8);
+    EXPECT_EQ(reader.refresh(), 8);
+    EXPECT_TRUE( (reader.read(5, 3) == Holor<int32_t, 2>(rows(range{5, 7}, range{0, 7}))) );
+    EXPECT_THROW( reader.read(6, 3), holor::exception::HolorRuntimeError );
+    EXPECT_THROW( reader.read(0, 0), holor::exception::HolorRuntimeError );
+
+    writer.flush();
+    EXPECT_EQ(reader.refresh(), 10);
+    EXPECT_TRUE( (reader.read(0, 10) == rows) );
+    writer.close();
+    EXPECT_EQ(reader.refresh(), 10);
+
+    // a file written by save can be read by rows
+    save(file.path_, rows);
+    HolorStreamReader<int32_t, 2> saved(file.path_);
+    EXPECT_EQ(saved.rows(), 10);
+    EXPECT_TRUE( (saved.read(9, 1).row(0) == rows.row(9)) );
+}
+
+
+TEST(TestStream, CheckErrors){
+    TemporaryFile file("stream", "errors");
+    EXPECT_THROW( (HolorStreamWriter<double, 2>(file.path_, {0})), holor::exception::HolorRuntimeError );
+    {
+        HolorStreamWriter<double, 2> writer(file.path_, {3}, 1 << 20, true);
+        writer.append(Holor<double, 1>{1, 2, 3});
+        EXPECT_THROW( (HolorStreamReader<float, 2>(file.path_)), holor::exception::HolorRuntimeError );
+        EXPECT_THROW( (HolorStreamReader<double, 3>(file.path_)), holor::exception::HolorRuntimeError );
+        // the rows in the buffer are not part of the file yet
+        EXPECT_EQ( (load<double, 2>(file.path_).lengths()), (std::array<size_t, 2>{0, 3}) );
+    }
+    EXPECT_TRUE( (load<double, 2>(file.path_) == Holor<double, 2>{ {1, 2, 3} }) );
+    EXPECT_THROW( (HolorStreamReader<double, 2>(file.path_.string() + ".missing")), holor::exception::HolorRuntimeError );
+}
+
+
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}